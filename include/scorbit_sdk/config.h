@@ -21,6 +21,7 @@
 
 #include "config_c.h"
 #include "event.h"
+#include "leaderboard.h"
 #include "net_types.h"
 #include <cstring>
 #include <functional>
@@ -31,6 +32,9 @@
 namespace scorbit {
 
 using EventCallback = std::function<void(const Event &event)>;
+/// Receives type and JSON payload of a control channel message
+using ControlMessageCallback =
+        std::function<void(const std::string &type, const std::string &payload)>;
 // SaveKeyCallback and LoadKeyCallback are defined in net_types.h
 
 /**
@@ -165,6 +169,103 @@ public:
         return *this;
     }
 
+    /**
+     * @brief Set directory for persistent player pictures cache.
+     * @param dir Writable directory. Optional, pictures are cached in memory only if not set.
+     * @return Reference to this Config for method chaining.
+     */
+    Config &setPictureCacheDir(const std::string &dir)
+    {
+        sb_config_set_picture_cache_dir(m_handle.get(), dir.c_str());
+        return *this;
+    }
+
+    /**
+     * @brief Set leaderboard cache TTL (see @ref sb_config_set_leaderboard_cache_ttl).
+     * @param ttl Seconds cached leaderboard is returned without request, 0 disables.
+     * @param staleWindow Seconds after TTL it is returned while refreshed in the background.
+     * @return Reference to this Config for method chaining.
+     */
+    Config &setLeaderboardCacheTtl(int ttl, int staleWindow = 300)
+    {
+        sb_config_set_leaderboard_cache_ttl(m_handle.get(), ttl, staleWindow);
+        return *this;
+    }
+
+    /**
+     * @brief Set leaderboards refreshed in the background (see
+     * @ref sb_config_set_leaderboard_prefetch).
+     * @param requests Boards to refresh after each game, empty disables prefetch.
+     * @param idleInterval Seconds between refreshes while idle, 0 refreshes only after the game.
+     * @return Reference to this Config for method chaining.
+     */
+    Config &setLeaderboardPrefetch(const std::vector<LeaderboardRequest> &requests,
+                                   int idleInterval = 0)
+    {
+        std::vector<sb_leaderboard_query_t> queries;
+        queries.reserve(requests.size());
+        for (const auto &request : requests) {
+            queries.push_back({static_cast<sb_leaderboard_scope_t>(request.scope),
+                               static_cast<sb_leaderboard_period_t>(request.period),
+                               request.since.empty() ? nullptr : request.since.c_str(),
+                               static_cast<sb_leaderboard_vpin_filter_t>(request.vpinFilter)});
+        }
+        sb_config_set_leaderboard_prefetch(m_handle.get(), queries.data(), queries.size(),
+                                           idleInterval);
+        return *this;
+    }
+
+    /**
+     * @brief Set file for scores of local leaderboards (see @ref sb_config_set_local_scores_path).
+     * @param path Writable file path. Optional, scores are kept in memory only if not set.
+     * @return Reference to this Config for method chaining.
+     */
+    Config &setLocalScoresPath(const std::string &path)
+    {
+        sb_config_set_local_scores_path(m_handle.get(), path.c_str());
+        return *this;
+    }
+
+    /**
+     * @brief Set file for recent SDK logs and events (see @ref sb_config_set_flight_recorder_path).
+     * @param path Writable file path. Optional, nothing is recorded if not set.
+     * @return Reference to this Config for method chaining.
+     */
+    Config &setFlightRecorderPath(const std::string &path)
+    {
+        sb_config_set_flight_recorder_path(m_handle.get(), path.c_str());
+        return *this;
+    }
+
+    /**
+     * @brief Set file for machine state kept between runs (see
+     * @ref sb_config_set_warm_start_cache_path).
+     * @param path Writable file path. Optional, everything is fetched at start if not set.
+     * @return Reference to this Config for method chaining.
+     */
+    Config &setWarmStartCachePath(const std::string &path)
+    {
+        sb_config_set_warm_start_cache_path(m_handle.get(), path.c_str());
+        return *this;
+    }
+
+    /**
+     * @brief Set diagnostics archive compression (see @ref sb_config_set_diagnostics_archive).
+     * @param compression Compression of the archive.
+     * @param level Compression level, 0 - default of the compression.
+     * @param threads Compression threads, used by zstd only.
+     * @param streamUpload Upload the archive while it's created instead of from a temporary file.
+     * @return Reference to this Config for method chaining.
+     */
+    Config &setDiagnosticsArchive(DiagnosticsCompression compression, int level = 0,
+                                  int threads = 1, bool streamUpload = false)
+    {
+        sb_config_set_diagnostics_archive(
+                m_handle.get(), static_cast<sb_diagnostics_compression_t>(compression), level,
+                threads, streamUpload);
+        return *this;
+    }
+
     /**
      * @brief Set nice / QOS for SDK background threads (see @ref sb_config_set_threads_priority).
      */
@@ -208,6 +309,18 @@ public:
         return *this;
     }
 
+    /**
+     * @brief Set how long the decrypted device key is kept for signing (see
+     * @ref sb_config_set_signing_key_cache_ttl).
+     * @param ttl Idle seconds before the key is wiped, 0 decrypts it for every signature.
+     * @return Reference to this Config for method chaining.
+     */
+    Config &setSigningKeyCacheTtl(int ttl)
+    {
+        sb_config_set_signing_key_cache_ttl(m_handle.get(), ttl);
+        return *this;
+    }
+
     /**
      * @brief Set the signer callback for TPM-based authentication.
      * @param signer The callback function to sign digests.
@@ -240,6 +353,29 @@ public:
         return *this;
     }
 
+    // ---- Control channel handlers ----
+
+    /**
+     * @brief Handle custom control channel messages (see @ref sb_config_add_control_handler).
+     *
+     * @param type Message type.
+     * @param method Payload method to match, empty - any.
+     * @param action Payload action name to match, empty - any.
+     * @param callback The callback function, invoked on the SDK worker thread.
+     * @return Reference to this Config for method chaining.
+     */
+    Config &addControlHandler(const std::string &type, const std::string &method,
+                              const std::string &action, ControlMessageCallback callback)
+    {
+        // Store callback locally; ownership will be moved to GameState
+        auto &storage = m_controlCallbackStorage.emplace_back(
+                std::make_unique<ControlMessageCallback>(std::move(callback)));
+        sb_config_add_control_handler(m_handle.get(), type.c_str(), method.c_str(),
+                                      action.c_str(), &Config::control_message_callback_c,
+                                      storage.get());
+        return *this;
+    }
+
     // ---- Key persistence callbacks ----
 
     /**
@@ -325,6 +461,15 @@ private:
         }
     }
 
+    static void control_message_callback_c(const char *type, const char *payload,
+                                           void *user_data)
+    {
+        auto *cb = static_cast<ControlMessageCallback *>(user_data);
+        if (cb && *cb && type && payload) {
+            (*cb)(std::string(type), std::string(payload));
+        }
+    }
+
     static void save_key_callback_c(const char *key, void *user_data)
     {
         auto *cb = static_cast<SaveKeyCallback *>(user_data);
@@ -356,6 +501,7 @@ private:
     std::unique_ptr<EventCallback> m_eventCallbackStorage;
     std::unique_ptr<SaveKeyCallback> m_saveKeyCallbackStorage;
     std::unique_ptr<LoadKeyCallback> m_loadKeyCallbackStorage;
+    std::vector<std::unique_ptr<ControlMessageCallback>> m_controlCallbackStorage;
 
     std::unique_ptr<std::remove_pointer<sb_config_t>::type, decltype(&sb_config_destroy)> m_handle;
 };
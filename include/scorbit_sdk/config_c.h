@@ -21,6 +21,7 @@
 
 #include <scorbit_sdk/export.h>
 #include "event_types_c.h"
+#include "leaderboard_c.h"
 #include "net_types_c.h"
 
 #include <stdbool.h>
@@ -128,6 +129,111 @@ void sb_config_set_serial_number(sb_config_t config, uint64_t serial_number);
 SCORBIT_SDK_EXPORT
 void sb_config_set_auto_download_player_pics(sb_config_t config, bool enable);
 
+/**
+ * @brief Set directory for persistent player pictures cache.
+ *
+ * Downloaded pictures are stored there and reused after restart, the SDK revalidates them with
+ * the server in the background. Used only with automatic player picture downloads.
+ *
+ * @param config The configuration handle.
+ * @param dir Writable directory, created if missing. Optional, if not set pictures are cached
+ *            in memory only.
+ */
+SCORBIT_SDK_EXPORT
+void sb_config_set_picture_cache_dir(sb_config_t config, const char *dir);
+
+/**
+ * @brief Set how long leaderboards from @ref sb_request_top_scores are cached.
+ *
+ * Within @p ttl_seconds the cached leaderboard is returned without request. After that, within
+ * @p stale_seconds, the cached leaderboard is still returned right away and the SDK refreshes it
+ * in the background. Identical concurrent requests are always merged into one.
+ *
+ * @param config The configuration handle.
+ * @param ttl_seconds Time to live, default 30. 0 disables serving without request.
+ * @param stale_seconds Stale window after TTL, default 300. 0 disables serving stale result.
+ */
+SCORBIT_SDK_EXPORT
+void sb_config_set_leaderboard_cache_ttl(sb_config_t config, int ttl_seconds, int stale_seconds);
+
+/**
+ * @brief Set leaderboards which the SDK refreshes into the cache in the background.
+ *
+ * The boards are refreshed when the game ends and its final scores are uploaded, so the request
+ * made on the game over screen is answered from the cache. With @p idle_interval_seconds they are
+ * also refreshed periodically while no game is played. Use @ref sb_leaderboard_updated_at to see
+ * how fresh the returned leaderboard is.
+ *
+ * @param config The configuration handle.
+ * @param queries Boards to refresh, copied. NULL or @p count 0 disables prefetch (default).
+ * @param count Number of @p queries.
+ * @param idle_interval_seconds Refresh period while idle, 0 refreshes only after the game.
+ */
+SCORBIT_SDK_EXPORT
+void sb_config_set_leaderboard_prefetch(sb_config_t config, const sb_leaderboard_query_t *queries,
+                                        size_t count, int idle_interval_seconds);
+
+/**
+ * @brief Set file where final scores of games played on this machine are kept.
+ *
+ * The scores are used by @ref SB_LEADERBOARD_SCOPE_LOCAL leaderboards, which are answered right
+ * away without network, e.g. when the venue is offline. The file has fixed size of about 300 KB.
+ *
+ * @param config The configuration handle.
+ * @param path Writable file path, created if missing. Optional, if not set scores are kept in
+ *             memory only and lost on restart.
+ */
+SCORBIT_SDK_EXPORT
+void sb_config_set_local_scores_path(sb_config_t config, const char *path);
+
+/**
+ * @brief Set file where the SDK keeps its recent log messages and state transitions.
+ *
+ * The file is a fixed size ring of about 256 KB written through memory mapping, so the recent
+ * history survives a crash or a watchdog reset. Both the records found at the next start and the
+ * current ones are added to the archive sent by @ref sb_upload_diagnostics. Messages below the
+ * log level (see @ref sb_log_set_level) are not recorded.
+ *
+ * @param config The configuration handle.
+ * @param path Writable file path, created if missing. Optional, nothing is recorded if not set.
+ */
+SCORBIT_SDK_EXPORT
+void sb_config_set_flight_recorder_path(sb_config_t config, const char *path);
+
+/**
+ * @brief Set file where the SDK keeps machine state between runs for a warm start.
+ *
+ * Machine identity, pairing, the last config and the pair short code are saved there. At the
+ * next start they are used right away, so @ref sb_request_pair_code, config events and
+ * leaderboards don't wait for the server, and they are revalidated in the background. Events are
+ * emitted again only if the server's data differs from the saved one. The file is checked by
+ * SHA-256 and bound to the device uuid and hostname, otherwise it's ignored.
+ *
+ * @param config The configuration handle.
+ * @param path Writable file path, created if missing. Optional, everything is fetched if not set.
+ */
+SCORBIT_SDK_EXPORT
+void sb_config_set_warm_start_cache_path(sb_config_t config, const char *path);
+
+/**
+ * @brief Set how the archive of @ref sb_upload_diagnostics is compressed and sent.
+ *
+ * By default the archive is a gzip compressed tar written to a temporary file and uploaded from
+ * there. Zstd is faster and can use several threads. With @p stream_upload the archive is sent
+ * while it's being created, so no temporary file is needed and uploading starts right away, but
+ * the server must accept chunked transfer encoding.
+ *
+ * @param config The configuration handle.
+ * @param compression Compression of the archive.
+ * @param level Compression level, 0 - default of the compression.
+ * @param threads Compression threads, used by zstd only. Values below 1 are treated as 1.
+ * @param stream_upload Upload the archive while it's created instead of from a temporary file.
+ */
+SCORBIT_SDK_EXPORT
+void sb_config_set_diagnostics_archive(sb_config_t config,
+                                       sb_diagnostics_compression_t compression, int level,
+                                       int threads, bool stream_upload);
+
 /**
  * @brief Set scheduling priority for SDK-owned background threads (worker and C API queue).
  *
@@ -179,6 +285,19 @@ void sb_config_set_score_features(sb_config_t config, const char **features, siz
 SCORBIT_SDK_EXPORT
 void sb_config_set_encrypted_key(sb_config_t config, const char *encrypted_key);
 
+/**
+ * @brief Set how long the device key is kept ready for signing.
+ *
+ * The SDK decrypts the soft device key on the first signature and keeps it parsed, in locked
+ * memory, for authentication and re-authentication. After @p ttl_seconds without a signature
+ * it's wiped and decrypted again when needed.
+ *
+ * @param config The configuration handle.
+ * @param ttl_seconds Idle time to live, default 300. 0 decrypts the key for every signature.
+ */
+SCORBIT_SDK_EXPORT
+void sb_config_set_signing_key_cache_ttl(sb_config_t config, int ttl_seconds);
+
 /**
  * @brief Set the signer callback for TPM-based authentication.
  *
@@ -228,6 +347,40 @@ SCORBIT_SDK_EXPORT
 void sb_config_set_event_callback(sb_config_t config, sb_event_callback_t callback,
                                   void *user_data);
 
+// ------------------------------------------------------------------------------------------------
+// Control channel handlers
+// ------------------------------------------------------------------------------------------------
+
+/**
+ * @brief Callback for control channel messages not handled by the SDK itself.
+ *
+ * @param type Value of the message "type", e.g. "action".
+ * @param payload_json Message payload, JSON object serialized to string.
+ * @param user_data User data passed to sb_config_add_control_handler.
+ */
+typedef void (*sb_control_message_callback_t)(const char *type, const char *payload_json,
+                                              void *user_data);
+
+/**
+ * @brief Handle custom messages published to the machine control channel.
+ *
+ * Message matches if its "type" equals @p type and, when given, payload "method" equals
+ * @p method and payload "name" equals @p action. The most specific handler wins. Messages the SDK
+ * handles stay with the SDK: a handler which would take any of them, e.g. "action" with method
+ * "MSG", is ignored with a warning. The callback is invoked on the SDK worker thread.
+ *
+ * @param config The configuration handle.
+ * @param type Message type, required.
+ * @param method Payload method to match, NULL or empty - any.
+ * @param action Payload action name to match, NULL or empty - any.
+ * @param callback The callback function, required.
+ * @param user_data Optional user data passed to the callback.
+ */
+SCORBIT_SDK_EXPORT
+void sb_config_add_control_handler(sb_config_t config, const char *type, const char *method,
+                                   const char *action, sb_control_message_callback_t callback,
+                                   void *user_data);
+
 // ------------------------------------------------------------------------------------------------
 // Key persistence callbacks
 // ------------------------------------------------------------------------------------------------
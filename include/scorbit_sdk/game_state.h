@@ -66,6 +66,7 @@ public:
         m_eventCallbackStorage = std::move(config.m_eventCallbackStorage);
         m_saveKeyCallbackStorage = std::move(config.m_saveKeyCallbackStorage);
         m_loadKeyCallbackStorage = std::move(config.m_loadKeyCallbackStorage);
+        m_controlCallbackStorage = std::move(config.m_controlCallbackStorage);
     }
 
     GameState(const GameState &) = delete;
@@ -286,6 +287,47 @@ public:
                               cbPair.second);
     }
 
+    /**
+     * @brief Retrieves the top scores as zero-copy @ref LeaderboardView.
+     *
+     * Same as @ref requestTopScores, but entries are not copied into @ref LeaderboardResult. The
+     * view is valid only during the callback, call @ref LeaderboardView::retain to keep it.
+     */
+    void requestTopScoresView(LeaderboardScope scope, LeaderboardPeriod period,
+                              const std::string &since, LeaderboardVpinFilter vpinFilter,
+                              LeaderboardViewCallback callback)
+    {
+        auto cbPair = prepareLeaderboardViewCallback(std::move(callback));
+        sb_request_top_scores(m_handle.get(), static_cast<sb_leaderboard_scope_t>(scope),
+                              static_cast<sb_leaderboard_period_t>(period),
+                              since.empty() ? nullptr : since.c_str(),
+                              static_cast<sb_leaderboard_vpin_filter_t>(vpinFilter), cbPair.first,
+                              cbPair.second);
+    }
+
+    /**
+     * @brief Retrieves several leaderboards at once (see @ref sb_request_top_scores_multi).
+     *
+     * Requests are fetched concurrently and reported together in one callback. Views are valid
+     * only during the callback, call @ref LeaderboardView::retain to keep them.
+     */
+    void requestTopScoresMulti(const std::vector<LeaderboardRequest> &requests,
+                               LeaderboardBatchCallback callback)
+    {
+        std::vector<sb_leaderboard_query_t> queries;
+        queries.reserve(requests.size());
+        for (const auto &request : requests) {
+            queries.push_back({static_cast<sb_leaderboard_scope_t>(request.scope),
+                               static_cast<sb_leaderboard_period_t>(request.period),
+                               request.since.empty() ? nullptr : request.since.c_str(),
+                               static_cast<sb_leaderboard_vpin_filter_t>(request.vpinFilter)});
+        }
+
+        auto *userData = new LeaderboardBatchCallback(std::move(callback));
+        sb_request_top_scores_multi(m_handle.get(), queries.data(), queries.size(),
+                                    &GameState::leaderboard_multi_callback_c, userData);
+    }
+
     /**
      * @brief Request a pairing short code (6 alphanumeric characters).
      *
@@ -483,6 +525,38 @@ private:
         delete cb;
     }
 
+    static void leaderboard_view_callback_c(sb_error_t error, sb_leaderboard_t *leaderboard,
+                                            void *user_data)
+    {
+        auto *cb = static_cast<LeaderboardViewCallback *>(user_data);
+        (*cb)(static_cast<Error>(error), LeaderboardView::borrow(leaderboard));
+        delete cb;
+    }
+
+    static void leaderboard_multi_callback_c(const sb_error_t *errors,
+                                             sb_leaderboard_t *const *leaderboards, size_t count,
+                                             void *user_data)
+    {
+        auto *cb = static_cast<LeaderboardBatchCallback *>(user_data);
+        std::vector<Error> cppErrors;
+        std::vector<LeaderboardView> views;
+        cppErrors.reserve(count);
+        views.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            cppErrors.push_back(static_cast<Error>(errors[i]));
+            views.push_back(LeaderboardView::borrow(leaderboards[i]));
+        }
+        (*cb)(cppErrors, views);
+        delete cb;
+    }
+
+    static std::pair<sb_leaderboard_callback_t, void *>
+    prepareLeaderboardViewCallback(LeaderboardViewCallback callback)
+    {
+        auto *userData = new LeaderboardViewCallback(std::move(callback));
+        return std::make_pair(&GameState::leaderboard_view_callback_c, userData);
+    }
+
     static std::pair<sb_leaderboard_callback_t, void *>
     prepareLeaderboardCallback(LeaderboardCallback callback)
     {
@@ -539,6 +613,7 @@ private:
     std::unique_ptr<std::function<void(const Event &)>> m_eventCallbackStorage;
     std::unique_ptr<SaveKeyCallback> m_saveKeyCallbackStorage;
     std::unique_ptr<LoadKeyCallback> m_loadKeyCallbackStorage;
+    std::vector<std::unique_ptr<ControlMessageCallback>> m_controlCallbackStorage;
 
     std::unique_ptr<std::remove_pointer<sb_game_handle_t>::type, void (*)(sb_game_handle_t)>
             m_handle;
@@ -300,6 +300,9 @@ const char *sb_get_pair_deeplink(sb_game_handle_t handle);
  * @param handle The game handle created using @ref sb_create_game_state.
  * @param scope Selects whether the request targets the paired venue machine leaderboard, the
  * variant-wide leaderboard for the paired title, or the shared game leaderboard.
+ * @ref SB_LEADERBOARD_SCOPE_LOCAL is answered right away from scores played on this machine (see
+ * @ref sb_config_set_local_scores_path) merged with the cached machine leaderboard, it doesn't
+ * need pairing or network.
  * @param period Selects the backend time bucket. Use @ref SB_LEADERBOARD_PERIOD_ALL_TIME for the
  * unfiltered all-time leaderboard.
  * @param since Optional UTC ISO-8601 lower-bound time filter. When set, only scores created at or
@@ -323,6 +326,24 @@ void sb_request_top_scores(sb_game_handle_t handle, sb_leaderboard_scope_t scope
                            sb_leaderboard_vpin_filter_t vpin_filter,
                            sb_leaderboard_callback_t callback, void *user_data);
 
+/**
+ * @brief Retrieves several leaderboards at once, e.g. machine, variant and game boards.
+ *
+ * Queries are fetched concurrently and reported together in one callback, with an error per
+ * query. Pairing and machine context is awaited once for the whole batch, the same way as in
+ * @ref sb_request_top_scores.
+ *
+ * @param handle The game handle created using @ref sb_create_game_state.
+ * @param queries Array of @p count queries, copied before the function returns.
+ * @param count Number of queries.
+ * @param callback A callback function of @ref sb_leaderboard_multi_callback_t.
+ * @param user_data Optional user data to pass to the callback. Pass NULL if not used.
+ */
+SCORBIT_SDK_EXPORT
+void sb_request_top_scores_multi(sb_game_handle_t handle, const sb_leaderboard_query_t *queries,
+                                 size_t count, sb_leaderboard_multi_callback_t callback,
+                                 void *user_data);
+
 /**
  * @brief Request a pairing short code (6 alphanumeric characters).
  *
@@ -22,9 +22,14 @@
 #include <scorbit_sdk/leaderboard_c.h>
 #include <scorbit_sdk/net_types.h>
 
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <iterator>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 namespace scorbit {
@@ -54,8 +59,18 @@ struct LeaderboardEntry {
     std::string created;
 };
 
+/// Convert @ref sb_leaderboard_updated_at, default time point if unknown
+inline std::chrono::system_clock::time_point
+leaderboardUpdatedAt(const sb_leaderboard_t *leaderboard)
+{
+    return std::chrono::system_clock::time_point {
+            std::chrono::milliseconds {::sb_leaderboard_updated_at(leaderboard)}};
+}
+
 struct LeaderboardResult {
     std::vector<LeaderboardEntry> entries;
+    /// When the server last confirmed the result, it may come from the cache
+    std::chrono::system_clock::time_point updatedAt;
 
     bool empty() const { return entries.empty(); }
     size_t size() const { return entries.size(); }
@@ -63,6 +78,7 @@ struct LeaderboardResult {
     static LeaderboardResult fromC(const sb_leaderboard_t *leaderboard)
     {
         LeaderboardResult result;
+        result.updatedAt = leaderboardUpdatedAt(leaderboard);
         const auto count = ::sb_leaderboard_entries_count(leaderboard);
         result.entries.reserve(count);
 
@@ -117,4 +133,213 @@ struct LeaderboardResult {
 
 using LeaderboardCallback = std::function<void(Error error, const LeaderboardResult &leaderboard)>;
 
+/**
+ * @brief Lightweight accessor of one leaderboard entry, valid as long as its LeaderboardView.
+ *
+ * Strings point directly into the leaderboard data, nothing is copied. Missing values are
+ * returned as empty strings or zeros.
+ */
+class LeaderboardEntryView
+{
+public:
+    LeaderboardEntryView(const sb_leaderboard_t *leaderboard, size_t index)
+        : m_leaderboard(leaderboard)
+        , m_index(index)
+    {
+    }
+
+    uint64_t id() const { return value<uint64_t>(&::sb_leaderboard_entry_id); }
+    int rank() const { return value<int>(&::sb_leaderboard_entry_rank); }
+    sb_score_t highScore() const { return value<sb_score_t>(&::sb_leaderboard_entry_high_score); }
+    std::string_view image() const { return string(&::sb_leaderboard_entry_image); }
+    int reactionCount() const { return value<int>(&::sb_leaderboard_entry_reaction_count); }
+    int scoreCount() const { return value<int>(&::sb_leaderboard_entry_score_count); }
+    bool isNfcVerified() const { return value<bool>(&::sb_leaderboard_entry_is_nfc_verified); }
+    bool isVerified() const { return value<bool>(&::sb_leaderboard_entry_is_verified); }
+    bool isVpin() const { return value<bool>(&::sb_leaderboard_entry_is_vpin); }
+    std::string_view created() const { return string(&::sb_leaderboard_entry_created); }
+
+    std::string_view playerId() const { return string(&::sb_leaderboard_entry_player_id); }
+    std::string_view playerUsername() const
+    {
+        return string(&::sb_leaderboard_entry_player_username);
+    }
+    std::string_view playerDisplayName() const
+    {
+        return string(&::sb_leaderboard_entry_player_display_name);
+    }
+    std::string_view playerInitials() const
+    {
+        return string(&::sb_leaderboard_entry_player_initials);
+    }
+    std::string_view playerAvatarUrl() const
+    {
+        return string(&::sb_leaderboard_entry_player_avatar);
+    }
+    int playerFollowerCount() const
+    {
+        return value<int>(&::sb_leaderboard_entry_player_follower_count);
+    }
+    int playerFollowingCount() const
+    {
+        return value<int>(&::sb_leaderboard_entry_player_following_count);
+    }
+    std::string_view playerLastLogin() const
+    {
+        return string(&::sb_leaderboard_entry_player_last_login);
+    }
+
+private:
+    template<typename T>
+    T value(bool (*accessor)(const sb_leaderboard_t *, size_t, T *)) const
+    {
+        T result {};
+        accessor(m_leaderboard, m_index, &result);
+        return result;
+    }
+
+    std::string_view string(bool (*accessor)(const sb_leaderboard_t *, size_t,
+                                             const char **)) const
+    {
+        const char *str = nullptr;
+        return accessor(m_leaderboard, m_index, &str) && str ? std::string_view {str}
+                                                              : std::string_view {};
+    }
+
+    const sb_leaderboard_t *m_leaderboard;
+    size_t m_index;
+};
+
+/**
+ * @brief Zero-copy view of the leaderboard, alternative to @ref LeaderboardResult.
+ *
+ * The view passed to @ref LeaderboardViewCallback borrows the leaderboard and is valid only
+ * during the callback. Call retain() to get a view which owns its own handle (RAII) and can be
+ * kept, e.g. to render the same board over many frames. Retaining doesn't copy the entries.
+ */
+class LeaderboardView
+{
+public:
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = LeaderboardEntryView;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = LeaderboardEntryView;
+
+        const_iterator(const sb_leaderboard_t *leaderboard, size_t index)
+            : m_leaderboard(leaderboard)
+            , m_index(index)
+        {
+        }
+
+        LeaderboardEntryView operator*() const { return {m_leaderboard, m_index}; }
+        const_iterator &operator++()
+        {
+            ++m_index;
+            return *this;
+        }
+        const_iterator operator++(int)
+        {
+            auto prev = *this;
+            ++m_index;
+            return prev;
+        }
+        bool operator==(const const_iterator &other) const { return m_index == other.m_index; }
+        bool operator!=(const const_iterator &other) const { return m_index != other.m_index; }
+
+    private:
+        const sb_leaderboard_t *m_leaderboard;
+        size_t m_index;
+    };
+
+    LeaderboardView() = default;
+
+    /// Borrow @p leaderboard, the caller keeps ownership
+    static LeaderboardView borrow(const sb_leaderboard_t *leaderboard)
+    {
+        return LeaderboardView {const_cast<sb_leaderboard_t *>(leaderboard), false};
+    }
+
+    /// Take ownership of @p leaderboard returned by @ref sb_leaderboard_retain
+    static LeaderboardView adopt(sb_leaderboard_t *leaderboard)
+    {
+        return LeaderboardView {leaderboard, true};
+    }
+
+    LeaderboardView(const LeaderboardView &) = delete;
+    LeaderboardView &operator=(const LeaderboardView &) = delete;
+
+    LeaderboardView(LeaderboardView &&other) noexcept
+        : m_leaderboard(std::exchange(other.m_leaderboard, nullptr))
+        , m_owned(std::exchange(other.m_owned, false))
+    {
+    }
+
+    LeaderboardView &operator=(LeaderboardView &&other) noexcept
+    {
+        if (this != &other) {
+            reset();
+            m_leaderboard = std::exchange(other.m_leaderboard, nullptr);
+            m_owned = std::exchange(other.m_owned, false);
+        }
+        return *this;
+    }
+
+    ~LeaderboardView() { reset(); }
+
+    /// View which owns its own handle to the same data and may outlive the callback
+    LeaderboardView retain() const { return adopt(::sb_leaderboard_retain(m_leaderboard)); }
+
+    bool isOwned() const { return m_owned; }
+    std::chrono::system_clock::time_point updatedAt() const
+    {
+        return leaderboardUpdatedAt(m_leaderboard);
+    }
+    size_t size() const { return ::sb_leaderboard_entries_count(m_leaderboard); }
+    bool empty() const { return size() == 0; }
+
+    LeaderboardEntryView operator[](size_t index) const { return {m_leaderboard, index}; }
+    const_iterator begin() const { return {m_leaderboard, 0}; }
+    const_iterator end() const { return {m_leaderboard, size()}; }
+
+    const sb_leaderboard_t *handle() const { return m_leaderboard; }
+
+private:
+    LeaderboardView(sb_leaderboard_t *leaderboard, bool owned)
+        : m_leaderboard(leaderboard)
+        , m_owned(owned)
+    {
+    }
+
+    void reset()
+    {
+        if (m_owned) {
+            ::sb_leaderboard_release(m_leaderboard);
+        }
+        m_leaderboard = nullptr;
+        m_owned = false;
+    }
+
+    sb_leaderboard_t *m_leaderboard {nullptr};
+    bool m_owned {false};
+};
+
+using LeaderboardViewCallback =
+        std::function<void(Error error, const LeaderboardView &leaderboard)>;
+
+/// One query of GameState::requestTopScoresMulti
+struct LeaderboardRequest {
+    LeaderboardScope scope {LeaderboardScope::Machine};
+    LeaderboardPeriod period {LeaderboardPeriod::AllTime};
+    std::string since;
+    LeaderboardVpinFilter vpinFilter {LeaderboardVpinFilter::Any};
+};
+
+/// Errors and borrowed views in the order of requests, view is empty if its request failed
+using LeaderboardBatchCallback = std::function<void(const std::vector<Error> &errors,
+                                                    const std::vector<LeaderboardView> &boards)>;
+
 } // namespace scorbit
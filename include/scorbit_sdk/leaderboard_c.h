@@ -37,11 +37,64 @@ typedef struct sb_leaderboard_t sb_leaderboard_t;
  * @brief Leaderboard callback function type.
  *
  * On success, @p leaderboard is non-NULL and valid only for the duration of the callback; do not
- * store the pointer or retain it after the callback returns. On failure, @p leaderboard is NULL.
+ * store the pointer after the callback returns, use @ref sb_leaderboard_retain to keep the
+ * leaderboard longer. On failure, @p leaderboard is NULL.
  */
 typedef void (*sb_leaderboard_callback_t)(sb_error_t error, sb_leaderboard_t *leaderboard,
                                           void *user_data);
 
+/**
+ * @brief One leaderboard query of @ref sb_request_top_scores_multi, see @ref sb_request_top_scores
+ * for the meaning of the fields.
+ */
+typedef struct sb_leaderboard_query_t {
+    sb_leaderboard_scope_t scope;
+    sb_leaderboard_period_t period;
+    const char *since; // Optional, NULL to omit
+    sb_leaderboard_vpin_filter_t vpin_filter;
+} sb_leaderboard_query_t;
+
+/**
+ * @brief Batched leaderboard callback function type.
+ *
+ * @p errors and @p leaderboards have @p count items, in the order of the queries. Leaderboard is
+ * non-NULL only if its error is @ref SB_EC_SUCCESS. Leaderboards are valid only for the duration
+ * of the callback, same as in @ref sb_leaderboard_callback_t.
+ */
+typedef void (*sb_leaderboard_multi_callback_t)(const sb_error_t *errors,
+                                                sb_leaderboard_t *const *leaderboards,
+                                                size_t count, void *user_data);
+
+/**
+ * @brief Keep the leaderboard beyond the callback.
+ *
+ * Returns a new handle to the same leaderboard data, nothing is copied. Strings returned by the
+ * accessors stay valid until the last handle is released.
+ *
+ * @param leaderboard Leaderboard received in @ref sb_leaderboard_callback_t or retained before.
+ * @return New handle which must be freed with @ref sb_leaderboard_release, NULL if
+ * @p leaderboard is NULL.
+ */
+SCORBIT_SDK_EXPORT
+sb_leaderboard_t *sb_leaderboard_retain(const sb_leaderboard_t *leaderboard);
+
+/**
+ * @brief Free the handle returned by @ref sb_leaderboard_retain. NULL is ignored.
+ */
+SCORBIT_SDK_EXPORT
+void sb_leaderboard_release(sb_leaderboard_t *leaderboard);
+
+/**
+ * @brief Return when the server last confirmed the leaderboard.
+ *
+ * Leaderboards may be answered from the cache, e.g. prefetched after the game ended, see
+ * @ref sb_config_set_leaderboard_prefetch. This tells how fresh the result is.
+ *
+ * @return Unix time in milliseconds, 0 if unknown.
+ */
+SCORBIT_SDK_EXPORT
+int64_t sb_leaderboard_updated_at(const sb_leaderboard_t *leaderboard);
+
 /**
  * @brief Return the number of entries in the leaderboard.
  */
@@ -22,6 +22,7 @@
 #include "log_c.h"
 #include "log_types.h"
 
+#include <memory>
 #include <vector>
 
 namespace scorbit {
@@ -34,6 +35,12 @@ inline std::vector<LoggerCallback *> &g_callbacks()
     return instance;
 }
 
+inline std::unique_ptr<LoggerBatchCallback> &g_batchCallback()
+{
+    static std::unique_ptr<LoggerBatchCallback> instance;
+    return instance;
+}
+
 // C-style callback that forwards to the C++ function
 inline void cLogCallback(const char *message, sb_log_level_t level, const char *file, int line,
                          int64_t timestamp, void *user_data)
@@ -45,6 +52,14 @@ inline void cLogCallback(const char *message, sb_log_level_t level, const char *
     }
 }
 
+inline void cLogBatchCallback(const sb_log_record_t *records, size_t count, void *user_data)
+{
+    auto &callback = *static_cast<scorbit::LoggerBatchCallback *>(user_data);
+    if (callback) {
+        callback(records, count);
+    }
+}
+
 } // namespace detail
 
 /**
@@ -76,12 +91,33 @@ inline void addLoggerCallback(LoggerCallback &&callback, size_t maxLength)
     sb_add_logger_callback(detail::cLogCallback, callbackPtr, maxLength);
 }
 
+/**
+ * @brief Set the callback receiving log messages in batches (see @ref sb_log_set_batch_callback).
+ *
+ * @param callback The callback, empty removes it.
+ * @param maxCount Maximum messages in a batch, 0 - default.
+ * @param maxDelayMs Maximum delay of a message in milliseconds, 0 - default.
+ * @param maxLength Maximum length of the messages.
+ */
+inline void setLoggerBatchCallback(LoggerBatchCallback &&callback, size_t maxCount = 0,
+                                   int maxDelayMs = 0, size_t maxLength = 512)
+{
+    auto previous = std::move(detail::g_batchCallback()); // Freed after it's replaced
+    if (callback) {
+        detail::g_batchCallback() = std::make_unique<LoggerBatchCallback>(std::move(callback));
+        sb_log_set_batch_callback(detail::cLogBatchCallback, detail::g_batchCallback().get(),
+                                  maxCount, maxDelayMs, maxLength);
+    } else {
+        sb_log_set_batch_callback(nullptr, nullptr, 0, 0, 0);
+    }
+}
+
 /**
  * @brief Clears all previously added logger callbacks.
  *
  * This function removes the logger callback functions that was previously added
- * using @ref addLoggerCallback. After this call, no logger callback will be invoked
- * until a new one is added.
+ * using @ref addLoggerCallback and the batch callback. After this call, no logger callback
+ * will be invoked until a new one is added.
  *
  * @see addLoggerCallback
  */
@@ -93,6 +129,57 @@ inline void resetLogger()
         delete callback;
     }
     detail::g_callbacks().clear();
+    detail::g_batchCallback().reset();
+}
+
+/**
+ * @brief Set the minimal level of messages logged by the SDK (see @ref sb_log_set_level).
+ *
+ * @param level Messages below this level are dropped before they are formatted.
+ */
+inline void setLogLevel(LogLevel level)
+{
+    sb_log_set_level(static_cast<sb_log_level_t>(level));
+}
+
+/**
+ * @brief Get the minimal level of messages logged by the SDK.
+ */
+inline LogLevel logLevel()
+{
+    return static_cast<LogLevel>(sb_log_get_level());
+}
+
+/**
+ * @brief Format SDK log messages on the logger thread (see @ref sb_log_set_deferred_format).
+ *
+ * @param enabled Defer formatting, disabled by default.
+ * @param bufferSize Ring buffer size in bytes per logging thread, 0 - default.
+ */
+inline void setLogDeferredFormat(bool enabled, size_t bufferSize = 0)
+{
+    sb_log_set_deferred_format(enabled, bufferSize);
+}
+
+/**
+ * @brief Number of log messages dropped because a ring buffer was full.
+ */
+inline uint64_t logDroppedCount()
+{
+    return sb_log_dropped_count();
+}
+
+using LogSiteStats = sb_log_site_stats_t;
+
+/**
+ * @brief Counters of rate limited log call sites (see @ref sb_log_rate_limited_sites).
+ */
+inline std::vector<LogSiteStats> logRateLimitedSites()
+{
+    std::vector<LogSiteStats> stats(sb_log_rate_limited_sites(nullptr, 0));
+    // Sites executed in between are reported on the next call
+    sb_log_rate_limited_sites(stats.data(), stats.size());
+    return stats;
 }
 
 } // namespace scorbit
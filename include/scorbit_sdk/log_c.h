@@ -23,6 +23,7 @@
 #include <scorbit_sdk/export.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -60,18 +61,97 @@ bool sb_logger_callbacks_supported(void);
 SCORBIT_SDK_EXPORT
 void sb_add_logger_callback(sb_log_callback_t callback, void *user_data, size_t max_length);
 
+/**
+ * @brief Set the callback receiving log messages in batches.
+ *
+ * Collected messages are delivered in one call once there are @p max_count of them, the oldest
+ * one waits for @p max_delay_ms or an error is logged. Cheaper than @ref sb_add_logger_callback
+ * when each call is expensive, e.g. to a scripting language. Only one batch callback can be
+ * set, it is removed by @ref sb_reset_logger or by passing NULL. Messages collected for the
+ * previous callback are delivered to it before this returns. Callbacks may call the logger
+ * setup functions themselves. No-op when the SDK is built with the spdlog backend.
+ *
+ * @param callback The callback, NULL removes it.
+ * @param user_data Optional user data passed to the callback.
+ * @param max_count Maximum messages in a batch, 0 - default (64).
+ * @param max_delay_ms Maximum delay of a message, 0 - default (100 ms).
+ * @param max_length Maximum length of the messages, longer ones are truncated.
+ */
+SCORBIT_SDK_EXPORT
+void sb_log_set_batch_callback(sb_log_batch_callback_t callback, void *user_data,
+                               size_t max_count, int max_delay_ms, size_t max_length);
+
 /**
  * @brief Clears all previously added logger callbacks.
  *
  * This function removes the logger callback functions that was previously added
- * using @ref sb_add_logger_callback. After this call, no logger callback will be invoked
- * until a new one is added.
+ * using @ref sb_add_logger_callback and the batch callback. After this call, no logger
+ * callback will be invoked until a new one is added.
  *
  * @see sb_add_logger_callback
  */
 SCORBIT_SDK_EXPORT
 void sb_reset_logger(void);
 
+/**
+ * @brief Set the minimal level of messages logged by the SDK.
+ *
+ * Messages below it are dropped before they are formatted, so disabled debug logging costs
+ * next to nothing. Default is @ref SB_DEBUG. Builds with a higher compile-time minimum
+ * (SCORBIT_LOG_MIN_LEVEL) never log messages below it, whatever is set here.
+ *
+ * @param level The minimal level, can be changed at any time from any thread.
+ */
+SCORBIT_SDK_EXPORT
+void sb_log_set_level(sb_log_level_t level);
+
+/**
+ * @brief Get the minimal level of messages logged by the SDK.
+ *
+ * @see sb_log_set_level
+ */
+SCORBIT_SDK_EXPORT
+sb_log_level_t sb_log_get_level(void);
+
+/**
+ * @brief Format SDK log messages on the logger thread instead of the logging one.
+ *
+ * Log calls then only copy their arguments into a ring buffer of the calling thread, which
+ * keeps logging cheap on the game and SDK threads. If a thread logs faster than the messages
+ * are delivered, its buffer fills up, further messages are dropped and counted, see
+ * @ref sb_log_dropped_count. No-op when the SDK is built with the spdlog backend.
+ *
+ * @param enabled Defer formatting, disabled by default.
+ * @param buffer_size Ring buffer size in bytes per logging thread, 0 - default (64 KiB).
+ * Applies to threads which did not log yet.
+ */
+SCORBIT_SDK_EXPORT
+void sb_log_set_deferred_format(bool enabled, size_t buffer_size);
+
+/**
+ * @brief Number of log messages dropped because a ring buffer was full.
+ *
+ * With the spdlog backend, messages dropped by its async queue overflow policy.
+ *
+ * @see sb_log_set_deferred_format
+ */
+SCORBIT_SDK_EXPORT
+uint64_t sb_log_dropped_count(void);
+
+/**
+ * @brief Get the counters of rate limited log call sites.
+ *
+ * Repeating messages, like connection errors during an outage, are logged at most once per
+ * interval from their call site. The first message after a quiet period is preceded by
+ * "Suppressed N similar messages". Only the sites executed so far are reported.
+ *
+ * @param stats Array receiving the counters, can be NULL if capacity is 0.
+ * @param capacity Size of the stats array.
+ * @return Number of sites, can be larger than capacity.
+ */
+SCORBIT_SDK_EXPORT
+size_t sb_log_rate_limited_sites(sb_log_site_stats_t *stats, size_t capacity);
+
 #ifdef __cplusplus
 }
 #endif
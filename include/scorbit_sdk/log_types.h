@@ -64,4 +64,13 @@ enum class LogLevel {
 using LoggerCallback = std::function<void(const std::string &message, LogLevel level,
                                           const char *file, int line, int64_t timestamp)>;
 
+/// Log message of @ref LoggerBatchCallback, valid only during the callback
+using LogRecord = sb_log_record_t;
+
+/**
+ * @typedef LoggerBatchCallback
+ * @brief Receives log messages in batches, oldest first.
+ */
+using LoggerBatchCallback = std::function<void(const LogRecord *records, size_t count)>;
+
 } // namespace scorbit
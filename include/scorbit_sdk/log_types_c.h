@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -65,6 +66,38 @@ typedef enum {
 typedef void (*sb_log_callback_t)(const char *message, sb_log_level_t level, const char *file,
                                   int line, int64_t timestamp, void *user_data);
 
+/**
+ * @struct sb_log_record_t
+ * @brief Log message delivered to @ref sb_log_batch_callback_t.
+ *
+ * The strings are valid only during the callback.
+ */
+typedef struct {
+    const char *message; /**< Message, null-terminated */
+    sb_log_level_t level;
+    const char *file; /**< Source file name */
+    int line;         /**< Line number in the source file */
+    int64_t timestamp; /**< Milliseconds since the epoch */
+} sb_log_record_t;
+
+/**
+ * @typedef sb_log_batch_callback_t
+ * @brief Receives log messages in batches, oldest first.
+ */
+typedef void (*sb_log_batch_callback_t)(const sb_log_record_t *records, size_t count,
+                                        void *user_data);
+
+/**
+ * @struct sb_log_site_stats_t
+ * @brief Counters of a rate limited log call site, see @ref sb_log_rate_limited_sites.
+ */
+typedef struct {
+    const char *file;    /**< Source file name, static string */
+    int line;            /**< Line number in the source file */
+    uint64_t logged;     /**< Messages logged */
+    uint64_t suppressed; /**< Messages suppressed by the rate limit */
+} sb_log_site_stats_t;
+
 #ifdef __cplusplus
 }
 #endif
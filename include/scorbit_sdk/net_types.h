@@ -60,6 +60,7 @@ enum class LeaderboardScope {
     Machine = SB_LEADERBOARD_SCOPE_MACHINE, // Specific paired venue machine leaderboard
     Variant = SB_LEADERBOARD_SCOPE_VARIANT, // Shared machine variant leaderboard
     Game = SB_LEADERBOARD_SCOPE_GAME,       // Shared game leaderboard across variants
+    Local = SB_LEADERBOARD_SCOPE_LOCAL,     // Scores played on this machine, works offline
 };
 
 enum class LeaderboardPeriod {
@@ -77,6 +78,11 @@ enum class LeaderboardVpinFilter {
     RealOnly = SB_LEADERBOARD_VPIN_REAL_ONLY // Exclude virtual pinball scores
 };
 
+enum class DiagnosticsCompression {
+    Gzip = SB_DIAGNOSTICS_GZIP, // tar.gz, single threaded
+    Zstd = SB_DIAGNOSTICS_ZSTD, // tar.zst, multi-threaded, gzip if libarchive lacks zstd
+};
+
 enum Capability : sb_capabilities_t {
     StartGame = SB_CAPABILITY_START_GAME,   // Game can be started remotely
     CreditDrop = SB_CAPABILITY_CREDIT_DROP, // Machine can accept coin drop events
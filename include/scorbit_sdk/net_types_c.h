@@ -62,6 +62,7 @@ typedef enum {
     SB_LEADERBOARD_SCOPE_MACHINE = 0, // Specific paired venue machine leaderboard
     SB_LEADERBOARD_SCOPE_VARIANT = 1, // Shared machine variant leaderboard
     SB_LEADERBOARD_SCOPE_GAME = 2,    // Shared game leaderboard across variants
+    SB_LEADERBOARD_SCOPE_LOCAL = 3,   // Scores played on this machine, answered without network
 } sb_leaderboard_scope_t;
 
 typedef enum {
@@ -85,6 +86,11 @@ typedef enum {
 } sb_capability_t;
 typedef uint32_t sb_capabilities_t;
 
+typedef enum {
+    SB_DIAGNOSTICS_GZIP = 0, // tar.gz, single threaded
+    SB_DIAGNOSTICS_ZSTD = 1, // tar.zst, multi-threaded, gzip if libarchive lacks zstd
+} sb_diagnostics_compression_t;
+
 typedef struct {
     /** Mandatory. The provider name, e.g., "scorbitron", "vpin". */
     const char *provider;
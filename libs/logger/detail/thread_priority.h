@@ -0,0 +1,32 @@
+/*
+ * Logger internal helper (not part of public API).
+ *
+ * (c) 2025 Spinner Systems, Inc. (DBA Scorbit), scorbit.io, All Rights Reserved
+ */
+
+#pragma once
+
+#if defined(__linux__)
+#    include <sys/resource.h>
+#    include <sys/syscall.h>
+#    include <unistd.h>
+#elif defined(__APPLE__)
+#    include <pthread.h>
+#endif
+
+namespace logger {
+
+/**
+ * Lower the priority of the calling thread, so writing logs doesn't compete with the game.
+ */
+inline void lowerThreadPriority()
+{
+#if defined(__linux__)
+    const pid_t tid = static_cast<pid_t>(syscall(SYS_gettid));
+    setpriority(PRIO_PROCESS, static_cast<id_t>(tid), 10);
+#elif defined(__APPLE__)
+    pthread_set_qos_class_self_np(QOS_CLASS_BACKGROUND, 0);
+#endif
+}
+
+} // namespace logger
@@ -20,8 +20,19 @@
 #pragma once
 
 #include <fmt/format.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <new>
 #include <string>
 #include <string_view>
+#include <tuple>
+#include <type_traits>
+
+/// Log calls below this level are compiled out, 0 - Debug ... 3 - Error. Set by CMake.
+#ifndef SCORBIT_LOG_MIN_LEVEL
+#    define SCORBIT_LOG_MIN_LEVEL 0
+#endif
 
 namespace logger {
 
@@ -43,6 +54,205 @@ enum class LogLevel : int {
     Error,
 };
 
+namespace detail {
+
+inline std::atomic<int> g_level {static_cast<int>(LogLevel::Debug)};
+inline std::atomic<bool> g_deferred {false};
+
+using LogTap = void (*)(LogLevel level, std::string_view message);
+inline std::atomic<LogTap> g_tap {nullptr};
+
+/// Called by the backend with every formatted message
+inline void tap(LogLevel level, std::string_view message)
+{
+    if (const auto tapFunc = g_tap.load(std::memory_order_acquire)) {
+        tapFunc(level, message);
+    }
+}
+
+/// How the backend handles arguments of deferred record, a std::tuple of copied values
+struct DeferredArgsOps {
+    size_t size;
+    size_t align;
+    void (*moveTo)(void *from, void *to); // Move-constructs args from 'from' at 'to'
+    std::string (*format)(const char *format, const void *args);
+    void (*destroy)(void *args);
+};
+
+template<typename Tuple>
+inline constexpr DeferredArgsOps deferredOps {
+        sizeof(Tuple), alignof(Tuple),
+        [](void *from, void *to) { new (to) Tuple(std::move(*static_cast<Tuple *>(from))); },
+        [](const char *format, const void *args) {
+            return std::apply(
+                    [format](const auto &...values) {
+                        return fmt::format(fmt::runtime(format), values...);
+                    },
+                    *static_cast<const Tuple *>(args));
+        },
+        [](void *args) { static_cast<Tuple *>(args)->~Tuple(); }};
+
+template<typename T>
+inline constexpr bool isDeferredString =
+        std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>
+        || std::is_same_v<T, const char *> || std::is_same_v<T, char *>;
+
+// Only plain values and strings are copied as is, other arguments may refer to data that is gone
+// by the time the record is formatted
+template<typename T>
+inline constexpr bool isDeferredArg =
+        std::is_arithmetic_v<T> || std::is_enum_v<T> || isDeferredString<T>;
+
+template<typename T>
+using DeferredArg = std::conditional_t<isDeferredString<std::decay_t<T>>, std::string,
+                                       std::decay_t<T>>;
+
+/**
+ * @brief Queue a record to be formatted on the logger thread, implemented by the backend.
+ *
+ * @param format Format string, must stay valid - a string literal.
+ * @param args Arguments, moved out with ops.moveTo.
+ */
+void logDeferred(LogLevel level, const char *file, int line, const char *format, void *args,
+                 const DeferredArgsOps &ops);
+
+/// Extract just the filename from the full path
+inline const char *baseName(const char *file)
+{
+    std::string_view filePath(file);
+    auto pos = filePath.find_last_of("/\\");
+    return (pos != std::string_view::npos) ? file + pos + 1 : file;
+}
+
+class RateLimitSite;
+inline std::atomic<RateLimitSite *> g_rateLimitSites {nullptr};
+
+/**
+ * @brief Throttle state of one SCORBIT_LOG_EVERY call site.
+ *
+ * Sites are static and register themselves in a lock-free list, so their counters can be read
+ * with forEachRateLimitSite. A throttled call costs a clock read, a relaxed load and one atomic
+ * increment.
+ */
+class RateLimitSite
+{
+public:
+    RateLimitSite(const char *file, int line) noexcept
+        : m_file(baseName(file))
+        , m_line(line)
+    {
+        m_nextSite = g_rateLimitSites.load(std::memory_order_relaxed);
+        while (!g_rateLimitSites.compare_exchange_weak(m_nextSite, this, std::memory_order_release,
+                                                       std::memory_order_relaxed)) {
+        }
+    }
+
+    RateLimitSite(const RateLimitSite &) = delete;
+    RateLimitSite &operator=(const RateLimitSite &) = delete;
+
+    /**
+     * @brief Check whether the message may be logged now.
+     *
+     * @param interval Minimal interval between logged messages.
+     * @param suppressed Set to the number of messages suppressed since the last logged one.
+     * @return true if the message should be logged.
+     */
+    bool pass(std::chrono::steady_clock::duration interval, uint64_t &suppressed) noexcept
+    {
+        const int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                    std::chrono::steady_clock::now().time_since_epoch())
+                                    .count();
+        int64_t next = m_nextTime.load(std::memory_order_relaxed);
+        if (now < next
+            || !m_nextTime.compare_exchange_strong(
+                    next,
+                    now + std::chrono::duration_cast<std::chrono::nanoseconds>(interval).count(),
+                    std::memory_order_relaxed)) {
+            m_suppressed.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        suppressed = m_suppressed.exchange(0, std::memory_order_relaxed);
+        m_suppressedTotal.fetch_add(suppressed, std::memory_order_relaxed);
+        m_logged.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    const char *file() const { return m_file; }
+    int line() const { return m_line; }
+    uint64_t logged() const { return m_logged.load(std::memory_order_relaxed); }
+
+    uint64_t suppressed() const
+    {
+        return m_suppressedTotal.load(std::memory_order_relaxed)
+             + m_suppressed.load(std::memory_order_relaxed);
+    }
+
+    const RateLimitSite *nextSite() const { return m_nextSite; }
+
+private:
+    const char *m_file;
+    int m_line;
+    RateLimitSite *m_nextSite {nullptr};
+    std::atomic<int64_t> m_nextTime {INT64_MIN};
+    std::atomic<uint64_t> m_suppressed {0};      // Since the last logged message
+    std::atomic<uint64_t> m_suppressedTotal {0}; // Reported in the summaries
+    std::atomic<uint64_t> m_logged {0};
+};
+
+} // namespace detail
+
+/**
+ * @brief Counters of a rate limited log call site.
+ */
+struct RateLimitStats {
+    const char *file; // Source file name (basename only)
+    int line;
+    uint64_t logged;
+    uint64_t suppressed;
+};
+
+/**
+ * @brief Invoke func with RateLimitStats of every rate limited call site executed so far.
+ */
+template<typename Func>
+inline void forEachRateLimitSite(Func &&func)
+{
+    for (const auto *site = detail::g_rateLimitSites.load(std::memory_order_acquire); site;
+         site = site->nextSite()) {
+        func(RateLimitStats {site->file(), site->line(), site->logged(), site->suppressed()});
+    }
+}
+
+/**
+ * @brief Set the runtime log threshold, messages below it are neither formatted nor logged.
+ */
+inline void setLevel(LogLevel level)
+{
+    detail::g_level.store(static_cast<int>(level), std::memory_order_relaxed);
+}
+
+inline LogLevel level()
+{
+    return static_cast<LogLevel>(detail::g_level.load(std::memory_order_relaxed));
+}
+
+/**
+ * @brief Pass every logged message also to @p tapFunc, e.g. to keep recent history on disk.
+ *
+ * The tap is invoked by the backend on the logging thread, or on the logger thread for deferred
+ * messages, so it must be thread-safe and fast. nullptr removes it.
+ */
+inline void setTap(detail::LogTap tapFunc)
+{
+    detail::g_tap.store(tapFunc, std::memory_order_release);
+}
+
+inline bool isEnabled(LogLevel level)
+{
+    return static_cast<int>(level) >= detail::g_level.load(std::memory_order_relaxed);
+}
+
 /**
  * @brief Log a message with the given level, file, and line.
  *
@@ -69,10 +279,23 @@ void log(const std::string &message, LogLevel level, const char *file, int line)
 template<typename Fmt, typename... Args>
 inline void logMessage(LogLevel level, const char *file, int line, Fmt &&fmt, Args &&...args)
 {
-    // Extract just the filename from the full path
-    std::string_view filePath(file);
-    auto pos = filePath.find_last_of("/\\");
-    const char *fileName = (pos != std::string_view::npos) ? file + pos + 1 : file;
+    const char *fileName = detail::baseName(file);
+
+    if (detail::g_deferred.load(std::memory_order_relaxed)) {
+        if constexpr (std::is_array_v<std::remove_reference_t<Fmt>>
+                      && (detail::isDeferredArg<std::decay_t<Args>> && ...)) {
+            std::tuple<detail::DeferredArg<Args>...> values {std::forward<Args>(args)...};
+            detail::logDeferred(level, fileName, line, fmt, &values,
+                                detail::deferredOps<decltype(values)>);
+        } else {
+            // Can't be deferred, but keep the order of the thread's messages
+            std::tuple<std::string> message {
+                    fmt::format(fmt::runtime(std::forward<Fmt>(fmt)), std::forward<Args>(args)...)};
+            detail::logDeferred(level, fileName, line, "{}", &message,
+                                detail::deferredOps<decltype(message)>);
+        }
+        return;
+    }
 
     // fmt::format with a single string pack uses compile-time format checking (consteval on
     // libfmt 10+), which breaks when called from non-constexpr contexts under C++20. Use a
@@ -83,8 +306,46 @@ inline void logMessage(LogLevel level, const char *file, int line, Fmt &&fmt, Ar
 
 } // namespace logger
 
+// Level is checked before the arguments are evaluated, so disabled calls cost a relaxed load.
+// Calls below SCORBIT_LOG_MIN_LEVEL are still compiled, to keep their arguments checked, but
+// generate no code.
+#define SCORBIT_LOG(level, ...)                                                                    \
+    do {                                                                                           \
+        if constexpr (static_cast<int>(level) >= SCORBIT_LOG_MIN_LEVEL) {                          \
+            if (logger::isEnabled(level)) {                                                        \
+                logger::logMessage(level, __FILE__, __LINE__, __VA_ARGS__);                        \
+            }                                                                                      \
+        }                                                                                          \
+    } while (0)
+
+// Logs at most once per interval (std::chrono duration) from this call site. The first message
+// logged after a quiet period is preceded by a summary of how many were suppressed.
+#define SCORBIT_LOG_EVERY(level, interval, ...)                                                    \
+    do {                                                                                           \
+        if constexpr (static_cast<int>(level) >= SCORBIT_LOG_MIN_LEVEL) {                          \
+            if (logger::isEnabled(level)) {                                                        \
+                static logger::detail::RateLimitSite scorbitLogSite {__FILE__, __LINE__};          \
+                uint64_t scorbitLogSuppressed = 0;                                                 \
+                if (scorbitLogSite.pass(interval, scorbitLogSuppressed)) {                         \
+                    if (scorbitLogSuppressed > 0) {                                                \
+                        logger::logMessage(level, __FILE__, __LINE__,                              \
+                                           "Suppressed {} similar messages",                       \
+                                           scorbitLogSuppressed);                                  \
+                    }                                                                              \
+                    logger::logMessage(level, __FILE__, __LINE__, __VA_ARGS__);                    \
+                }                                                                                  \
+            }                                                                                      \
+        }                                                                                          \
+    } while (0)
+
 // Logging macros for convenient usage
-#define DBG(...) logger::logMessage(logger::LogLevel::Debug, __FILE__, __LINE__, __VA_ARGS__)
-#define INF(...) logger::logMessage(logger::LogLevel::Info, __FILE__, __LINE__, __VA_ARGS__)
-#define WRN(...) logger::logMessage(logger::LogLevel::Warn, __FILE__, __LINE__, __VA_ARGS__)
-#define ERR(...) logger::logMessage(logger::LogLevel::Error, __FILE__, __LINE__, __VA_ARGS__)
+#define DBG(...) SCORBIT_LOG(logger::LogLevel::Debug, __VA_ARGS__)
+#define INF(...) SCORBIT_LOG(logger::LogLevel::Info, __VA_ARGS__)
+#define WRN(...) SCORBIT_LOG(logger::LogLevel::Warn, __VA_ARGS__)
+#define ERR(...) SCORBIT_LOG(logger::LogLevel::Error, __VA_ARGS__)
+
+// Rate limited variants, e.g. WRN_EVERY(10s, "Connection failed: {}", error)
+#define DBG_EVERY(interval, ...) SCORBIT_LOG_EVERY(logger::LogLevel::Debug, interval, __VA_ARGS__)
+#define INF_EVERY(interval, ...) SCORBIT_LOG_EVERY(logger::LogLevel::Info, interval, __VA_ARGS__)
+#define WRN_EVERY(interval, ...) SCORBIT_LOG_EVERY(logger::LogLevel::Warn, interval, __VA_ARGS__)
+#define ERR_EVERY(interval, ...) SCORBIT_LOG_EVERY(logger::LogLevel::Error, interval, __VA_ARGS__)
@@ -20,9 +20,11 @@
 #pragma once
 
 #include <logger/logger.h>
+#include <chrono>
 #include <cstdint>
 #include <functional>
 #include <string>
+#include <vector>
 
 namespace logger {
 
@@ -54,11 +56,57 @@ using LoggerCallback = std::function<void(const std::string &message, LogLevel l
  */
 void addCallback(LoggerCallback &&callback, size_t maxLength = 512);
 
+/// Log message delivered to @ref BatchCallback
+struct LogRecord {
+    std::string message;
+    LogLevel level;
+    const char *file;
+    int line;
+    int64_t timestamp;
+};
+
+/**
+ * @typedef BatchCallback
+ * @brief Receives log messages in batches, oldest first.
+ */
+using BatchCallback = std::function<void(const std::vector<LogRecord> &records)>;
+
+/**
+ * @brief Set the callback receiving log messages in batches, replaces the previous one.
+ *
+ * Batch is delivered when it has maxCount messages, its oldest message waits for maxDelay or
+ * an error is logged. Messages collected by the previous callback are still delivered to it.
+ *
+ * @param callback The callback function, empty removes it.
+ * @param maxCount Maximum messages in a batch.
+ * @param maxDelay Maximum time a message waits in the batch.
+ * @param maxLength Maximum length of the messages, longer ones are truncated.
+ */
+void setBatchCallback(BatchCallback &&callback, size_t maxCount,
+                      std::chrono::milliseconds maxDelay, size_t maxLength = 512);
+
 /**
- * @brief Clears all previously added logger callbacks.
+ * @brief Clears all previously added logger callbacks and the batch callback.
  *
  * After this call, no logger callback will be invoked until a new one is added.
  */
 void resetCallbacks();
 
+/**
+ * @brief Format log messages on the logger thread instead of the logging one.
+ *
+ * Log calls only copy the format string pointer and the arguments into a ring buffer of the
+ * calling thread. When the buffer is full, messages are dropped and counted, a warning with
+ * the count is logged once there is room again.
+ *
+ * @param enabled Defer formatting, disabled by default.
+ * @param bufferSize Ring buffer size of each logging thread, for threads which did not log yet.
+ */
+void setDeferredFormat(bool enabled, size_t bufferSize = 64 * 1024);
+
+/**
+ * @brief Number of messages dropped because the ring buffer of their thread was full.
+ */
+uint64_t droppedCount();
+
 } // namespace logger
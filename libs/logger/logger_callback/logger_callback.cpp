@@ -18,23 +18,21 @@
  */
 
 #include "detail/cut_long_string.h"
+#include "detail/thread_priority.h"
 #include <logger/logger_callback.h>
 
 #include <blockingconcurrentqueue.h>
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <cstddef>
+#include <memory>
 #include <mutex>
+#include <optional>
 #include <thread>
 #include <variant>
 #include <vector>
 
-#if defined(__linux__)
-#    include <sys/resource.h>
-#    include <sys/syscall.h>
-#    include <unistd.h>
-#elif defined(__APPLE__)
-#    include <pthread.h>
-#endif
-
 namespace {
 
 #if defined(__GNUC__) || defined(__clang__)
@@ -45,11 +43,129 @@ namespace {
 #    define UNLIKELY(x) (x)
 #endif
 
+constexpr size_t RECORD_ALIGN = 16;
+constexpr size_t MIN_RING_SIZE = 4 * 1024;
+
+// Deferred records are picked up at least this often. Threads wake the logger thread earlier
+// when their ring gets half full or on error.
+constexpr auto DEFERRED_POLL_INTERVAL = std::chrono::milliseconds(10);
+
+constexpr size_t alignRecord(size_t size)
+{
+    return (size + RECORD_ALIGN - 1) & ~(RECORD_ALIGN - 1);
+}
+
+int64_t nowMs()
+{
+    using namespace std::chrono;
+    return duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
+}
+
 } // anonymous namespace
 
 namespace logger {
 namespace detail {
 
+/**
+ * Single producer, single consumer ring of deferred log records: written by its thread, read by
+ * the logger thread. Record is a header followed by the arguments and never wraps around the
+ * buffer end, zero size marks the rest of the buffer as skipped.
+ */
+class RecordRing
+{
+public:
+    struct Header {
+        size_t size; // Whole record, must be the first member
+        const DeferredArgsOps *ops;
+        const char *format;
+        const char *file;
+        int line;
+        LogLevel level;
+        int64_t timestamp;
+    };
+
+    explicit RecordRing(size_t size)
+        : m_chunks(alignRecord(std::max(size, MIN_RING_SIZE)) / RECORD_ALIGN)
+    {
+    }
+
+    ~RecordRing()
+    {
+        consume([](const Header &, const void *) {}); // Destroy arguments not consumed
+    }
+
+    RecordRing(const RecordRing &) = delete;
+    RecordRing &operator=(const RecordRing &) = delete;
+
+    size_t capacity() const { return m_chunks.size() * RECORD_ALIGN; }
+
+    size_t used() const
+    {
+        return m_head.load(std::memory_order_relaxed) - m_tail.load(std::memory_order_relaxed);
+    }
+
+    /// @return false if there is no room for the record
+    bool push(Header header, void *args)
+    {
+        header.size = alignRecord(sizeof(Header)) + alignRecord(header.ops->size);
+        const auto capacity = this->capacity();
+        auto head = m_head.load(std::memory_order_relaxed);
+        const auto tail = m_tail.load(std::memory_order_acquire);
+        const auto contiguous = capacity - head % capacity;
+        const auto needed = header.size <= contiguous ? header.size : contiguous + header.size;
+        if (header.ops->align > RECORD_ALIGN || needed > capacity - (head - tail)) {
+            return false;
+        }
+
+        if (header.size > contiguous) {
+            new (at(head)) size_t {0};
+            head += contiguous;
+        }
+        new (at(head)) Header(header);
+        header.ops->moveTo(args, at(head) + alignRecord(sizeof(Header)));
+        m_head.store(head + header.size, std::memory_order_release);
+        return true;
+    }
+
+    /// Calls fn(header, args) for each record, oldest first
+    template<typename Fn>
+    void consume(Fn &&fn)
+    {
+        const auto capacity = this->capacity();
+        const auto head = m_head.load(std::memory_order_acquire);
+        auto tail = m_tail.load(std::memory_order_relaxed);
+        while (tail != head) {
+            auto *record = at(tail);
+            if (const auto size = *std::launder(reinterpret_cast<size_t *>(record)); size == 0) {
+                tail += capacity - tail % capacity;
+            } else {
+                const auto &header = *std::launder(reinterpret_cast<Header *>(record));
+                void *args = record + alignRecord(sizeof(Header));
+                fn(header, args);
+                header.ops->destroy(args);
+                tail += size;
+            }
+            m_tail.store(tail, std::memory_order_release);
+        }
+    }
+
+    std::atomic<bool> closed {false}; // The thread has exited, remove when consumed
+
+private:
+    struct alignas(RECORD_ALIGN) Chunk {
+        std::byte bytes[RECORD_ALIGN];
+    };
+
+    std::byte *at(size_t position)
+    {
+        return reinterpret_cast<std::byte *>(m_chunks.data()) + position % capacity();
+    }
+
+    std::vector<Chunk> m_chunks;
+    alignas(64) std::atomic<size_t> m_head {0}; // Written by the producer only
+    alignas(64) std::atomic<size_t> m_tail {0}; // Written by the consumer only
+};
+
 class CallbackLogger
 {
     struct LogData {
@@ -61,14 +177,29 @@ class CallbackLogger
     };
 
     struct LogDispatcherStop {};
+    struct LogDispatcherWake {}; // Deferred records are waiting
 
-    using LogQueueItem = std::variant<LogData, LogDispatcherStop>;
+    using LogQueueItem = std::variant<LogData, LogDispatcherStop, LogDispatcherWake>;
 
     struct CallbackAndData {
         LoggerCallback callback;
         size_t maxLength {512};
     };
 
+    struct BatchCallbackAndData {
+        BatchCallback callback;
+        size_t maxCount {1};
+        std::chrono::milliseconds maxDelay {0};
+        size_t maxLength {512};
+    };
+
+    /// Never modified once published, changes make a new copy
+    struct Callbacks {
+        std::vector<CallbackAndData> callbacks;
+        std::shared_ptr<const BatchCallbackAndData> batch;
+        uint64_t resets {0}; // Records waiting for the batch are dropped, not flushed, on change
+    };
+
 public:
     static CallbackLogger *instance()
     {
@@ -78,6 +209,7 @@ public:
 
     ~CallbackLogger()
     {
+        g_deferred.store(false, std::memory_order_relaxed);
         m_queue.enqueue(LogQueueItem {LogDispatcherStop {}});
 
         if (m_thread.joinable()) {
@@ -87,14 +219,32 @@ public:
 
     void addCallback(LoggerCallback &&callback, size_t maxLength)
     {
-        std::scoped_lock lock {m_cbMutex};
-        m_callbacks.emplace_back(CallbackAndData {std::move(callback), maxLength});
+        update([&](Callbacks &callbacks) {
+            callbacks.callbacks.emplace_back(CallbackAndData {std::move(callback), maxLength});
+        });
+    }
+
+    void setBatchCallback(BatchCallback &&callback, size_t maxCount,
+                          std::chrono::milliseconds maxDelay, size_t maxLength)
+    {
+        std::shared_ptr<const BatchCallbackAndData> batch;
+        if (callback) {
+            batch = std::make_shared<const BatchCallbackAndData>(BatchCallbackAndData {
+                    std::move(callback), std::max<size_t>(maxCount, 1), maxDelay, maxLength});
+        }
+        update([&](Callbacks &callbacks) { callbacks.batch = std::move(batch); });
+        apply(); // Previous callback gets its batch before it's replaced
+        wake();  // Wait with the new delay
     }
 
     void clear()
     {
-        std::scoped_lock lock {m_cbMutex};
-        m_callbacks.clear();
+        update([](Callbacks &callbacks) {
+            callbacks.callbacks.clear();
+            callbacks.batch.reset();
+            ++callbacks.resets;
+        });
+        apply();
     }
 
     void log(const std::string &message, LogLevel level, const char *file, int line)
@@ -103,23 +253,37 @@ public:
         const auto timestamp =
                 duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
 
+        tap(level, message); // Right away, the queued message is lost if the process crashes
         m_queue.enqueue(LogQueueItem {LogData {message, level, file, line, timestamp}});
     }
 
-private:
-    CallbackLogger()
-        : m_thread(&CallbackLogger::processLogs, this)
+    void logDeferred(LogLevel level, const char *file, int line, const char *format, void *args,
+                     const DeferredArgsOps &ops)
     {
+        auto &ring = threadRing();
+        if (UNLIKELY(!ring.push({0, &ops, format, file, line, level, nowMs()}, args))) {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            wake();
+        } else if (UNLIKELY(level >= LogLevel::Error || ring.used() * 2 > ring.capacity())) {
+            wake();
+        }
     }
 
-    static void lowerThreadPriority()
+    void setDeferredFormat(bool enabled, size_t bufferSize)
+    {
+        m_ringSize.store(bufferSize, std::memory_order_relaxed);
+        g_deferred.store(enabled, std::memory_order_relaxed);
+        if (!enabled) {
+            wake(); // Deliver what is left
+        }
+    }
+
+    uint64_t droppedCount() const { return m_dropped.load(std::memory_order_relaxed); }
+
+private:
+    CallbackLogger()
+        : m_thread(&CallbackLogger::processLogs, this)
     {
-#if defined(__linux__)
-        const pid_t tid = static_cast<pid_t>(syscall(SYS_gettid));
-        setpriority(PRIO_PROCESS, static_cast<id_t>(tid), 10);
-#elif defined(__APPLE__)
-        pthread_set_qos_class_self_np(QOS_CLASS_BACKGROUND, 0);
-#endif
     }
 
     void processLogs()
@@ -128,40 +292,235 @@ private:
 
         for (;;) {
             LogQueueItem item;
-            m_queue.wait_dequeue(item);
-            if (std::holds_alternative<LogDispatcherStop>(item)) {
-                break;
+            bool received = true;
+            if (const auto timeout = waitTimeout()) {
+                received = m_queue.wait_dequeue_timed(item, *timeout);
+            } else {
+                m_queue.wait_dequeue(item);
+            }
+
+            m_wakePending.store(false, std::memory_order_relaxed);
+
+            // Held while delivering, so no callback is invoked after resetCallbacks() returns.
+            // m_cbMutex is not, so callbacks can add, replace or reset callbacks.
+            std::scoped_lock deliverLock {m_deliverMutex};
+            updateCallbacks();
+            processDeferred();
+
+            if (received) {
+                if (std::holds_alternative<LogDispatcherStop>(item)) {
+                    flushBatch();
+                    break;
+                }
+                if (const auto *logData = std::get_if<LogData>(&item)) {
+                    deliver(logData->message, logData->level, logData->file, logData->line,
+                            logData->timestamp);
+                }
+            }
+
+            if (!m_batchRecords.empty() && std::chrono::steady_clock::now() >= m_batchDeadline) {
+                flushBatch();
             }
+        }
+    }
 
-            auto logData = std::move(std::get<LogData>(item));
-
-            std::unique_lock<std::mutex> cbLock {m_cbMutex};
-            for (auto cbItem : m_callbacks) {
-                cbLock.unlock();
-
-                if (LIKELY(cbItem.callback)) {
-                    if (LIKELY(logData.message.length() < cbItem.maxLength)) {
-                        cbItem.callback(logData.message, logData.level, logData.file, logData.line,
-                                        logData.timestamp);
-                    } else {
-                        // C strings must be null-terminated, so we cut the message at
-                        // maxLength - 1
-                        cbItem.callback(cutLongString(logData.message, cbItem.maxLength - 1),
-                                        logData.level, logData.file, logData.line,
-                                        logData.timestamp);
-                    }
+    /// Empty - wait for the next message
+    std::optional<std::chrono::milliseconds> waitTimeout()
+    {
+        using namespace std::chrono;
+        std::optional<milliseconds> timeout;
+        if (m_hasRings.load(std::memory_order_relaxed)) {
+            timeout = DEFERRED_POLL_INTERVAL;
+        }
+
+        std::scoped_lock lock {m_deliverMutex};
+        if (!m_batchRecords.empty()) {
+            const auto untilDeadline = ceil<milliseconds>(m_batchDeadline - steady_clock::now());
+            timeout = std::clamp(untilDeadline, milliseconds {0},
+                                 timeout.value_or(milliseconds::max()));
+        }
+        return timeout;
+    }
+
+    template<typename Fn>
+    void update(Fn &&fn)
+    {
+        std::scoped_lock lock {m_cbMutex};
+        auto callbacks = std::make_shared<Callbacks>(*m_callbacks);
+        fn(*callbacks);
+        m_callbacks = std::move(callbacks);
+    }
+
+    /// Waits for the callbacks being invoked and switches to the current ones
+    void apply()
+    {
+        std::scoped_lock lock {m_deliverMutex};
+        updateCallbacks();
+    }
+
+    // Called with m_deliverMutex locked
+    void updateCallbacks()
+    {
+        std::shared_ptr<const Callbacks> callbacks;
+        {
+            std::scoped_lock lock {m_cbMutex};
+            callbacks = m_callbacks;
+        }
+
+        if (callbacks->batch != m_active->batch) {
+            if (callbacks->resets == m_active->resets) {
+                flushBatch(); // What the replaced callback collected is still delivered to it
+            }
+            m_batchRecords.clear();
+            m_batchRecords.reserve(callbacks->batch ? callbacks->batch->maxCount : 0);
+        }
+        m_active = std::move(callbacks);
+    }
+
+    void wake()
+    {
+        if (!m_wakePending.load(std::memory_order_relaxed)
+            && !m_wakePending.exchange(true, std::memory_order_relaxed)) {
+            m_queue.enqueue(LogQueueItem {LogDispatcherWake {}});
+        }
+    }
+
+    RecordRing &threadRing()
+    {
+        struct ThreadRing {
+            std::shared_ptr<RecordRing> ring;
+
+            ~ThreadRing()
+            {
+                if (ring) {
+                    ring->closed.store(true, std::memory_order_release);
                 }
+            }
+        };
+
+        thread_local ThreadRing threadRing;
+        if (UNLIKELY(!threadRing.ring)) {
+            threadRing.ring =
+                    std::make_shared<RecordRing>(m_ringSize.load(std::memory_order_relaxed));
+            std::scoped_lock lock {m_ringsMutex};
+            m_rings.push_back(threadRing.ring);
+            m_hasRings.store(true, std::memory_order_relaxed);
+            wake(); // Logger thread may wait without timeout
+        }
+        return *threadRing.ring;
+    }
 
-                cbLock.lock(); // Lock again for the next callback
+    void processDeferred()
+    {
+        std::vector<std::shared_ptr<RecordRing>> rings;
+        {
+            std::scoped_lock lock {m_ringsMutex};
+            rings = m_rings;
+        }
+
+        for (const auto &ring : rings) {
+            const bool closed = ring->closed.load(std::memory_order_acquire);
+            ring->consume([this](const RecordRing::Header &header, const void *args) {
+                std::string message;
+                try {
+                    message = header.ops->format(header.format, args);
+                } catch (const std::exception &e) {
+                    message = fmt::format("Log format error: {}, format: {}", e.what(),
+                                          header.format);
+                }
+                tap(header.level, message);
+                deliver(message, header.level, header.file, header.line, header.timestamp);
+            });
+
+            if (closed) {
+                std::scoped_lock lock {m_ringsMutex};
+                m_rings.erase(std::find(m_rings.begin(), m_rings.end(), ring));
+                m_hasRings.store(!m_rings.empty(), std::memory_order_relaxed);
+            }
+        }
+
+        if (const auto dropped = m_dropped.load(std::memory_order_relaxed);
+            UNLIKELY(dropped != m_reportedDrops)) {
+            const auto message =
+                    fmt::format("Log buffer full, dropped {} messages", dropped - m_reportedDrops);
+            tap(LogLevel::Warn, message);
+            deliver(message, LogLevel::Warn, "logger_callback.cpp", __LINE__, nowMs());
+            m_reportedDrops = dropped;
+        }
+    }
+
+    // Called with m_deliverMutex locked
+    void deliver(const std::string &message, LogLevel level, const char *file, int line,
+                 int64_t timestamp)
+    {
+        const auto active = m_active;
+        for (const auto &cbItem : active->callbacks) {
+            if (UNLIKELY(m_active->resets != active->resets)) {
+                break; // Reset by the previous callback, the others may be gone
             }
+            if (LIKELY(cbItem.callback)) {
+                if (LIKELY(message.length() < cbItem.maxLength)) {
+                    cbItem.callback(message, level, file, line, timestamp);
+                } else {
+                    // C strings must be null-terminated, so we cut the message at
+                    // maxLength - 1
+                    cbItem.callback(cutLongString(message, cbItem.maxLength - 1), level, file,
+                                    line, timestamp);
+                }
+            }
+        }
+
+        if (const auto batch = m_active->batch) {
+            if (m_batchRecords.empty()) {
+                m_batchDeadline = std::chrono::steady_clock::now() + batch->maxDelay;
+            }
+            m_batchRecords.push_back({LIKELY(message.length() < batch->maxLength)
+                                              ? message
+                                              : cutLongString(message, batch->maxLength - 1),
+                                      level, file, line, timestamp});
+            if (m_batchRecords.size() >= batch->maxCount || level >= LogLevel::Error) {
+                flushBatch();
+            }
+        }
+    }
+
+    // Called with m_deliverMutex locked
+    void flushBatch()
+    {
+        const auto batch = m_active->batch;
+        if (m_batchRecords.empty() || !batch) {
+            m_batchRecords.clear();
+            return;
+        }
+
+        // The callback may replace itself, which delivers the batch again
+        auto records = std::move(m_batchRecords);
+        m_batchRecords.clear();
+        batch->callback(records);
+        if (m_batchRecords.empty()) {
+            records.clear();
+            m_batchRecords = std::move(records); // Reuse the memory
         }
     }
 
 private:
     moodycamel::BlockingConcurrentQueue<LogQueueItem> m_queue;
-    std::vector<CallbackAndData> m_callbacks;
-
-    std::mutex m_cbMutex;
+    std::shared_ptr<const Callbacks> m_callbacks {std::make_shared<const Callbacks>()};
+    std::mutex m_cbMutex; // Guards m_callbacks only, never held while calling them
+
+    // Guarded by m_deliverMutex. Recursive, as callbacks may reset or replace callbacks.
+    std::shared_ptr<const Callbacks> m_active {m_callbacks}; // Callbacks being delivered to
+    std::vector<LogRecord> m_batchRecords;
+    std::chrono::steady_clock::time_point m_batchDeadline;
+    std::recursive_mutex m_deliverMutex;
+
+    std::vector<std::shared_ptr<RecordRing>> m_rings; // Of threads that deferred any message
+    std::mutex m_ringsMutex;
+    std::atomic<bool> m_hasRings {false};
+    std::atomic<bool> m_wakePending {false};
+    std::atomic<size_t> m_ringSize {64 * 1024};
+    std::atomic<uint64_t> m_dropped {0};
+    uint64_t m_reportedDrops {0}; // Logger thread only
 
     std::thread m_thread; // This should be last, other members must be valid when it is destroyed
 };
@@ -175,6 +534,12 @@ void log(const std::string &message, LogLevel level, const char *file, int line)
     detail::CallbackLogger::instance()->log(message, level, file, line);
 }
 
+void detail::logDeferred(LogLevel level, const char *file, int line, const char *format,
+                         void *args, const DeferredArgsOps &ops)
+{
+    detail::CallbackLogger::instance()->logDeferred(level, file, line, format, args, ops);
+}
+
 // ---- C++ API ----
 
 void addCallback(LoggerCallback &&callback, size_t maxLength)
@@ -182,9 +547,26 @@ void addCallback(LoggerCallback &&callback, size_t maxLength)
     detail::CallbackLogger::instance()->addCallback(std::move(callback), maxLength);
 }
 
+void setBatchCallback(BatchCallback &&callback, size_t maxCount,
+                      std::chrono::milliseconds maxDelay, size_t maxLength)
+{
+    detail::CallbackLogger::instance()->setBatchCallback(std::move(callback), maxCount, maxDelay,
+                                                         maxLength);
+}
+
 void resetCallbacks()
 {
     detail::CallbackLogger::instance()->clear();
 }
 
+void setDeferredFormat(bool enabled, size_t bufferSize)
+{
+    detail::CallbackLogger::instance()->setDeferredFormat(enabled, bufferSize);
+}
+
+uint64_t droppedCount()
+{
+    return detail::CallbackLogger::instance()->droppedCount();
+}
+
 } // namespace logger
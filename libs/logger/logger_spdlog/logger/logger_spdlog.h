@@ -8,12 +8,17 @@
 #pragma once
 
 #include <logger/logger.h>
+#include <chrono>
+#include <cstdint>
 #include <memory>
 #include <string>
 
 namespace spdlog {
 class logger;
+namespace details {
+class thread_pool;
 }
+} // namespace spdlog
 
 namespace logger {
 
@@ -24,16 +29,36 @@ enum Flag : Flags {
     SHOW_FILE = 0x0002,
 };
 
+/// What the async logger does when its queue is full
+enum class Overflow {
+    Block,      // Wait for free space, nothing is lost
+    DropOldest, // Replace the oldest queued message
+    DropNew,    // Drop the message being logged
+};
+
+struct LoggerOptions {
+    bool async {false};        // Write on a background thread, logging thread does no file I/O
+    size_t queueSize {8192};   // Messages waiting to be written in async mode
+    Overflow overflow {Overflow::Block};
+    std::chrono::milliseconds flushInterval {1000}; // 0 - flushed by flushOn and flush() only
+    LogLevel flushOn {LogLevel::Warn};              // Messages at this level are flushed right away
+    bool compressRotated {true}; // Gzip rotated files on a background low priority thread
+};
+
 class Logger
 {
 public:
     static Logger *instance();
 
     void initLogger(LogLevel level, Flags flags, const std::string &fileName, size_t maxLogSize,
-                    size_t maxLogFiles, size_t maxLogMessageLength = 512);
+                    size_t maxLogFiles, size_t maxLogMessageLength = 512,
+                    const LoggerOptions &options = {});
 
     void flush();
 
+    /// Messages lost because the async queue was full
+    uint64_t droppedCount() const;
+
     void logImpl(const std::string &message, LogLevel level, const char *file, int line);
 
 private:
@@ -41,6 +66,7 @@ private:
 
 private:
     std::shared_ptr<spdlog::logger> m_logger;
+    std::shared_ptr<spdlog::details::thread_pool> m_threadPool; // Async mode only
     size_t m_maxLogMessageLength {512};
 };
 
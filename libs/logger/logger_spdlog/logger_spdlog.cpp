@@ -6,17 +6,31 @@
  */
 
 #include "detail/cut_long_string.h"
+#include "detail/thread_priority.h"
 #include <logger/logger_spdlog.h>
 
 #include <spdlog/spdlog.h>
+#include <spdlog/async.h>
+#include <spdlog/async_logger.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/sinks/rotating_file_sink.h>
+#include <zlib.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <thread>
 #include <vector>
 #include <iostream>
 
 namespace {
 
 constexpr auto GZIP_EXT = "gz";
+constexpr size_t GZIP_BUFFER_SIZE = 64 * 1024;
+
+std::atomic<bool> g_compressRotated {true};
 
 #if defined(__GNUC__) || defined(__clang__)
 #    define LIKELY(x) __builtin_expect(!!(x), 1)
@@ -42,8 +56,109 @@ constexpr spdlog::level::level_enum toSpdlogLevel(logger::LogLevel level)
     }
 }
 
+spdlog::async_overflow_policy toSpdlogPolicy(logger::Overflow overflow)
+{
+    switch (overflow) {
+    case logger::Overflow::DropOldest:
+        return spdlog::async_overflow_policy::overrun_oldest;
+    case logger::Overflow::DropNew:
+        return spdlog::async_overflow_policy::discard_new;
+    case logger::Overflow::Block:
+    default:
+        return spdlog::async_overflow_policy::block;
+    }
+}
+
+/// Compress @p path to @p path.gz, the original is removed when done
+bool gzipFile(const std::string &path)
+{
+    std::FILE *in = std::fopen(path.c_str(), "rb");
+    if (!in) {
+        return false; // Rotated away meanwhile
+    }
+
+    // Written under temporary name, so a half-written archive is never taken for a log
+    const auto target = fmt::format("{}.{}", path, GZIP_EXT);
+    const auto temp = target + ".tmp";
+    gzFile out = gzopen(temp.c_str(), "wb");
+    if (!out) {
+        std::fclose(in);
+        return false;
+    }
+
+    std::vector<char> buffer(GZIP_BUFFER_SIZE);
+    bool ok = true;
+    for (size_t size; ok && (size = std::fread(buffer.data(), 1, buffer.size(), in)) > 0;) {
+        ok = gzwrite(out, buffer.data(), static_cast<unsigned>(size)) == static_cast<int>(size);
+    }
+    ok = !std::ferror(in) && ok;
+    std::fclose(in);
+    ok = gzclose(out) == Z_OK && ok;
+
+    std::error_code ec;
+    if (ok) {
+        std::filesystem::rename(temp, target, ec);
+        ok = !ec;
+    }
+    std::filesystem::remove(ok ? path : temp, ec);
+    return ok;
+}
+
+/// Gzips rotated log files one by one on a low priority thread
+class Compressor
+{
+public:
+    static Compressor &instance()
+    {
+        // Never destroyed: the sink rotates while the logger is destroyed at exit, which may be
+        // after a function static. Files still waiting at exit are left uncompressed.
+        static auto *compressor = new Compressor();
+        return *compressor;
+    }
+
+    void add(std::string path)
+    {
+        std::scoped_lock lock(m_mutex);
+        m_files.push_back(std::move(path));
+        if (!m_thread.joinable()) {
+            m_thread = std::thread(&Compressor::run, this);
+        }
+        m_cv.notify_one();
+    }
+
+private:
+    Compressor() = default;
+
+    void run()
+    {
+        logger::lowerThreadPriority();
+
+        std::unique_lock lock(m_mutex);
+        for (;;) {
+            m_cv.wait(lock, [this] { return !m_files.empty(); });
+
+            const auto path = std::move(m_files.front());
+            m_files.pop_front();
+            lock.unlock();
+            if (!gzipFile(path)) {
+                WRN("Can't compress rotated log file {}", path);
+            }
+            lock.lock();
+        }
+    }
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque<std::string> m_files;
+    std::thread m_thread;
+};
+
+// Called by the rotating sink with the file it has just rotated, on the thread writing the log
 void logCompressorCallback(spdlog::filename_t filename)
 {
+    if (g_compressRotated.load(std::memory_order_relaxed)) {
+        Compressor::instance().add(spdlog::details::os::filename_to_str(filename));
+    }
 }
 
 } // namespace
@@ -57,9 +172,11 @@ Logger *Logger::instance()
 }
 
 void Logger::initLogger(LogLevel level, Flags flags, const std::string &fileName, size_t maxLogSize,
-                        size_t maxLogFiles, size_t maxLogMessageLength)
+                        size_t maxLogFiles, size_t maxLogMessageLength,
+                        const LoggerOptions &options)
 {
     m_maxLogMessageLength = maxLogMessageLength;
+    g_compressRotated.store(options.compressRotated, std::memory_order_relaxed);
     const auto fileLine = (flags & SHOW_FILE) ? "\t[file://%s:%#]" : std::string {};
     const auto timestamp = (flags & SHOW_TIME) ? "[%Y-%m-%d %T.%e] [%^%4!l%$] " : std::string {};
     const auto pattern = fmt::format("{}%v{}", timestamp, fileLine);
@@ -85,12 +202,24 @@ void Logger::initLogger(LogLevel level, Flags flags, const std::string &fileName
     }
 
     spdlog::drop("logger"); // Remove previous logger from registry if it exists
-    m_logger = std::make_shared<spdlog::logger>("logger", begin(sinks), end(sinks));
-    m_logger->set_level(toSpdlogLevel(level));
-    m_logger->flush_on(spdlog::level::warn);
+    if (options.async) {
+        // Previous pool, if any, writes out its queue when it's replaced
+        m_threadPool = std::make_shared<spdlog::details::thread_pool>(options.queueSize, 1,
+                                                                      [] { lowerThreadPriority(); });
+        m_logger = std::make_shared<spdlog::async_logger>("logger", begin(sinks), end(sinks),
+                                                          m_threadPool,
+                                                          toSpdlogPolicy(options.overflow));
+    } else {
+        m_logger = std::make_shared<spdlog::logger>("logger", begin(sinks), end(sinks));
+        m_threadPool.reset();
+    }
+    // Messages are filtered by the threshold before formatting, spdlog passes all that reach it
+    setLevel(level);
+    m_logger->set_level(spdlog::level::debug);
+    m_logger->flush_on(toSpdlogLevel(options.flushOn));
 
     spdlog::register_logger(m_logger); // Add to spdlog registry, so flush_every() can access it
-    spdlog::flush_every(std::chrono::seconds(1));
+    spdlog::flush_every(options.flushInterval); // 0 stops periodic flush
 }
 
 void Logger::flush()
@@ -100,8 +229,14 @@ void Logger::flush()
     }
 }
 
+uint64_t Logger::droppedCount() const
+{
+    return m_threadPool ? m_threadPool->overrun_counter() + m_threadPool->discard_counter() : 0;
+}
+
 void Logger::logImpl(const std::string &message, LogLevel level, const char *file, int line)
 {
+    detail::tap(level, message);
     if (LIKELY(m_logger)) {
         // Already formatted by logMessage(); string_view hits spdlog's non-template log() so the
         // message is not routed through spdlog's log(loc, lvl, "{}", msg) fmt indirection.
@@ -116,6 +251,13 @@ void Logger::logImpl(const std::string &message, LogLevel level, const char *fil
     }
 }
 
+// spdlog backend has no deferred mode, format right away
+void detail::logDeferred(LogLevel level, const char *file, int line, const char *format,
+                         void *args, const DeferredArgsOps &ops)
+{
+    Logger::instance()->logImpl(ops.format(format, args), level, file, line);
+}
+
 // Implementation of the interface log() function
 void log(const std::string &message, LogLevel level, const char *file, int line)
 {
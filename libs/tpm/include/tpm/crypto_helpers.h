@@ -20,10 +20,56 @@
 #pragma once
 
 #include <utils/bytearray.h>
+#include <cstddef>
+#include <vector>
 
 using ByteArray = utils::ByteArray;
 
+struct evp_pkey_st;
+
 ByteArray sha256Hash(const ByteArray &data);
 bool ecdsaSign(const ByteArray &privateKey, const ByteArray &hash, ByteArray &signature);
 bool ecdsaVerify(const ByteArray &publicKey, const ByteArray &hash, const ByteArray &signature);
 bool generateEcdsaKeyPair(ByteArray &publicKey, ByteArray &privateKey);
+
+/**
+ * @brief Set up the OpenSSL secure heap, so private keys parsed afterwards live in mlock'ed
+ * memory which is wiped on free. It's process wide and done once, later calls return the
+ * first result.
+ * @param size Heap size in bytes, power of two.
+ * @return true if the heap is up and locked in RAM.
+ */
+bool enableSecureKeyMemory(size_t size);
+
+/**
+ * @brief P-256 private key parsed once for repeated signing.
+ *
+ * The private scalar is kept in the secure heap when @ref enableSecureKeyMemory was called and
+ * is wiped when the key is reset or destroyed.
+ */
+class EcdsaSigningKey
+{
+public:
+    EcdsaSigningKey() = default;
+    explicit EcdsaSigningKey(const ByteArray &privateKey);
+    ~EcdsaSigningKey();
+
+    EcdsaSigningKey(EcdsaSigningKey &&other) noexcept;
+    EcdsaSigningKey &operator=(EcdsaSigningKey &&other) noexcept;
+    EcdsaSigningKey(const EcdsaSigningKey &) = delete;
+    EcdsaSigningKey &operator=(const EcdsaSigningKey &) = delete;
+
+    bool isValid() const { return m_key != nullptr; }
+    void reset();
+
+    bool sign(const ByteArray &hash, ByteArray &signature) const;
+
+    /**
+     * @brief Sign several hashes with one signing context.
+     * @return false if any of them failed, @p signatures is empty then.
+     */
+    bool signBatch(const std::vector<ByteArray> &hashes, std::vector<ByteArray> &signatures) const;
+
+private:
+    evp_pkey_st *m_key {nullptr};
+};
@@ -9,6 +9,7 @@
 
 #include "itpm.h"
 #include "tpm.h"
+#include "tpm_session.h"
 #include <memory>
 
 class HardwareTpm : public ITpm
@@ -27,14 +28,13 @@ public:
     std::string signMessage(const utils::ByteArray &message) const override;
     utils::ByteArray signDigest(const utils::ByteArray &digest) const override;
 
+    TpmSessionMetrics metrics() const;
+
 private:
-    Tpm tpm() const;
     bool readIdentity();
 
 private:
-    TpmBusFlags m_busFlags;
-    std::string m_usbDevicePath;
-    TpmDevice m_device;
+    std::unique_ptr<TpmSession> m_session;
 
     uint64_t m_serial {0};
     ByteArray m_uuid;
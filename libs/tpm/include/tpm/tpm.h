@@ -55,6 +55,11 @@ public:
     bool ok() const;
     TpmDevice device() const;
 
+    // cryptoauthlib status of the last device command, ATCA_SUCCESS (0) if it succeeded
+    int lastStatus() const;
+    // Bus or wake failures after which the device should be opened again
+    static bool isCommunicationError(int status);
+
     ByteArray info();
     ByteArray tpmSerialNumber();
 
@@ -0,0 +1,113 @@
+/*
+ * Scorbit SDK
+ *
+ * (c) 2025 Spinner Systems, Inc. (DBA Scorbit), scrobit.io, All Rights Reserved
+ *
+ * MIT License
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "tpm.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+struct TpmOpStats {
+    uint64_t count {0};
+    uint64_t failures {0};
+    std::chrono::microseconds total {0};
+    std::chrono::microseconds max {0};
+};
+
+struct TpmSessionMetrics {
+    uint64_t deviceOpens {0};   // Successful atcab_init, first one included
+    uint64_t openFailures {0};  // Open attempts which found no device
+    uint64_t reconnects {0};    // Re-opens after a command failed to reach the device
+    std::map<std::string, TpmOpStats> ops; // Per command latency, "open" for device opens
+};
+
+/**
+ * @brief Long-lived connection to the TPM.
+ *
+ * The device is opened on the first command and kept open. Commands from any thread are queued
+ * and run one by one on the session thread, cryptoauthlib devices are not thread safe. If a
+ * command fails with a communication error, the device is re-opened and the command is retried
+ * once. Other errors are returned as is. When no device is found, further open attempts are
+ * throttled.
+ */
+class TpmSession
+{
+public:
+    using Command = std::function<bool(Tpm &tpm)>;
+
+    explicit TpmSession(TpmBusFlags busFlags, std::string usbDevicePath = {});
+    ~TpmSession();
+
+    TpmSession(const TpmSession &) = delete;
+    TpmSession &operator=(const TpmSession &) = delete;
+
+    /**
+     * @brief Run @p command on the session thread with the open device and wait for it.
+     * @param name Command name for metrics.
+     * @param command Returns false on failure, Tpm::lastStatus() tells whether to reconnect.
+     * @return false if the device couldn't be opened or the command failed after reconnect.
+     */
+    bool execute(const std::string &name, const Command &command);
+
+    bool ok();
+    bool readIdentity(uint64_t &serialNumber, ByteArray &uuid);
+    ByteArray signDigest(uint16_t keyId, const ByteArray &digest);
+    ByteArray signMessage(uint16_t keyId, const ByteArray &message);
+
+    TpmSessionMetrics metrics() const;
+
+private:
+    struct Request {
+        std::string name;
+        const Command *command;
+        std::promise<bool> done;
+    };
+
+    void run();
+    bool process(const Request &request);
+    bool open();
+    void record(const std::string &name, std::chrono::steady_clock::duration elapsed, bool ok);
+
+    const TpmBusFlags m_busFlags;
+    const std::string m_usbDevicePath;
+
+    // Session thread only
+    std::unique_ptr<Tpm> m_tpm;
+    TpmDevice m_device;
+    std::chrono::steady_clock::time_point m_lastOpenFailure;
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque<Request> m_queue;
+    bool m_stop {false};
+
+    mutable std::mutex m_metricsMutex;
+    TpmSessionMetrics m_metrics;
+
+    std::thread m_thread; // Last, other members must be valid while it runs
+};
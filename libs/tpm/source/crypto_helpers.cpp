@@ -17,6 +17,8 @@
 #include <openssl/ecdsa.h>
 #include <openssl/err.h>
 #include <openssl/bn.h>
+#include <openssl/crypto.h>
+#include <utility>
 
 using namespace tpm::crypto;
 
@@ -91,6 +93,46 @@ static bool rawToDer(const ByteArray &raw, ByteArray &der)
     return true;
 }
 
+static EVP_PKEY_CTX_ptr createSignContext(EVP_PKEY *pkey)
+{
+    EVP_PKEY_CTX_ptr ctx(EVP_PKEY_CTX_new_from_pkey(nullptr, pkey, nullptr), EVP_PKEY_CTX_free);
+    if (!ctx) {
+        ERR("EVP_PKEY_CTX_new_from_pkey failed: {}", getOpenSSLErrorString());
+        return EVP_PKEY_CTX_ptr(nullptr, EVP_PKEY_CTX_free);
+    }
+
+    if (EVP_PKEY_sign_init(ctx.get()) != 1) {
+        ERR("EVP_PKEY_sign_init failed: {}", getOpenSSLErrorString());
+        return EVP_PKEY_CTX_ptr(nullptr, EVP_PKEY_CTX_free);
+    }
+    return ctx;
+}
+
+static bool signWithContext(EVP_PKEY_CTX *ctx, const ByteArray &hash, ByteArray &signature)
+{
+    signature.clear();
+
+    if (hash.size() != kSHA256Size) {
+        ERR(kErrorInvalidHashSize, hash.size(), kSHA256Size);
+        return false;
+    }
+
+    size_t der_len = 0;
+    if (EVP_PKEY_sign(ctx, nullptr, &der_len, hash.data(), hash.size()) != 1) {
+        ERR("EVP_PKEY_sign (len) failed: {}", getOpenSSLErrorString());
+        return false;
+    }
+
+    ByteArray der(der_len);
+    if (EVP_PKEY_sign(ctx, der.data(), &der_len, hash.data(), hash.size()) != 1) {
+        ERR("EVP_PKEY_sign failed: {}", getOpenSSLErrorString());
+        return false;
+    }
+    der.resize(der_len);
+
+    return derToRaw(der.data(), der.size(), signature);
+}
+
 // --- API ------------------------------------------------------------------
 
 ByteArray sha256Hash(const ByteArray &data)
@@ -124,39 +166,8 @@ bool ecdsaSign(const ByteArray &privateKey, const ByteArray &hash, ByteArray &si
         return false;
     }
 
-    // Create private key using utility function
-    EVP_PKEY_ptr pkey = createEcdsaPrivateKey(privateKey);
-    if (!pkey) {
-        return false;
-    }
-
-    // Sign
-    EVP_PKEY_CTX_ptr ctx(EVP_PKEY_CTX_new_from_pkey(nullptr, pkey.get(), nullptr),
-                         EVP_PKEY_CTX_free);
-    if (!ctx) {
-        ERR("EVP_PKEY_CTX_new_from_pkey failed: {}", getOpenSSLErrorString());
-        return false;
-    }
-
-    if (EVP_PKEY_sign_init(ctx.get()) != 1) {
-        ERR("EVP_PKEY_sign_init failed: {}", getOpenSSLErrorString());
-        return false;
-    }
-
-    size_t der_len = 0;
-    if (EVP_PKEY_sign(ctx.get(), nullptr, &der_len, hash.data(), hash.size()) != 1) {
-        ERR("EVP_PKEY_sign (len) failed: {}", getOpenSSLErrorString());
-        return false;
-    }
-
-    ByteArray der(der_len);
-    if (EVP_PKEY_sign(ctx.get(), der.data(), &der_len, hash.data(), hash.size()) != 1) {
-        ERR("EVP_PKEY_sign failed: {}", getOpenSSLErrorString());
-        return false;
-    }
-    der.resize(der_len);
-
-    return derToRaw(der.data(), der.size(), signature);
+    EcdsaSigningKey key(privateKey);
+    return key.isValid() && key.sign(hash, signature);
 }
 
 bool ecdsaVerify(const ByteArray &publicKey, const ByteArray &hash, const ByteArray &signature)
@@ -296,3 +307,90 @@ bool generateEcdsaKeyPair(ByteArray &publicKey, ByteArray &privateKey)
 
     return true;
 }
+
+bool enableSecureKeyMemory(size_t size)
+{
+    static const bool locked = [size] {
+        if (CRYPTO_secure_malloc_initialized()) {
+            return true;
+        }
+        switch (CRYPTO_secure_malloc_init(size, 16)) {
+        case 1:
+            return true;
+        case 2:
+            WRN("Secure heap is up, but it couldn't be locked in RAM");
+            return false;
+        default:
+            WRN("Secure heap is not available, keys are kept in regular memory");
+            return false;
+        }
+    }();
+    return locked;
+}
+
+EcdsaSigningKey::EcdsaSigningKey(const ByteArray &privateKey)
+{
+    m_key = createEcdsaPrivateKey(privateKey).release();
+}
+
+EcdsaSigningKey::~EcdsaSigningKey()
+{
+    reset();
+}
+
+EcdsaSigningKey::EcdsaSigningKey(EcdsaSigningKey &&other) noexcept
+    : m_key(std::exchange(other.m_key, nullptr))
+{
+}
+
+EcdsaSigningKey &EcdsaSigningKey::operator=(EcdsaSigningKey &&other) noexcept
+{
+    if (this != &other) {
+        reset();
+        m_key = std::exchange(other.m_key, nullptr);
+    }
+    return *this;
+}
+
+void EcdsaSigningKey::reset()
+{
+    // The EC key management frees its private scalar with BN_clear_free
+    EVP_PKEY_free(m_key);
+    m_key = nullptr;
+}
+
+bool EcdsaSigningKey::sign(const ByteArray &hash, ByteArray &signature) const
+{
+    signature.clear();
+    if (!m_key) {
+        ERR("Signing key is not loaded");
+        return false;
+    }
+
+    EVP_PKEY_CTX_ptr ctx = createSignContext(m_key);
+    return ctx && signWithContext(ctx.get(), hash, signature);
+}
+
+bool EcdsaSigningKey::signBatch(const std::vector<ByteArray> &hashes,
+                                std::vector<ByteArray> &signatures) const
+{
+    signatures.clear();
+    if (!m_key) {
+        ERR("Signing key is not loaded");
+        return false;
+    }
+
+    EVP_PKEY_CTX_ptr ctx = createSignContext(m_key);
+    if (!ctx) {
+        return false;
+    }
+
+    signatures.resize(hashes.size());
+    for (size_t i = 0; i < hashes.size(); ++i) {
+        if (!signWithContext(ctx.get(), hashes[i], signatures[i])) {
+            signatures.clear();
+            return false;
+        }
+    }
+    return true;
+}
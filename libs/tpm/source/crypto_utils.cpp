@@ -72,9 +72,9 @@ EVP_PKEY_ptr createEcdsaPrivateKey(const ByteArray &privateKey)
         return EVP_PKEY_ptr(nullptr, EVP_PKEY_free);
     }
 
-    // Convert private key bytes to BIGNUM
-    BN_ptr priv_key_bn(BN_bin2bn(privateKey.data(), privateKey.size(), nullptr), BN_free);
-    if (!priv_key_bn) {
+    // Convert private key bytes to BIGNUM, in the secure heap if it is set up
+    BN_secure_ptr priv_key_bn(BN_secure_new(), BN_clear_free);
+    if (!priv_key_bn || !BN_bin2bn(privateKey.data(), privateKey.size(), priv_key_bn.get())) {
         ERR("BN_bin2bn failed for private key: {}", getOpenSSLErrorString());
         return EVP_PKEY_ptr(nullptr, EVP_PKEY_free);
     }
@@ -32,6 +32,7 @@ using OSSL_PARAM_BLD_ptr = ossl_ptr<OSSL_PARAM_BLD, OSSL_PARAM_BLD_free>;
 using OSSL_PARAM_ptr = ossl_ptr<OSSL_PARAM, OSSL_PARAM_free>;
 using ECDSA_SIG_ptr = ossl_ptr<ECDSA_SIG, ECDSA_SIG_free>;
 using BN_ptr = ossl_ptr<BIGNUM, BN_free>;
+using BN_secure_ptr = ossl_ptr<BIGNUM, BN_clear_free>;
 
 // Utility functions
 std::string getOpenSSLErrorString();
@@ -10,8 +10,7 @@
 using ByteArray = utils::ByteArray;
 
 HardwareTpm::HardwareTpm(TpmBusFlags busFlags, const std::string &usbDevicePath)
-    : m_busFlags(busFlags)
-    , m_usbDevicePath(usbDevicePath)
+    : m_session(std::make_unique<TpmSession>(busFlags, usbDevicePath))
 {
     readIdentity();
 }
@@ -22,7 +21,7 @@ HardwareTpm::~HardwareTpm()
 
 bool HardwareTpm::hasTpm() const
 {
-    return tpm().ok();
+    return m_session->ok();
 }
 
 bool HardwareTpm::isValid() const
@@ -57,35 +56,25 @@ std::string HardwareTpm::uuid() const
 
 std::string HardwareTpm::signMessage(const ByteArray &message) const
 {
-    return tpm().signMessage(KEY4_SLOT, message).hex();
+    return m_session->signMessage(KEY4_SLOT, message).hex();
 }
 
 ByteArray HardwareTpm::signDigest(const ByteArray &digest) const
 {
-    return tpm().signDigest(KEY4_SLOT, digest);
+    return m_session->signDigest(KEY4_SLOT, digest);
 }
 
-Tpm HardwareTpm::tpm() const
+TpmSessionMetrics HardwareTpm::metrics() const
 {
-    if (m_device.isValid()) {
-        return Tpm(m_device);
-    }
-
-    return Tpm(m_busFlags, m_usbDevicePath);
+    return m_session->metrics();
 }
 
 bool HardwareTpm::readIdentity()
 {
-    auto tpm1 = tpm();
-    if (!tpm1.ok() || !tpm1.readIdentity()) {
+    if (!m_session->readIdentity(m_serial, m_uuid)) {
         m_serial = 0;
         m_uuid.clear();
-        m_device = {};
         return false;
     }
-
-    m_serial = tpm1.serialNumber();
-    m_uuid = tpm1.uuid();
-    m_device = tpm1.device();
     return true;
 }
@@ -88,8 +88,15 @@ struct Tpm::Impl {
         }
     }
 
+    ATCA_STATUS retry(std::function<ATCA_STATUS()> func)
+    {
+        lastStatus = atcaRetry(std::move(func));
+        return lastStatus;
+    }
+
     ATCAIfaceCfg atcaConfig;
     ATCADevice atcaDevice {nullptr};
+    ATCA_STATUS lastStatus {ATCA_SUCCESS};
 
     std::string usbDevicePath;
 
@@ -159,6 +166,35 @@ bool Tpm::ok() const
     return !p->infoResult.empty();
 }
 
+int Tpm::lastStatus() const
+{
+    return p->lastStatus;
+}
+
+bool Tpm::isCommunicationError(int status)
+{
+    switch (status) {
+    case ATCA_WAKE_FAILED:
+    case ATCA_STATUS_CRC:
+    case ATCA_RX_CRC_ERROR:
+    case ATCA_RX_FAIL:
+    case ATCA_RX_NO_RESPONSE:
+    case ATCA_RESYNC_WITH_WAKEUP:
+    case ATCA_PARITY_ERROR:
+    case ATCA_TX_TIMEOUT:
+    case ATCA_RX_TIMEOUT:
+    case ATCA_TOO_MANY_COMM_RETRIES:
+    case ATCA_COMM_FAIL:
+    case ATCA_TIMEOUT:
+    case ATCA_TX_FAIL:
+    case ATCA_NO_DEVICES:
+    case ATCA_NOT_INITIALIZED:
+        return true;
+    default:
+        return false;
+    }
+}
+
 TpmDevice Tpm::device() const
 {
     return p->device;
@@ -170,7 +206,7 @@ ByteArray Tpm::info()
         return p->infoResult;
 
     ByteArray result(INFO_SIZE, 0);
-    auto status = atcaRetry(std::bind(calib_info, p->atcaDevice, result.data()));
+    auto status = p->retry(std::bind(calib_info, p->atcaDevice, result.data()));
     if (status != ATCA_SUCCESS) {
         if (status != ATCA_COMM_FAIL) {
             ERR("{}: error {}", __func__, static_cast<int>(status));
@@ -184,7 +220,7 @@ ByteArray Tpm::info()
 ByteArray Tpm::tpmSerialNumber()
 {
     ByteArray result(ATCA_SERIAL_NUM_SIZE, 0);
-    auto status = atcaRetry(std::bind(calib_read_serial_number, p->atcaDevice, result.data()));
+    auto status = p->retry(std::bind(calib_read_serial_number, p->atcaDevice, result.data()));
     if (status != ATCA_SUCCESS) {
         ERR("{}: error {}", __func__, static_cast<int>(status));
         return ByteArray();
@@ -206,8 +242,8 @@ ByteArray Tpm::uuid() const
 bool Tpm::readSerialUuid()
 {
     ByteArray data(ATCA_BLOCK_SIZE, 0);
-    auto status = atcaRetry(std::bind(calib_read_bytes_zone, p->atcaDevice, ATCA_ZONE_DATA,
-                                      SERIAL_SLOT, 0, data.data(), ATCA_BLOCK_SIZE));
+    auto status = p->retry(std::bind(calib_read_bytes_zone, p->atcaDevice, ATCA_ZONE_DATA,
+                                     SERIAL_SLOT, 0, data.data(), ATCA_BLOCK_SIZE));
     if (status != ATCA_SUCCESS) {
         ERR("{}: slot {}, error {}", __func__, SERIAL_SLOT, static_cast<int>(status));
         return false;
@@ -234,7 +270,7 @@ bool Tpm::readIdentity()
 bool Tpm::isConfigLocked()
 {
     bool isLocked = false;
-    auto status = atcaRetry(std::bind(calib_is_locked, p->atcaDevice, LOCK_ZONE_CONFIG, &isLocked));
+    auto status = p->retry(std::bind(calib_is_locked, p->atcaDevice, LOCK_ZONE_CONFIG, &isLocked));
     if (status != ATCA_SUCCESS) {
         ERR("{}: error {}", __func__, static_cast<int>(status));
     }
@@ -245,7 +281,7 @@ bool Tpm::isConfigLocked()
 bool Tpm::isDataLocked()
 {
     bool isLocked = false;
-    auto status = atcaRetry(std::bind(calib_is_locked, p->atcaDevice, LOCK_ZONE_DATA, &isLocked));
+    auto status = p->retry(std::bind(calib_is_locked, p->atcaDevice, LOCK_ZONE_DATA, &isLocked));
     if (status != ATCA_SUCCESS) {
         ERR("{}: error {}", __func__, static_cast<int>(status));
     }
@@ -256,7 +292,7 @@ bool Tpm::isDataLocked()
 ByteArray Tpm::readConfig()
 {
     ByteArray config(ATCA_ECC_CONFIG_SIZE, 0);
-    auto status = atcaRetry(std::bind(calib_read_config_zone, p->atcaDevice, config.data()));
+    auto status = p->retry(std::bind(calib_read_config_zone, p->atcaDevice, config.data()));
     if (status != ATCA_SUCCESS) {
         ERR("{}: error {}", __func__, static_cast<int>(status));
         return ByteArray();
@@ -272,8 +308,8 @@ bool Tpm::verifySignature(const ByteArray &message, const ByteArray &signature,
     atcah_sha256(message.size(), message.data(), digest.data());
 
     bool isVerified;
-    auto status = atcaRetry(std::bind(calib_verify_extern, p->atcaDevice, digest.data(),
-                                      signature.data(), publicKey.data(), &isVerified));
+    auto status = p->retry(std::bind(calib_verify_extern, p->atcaDevice, digest.data(),
+                                     signature.data(), publicKey.data(), &isVerified));
     if (status != ATCA_SUCCESS) {
         ERR("{}: error {}", __func__, static_cast<int>(status));
         return false;
@@ -294,7 +330,7 @@ ByteArray Tpm::signDigest(uint16_t keyId, const ByteArray &digest)
 {
     ByteArray signature(ATCA_ECCP256_SIG_SIZE, 0);
     auto status =
-            atcaRetry(std::bind(calib_sign, p->atcaDevice, keyId, digest.data(), signature.data()));
+            p->retry(std::bind(calib_sign, p->atcaDevice, keyId, digest.data(), signature.data()));
     if (status != ATCA_SUCCESS) {
         ERR("{}: error {}", __func__, static_cast<int>(status));
         return ByteArray();
@@ -306,7 +342,7 @@ ByteArray Tpm::signDigest(uint16_t keyId, const ByteArray &digest)
 ByteArray Tpm::getPublicKey(uint16_t keyId)
 {
     ByteArray data(ATCA_ECCP256_PUBKEY_SIZE, 0);
-    auto status = atcaRetry(std::bind(calib_get_pubkey, p->atcaDevice, keyId, data.data()));
+    auto status = p->retry(std::bind(calib_get_pubkey, p->atcaDevice, keyId, data.data()));
     if (status != ATCA_SUCCESS) {
         ERR("{}: error {}", __func__, static_cast<int>(status));
         return ByteArray();
@@ -317,8 +353,7 @@ ByteArray Tpm::getPublicKey(uint16_t keyId)
 
 bool Tpm::writeConfig(const uint8_t ATECC508A_CONFIGDATA[])
 {
-    auto status =
-            atcaRetry(std::bind(calib_write_config_zone, p->atcaDevice, ATECC508A_CONFIGDATA));
+    auto status = p->retry(std::bind(calib_write_config_zone, p->atcaDevice, ATECC508A_CONFIGDATA));
     if (status != ATCA_SUCCESS) {
         ERR("{}: couldn't write config, error {}", __func__, static_cast<int>(status));
         return false;
@@ -329,7 +364,7 @@ bool Tpm::writeConfig(const uint8_t ATECC508A_CONFIGDATA[])
 
 bool Tpm::lockConfig()
 {
-    auto status = atcaRetry(std::bind(calib_lock_config_zone, p->atcaDevice));
+    auto status = p->retry(std::bind(calib_lock_config_zone, p->atcaDevice));
     if (status != ATCA_SUCCESS) {
         ERR("{}: couldn't lock config, error {}", __func__, static_cast<int>(status));
         return false;
@@ -343,7 +378,7 @@ bool Tpm::lockData()
     if (isDataLocked())
         return false;
 
-    auto status = atcaRetry(std::bind(calib_lock_data_zone, p->atcaDevice));
+    auto status = p->retry(std::bind(calib_lock_data_zone, p->atcaDevice));
     if (status != ATCA_SUCCESS) {
         ERR("{}: couldn't lock data zone, error {}", __func__, static_cast<int>(status));
         return false;
@@ -359,7 +394,7 @@ bool Tpm::writeKey(uint16_t keyId, const ByteArray &key)
         return false;
     }
 
-    auto status = atcaRetry(
+    auto status = p->retry(
             std::bind(calib_priv_write, p->atcaDevice, keyId, key.data(), 0, nullptr, nullptr));
     if (status != ATCA_SUCCESS) {
         ERR("{}: slot {}, error {}", __func__, keyId, static_cast<int>(status));
@@ -371,7 +406,7 @@ bool Tpm::writeKey(uint16_t keyId, const ByteArray &key)
 
 bool Tpm::genKey(uint16_t keyId)
 {
-    auto status = atcaRetry(std::bind(calib_genkey, p->atcaDevice, keyId, nullptr));
+    auto status = p->retry(std::bind(calib_genkey, p->atcaDevice, keyId, nullptr));
     if (status != ATCA_SUCCESS) {
         ERR("{}: couldn't generate key on slot {}, error {}", __func__, keyId,
             static_cast<int>(status));
@@ -388,8 +423,8 @@ bool Tpm::writeData(uint16_t slot, const ByteArray &data)
         return false;
     }
 
-    auto status = atcaRetry(std::bind(calib_write_bytes_zone, p->atcaDevice, ATCA_ZONE_DATA, slot,
-                                      0, data.data(), data.size()));
+    auto status = p->retry(std::bind(calib_write_bytes_zone, p->atcaDevice, ATCA_ZONE_DATA, slot, 0,
+                                     data.data(), data.size()));
     if (status != ATCA_SUCCESS) {
         ERR("{}: slot {}, error {}", __func__, slot, static_cast<int>(status));
         return false;
@@ -0,0 +1,210 @@
+/*
+ * Scorbit SDK
+ *
+ * (c) 2025 Spinner Systems, Inc. (DBA Scorbit), scrobit.io, All Rights Reserved
+ *
+ * MIT License
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "tpm/tpm_session.h"
+
+#include <logger/logger.h>
+#include <algorithm>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+// Don't look for a missing device on every command
+constexpr auto REOPEN_AFTER_FAILURE_DELAY = 1s;
+
+} // namespace
+
+TpmSession::TpmSession(TpmBusFlags busFlags, std::string usbDevicePath)
+    : m_busFlags(busFlags)
+    , m_usbDevicePath(std::move(usbDevicePath))
+    , m_thread(&TpmSession::run, this)
+{
+}
+
+TpmSession::~TpmSession()
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_stop = true;
+    }
+    m_cv.notify_all();
+    m_thread.join();
+
+    const auto metrics = this->metrics();
+    DBG("TPM session closed: {} device opens, {} reconnects", metrics.deviceOpens,
+        metrics.reconnects);
+}
+
+bool TpmSession::execute(const std::string &name, const Command &command)
+{
+    std::future<bool> done;
+    {
+        std::lock_guard lock(m_mutex);
+        if (m_stop) {
+            return false;
+        }
+        auto &request = m_queue.emplace_back(Request {name, &command, {}});
+        done = request.done.get_future();
+    }
+    m_cv.notify_one();
+    return done.get();
+}
+
+bool TpmSession::ok()
+{
+    return execute("ok", [](Tpm &tpm) { return tpm.ok(); });
+}
+
+bool TpmSession::readIdentity(uint64_t &serialNumber, ByteArray &uuid)
+{
+    return execute("readIdentity", [&serialNumber, &uuid](Tpm &tpm) {
+        if (!tpm.readIdentity()) {
+            return false;
+        }
+        serialNumber = tpm.serialNumber();
+        uuid = tpm.uuid();
+        return true;
+    });
+}
+
+ByteArray TpmSession::signDigest(uint16_t keyId, const ByteArray &digest)
+{
+    ByteArray signature;
+    execute("signDigest", [&](Tpm &tpm) {
+        signature = tpm.signDigest(keyId, digest);
+        return !signature.empty();
+    });
+    return signature;
+}
+
+ByteArray TpmSession::signMessage(uint16_t keyId, const ByteArray &message)
+{
+    ByteArray signature;
+    execute("signMessage", [&](Tpm &tpm) {
+        signature = tpm.signMessage(keyId, message);
+        return !signature.empty();
+    });
+    return signature;
+}
+
+TpmSessionMetrics TpmSession::metrics() const
+{
+    std::lock_guard lock(m_metricsMutex);
+    return m_metrics;
+}
+
+void TpmSession::run()
+{
+    std::unique_lock lock(m_mutex);
+    while (true) {
+        m_cv.wait(lock, [this] { return m_stop || !m_queue.empty(); });
+        if (m_queue.empty()) {
+            break; // Stopped and drained
+        }
+
+        auto request = std::move(m_queue.front());
+        m_queue.pop_front();
+
+        lock.unlock();
+        request.done.set_value(process(request));
+        lock.lock();
+    }
+
+    m_tpm.reset();
+}
+
+bool TpmSession::process(const Request &request)
+{
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        if (!m_tpm && !open()) {
+            return false;
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        const bool ok = (*request.command)(*m_tpm);
+        record(request.name, std::chrono::steady_clock::now() - start, ok);
+        if (ok) {
+            return true;
+        }
+
+        // A rejected command (locked slot, bad key id...) fails the same way on a new connection
+        const int status = m_tpm->lastStatus();
+        if (!Tpm::isCommunicationError(status)) {
+            return false;
+        }
+
+        if (attempt == 0) {
+            // The device may have been reset or unplugged, open it again and retry once
+            WRN("TPM {} failed with error {}, reconnecting", request.name, status);
+            m_tpm.reset();
+            std::lock_guard lock(m_metricsMutex);
+            ++m_metrics.reconnects;
+        }
+    }
+    return false;
+}
+
+bool TpmSession::open()
+{
+    const auto now = std::chrono::steady_clock::now();
+    if (m_lastOpenFailure.time_since_epoch().count() != 0
+        && now - m_lastOpenFailure < REOPEN_AFTER_FAILURE_DELAY) {
+        return false;
+    }
+
+    // The device found before is tried first, discovery on all buses is slow
+    auto tpm = m_device.isValid() ? std::make_unique<Tpm>(m_device)
+                                  : std::make_unique<Tpm>(m_busFlags, m_usbDevicePath);
+    if (!tpm->ok() && m_device.isValid()) {
+        tpm = std::make_unique<Tpm>(m_busFlags, m_usbDevicePath);
+    }
+
+    const bool ok = tpm->ok();
+    record("open", std::chrono::steady_clock::now() - now, ok);
+    {
+        std::lock_guard lock(m_metricsMutex);
+        ++(ok ? m_metrics.deviceOpens : m_metrics.openFailures);
+    }
+
+    if (!ok) {
+        m_lastOpenFailure = std::chrono::steady_clock::now();
+        return false;
+    }
+
+    m_lastOpenFailure = {};
+    m_device = tpm->device();
+    m_tpm = std::move(tpm);
+    return true;
+}
+
+void TpmSession::record(const std::string &name, std::chrono::steady_clock::duration elapsed,
+                        bool ok)
+{
+    const auto us = std::chrono::duration_cast<std::chrono::microseconds>(elapsed);
+
+    std::lock_guard lock(m_metricsMutex);
+    auto &stats = m_metrics.ops[name];
+    ++stats.count;
+    if (!ok) {
+        ++stats.failures;
+    }
+    stats.total += us;
+    stats.max = std::max(stats.max, us);
+}
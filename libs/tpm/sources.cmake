@@ -3,6 +3,7 @@ set(headers
     include/tpm/itpm.h
     include/tpm/softwaretpm.h
     include/tpm/tpm.h
+    include/tpm/tpm_session.h
     include/tpm/crypto_helpers.h
 )
 
@@ -10,6 +11,7 @@ set(sources
     source/hardwaretpm.cpp
     source/softwaretpm.cpp
     source/tpm.cpp
+    source/tpm_session.cpp
     source/crypto_helpers.cpp
     source/crypto_utils.h
     source/crypto_utils.cpp
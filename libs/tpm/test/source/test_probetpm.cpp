@@ -1,5 +1,6 @@
 #include <doctest/doctest.h>
 #include <tpm/tpm.h>
+#include <tpm/tpm_session.h>
 #include <tpm/crypto_helpers.h>
 #include <utils/bytearray.h>
 #include <nlohmann/json.hpp>
@@ -54,4 +55,21 @@ TEST_SUITE("ProbeTpm Basic Tests")
 		CHECK(data.size()==128);
 		printf("-----------------------------------------\n");
     }
+
+    TEST_CASE("ProbeTpm session keeps the device open")
+    {
+        TpmSession session(TpmBus::All);
+        for (int i = 0; i < 10; ++i) {
+            CHECK(session.signDigest(KEY4_SLOT, ByteArray(32, static_cast<uint8_t>(i))).size()
+                  == 64);
+        }
+
+        const auto metrics = session.metrics();
+        CHECK(metrics.deviceOpens == 1);
+        const auto &sign = metrics.ops.at("signDigest");
+        printf("open: %lld us, sign: %lld us avg, %lld us max\n",
+               static_cast<long long>(metrics.ops.at("open").total.count()),
+               static_cast<long long>(sign.total.count() / sign.count),
+               static_cast<long long>(sign.max.count()));
+    }
 }
@@ -0,0 +1,74 @@
+#include <doctest/doctest.h>
+#include <tpm/tpm_session.h>
+#include <utils/bytearray.h>
+#include <atca_status.h>
+
+#include <thread>
+#include <vector>
+
+using ByteArray = utils::ByteArray;
+
+// ============================================================================
+// TpmSession Tests (no device attached)
+// ============================================================================
+
+TEST_SUITE("TpmSession Tests")
+{
+    TEST_CASE("TpmSession fails commands without a device")
+    {
+        TpmSession session(TpmBus::None);
+
+        CHECK_FALSE(session.ok());
+        CHECK(session.signDigest(KEY4_SLOT, ByteArray(32, 0x42)).empty());
+
+        uint64_t serial = 0;
+        ByteArray uuid;
+        CHECK_FALSE(session.readIdentity(serial, uuid));
+
+        bool ran = false;
+        CHECK_FALSE(session.execute("custom", [&ran](Tpm &) { return ran = true; }));
+        CHECK_FALSE(ran);
+
+        const auto metrics = session.metrics();
+        CHECK(metrics.deviceOpens == 0);
+        CHECK(metrics.openFailures >= 1);
+        CHECK(metrics.ops.count("signDigest") == 0);
+    }
+
+    TEST_CASE("TpmSession throttles opening a missing device")
+    {
+        TpmSession session(TpmBus::None);
+
+        std::vector<std::thread> threads;
+        for (int i = 0; i < 8; ++i) {
+            threads.emplace_back([&session] {
+                for (int n = 0; n < 10; ++n) {
+                    CHECK(session.signDigest(KEY4_SLOT, ByteArray(32, 0x42)).empty());
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+
+        // 80 commands, but the bus is only probed again after the reopen delay
+        const auto metrics = session.metrics();
+        CHECK(metrics.deviceOpens == 0);
+        CHECK(metrics.openFailures <= 2);
+        CHECK(metrics.ops.at("open").count == metrics.openFailures);
+    }
+
+    TEST_CASE("TpmSession reconnects only on communication errors")
+    {
+        CHECK(Tpm::isCommunicationError(ATCA_COMM_FAIL));
+        CHECK(Tpm::isCommunicationError(ATCA_WAKE_FAILED));
+        CHECK(Tpm::isCommunicationError(ATCA_RX_NO_RESPONSE));
+        CHECK(Tpm::isCommunicationError(ATCA_TOO_MANY_COMM_RETRIES));
+
+        // Errors reported by the device itself would fail the same way after a reconnect
+        CHECK_FALSE(Tpm::isCommunicationError(ATCA_SUCCESS));
+        CHECK_FALSE(Tpm::isCommunicationError(ATCA_EXECUTION_ERROR));
+        CHECK_FALSE(Tpm::isCommunicationError(ATCA_BAD_PARAM));
+        CHECK_FALSE(Tpm::isCommunicationError(ATCA_NOT_LOCKED));
+    }
+}
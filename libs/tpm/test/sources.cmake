@@ -3,5 +3,6 @@ set(sources
     source/test_crypto_helpers.cpp
     source/test_crypto_utils.cpp
     source/test_softwaretpm.cpp
+    source/test_tpm_session.cpp
     source/test_probetpm.cpp
 )
@@ -0,0 +1,272 @@
+/*
+ * Scorbit SDK
+ *
+ * (c) 2025 Spinner Systems, Inc. (DBA Scorbit), scrobit.io, All Rights Reserved
+ *
+ * MIT License
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "boot_sequence.h"
+
+#include <logger/logger.h>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <limits>
+#include <optional>
+
+namespace scorbit {
+namespace detail {
+
+namespace {
+
+constexpr size_t NOT_FOUND = std::numeric_limits<size_t>::max();
+
+const char *resultName(BootStepTiming::Result result)
+{
+    switch (result) {
+    case BootStepTiming::Result::Pending:
+        return "pending";
+    case BootStepTiming::Result::Ok:
+        return "done";
+    case BootStepTiming::Result::Failed:
+        return "failed";
+    case BootStepTiming::Result::Skipped:
+        return "skipped";
+    }
+    return "unknown";
+}
+
+std::chrono::milliseconds toMs(std::chrono::steady_clock::duration duration)
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(duration);
+}
+
+} // namespace
+
+BootSequence::BootSequence(Executor executor)
+    : m_executor(std::move(executor))
+{
+}
+
+bool BootSequence::add(std::string name, std::vector<std::string> after, Step step,
+                       bool evenIfFailed)
+{
+    std::lock_guard lock(m_mutex);
+    if (m_started || indexOf(name) != NOT_FOUND) {
+        return false;
+    }
+
+    std::vector<size_t> dependencies;
+    for (const auto &dependency : after) {
+        const auto index = indexOf(dependency);
+        if (index == NOT_FOUND) {
+            return false;
+        }
+        dependencies.push_back(index);
+    }
+
+    const auto index = m_nodes.size();
+    Node node;
+    node.step = std::move(step);
+    node.evenIfFailed = evenIfFailed;
+    for (const auto dependency : dependencies) {
+        const auto result = m_metrics.steps[dependency].result;
+        if (result == BootStepTiming::Result::Pending) {
+            ++node.pendingDependencies;
+            m_nodes[dependency].dependents.push_back(index);
+        } else if (result != BootStepTiming::Result::Ok && !evenIfFailed) {
+            node.dependencyFailed = true;
+        }
+    }
+
+    m_nodes.push_back(std::move(node));
+    m_metrics.steps.push_back(BootStepTiming {.name = std::move(name)});
+    return true;
+}
+
+bool BootSequence::addFinished(std::string name, std::chrono::steady_clock::time_point startedAt,
+                               bool ok)
+{
+    std::lock_guard lock(m_mutex);
+    if (m_started || indexOf(name) != NOT_FOUND) {
+        return false;
+    }
+
+    Node node;
+    node.startedAt = startedAt;
+    m_nodes.push_back(std::move(node));
+    m_metrics.steps.push_back(BootStepTiming {
+            .name = std::move(name),
+            .duration = toMs(std::chrono::steady_clock::now() - startedAt),
+            .result = ok ? BootStepTiming::Result::Ok : BootStepTiming::Result::Failed,
+    });
+    ++m_finished;
+    return true;
+}
+
+void BootSequence::start(ReadyCallback onReady)
+{
+    std::vector<size_t> toLaunch;
+    std::vector<size_t> toSkip;
+    std::optional<BootMetrics> ready;
+    {
+        std::lock_guard lock(m_mutex);
+        if (m_started) {
+            return;
+        }
+        m_started = true;
+        m_onReady = std::move(onReady);
+
+        // Steps finished before start are part of the boot too
+        m_startedAt = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < m_nodes.size(); ++i) {
+            if (m_metrics.steps[i].result != BootStepTiming::Result::Pending) {
+                m_startedAt = std::min(m_startedAt, m_nodes[i].startedAt);
+            }
+        }
+
+        for (size_t i = 0; i < m_nodes.size(); ++i) {
+            auto &timing = m_metrics.steps[i];
+            if (timing.result != BootStepTiming::Result::Pending) {
+                timing.startedAt = toMs(m_nodes[i].startedAt - m_startedAt);
+            } else if (m_nodes[i].pendingDependencies == 0) {
+                (m_nodes[i].dependencyFailed ? toSkip : toLaunch).push_back(i);
+            }
+        }
+
+        if (m_finished == m_nodes.size()) {
+            m_metrics.ready = true;
+            m_metrics.timeToReady = toMs(std::chrono::steady_clock::now() - m_startedAt);
+            ready = m_metrics;
+        }
+    }
+
+    for (const auto index : toLaunch) {
+        launch(index);
+    }
+    for (const auto index : toSkip) {
+        finish(index, BootStepTiming::Result::Skipped);
+    }
+    if (ready && m_onReady) {
+        m_onReady(*ready);
+    }
+}
+
+BootMetrics BootSequence::metrics() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_metrics;
+}
+
+size_t BootSequence::indexOf(const std::string &name) const
+{
+    const auto it = std::find_if(m_metrics.steps.cbegin(), m_metrics.steps.cend(),
+                                 [&name](const auto &step) { return step.name == name; });
+    return it == m_metrics.steps.cend() ? NOT_FOUND
+                                        : static_cast<size_t>(it - m_metrics.steps.cbegin());
+}
+
+void BootSequence::launch(size_t index)
+{
+    Step step;
+    {
+        std::lock_guard lock(m_mutex);
+        auto &node = m_nodes[index];
+        node.startedAt = std::chrono::steady_clock::now();
+        m_metrics.steps[index].startedAt = toMs(node.startedAt - m_startedAt);
+        step = std::move(node.step);
+    }
+
+    m_executor([self = shared_from_this(), index, step = std::move(step)] {
+        auto called = std::make_shared<std::atomic_bool>(false);
+        Done done = [self, index, called](bool ok) {
+            if (!called->exchange(true)) {
+                self->finish(index, ok ? BootStepTiming::Result::Ok
+                                       : BootStepTiming::Result::Failed);
+            }
+        };
+
+        try {
+            step(done);
+        } catch (const std::exception &e) {
+            ERR("Boot step {} threw: {}", self->metrics().steps[index].name, e.what());
+            done(false);
+        }
+    });
+}
+
+void BootSequence::finish(size_t index, BootStepTiming::Result result)
+{
+    std::vector<size_t> toLaunch;
+    std::vector<size_t> toSkip;
+    std::optional<BootMetrics> ready;
+    {
+        std::lock_guard lock(m_mutex);
+        const auto now = std::chrono::steady_clock::now();
+        auto &timing = m_metrics.steps[index];
+        timing.result = result;
+        if (result == BootStepTiming::Result::Skipped) {
+            timing.startedAt = toMs(now - m_startedAt);
+        } else {
+            timing.duration = toMs(now - m_nodes[index].startedAt);
+        }
+        INF("Boot step {} {} in {} ms", timing.name, resultName(result), timing.duration.count());
+
+        for (const auto dependent : m_nodes[index].dependents) {
+            auto &node = m_nodes[dependent];
+            if (result != BootStepTiming::Result::Ok && !node.evenIfFailed) {
+                node.dependencyFailed = true;
+            }
+            if (--node.pendingDependencies == 0) {
+                (node.dependencyFailed ? toSkip : toLaunch).push_back(dependent);
+            }
+        }
+
+        if (++m_finished == m_nodes.size()) {
+            m_metrics.ready = true;
+            m_metrics.timeToReady = toMs(now - m_startedAt);
+            ready = m_metrics;
+        }
+    }
+
+    for (const auto dependent : toLaunch) {
+        launch(dependent);
+    }
+    for (const auto dependent : toSkip) {
+        finish(dependent, BootStepTiming::Result::Skipped);
+    }
+    if (ready && m_onReady) {
+        m_onReady(*ready);
+    }
+}
+
+std::shared_ptr<BootSequence> makeConnectionBoot(
+        BootSequence::Executor executor, std::chrono::steady_clock::time_point authStartedAt,
+        ConnectionSteps steps)
+{
+    auto boot = std::make_shared<BootSequence>(std::move(executor));
+    boot->addFinished("auth", authStartedAt);
+    boot->add("scorbitron_object", {"auth"}, std::move(steps.scorbitronObject));
+    boot->add("cf_token", {"auth"}, std::move(steps.cfToken));
+    boot->add("config", {"auth"}, std::move(steps.config));
+    boot->add("nfc_nonces", {"auth"}, std::move(steps.nfcNonces));
+    boot->add("machine_object", {"scorbitron_object"}, std::move(steps.machineObject));
+    boot->add("release_track", {"scorbitron_object"}, std::move(steps.releaseTrack));
+    boot->add("centrifugo", {"cf_token"}, std::move(steps.centrifugo), true);
+    return boot;
+}
+
+} // namespace detail
+} // namespace scorbit
@@ -0,0 +1,135 @@
+/*
+ * Scorbit SDK
+ *
+ * (c) 2025 Spinner Systems, Inc. (DBA Scorbit), scrobit.io, All Rights Reserved
+ *
+ * MIT License
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace scorbit {
+namespace detail {
+
+struct BootStepTiming {
+    enum class Result {
+        Pending,
+        Ok,
+        Failed,
+        Skipped, // One of the steps it depends on didn't succeed
+    };
+
+    std::string name;
+    std::chrono::milliseconds startedAt {0}; // Since the boot started
+    std::chrono::milliseconds duration {0};
+    Result result {Result::Pending};
+};
+
+struct BootMetrics {
+    bool ready {false};
+    std::chrono::milliseconds timeToReady {0}; // Until the last step finished
+    std::vector<BootStepTiming> steps;          // In the order they were added
+};
+
+/**
+ * @brief Startup work as a graph of steps, each starts as soon as the steps it depends on
+ * succeeded.
+ *
+ * Steps are asynchronous: the step function gets a done callback and calls it exactly once when
+ * its work, e.g. HTTP reply, is finished. Independent steps run concurrently on the executor.
+ * If a step fails, the steps depending on it are skipped, unless they were added to run anyway. Steps must be added before start(),
+ * dependencies before their dependents, so the graph can't have cycles.
+ */
+class BootSequence : public std::enable_shared_from_this<BootSequence>
+{
+public:
+    using Done = std::function<void(bool ok)>;
+    using Step = std::function<void(Done done)>;
+    using Executor = std::function<void(std::function<void()> task)>;
+    using ReadyCallback = std::function<void(const BootMetrics &metrics)>;
+
+    explicit BootSequence(Executor executor);
+
+    /**
+     * @param evenIfFailed Run the step once @p after finished, whether they succeeded or not
+     * @return false if the name is taken or a dependency is unknown, the step is not added then
+     */
+    bool add(std::string name, std::vector<std::string> after, Step step,
+             bool evenIfFailed = false);
+
+    /// Add a step which already ran, e.g. authentication, so it's timed with the others
+    bool addFinished(std::string name, std::chrono::steady_clock::time_point startedAt,
+                     bool ok = true);
+
+    void start(ReadyCallback onReady = {});
+
+    BootMetrics metrics() const;
+
+private:
+    struct Node {
+        Step step;
+        std::vector<size_t> dependents;
+        size_t pendingDependencies {0};
+        bool dependencyFailed {false};
+        bool evenIfFailed {false};
+        std::chrono::steady_clock::time_point startedAt;
+    };
+
+    size_t indexOf(const std::string &name) const;
+    void launch(size_t index);
+    void finish(size_t index, BootStepTiming::Result result);
+
+    Executor m_executor;
+    ReadyCallback m_onReady;
+
+    mutable std::mutex m_mutex;
+    std::vector<Node> m_nodes;
+    BootMetrics m_metrics;
+    std::chrono::steady_clock::time_point m_startedAt;
+    size_t m_finished {0};
+    bool m_started {false};
+};
+
+/// Requests made once the machine is authenticated, one step each
+struct ConnectionSteps {
+    BootSequence::Step scorbitronObject; // Tells pairing status and release track url
+    BootSequence::Step cfToken;
+    BootSequence::Step config;
+    BootSequence::Step machineObject;
+    BootSequence::Step releaseTrack;
+    BootSequence::Step nfcNonces;
+    BootSequence::Step centrifugo;
+};
+
+/**
+ * @brief Build the graph Net runs after authentication, not started yet.
+ *
+ * Only machine object and release track need the Scorbitron object reply, the other requests
+ * start right after authentication. Centrifugo is started after the token fetch even if it
+ * failed, the client fetches a token itself then. NFC nonces request waits for the pairing status itself, the
+ * tag needs the machine uuid, so a failed Scorbitron object doesn't skip it.
+ */
+std::shared_ptr<BootSequence> makeConnectionBoot(
+        BootSequence::Executor executor, std::chrono::steady_clock::time_point authStartedAt,
+        ConnectionSteps steps);
+
+} // namespace detail
+} // namespace scorbit
@@ -18,6 +18,7 @@
  */
 
 #include "device_info.h"
+#include <algorithm>
 #include <new>
 #include <vector>
 
@@ -87,6 +88,71 @@ void sb_config_set_auto_download_player_pics(sb_config_t config, bool enable)
     }
 }
 
+void sb_config_set_picture_cache_dir(sb_config_t config, const char *dir)
+{
+    if (config) {
+        config->pictureCacheDir = dir ? dir : std::string {};
+    }
+}
+
+void sb_config_set_leaderboard_cache_ttl(sb_config_t config, int ttl_seconds, int stale_seconds)
+{
+    if (config) {
+        config->leaderboardCacheTtl = std::max(ttl_seconds, 0);
+        config->leaderboardCacheStaleWindow = std::max(stale_seconds, 0);
+    }
+}
+
+void sb_config_set_leaderboard_prefetch(sb_config_t config, const sb_leaderboard_query_t *queries,
+                                        size_t count, int idle_interval_seconds)
+{
+    if (!config) {
+        return;
+    }
+
+    config->leaderboardPrefetch.clear();
+    for (size_t i = 0; queries && i < count; ++i) {
+        const auto &query = queries[i];
+        config->leaderboardPrefetch.push_back(
+                {static_cast<scorbit::LeaderboardScope>(query.scope),
+                 static_cast<scorbit::LeaderboardPeriod>(query.period),
+                 query.since ? query.since : std::string {},
+                 static_cast<scorbit::LeaderboardVpinFilter>(query.vpin_filter)});
+    }
+    config->leaderboardPrefetchInterval = std::max(idle_interval_seconds, 0);
+}
+
+void sb_config_set_local_scores_path(sb_config_t config, const char *path)
+{
+    if (config) {
+        config->localScoresPath = path ? path : std::string {};
+    }
+}
+
+void sb_config_set_flight_recorder_path(sb_config_t config, const char *path)
+{
+    if (config) {
+        config->flightRecorderPath = path ? path : std::string {};
+    }
+}
+
+void sb_config_set_warm_start_cache_path(sb_config_t config, const char *path)
+{
+    if (config) {
+        config->warmStartCachePath = path ? path : std::string {};
+    }
+}
+
+void sb_config_set_diagnostics_archive(sb_config_t config,
+                                       sb_diagnostics_compression_t compression, int level,
+                                       int threads, bool stream_upload)
+{
+    if (config) {
+        config->diagnosticsArchive = {static_cast<scorbit::DiagnosticsCompression>(compression),
+                                      std::max(level, 0), std::max(threads, 1), stream_upload};
+    }
+}
+
 void sb_config_set_threads_priority(sb_config_t config, int priority)
 {
     if (config) {
@@ -121,6 +187,13 @@ void sb_config_set_encrypted_key(sb_config_t config, const char *encrypted_key)
     }
 }
 
+void sb_config_set_signing_key_cache_ttl(sb_config_t config, int ttl_seconds)
+{
+    if (config) {
+        config->signingKeyCacheTtl = std::max(ttl_seconds, 0);
+    }
+}
+
 void sb_config_set_signer(sb_config_t config, sb_signer_callback_t signer, void *user_data)
 {
     if (config) {
@@ -174,6 +247,19 @@ void sb_config_set_event_callback(sb_config_t config, sb_event_callback_t callba
     }
 }
 
+void sb_config_add_control_handler(sb_config_t config, const char *type, const char *method,
+                                   const char *action, sb_control_message_callback_t callback,
+                                   void *user_data)
+{
+    if (config && type && *type && callback) {
+        config->controlHandlers.push_back(
+                {type, method ? method : "", action ? action : "",
+                 [callback, user_data](const std::string &type, const std::string &payload) {
+                     callback(type.c_str(), payload.c_str(), user_data);
+                 }});
+    }
+}
+
 void sb_config_set_save_key_callback(sb_config_t config, sb_save_key_callback_t callback,
                                      void *user_data)
 {
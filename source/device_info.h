@@ -23,6 +23,7 @@
 #include <scorbit_sdk/event.h>
 #include <scorbit_sdk/net_types.h>
 #include "event_classes.h"
+#include "leaderboard_internal.h"
 #include <functional>
 #include <memory>
 #include <string>
@@ -30,6 +31,25 @@
 
 namespace scorbit {
 
+namespace detail {
+
+/// Integrator handler of control channel messages, see sb_config_add_control_handler
+struct ControlHandler {
+    std::string type;
+    std::string method; // Empty - any
+    std::string action; // Empty - any
+    std::function<void(const std::string &type, const std::string &payload)> callback;
+};
+
+struct DiagnosticsArchive {
+    DiagnosticsCompression compression {DiagnosticsCompression::Gzip};
+    int level {0};             // 0 - default of the compression
+    int threads {1};           // Zstd only
+    bool streamUpload {false}; // Upload while archiving, no temporary file
+};
+
+} // namespace detail
+
 /**
  * Internal DeviceInfo structure.
  *
@@ -48,6 +68,15 @@ struct DeviceInfo {
     std::string uuid;
     uint64_t serialNumber {0};
     bool autoDownloadPlayerPics {false};
+    std::string pictureCacheDir; // Persist downloaded player pictures here, empty - memory only
+    int leaderboardCacheTtl {30};          // Seconds leaderboard is served without request
+    int leaderboardCacheStaleWindow {300}; // Seconds stale one is served while revalidated
+    std::vector<detail::LeaderboardQuery> leaderboardPrefetch; // Refreshed after each game
+    int leaderboardPrefetchInterval {0}; // Seconds between idle refreshes, 0 - after game only
+    std::string localScoresPath; // Keep final scores played here for local leaderboards
+    std::string flightRecorderPath; // Ring file of recent logs and events, survives crashes
+    std::string warmStartCachePath; // Machine state of the last run, served until revalidated
+    detail::DiagnosticsArchive diagnosticsArchive;
     std::vector<std::string> scoreFeatures;
     int scoreFeaturesVersion {0};
 
@@ -56,6 +85,7 @@ struct DeviceInfo {
 
     // Authentication - one of these must be set
     std::string encryptedKey;
+    int signingKeyCacheTtl {300}; // Seconds parsed soft key is kept after last use, 0 - not kept
     sb_signer_callback_t signerCallback {nullptr};
     void *signerUserData {nullptr};
 
@@ -68,6 +98,9 @@ struct DeviceInfo {
     // Event callback - stored here and passed to EventManager
     detail::EventCallback m_eventCallback;
 
+    // Custom control channel messages, registered after the SDK ones
+    std::vector<detail::ControlHandler> controlHandlers;
+
     // Key persistence callbacks - stored as std::function (similar to m_eventCallback)
     SaveKeyCallback saveKeyCallback;
     LoadKeyCallback loadKeyCallback;
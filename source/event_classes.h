@@ -239,7 +239,8 @@ private:
 class PlayerPictureReadyEvent : public EventBase
 {
 public:
-    explicit PlayerPictureReadyEvent(sb_player_t player, std::vector<uint8_t> picture)
+    /// Picture is shared with the pictures cache, not copied
+    explicit PlayerPictureReadyEvent(sb_player_t player, PicturePtr picture)
         : EventBase(EventType::PlayerPictureReady, EventPriority::Normal)
         , m_player {player}
         , m_picture {std::move(picture)}
@@ -247,12 +248,12 @@ public:
     }
 
     auto player() const -> sb_player_t { return m_player; }
-    auto pictureData() const -> const uint8_t * { return m_picture.data(); }
-    auto pictureSize() const -> size_t { return m_picture.size(); }
+    auto pictureData() const -> const uint8_t * { return m_picture ? m_picture->data() : nullptr; }
+    auto pictureSize() const -> size_t { return m_picture ? m_picture->size() : 0; }
 
 private:
     sb_player_t m_player;
-    std::vector<uint8_t> m_picture;
+    PicturePtr m_picture;
 };
 
 // ---------------- DiagnosticsUploadRequested implementation ----------------
@@ -0,0 +1,517 @@
+/*
+ * Scorbit SDK
+ *
+ * (c) 2025 Spinner Systems, Inc. (DBA Scorbit), scrobit.io, All Rights Reserved
+ *
+ * MIT License
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "file_downloader.h"
+#include "identifiers.h"
+#include <logger/logger.h>
+#include <fmt/format.h>
+#include <boost/filesystem.hpp>
+#include <algorithm>
+#include <fstream>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace fs = boost::filesystem;
+
+namespace scorbit {
+namespace detail {
+
+constexpr auto DOWNLOAD_PART_EXT = ".part";
+constexpr auto DOWNLOAD_VALIDATOR_EXT = ".validator"; // ETag/Last-Modified for If-Range on resume
+constexpr int64_t DOWNLOAD_SEGMENT_MIN_SIZE = 4 * 1024 * 1024; // Don't split smaller files
+constexpr int DOWNLOAD_MAX_SEGMENTS = 4;
+constexpr size_t DOWNLOAD_HASH_BLOCK_SIZE = 64 * 1024;
+constexpr size_t DOWNLOAD_ERROR_BODY_LIMIT = 4 * 1024; // Keep only the head of error replies
+
+namespace {
+
+std::string readTextFile(const std::string &path)
+{
+    std::ifstream file(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+void writeTextFile(const std::string &path, const std::string &text)
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << text;
+}
+
+/// Feed @p length bytes of @p path from @p offset, @return false if they can't be read
+bool hashFileRange(Sha256Stream &hasher, const std::string &path, int64_t offset, int64_t length)
+{
+    std::ifstream file(path, std::ios::binary);
+    file.seekg(offset);
+    std::vector<char> buffer(DOWNLOAD_HASH_BLOCK_SIZE);
+    while (length > 0 && file) {
+        const auto n = std::min<int64_t>(length, static_cast<int64_t>(buffer.size()));
+        file.read(buffer.data(), static_cast<std::streamsize>(n));
+        hasher.update(buffer.data(), static_cast<size_t>(file.gcount()));
+        length -= file.gcount();
+    }
+    return length == 0;
+}
+
+/// Response headers which tell whether the body continues what was received
+struct RangeReply {
+    int status {0};
+    std::string etag;
+    std::string lastModified;
+    std::optional<ContentRange> contentRange;
+
+    void onHeaderLine(std::string_view line)
+    {
+        if (const auto code = parseHttpStatusLine(line)) {
+            // Next response in chain (redirect, 100-continue), forget previous headers
+            *this = {};
+            status = code;
+        } else if (const auto header = parseHttpHeaderLine(line)) {
+            const auto &[key, value] = *header;
+            if (key == "etag" && !value.starts_with("W/")) {
+                etag = value; // Weak ETag can't be used in If-Range
+            } else if (key == "last-modified") {
+                lastModified = value;
+            } else if (key == "content-range") {
+                contentRange = parseContentRange(value);
+            }
+        }
+    }
+
+    const std::string &validator() const { return etag.empty() ? lastModified : etag; }
+};
+
+} // namespace
+
+FileDownloader::FileDownloader(cpr::SslOptions sslOptions, Limits limits)
+    : m_sslOptions(std::move(sslOptions))
+    , m_limits(limits)
+{
+}
+
+std::pair<Error, int> FileDownloader::download(const std::string &url, const std::string &filename,
+                                               const MakeHeaders &makeHeaders,
+                                               const DownloadOptions &options) const
+{
+    Error error {Error::ApiError};
+    int statusCode = 0;
+
+    const auto elidedUrl = elideUrl(url);
+    const auto partFile = filename + DOWNLOAD_PART_EXT;
+    const auto removePartial = [&partFile]() {
+        boost::system::error_code ec;
+        fs::remove(partFile, ec);
+        fs::remove(partFile + DOWNLOAD_VALIDATOR_EXT, ec);
+    };
+
+    if (!options.keepPartial) {
+        removePartial();
+    }
+
+    Sha256Stream hasher;
+    bool downloaded = false;
+
+    if (options.segments > 1 && options.expectedSize >= DOWNLOAD_SEGMENT_MIN_SIZE) {
+        boost::system::error_code ec;
+        const auto partSize = fs::file_size(partFile, ec);
+        if (!ec && partSize > 0) {
+            // Segments would start over, continuing in one stream keeps what was received
+            INF("API Download file: partial file of {} bytes found, not splitting: {}", partSize,
+                elidedUrl);
+        } else {
+            std::tie(error, statusCode) =
+                    downloadSegmented(url, partFile, makeHeaders, options, hasher);
+            downloaded = error == Error::Success;
+            if (!downloaded) {
+                WRN("API Download file: segmented download failed, code={}, falling back to "
+                    "single stream: {}",
+                    statusCode, elidedUrl);
+            }
+        }
+    }
+
+    if (!downloaded) {
+        // Failed segmented download leaves the head of the file to continue from
+        boost::system::error_code ec;
+        const bool resume = options.keepPartial || fs::exists(partFile, ec);
+        std::tie(error, statusCode) =
+                downloadResumable(url, partFile, makeHeaders, resume, hasher);
+    }
+
+    if (error == Error::Success && options.expectedSize >= 0
+        && hasher.size() != static_cast<uint64_t>(options.expectedSize)) {
+        ERR("API Download file: size mismatch, expected: {}, got: {}, url: {}",
+            options.expectedSize, hasher.size(), elidedUrl);
+        error = Error::FileError;
+    }
+
+    if (error == Error::Success && !options.expectedSha256.empty()) {
+        const auto digest = hasher.hexDigest();
+        if (sha256Matches(digest, options.expectedSha256)) {
+            DBG("API Download file: sha256 ok, {}", digest);
+        } else {
+            ERR("API Download file: sha256 mismatch, expected: {}, got: {}, url: {}",
+                options.expectedSha256, digest, elidedUrl);
+            error = Error::FileError;
+        }
+    }
+
+    if (error == Error::Success) {
+        boost::system::error_code ec;
+        fs::rename(partFile, filename, ec);
+        if (ec) {
+            ERR("API Download file: can't move {} to {}: {}", partFile, filename, ec.message());
+            error = Error::FileError;
+        }
+    }
+
+    // Partial file is worth keeping only if transfer was interrupted, not if it's corrupted
+    if (error != Error::ApiError || !options.keepPartial) {
+        removePartial();
+    }
+
+    return {error, statusCode};
+}
+
+std::pair<Error, int> FileDownloader::downloadResumable(const std::string &url,
+                                                        const std::string &partFile,
+                                                        const MakeHeaders &makeHeaders,
+                                                        bool resumeExisting,
+                                                        Sha256Stream &hasher) const
+{
+    const auto elidedUrl = elideUrl(url);
+    const auto validatorFile = partFile + DOWNLOAD_VALIDATOR_EXT;
+
+    int64_t offset = 0;
+    std::string validator; // ETag or Last-Modified of the partially downloaded file
+
+    hasher.reset();
+    if (resumeExisting) {
+        boost::system::error_code ec;
+        const auto size = fs::file_size(partFile, ec);
+        validator = readTextFile(validatorFile);
+
+        // Without validator we can't be sure the file on server is the same, start over
+        if (!ec && size > 0 && !validator.empty() && hasher.updateFromFile(partFile)) {
+            offset = static_cast<int64_t>(size);
+            INF("API Download file: resuming from {} bytes: {}", offset, elidedUrl);
+        } else {
+            hasher.reset();
+            validator.clear();
+        }
+    }
+
+    std::ofstream file(partFile, std::ios::binary | (offset > 0 ? std::ios::app : std::ios::trunc));
+    if (!file.is_open()) {
+        ERR("API Can't open file for writing: {}", partFile);
+        return {Error::FileError, 0};
+    }
+
+    const auto restartFromScratch = [&]() {
+        file.close();
+        file.open(partFile, std::ios::binary | std::ios::trunc);
+        hasher.reset();
+        offset = 0;
+        validator.clear();
+        boost::system::error_code ec;
+        fs::remove(validatorFile, ec);
+    };
+
+    Error error {Error::ApiError};
+    int statusCode = 0;
+
+    for (int i = 0; i < m_limits.retries && file.is_open(); ++i) {
+        auto headers = makeHeaders();
+        if (offset > 0) {
+            headers[HDR_KEY_RANGE] = rangeHeaderFrom(offset);
+            // Server without validators: size and sha256 checks are what catches a changed file
+            if (!validator.empty()) {
+                headers[HDR_KEY_IF_RANGE] = validator;
+            }
+        }
+
+        INF("API Download file: {}", elidedUrl);
+
+        RangeReply reply;
+        bool bodyChecked = false;
+        bool bodyAccepted = false;
+        std::string errorBody;
+
+        auto onHeader = [&reply](std::string_view line, intptr_t) {
+            reply.onHeaderLine(line);
+            return true;
+        };
+
+        auto onWrite = [&](std::string_view data, intptr_t) {
+            if (!bodyChecked) {
+                bodyChecked = true;
+                if (reply.status == 206 && reply.contentRange
+                    && reply.contentRange->first == offset) {
+                    bodyAccepted = true;
+                } else if (reply.status == 200) {
+                    if (offset > 0) {
+                        INF("API Download file: got whole file instead of range, restarting: {}",
+                            elidedUrl);
+                        restartFromScratch();
+                    }
+                    bodyAccepted = true;
+                }
+
+                if (bodyAccepted && reply.validator() != validator) {
+                    validator = reply.validator();
+                    writeTextFile(validatorFile, validator);
+                }
+            }
+
+            if (!bodyAccepted) {
+                // Keep the head for the log, don't pull the rest of what may be a whole file
+                errorBody.append(data.substr(0, DOWNLOAD_ERROR_BODY_LIMIT - errorBody.size()));
+                return errorBody.size() < DOWNLOAD_ERROR_BODY_LIMIT;
+            }
+
+            file.write(data.data(), static_cast<std::streamsize>(data.size()));
+            if (!file) {
+                ERR("API Download file: write failed: {}", partFile);
+                return false; // Abort transfer
+            }
+            hasher.update(data);
+            offset += static_cast<int64_t>(data.size());
+            return true;
+        };
+
+        auto r = cpr::Download(cpr::WriteCallback {onWrite}, cpr::Url {url},
+                               cpr::HeaderCallback {onHeader}, cpr::Timeout {m_limits.transferTimeout},
+                               cpr::ConnectTimeout {m_limits.connectTimeout},
+                               cpr::LowSpeed {m_limits.lowSpeedBps, m_limits.lowSpeedStallTime},
+                               headers, m_sslOptions);
+        file.flush();
+        statusCode = reply.status != 0 ? reply.status : static_cast<int>(r.status_code);
+
+        if (!file) {
+            error = Error::FileError;
+            break;
+        }
+
+        const bool transferOk = r.error.code == cpr::ErrorCode::OK;
+        if (transferOk && (bodyAccepted || (statusCode == 200 && !bodyChecked))) {
+            if (!bodyChecked && offset > 0) {
+                restartFromScratch(); // Whole file is empty
+            }
+            DBG("API Download file: ok, {} bytes", offset);
+            error = Error::Success;
+            break;
+        }
+
+        error = Error::ApiError;
+        ERR("API Download file failed: code={}, message: {}, reply: {}, received: {}, url: {}",
+            statusCode, r.error.message, errorBody, offset, elidedUrl);
+
+        if (statusCode == 416 || (statusCode == 206 && !bodyAccepted)) {
+            // Our partial file doesn't match what server has, download it again
+            restartFromScratch();
+            continue;
+        }
+
+        if (statusCode >= 400) {
+            break;
+        }
+    }
+
+    if (!file.is_open() && error != Error::Success) {
+        ERR("API Can't open file for writing: {}", partFile);
+        error = Error::FileError;
+    }
+
+    return {error, statusCode};
+}
+
+std::pair<Error, int> FileDownloader::downloadSegmented(const std::string &url,
+                                                        const std::string &partFile,
+                                                        const MakeHeaders &makeHeaders,
+                                                        const DownloadOptions &options,
+                                                        Sha256Stream &hasher) const
+{
+    const auto elidedUrl = elideUrl(url);
+    const auto ranges = splitByteRanges(options.expectedSize,
+                                        std::min(options.segments, DOWNLOAD_MAX_SEGMENTS));
+
+    INF("API Download file: {} segments, {} bytes: {}", ranges.size(), options.expectedSize,
+        elidedUrl);
+
+    // Segments are written into their place in the preallocated file
+    {
+        std::ofstream file(partFile, std::ios::binary | std::ios::trunc);
+        file.close();
+        boost::system::error_code ec;
+        fs::resize_file(partFile, static_cast<uintmax_t>(options.expectedSize), ec);
+        if (!file || ec) {
+            ERR("API Can't preallocate file for writing: {}", partFile);
+            return {Error::FileError, 0};
+        }
+    }
+
+    struct Segment {
+        int status {0};
+        bool complete {false};
+        int64_t received {0};
+        std::string validator;
+    };
+
+    // Bytes are hashed in file order: those of the first incomplete segment as they arrive, the
+    // ones received earlier by the next segment are read back once it becomes the first.
+    std::mutex mutex;
+    std::vector<Segment> segments(ranges.size());
+    size_t hashing = 0;
+    bool hashFailed = false;
+    hasher.reset();
+
+    const auto segmentCompleted = [&](size_t i) {
+        segments[i].complete = true;
+        while (hashing < segments.size() && segments[hashing].complete) {
+            if (++hashing < segments.size() && segments[hashing].received > 0) {
+                hashFailed |= !hashFileRange(hasher, partFile, ranges[hashing].first,
+                                             segments[hashing].received);
+            }
+        }
+    };
+
+    std::vector<std::future<void>> futures;
+    for (size_t i = 0; i < ranges.size(); ++i) {
+        futures.push_back(std::async(std::launch::async, [&, i]() {
+            const auto [first, last] = ranges[i];
+            const auto length = last - first + 1;
+            auto &segment = segments[i];
+
+            // Unbuffered, so bytes read back for hashing are on disk
+            std::fstream file;
+            file.rdbuf()->pubsetbuf(nullptr, 0);
+            file.open(partFile, std::ios::binary | std::ios::in | std::ios::out);
+            file.seekp(first);
+
+            for (int attempt = 0; attempt < m_limits.retries && file; ++attempt) {
+                // Retry continues the segment where the previous attempt stopped
+                auto headers = makeHeaders();
+                headers[HDR_KEY_RANGE] = fmt::format("bytes={}-{}", first + segment.received, last);
+                if (segment.received > 0 && !segment.validator.empty()) {
+                    headers[HDR_KEY_IF_RANGE] = segment.validator;
+                }
+
+                RangeReply reply;
+                bool bodyChecked = false;
+                bool bodyAccepted = false;
+
+                auto onHeader = [&reply](std::string_view line, intptr_t) {
+                    reply.onHeaderLine(line);
+                    return true;
+                };
+
+                auto onWrite = [&](std::string_view data, intptr_t) {
+                    if (!bodyChecked) {
+                        bodyChecked = true;
+                        bodyAccepted = reply.status == 206 && reply.contentRange
+                                    && reply.contentRange->first == first + segment.received
+                                    && reply.contentRange->last == last;
+                        if (bodyAccepted && segment.received == 0) {
+                            segment.validator = reply.validator();
+                        }
+                    }
+
+                    // Whole file or error reply, no point in receiving it
+                    if (!bodyAccepted
+                        || segment.received + static_cast<int64_t>(data.size()) > length) {
+                        return false;
+                    }
+
+                    std::scoped_lock lock(mutex);
+                    file.write(data.data(), static_cast<std::streamsize>(data.size()));
+                    if (hashing == i) {
+                        hasher.update(data);
+                    }
+                    segment.received += static_cast<int64_t>(data.size());
+                    return static_cast<bool>(file);
+                };
+
+                auto r = cpr::Download(
+                        cpr::WriteCallback {onWrite}, cpr::Url {url}, cpr::HeaderCallback {onHeader},
+                        cpr::Timeout {m_limits.transferTimeout},
+                        cpr::ConnectTimeout {m_limits.connectTimeout},
+                        cpr::LowSpeed {m_limits.lowSpeedBps, m_limits.lowSpeedStallTime}, headers,
+                        m_sslOptions);
+                segment.status = reply.status != 0 ? reply.status : static_cast<int>(r.status_code);
+
+                if (segment.received == length) {
+                    std::scoped_lock lock(mutex);
+                    segmentCompleted(i);
+                    return;
+                }
+
+                // 200 means server ignores ranges or the file changed, no point to retry
+                if (segment.status == 200 || segment.status >= 400
+                    || (bodyChecked && !bodyAccepted)) {
+                    return;
+                }
+
+                DBG("API Download file: segment {} interrupted at {} of {} bytes", i,
+                    segment.received, length);
+            }
+        }));
+    }
+
+    for (auto &future : futures) {
+        future.get();
+    }
+
+    Error error {Error::Success};
+    int statusCode = 206;
+    for (const auto &segment : segments) {
+        if (!segment.complete) {
+            error = Error::ApiError;
+            statusCode = segment.status;
+        } else if (segment.validator != segments.front().validator) {
+            WRN("API Download file: file changed while downloading segments: {}", elidedUrl);
+            error = Error::ApiError;
+        }
+    }
+
+    if (error == Error::Success && hashFailed) {
+        ERR("API Download file: can't read back segments for hashing: {}", partFile);
+        error = Error::FileError;
+    }
+
+    if (error != Error::Success) {
+        boost::system::error_code ec;
+        bool keepHead = false;
+        if (segments.front().received > 0 && !segments.front().validator.empty()) {
+            // The first segment is the head of the file, single stream continues from it
+            fs::resize_file(partFile, static_cast<uintmax_t>(segments.front().received), ec);
+            keepHead = !ec;
+        }
+        if (keepHead) {
+            writeTextFile(partFile + DOWNLOAD_VALIDATOR_EXT, segments.front().validator);
+        } else {
+            fs::remove(partFile, ec);
+        }
+    }
+
+    return {error, statusCode};
+}
+
+} // namespace detail
+} // namespace scorbit
@@ -0,0 +1,88 @@
+/*
+ * Scorbit SDK
+ *
+ * (c) 2025 Spinner Systems, Inc. (DBA Scorbit), scrobit.io, All Rights Reserved
+ *
+ * MIT License
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "utils/download_range.h"
+#include <scorbit_sdk/net_types.h>
+#include <cpr/cpr.h>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+
+namespace scorbit {
+namespace detail {
+
+/**
+ * Options for file downloads. Interrupted transfers are always continued with Range requests
+ * within one download call, these options enable more.
+ */
+struct DownloadOptions {
+    std::string expectedSha256; // Hex SHA-256 of the whole file, empty - don't verify
+    int64_t expectedSize {-1};  // Known file size (e.g. from release manifest), -1 if unknown
+    bool keepPartial {false};   // Keep <filename>.part to resume in the next download call
+    int segments {1};           // Parallel Range segments, used only if expectedSize is known
+};
+
+/**
+ * @brief Downloads a file over HTTP into <filename>.part and moves it into place when complete.
+ *
+ * Interrupted transfer continues with "Range: bytes=N-", guarded by If-Range when the server sent
+ * a strong ETag or Last-Modified. Segments of a segmented download resume the same way each on
+ * its own. Received bytes are hashed on the way, size and SHA-256 are checked before the file is
+ * moved into place. Blocking, call it from a worker thread.
+ */
+class FileDownloader
+{
+public:
+    struct Limits {
+        std::chrono::milliseconds connectTimeout;
+        std::chrono::milliseconds transferTimeout; // 0 - no limit, stalls are caught by low speed
+        std::int32_t lowSpeedBps;
+        std::chrono::seconds lowSpeedStallTime;
+        int retries; // Attempts per transfer, each continues where the previous one stopped
+    };
+
+    /// Headers are made per request, e.g. auth token might be refreshed between retries
+    using MakeHeaders = std::function<cpr::Header()>;
+
+    FileDownloader(cpr::SslOptions sslOptions, Limits limits);
+
+    /// @return error and the last HTTP status
+    std::pair<Error, int> download(const std::string &url, const std::string &filename,
+                                   const MakeHeaders &makeHeaders,
+                                   const DownloadOptions &options) const;
+
+private:
+    std::pair<Error, int> downloadResumable(const std::string &url, const std::string &partFile,
+                                            const MakeHeaders &makeHeaders, bool resumeExisting,
+                                            Sha256Stream &hasher) const;
+    std::pair<Error, int> downloadSegmented(const std::string &url, const std::string &partFile,
+                                            const MakeHeaders &makeHeaders,
+                                            const DownloadOptions &options,
+                                            Sha256Stream &hasher) const;
+
+    cpr::SslOptions m_sslOptions;
+    Limits m_limits;
+};
+
+} // namespace detail
+} // namespace scorbit
@@ -0,0 +1,237 @@
+/*
+ * Scorbit SDK
+ *
+ * (c) 2025 Spinner Systems, Inc. (DBA Scorbit), scrobit.io, All Rights Reserved
+ *
+ * MIT License
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "flight_recorder.h"
+#include "utils/date_time_parser.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace scorbit {
+namespace detail {
+
+constexpr uint32_t FLIGHT_RECORDER_MAGIC = 0x53424652; // "SBFR"
+constexpr uint16_t FLIGHT_RECORDER_VERSION = 1;
+constexpr uint32_t FLIGHT_RECORD_MAGIC = 0x5342524b; // "SBRK"
+
+struct FlightRecorder::Header {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t reserved;
+    uint64_t capacity;
+    uint64_t writePosition; // Bytes reserved since the file was created, never wraps
+};
+
+struct FlightRecorder::RecordHeader {
+    uint32_t magic;
+    uint32_t checksum; // Of the rest of the header and the text, mismatch means torn record
+    int64_t timestamp; // Unix time, milliseconds
+    uint16_t length;   // Of the text following the header
+    uint8_t tag;
+    uint8_t reserved;
+};
+
+namespace {
+
+uint32_t checksum(int64_t timestamp, uint16_t length, uint8_t tag, std::string_view text)
+{
+    // FNV-1a
+    uint32_t hash = 2166136261u;
+    const auto add = [&hash](const void *data, size_t size) {
+        const auto *bytes = static_cast<const uint8_t *>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash = (hash ^ bytes[i]) * 16777619u;
+        }
+    };
+    add(&timestamp, sizeof(timestamp));
+    add(&length, sizeof(length));
+    add(&tag, sizeof(tag));
+    add(text.data(), text.size());
+    return hash;
+}
+
+std::string_view tagName(uint8_t tag)
+{
+    constexpr std::string_view NAMES[] = {"DBG", "INF", "WRN", "ERR", "EVT"};
+    return tag < std::size(NAMES) ? NAMES[tag] : "???";
+}
+
+std::string formatTimestamp(int64_t timestampMs)
+{
+    // 2026-04-01T10:00:00Z -> 2026-04-01T10:00:00.123Z
+    auto formatted = formatUnixTimestampIso8601(timestampMs / 1000);
+    if (!formatted.empty()) {
+        formatted.insert(formatted.size() - 1, fmt::format(".{:03}", timestampMs % 1000));
+    }
+    return formatted;
+}
+
+} // namespace
+
+FlightRecorder::FlightRecorder(size_t size)
+    : m_capacity(size)
+{
+}
+
+FlightRecorder &FlightRecorder::instance()
+{
+    // Never destroyed, the logger thread may still record while the process exits
+    static auto *recorder = new FlightRecorder();
+    return *recorder;
+}
+
+bool FlightRecorder::open(const std::string &path)
+{
+    std::scoped_lock lock(m_openMutex);
+
+    if (isOpen()) {
+        return path == m_path;
+    }
+
+    if (!m_file.open(path, sizeof(Header) + m_capacity)) {
+        return false;
+    }
+
+    auto *stored = reinterpret_cast<Header *>(m_file.data());
+    if (stored->magic != FLIGHT_RECORDER_MAGIC || stored->version != FLIGHT_RECORDER_VERSION
+        || stored->capacity != m_capacity) {
+        // New file or different layout, start over
+        std::memset(m_file.data(), 0, m_file.size());
+        stored->magic = FLIGHT_RECORDER_MAGIC;
+        stored->version = FLIGHT_RECORDER_VERSION;
+        stored->capacity = m_capacity;
+    }
+
+    m_path = path;
+    m_data.store(m_file.data() + sizeof(Header), std::memory_order_release);
+    m_previousRun = dump();
+    m_file.flush();
+    return true;
+}
+
+void FlightRecorder::log(logger::LogLevel level, std::string_view message)
+{
+    write(static_cast<Tag>(level), message);
+}
+
+void FlightRecorder::event(std::string_view message)
+{
+    write(Tag::Event, message);
+}
+
+FlightRecorder::Header *FlightRecorder::header() const
+{
+    return reinterpret_cast<Header *>(m_data.load(std::memory_order_acquire) - sizeof(Header));
+}
+
+void FlightRecorder::write(Tag tag, std::string_view text)
+{
+    if (!isOpen()) {
+        return;
+    }
+
+    text = text.substr(0, std::min(FLIGHT_RECORDER_MAX_TEXT, m_capacity / 4));
+    RecordHeader record {};
+    record.magic = FLIGHT_RECORD_MAGIC;
+    record.timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
+                               std::chrono::system_clock::now().time_since_epoch())
+                               .count();
+    record.length = static_cast<uint16_t>(text.size());
+    record.tag = static_cast<uint8_t>(tag);
+    record.checksum = checksum(record.timestamp, record.length, record.tag, text);
+
+    const auto position =
+            std::atomic_ref<uint64_t>(header()->writePosition)
+                    .fetch_add(sizeof(RecordHeader) + text.size(), std::memory_order_relaxed);
+
+    // Header goes last, so the record is valid only when the text is in place
+    copyIn(position + sizeof(RecordHeader), text.data(), text.size());
+    copyIn(position, &record, sizeof(record));
+}
+
+void FlightRecorder::copyIn(uint64_t position, const void *data, size_t size)
+{
+    auto *ring = m_data.load(std::memory_order_relaxed);
+    const auto offset = static_cast<size_t>(position % m_capacity);
+    const auto first = std::min(size, m_capacity - offset);
+    std::memcpy(ring + offset, data, first);
+    std::memcpy(ring, static_cast<const uint8_t *>(data) + first, size - first);
+}
+
+void FlightRecorder::copyOut(uint64_t position, void *data, size_t size) const
+{
+    const auto *ring = m_data.load(std::memory_order_relaxed);
+    const auto offset = static_cast<size_t>(position % m_capacity);
+    const auto first = std::min(size, m_capacity - offset);
+    std::memcpy(data, ring + offset, first);
+    std::memcpy(static_cast<uint8_t *>(data) + first, ring, size - first);
+}
+
+std::string FlightRecorder::dump() const
+{
+    std::string result;
+    if (!isOpen()) {
+        return result;
+    }
+
+    const auto end = std::atomic_ref<uint64_t>(header()->writePosition)
+                             .load(std::memory_order_acquire);
+    auto position = end > m_capacity ? end - m_capacity : 0;
+    std::string text;
+
+    // Oldest record is usually overwritten in part, and records torn by a crash are invalid, so
+    // look for the next valid record byte by byte
+    while (position + sizeof(RecordHeader) <= end) {
+        RecordHeader record;
+        copyOut(position, &record, sizeof(record));
+        if (record.magic == FLIGHT_RECORD_MAGIC && record.length <= m_capacity / 4
+            && position + sizeof(record) + record.length <= end) {
+            text.resize(record.length);
+            copyOut(position + sizeof(record), text.data(), text.size());
+            if (record.checksum == checksum(record.timestamp, record.length, record.tag, text)) {
+                std::replace_if(
+                        text.begin(), text.end(), [](char c) { return c == '\n' || c == '\r'; },
+                        ' ');
+                fmt::format_to(std::back_inserter(result), "{} {} {}\n",
+                               formatTimestamp(record.timestamp), tagName(record.tag), text);
+                position += sizeof(record) + record.length;
+                continue;
+            }
+        }
+        ++position;
+    }
+
+    return result;
+}
+
+bool startFlightRecorder(const std::string &path)
+{
+    if (!FlightRecorder::instance().open(path)) {
+        return false;
+    }
+
+    logger::setTap([](logger::LogLevel level, std::string_view message) {
+        FlightRecorder::instance().log(level, message);
+    });
+    return true;
+}
+
+} // namespace detail
+} // namespace scorbit
@@ -0,0 +1,106 @@
+/*
+ * Scorbit SDK
+ *
+ * (c) 2025 Spinner Systems, Inc. (DBA Scorbit), scrobit.io, All Rights Reserved
+ *
+ * MIT License
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "utils/mapped_file.h"
+#include <logger/logger.h>
+
+#include <fmt/format.h>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+namespace scorbit {
+namespace detail {
+
+constexpr size_t FLIGHT_RECORDER_SIZE = 256 * 1024; // Last few thousand messages
+constexpr size_t FLIGHT_RECORDER_MAX_TEXT = 1024;   // Longer messages are cut
+
+/**
+ * @brief Recent log messages and SDK events kept in a memory mapped ring file.
+ *
+ * Writes land in the page cache right away, so the history survives a crash or a watchdog
+ * kill, and is read back by open() at the next start. Writers don't lock: a record is reserved
+ * with one atomic add and committed by its checksum, so records torn by a crash are skipped
+ * when read. Nothing is recorded until open() succeeds.
+ */
+class FlightRecorder
+{
+public:
+    explicit FlightRecorder(size_t size = FLIGHT_RECORDER_SIZE);
+
+    /// Recorder of the process, receives SDK log messages once opened by startFlightRecorder()
+    static FlightRecorder &instance();
+
+    /**
+     * @brief Keep the records in @p path, records of the previous run are kept by previousRun().
+     * @return false if the file can't be used or the recorder is already open with other file
+     */
+    bool open(const std::string &path);
+
+    bool isOpen() const { return m_data.load(std::memory_order_acquire) != nullptr; }
+
+    void log(logger::LogLevel level, std::string_view message);
+
+    /// SDK state transition, e.g. authentication status change
+    void event(std::string_view message);
+
+    template<typename... Args>
+    void event(fmt::format_string<Args...> format, Args &&...args)
+    {
+        if (isOpen()) {
+            fmt::memory_buffer buffer;
+            fmt::format_to(std::back_inserter(buffer), format, std::forward<Args>(args)...);
+            event(std::string_view {buffer.data(), buffer.size()});
+        }
+    }
+
+    /// Records in the file, oldest first, one per line
+    std::string dump() const;
+
+    /// Records found in the file when it was opened
+    const std::string &previousRun() const { return m_previousRun; }
+
+private:
+    struct Header;
+    struct RecordHeader;
+
+    enum class Tag : uint8_t { Debug, Info, Warn, Error, Event };
+
+    void write(Tag tag, std::string_view text);
+    void copyIn(uint64_t position, const void *data, size_t size);
+    void copyOut(uint64_t position, void *data, size_t size) const;
+    Header *header() const;
+
+    const size_t m_capacity; // Bytes of the ring, without the header
+    std::mutex m_openMutex;
+    MappedFile m_file;
+    std::string m_path;
+    std::string m_previousRun;
+    std::atomic<uint8_t *> m_data {nullptr}; // Start of the ring
+};
+
+/// Open the process flight recorder in @p path and pass it all SDK log messages
+bool startFlightRecorder(const std::string &path);
+
+} // namespace detail
+} // namespace scorbit
@@ -21,6 +21,26 @@
 
 #include <scorbit_sdk/net_types.h>
 #include <fmt/format.h>
+#include <nlohmann/json.hpp>
+
+namespace scorbit {
+namespace detail {
+
+/// Serializes json only when the log message is formatted: DBG("data: {}", JsonDump {j})
+struct JsonDump {
+    const nlohmann::json &json;
+};
+
+} // namespace detail
+} // namespace scorbit
+
+template<>
+struct fmt::formatter<scorbit::detail::JsonDump> : fmt::formatter<std::string_view> {
+    auto format(const scorbit::detail::JsonDump &dump, fmt::format_context &ctx) const
+    {
+        return fmt::formatter<std::string_view>::format(dump.json.dump(), ctx);
+    }
+};
 
 template<>
 struct fmt::formatter<scorbit::GameStartOrigin> : fmt::formatter<std::string_view> {
@@ -39,3 +59,33 @@ struct fmt::formatter<scorbit::GameStartOrigin> : fmt::formatter<std::string_vie
         return fmt::formatter<std::string_view>::format(name, ctx);
     }
 };
+
+template<>
+struct fmt::formatter<scorbit::AuthStatus> : fmt::formatter<std::string_view> {
+    auto format(scorbit::AuthStatus c, fmt::format_context &ctx) const
+    {
+        using namespace scorbit;
+        std::string_view name = "unknown";
+        switch (c) {
+        case AuthStatus::NotAuthenticated:
+            name = "NotAuthenticated";
+            break;
+        case AuthStatus::Authenticating:
+            name = "Authenticating";
+            break;
+        case AuthStatus::AuthenticatedCheckingPairing:
+            name = "AuthenticatedCheckingPairing";
+            break;
+        case AuthStatus::AuthenticatedUnpaired:
+            name = "AuthenticatedUnpaired";
+            break;
+        case AuthStatus::AuthenticatedPaired:
+            name = "AuthenticatedPaired";
+            break;
+        case AuthStatus::AuthenticationFailed:
+            name = "AuthenticationFailed";
+            break;
+        }
+        return fmt::formatter<std::string_view>::format(name, ctx);
+    }
+};
@@ -135,6 +135,13 @@ struct JobRequestTopScores {
     void *user_data;
 };
 
+struct JobRequestTopScoresMulti {
+    sb_game_state_struct *h;
+    std::vector<detail::LeaderboardQuery> queries;
+    sb_leaderboard_multi_callback_t callback;
+    void *user_data;
+};
+
 struct JobRequestPairCode {
     sb_game_state_struct *h;
     sb_string_callback_t callback;
@@ -204,9 +211,9 @@ using ApiQueueItem =
         std::variant<Poison, JobSetGameStarted, JobSetGameFinished, JobSetCurrentBall,
                      JobSetActivePlayer, JobSetScore, JobAddMode, JobAddModeExpiring,
                      JobTickModeExpiries, JobRemoveMode, JobClearModes, JobCommit,
-                     JobRequestTopScores, JobRequestPairCode, JobRequestUnpair, JobSetCapabilities,
-                     JobPairMachine, JobCreditsDropped, JobCreditsStatus, JobDownload,
-                     JobDownloadBuffer, JobUploadDiagnostics>;
+                     JobRequestTopScores, JobRequestTopScoresMulti, JobRequestPairCode,
+                     JobRequestUnpair, JobSetCapabilities, JobPairMachine, JobCreditsDropped,
+                     JobCreditsStatus, JobDownload, JobDownloadBuffer, JobUploadDiagnostics>;
 
 // Combines lambdas into one functor for std::visit (standard C++17 pattern). C++17 helper for
 // std::visit. In C++20+, equivalent functionality may be provided by a standard or library helper
@@ -248,6 +255,26 @@ inline auto makeLeaderboardReplyBridge(sb_leaderboard_callback_t cb, void *user_
     };
 }
 
+inline auto makeLeaderboardMultiReplyBridge(sb_leaderboard_multi_callback_t cb, void *user_data)
+{
+    return [cb, user_data](std::vector<Error> errors,
+                           std::vector<sb_leaderboard_t *> leaderboards) {
+        if (cb) {
+            std::vector<sb_error_t> cErrors;
+            cErrors.reserve(errors.size());
+            for (const auto error : errors) {
+                cErrors.push_back(static_cast<sb_error_t>(error));
+            }
+            cb(cErrors.data(), leaderboards.data(), leaderboards.size(), user_data);
+        }
+        for (auto *leaderboard : leaderboards) {
+            if (leaderboard) {
+                detail::destroyLeaderboard(leaderboard);
+            }
+        }
+    };
+}
+
 } // namespace scorbit_c_api_queue
 
 struct sb_game_state_struct {
@@ -295,6 +322,11 @@ void dispatchApiJob(ApiQueueItem &&item)
                                 static_cast<LeaderboardVpinFilter>(j.vpin_filter),
                                 makeLeaderboardReplyBridge(j.callback, j.user_data));
                     },
+                    [](JobRequestTopScoresMulti &&j) {
+                        j.h->gameState.requestTopScoresMulti(
+                                std::move(j.queries),
+                                makeLeaderboardMultiReplyBridge(j.callback, j.user_data));
+                    },
                     [](JobRequestPairCode &&j) {
                         j.h->gameState.requestPairCode(
                                 makeCStringReplyBridge(j.callback, j.user_data));
@@ -510,6 +542,26 @@ void sb_request_top_scores(sb_game_handle_t handle, sb_leaderboard_scope_t scope
                                             callback, user_data});
 }
 
+void sb_request_top_scores_multi(sb_game_handle_t handle, const sb_leaderboard_query_t *queries,
+                                 size_t count, sb_leaderboard_multi_callback_t callback,
+                                 void *user_data)
+{
+    std::vector<detail::LeaderboardQuery> copied;
+    if (queries) {
+        copied.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            const auto &query = queries[i];
+            copied.push_back({static_cast<LeaderboardScope>(query.scope),
+                              static_cast<LeaderboardPeriod>(query.period),
+                              scorbit_c_api_queue::copyCStr(query.since),
+                              static_cast<LeaderboardVpinFilter>(query.vpin_filter)});
+        }
+    }
+
+    handle->postApiJob(
+            JobRequestTopScoresMulti {handle, std::move(copied), callback, user_data});
+}
+
 void sb_request_pair_code(sb_game_handle_t handle, sb_string_callback_t callback, void *user_data)
 {
     handle->postApiJob(JobRequestPairCode {handle, callback, user_data});
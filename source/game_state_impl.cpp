@@ -264,6 +264,12 @@ void GameStateImpl::requestTopScores(LeaderboardScope scope, LeaderboardPeriod p
     m_net->requestTopScores(scope, period, since, vpinFilter, std::move(callback));
 }
 
+void GameStateImpl::requestTopScoresMulti(std::vector<LeaderboardQuery> queries,
+                                          LeaderboardMultiCallback callback)
+{
+    m_net->requestTopScoresMulti(std::move(queries), std::move(callback));
+}
+
 void GameStateImpl::requestPairCode(StringCallback callback) const
 {
     m_net->requestPairCode(std::move(callback));
@@ -283,7 +289,7 @@ void GameStateImpl::requestPairMachine(const std::string &machineUuid, const std
 void GameStateImpl::download(StringCallback callback, const std::string &url,
                              const std::string &filename, const HttpHeaders &headers)
 {
-    m_net->download(true, std::move(callback), url, filename, headers);
+    m_net->download(true, std::move(callback), url, filename, headers, {});
 }
 
 void GameStateImpl::downloadBuffer(VectorCallback callback, const std::string &url,
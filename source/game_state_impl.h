@@ -80,6 +80,8 @@ public:
     void requestTopScores(LeaderboardScope scope, LeaderboardPeriod period, const std::string &since,
                           LeaderboardVpinFilter vpinFilter,
                           LeaderboardHandleCallback callback);
+    void requestTopScoresMulti(std::vector<LeaderboardQuery> queries,
+                               LeaderboardMultiCallback callback);
 
     void requestPairCode(StringCallback callback) const;
     void requestUnpair(StringCallback callback) const;
@@ -72,6 +72,13 @@ constexpr auto HDR_VAL_NO_CACHE {"no-cache"};
 
 constexpr auto HDR_KEY_FINGERPRINT_HASH {"X-Fingerprint-Hash"};
 
+constexpr auto HDR_KEY_RANGE {"Range"};
+constexpr auto HDR_KEY_IF_RANGE {"If-Range"};
+constexpr auto HDR_KEY_IF_NONE_MATCH {"If-None-Match"};
+constexpr auto HDR_KEY_IF_MODIFIED_SINCE {"If-Modified-Since"};
+constexpr auto HDR_KEY_ETAG {"ETag"};
+constexpr auto HDR_KEY_LAST_MODIFIED {"Last-Modified"};
+
 // Providers
 constexpr auto PROVIDER_SCORBITRON {"scorbitron"};
 constexpr auto PROVIDER_VSCORBITRON {"vscorbitron"};
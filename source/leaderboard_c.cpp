@@ -17,331 +17,556 @@
  * SOFTWARE.
  */
 
+
 #include "leaderboard_internal.h"
 
 #include <nlohmann/json.hpp>
 
 #include <memory>
+#include <stdexcept>
 
 using json = nlohmann::json;
+using scorbit::detail::LeaderboardData;
+using scorbit::detail::LeaderboardString;
 
 namespace {
 
-template<typename T>
-bool assignScalar(const json &obj, const char *key, T &out)
+enum class Field {
+    Id,
+    Rank,
+    HighScore,
+    ReactionCount,
+    ScoreCount,
+    IsNfcVerified,
+    IsVerified,
+    IsVpin,
+    FollowerCount,
+    FollowingCount,
+    String,
+};
+
+struct FieldInfo {
+    std::string_view key;
+    Field field;
+    LeaderboardString string {LeaderboardString::Count};
+};
+
+constexpr auto PLAYER_KEY = std::string_view {"player"};
+
+constexpr FieldInfo ENTRY_FIELDS[] {
+        {"id", Field::Id},
+        {"rank", Field::Rank},
+        {"high_score", Field::HighScore},
+        {"image", Field::String, LeaderboardString::Image},
+        {"reaction_count", Field::ReactionCount},
+        {"score_count", Field::ScoreCount},
+        {"is_nfc_verified", Field::IsNfcVerified},
+        {"is_verified", Field::IsVerified},
+        {"is_vpin", Field::IsVpin},
+        {"created", Field::String, LeaderboardString::Created},
+};
+
+constexpr FieldInfo PLAYER_FIELDS[] {
+        {"id", Field::String, LeaderboardString::PlayerId},
+        {"username", Field::String, LeaderboardString::PlayerUsername},
+        {"display_name", Field::String, LeaderboardString::PlayerDisplayName},
+        {"initials", Field::String, LeaderboardString::PlayerInitials},
+        {"avatar", Field::String, LeaderboardString::PlayerAvatar},
+        {"follower_count", Field::FollowerCount},
+        {"following_count", Field::FollowingCount},
+        {"last_login", Field::String, LeaderboardString::PlayerLastLogin},
+};
+
+template<size_t N>
+const FieldInfo *findField(const FieldInfo (&fields)[N], std::string_view key)
 {
-    const auto it = obj.find(key);
-    if (it == obj.end() || it->is_null()) {
-        return false;
+    for (const auto &field : fields) {
+        if (field.key == key) {
+            return &field;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * SAX handler which writes leaderboard entries straight into LeaderboardData, no json DOM is
+ * built. Expects array of entry objects with optional nested player object, unknown keys and
+ * values of unexpected type are ignored. Returning false stops parsing: reply is not leaderboard.
+ */
+class LeaderboardSaxHandler : public nlohmann::json_sax<json>
+{
+public:
+    explicit LeaderboardSaxHandler(LeaderboardData &data)
+        : m_data(data)
+    {
+    }
+
+    bool null() override
+    {
+        m_field = nullptr;
+        m_playerKey = false; // Null player is fine, entry just has no player data
+        return m_skip > 0 || m_depth >= Depth::Entry;
+    }
+
+    bool boolean(bool val) override
+    {
+        return scalar([this, val](const FieldInfo &info) {
+            const auto index = m_data.size() - 1;
+            switch (info.field) {
+            case Field::IsNfcVerified:
+                m_data.isNfcVerified[index] = val;
+                break;
+            case Field::IsVerified:
+                m_data.isVerified[index] = val;
+                break;
+            case Field::IsVpin:
+                m_data.isVpin[index] = val;
+                break;
+            default:
+                break;
+            }
+        });
+    }
+
+    bool number_integer(number_integer_t val) override { return number(val); }
+    bool number_unsigned(number_unsigned_t val) override { return number(val); }
+    bool number_float(number_float_t val, const string_t &) override { return number(val); }
+
+    bool string(string_t &val) override
+    {
+        return scalar([this, &val](const FieldInfo &info) {
+            if (info.field == Field::String) {
+                m_data.setString(info.string, m_data.size() - 1, val);
+            }
+        });
     }
 
-    if constexpr (std::is_same_v<T, bool>) {
-        if (!it->is_boolean()) {
+    bool binary(binary_t &) override { return scalar([](const FieldInfo &) {}); }
+
+    bool start_object(std::size_t) override
+    {
+        if (m_skip > 0) {
+            ++m_skip;
+            return true;
+        }
+
+        switch (m_depth) {
+        case Depth::None:
             return false;
+        case Depth::Array:
+            m_data.addEntry();
+            m_depth = Depth::Entry;
+            return true;
+        case Depth::Entry:
+            if (m_playerKey) {
+                m_playerKey = false;
+                m_depth = Depth::Player;
+                return true;
+            }
+            [[fallthrough]];
+        case Depth::Player:
+            m_skip = 1;
+            return true;
+        }
+        return false;
+    }
+
+    bool key(string_t &val) override
+    {
+        if (m_skip > 0) {
+            return true;
+        }
+
+        if (m_depth == Depth::Entry) {
+            m_playerKey = val == PLAYER_KEY;
+            m_field = findField(ENTRY_FIELDS, val);
+        } else {
+            m_field = findField(PLAYER_FIELDS, val);
+        }
+        return true;
+    }
+
+    bool end_object() override
+    {
+        if (m_skip > 0) {
+            --m_skip;
+        } else {
+            m_depth = m_depth == Depth::Player ? Depth::Entry : Depth::Array;
+        }
+        m_field = nullptr;
+        m_playerKey = false;
+        return true;
+    }
+
+    bool start_array(std::size_t) override
+    {
+        if (m_skip > 0) {
+            ++m_skip;
+            return true;
+        }
+
+        switch (m_depth) {
+        case Depth::None:
+            m_depth = Depth::Array;
+            return true;
+        case Depth::Array:
+            return false; // Entry must be an object
+        case Depth::Entry:
+        case Depth::Player:
+            if (m_playerKey) {
+                return false;
+            }
+            m_skip = 1;
+            return true;
+        }
+        return false;
+    }
+
+    bool end_array() override
+    {
+        if (m_skip > 0) {
+            --m_skip;
+        } else {
+            m_depth = Depth::None;
+        }
+        m_field = nullptr;
+        return true;
+    }
+
+    bool parse_error(std::size_t, const std::string &,
+                     const nlohmann::detail::exception &ex) override
+    {
+        throw std::runtime_error(ex.what());
+    }
+
+private:
+    enum class Depth {
+        None,
+        Array,
+        Entry,
+        Player,
+    };
+
+    template<typename Assign>
+    bool scalar(Assign &&assign)
+    {
+        if (m_skip > 0) {
+            return true;
         }
-    } else {
-        if (!it->is_number()) {
+
+        // Scalars are allowed only as entry or player values, and player must be an object
+        if (m_depth < Depth::Entry || (m_depth == Depth::Entry && m_playerKey)) {
             return false;
         }
+
+        if (m_field) {
+            assign(*m_field);
+            m_field = nullptr;
+        }
+        return true;
     }
 
-    out = it->get<T>();
-    return true;
+    template<typename T>
+    bool number(T val)
+    {
+        return scalar([this, val](const FieldInfo &info) {
+            const auto index = m_data.size() - 1;
+            switch (info.field) {
+            case Field::Id:
+                m_data.ids[index] = static_cast<uint64_t>(val);
+                break;
+            case Field::Rank:
+                m_data.ranks[index] = static_cast<int>(val);
+                break;
+            case Field::HighScore:
+                m_data.highScores[index] = static_cast<sb_score_t>(val);
+                break;
+            case Field::ReactionCount:
+                m_data.reactionCounts[index] = static_cast<int>(val);
+                break;
+            case Field::ScoreCount:
+                m_data.scoreCounts[index] = static_cast<int>(val);
+                break;
+            case Field::FollowerCount:
+                m_data.playerFollowerCounts[index] = static_cast<int>(val);
+                break;
+            case Field::FollowingCount:
+                m_data.playerFollowingCounts[index] = static_cast<int>(val);
+                break;
+            default:
+                break;
+            }
+        });
+    }
+
+    LeaderboardData &m_data;
+    Depth m_depth {Depth::None};
+    int m_skip {0}; // Nesting level inside ignored value
+    const FieldInfo *m_field {nullptr};
+    bool m_playerKey {false};
+};
+
+const LeaderboardData *getData(const sb_leaderboard_t *leaderboard, size_t index)
+{
+    if (leaderboard == nullptr || !leaderboard->data || index >= leaderboard->data->size()) {
+        return nullptr;
+    }
+
+    return leaderboard->data.get();
 }
 
-bool assignString(const json &obj, const char *key, std::string &out)
+template<typename T, typename Column>
+bool getValue(const sb_leaderboard_t *leaderboard, size_t index, const Column &column, T *out)
 {
-    const auto it = obj.find(key);
-    if (it == obj.end() || it->is_null() || !it->is_string()) {
+    const auto *data = getData(leaderboard, index);
+    if (data == nullptr || out == nullptr) {
         return false;
     }
 
-    out = it->get<std::string>();
+    *out = static_cast<T>((data->*column)[index]);
     return true;
 }
 
-const scorbit::detail::LeaderboardEntryData *getEntry(const sb_leaderboard_t *leaderboard,
-                                                      size_t index)
+bool getString(const sb_leaderboard_t *leaderboard, size_t index, LeaderboardString field,
+               const char **out)
 {
-    if (leaderboard == nullptr || index >= leaderboard->entries.size()) {
-        return nullptr;
+    const auto *data = getData(leaderboard, index);
+    if (data == nullptr || out == nullptr) {
+        return false;
     }
 
-    return &leaderboard->entries[index];
+    const auto *str = data->string(field, index);
+    if (str == nullptr) {
+        return false;
+    }
+
+    *out = str;
+    return true;
 }
 
 } // namespace
 
+size_t std::hash<scorbit::detail::LeaderboardQuery>::operator()(
+        const scorbit::detail::LeaderboardQuery &query) const noexcept
+{
+    size_t seed = std::hash<std::string> {}(query.since);
+    const auto combine = [&seed](size_t value) {
+        seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    };
+    combine(static_cast<size_t>(query.scope));
+    combine(static_cast<size_t>(query.period));
+    combine(static_cast<size_t>(query.vpinFilter));
+    return seed;
+}
+
 namespace scorbit {
 namespace detail {
 
-sb_leaderboard_t *parseLeaderboardJson(const std::string &reply)
+size_t LeaderboardData::addEntry()
 {
-    auto parsed = json::parse(reply);
-    if (!parsed.is_array()) {
-        return nullptr;
+    ids.push_back(0);
+    ranks.push_back(0);
+    highScores.push_back(0);
+    reactionCounts.push_back(0);
+    scoreCounts.push_back(0);
+    isNfcVerified.push_back(0);
+    isVerified.push_back(0);
+    isVpin.push_back(0);
+    playerFollowerCounts.push_back(0);
+    playerFollowingCounts.push_back(0);
+    for (auto &column : strings) {
+        column.emplace_back();
     }
+    return ids.size() - 1;
+}
 
-    auto leaderboard = std::make_unique<sb_leaderboard_t>();
-    leaderboard->entries.reserve(parsed.size());
+void LeaderboardData::setString(LeaderboardString field, size_t index, std::string_view value)
+{
+    auto &ref = strings[static_cast<size_t>(field)][index];
+    if (value.empty()) {
+        ref = {};
+        return;
+    }
 
-    for (const auto &obj : parsed) {
-        if (!obj.is_object()) {
-            return nullptr;
-        }
+    ref.offset = static_cast<uint32_t>(arena.size());
+    ref.size = static_cast<uint32_t>(value.size());
+    arena.append(value);
+    arena.push_back('\0');
+}
 
-        LeaderboardEntryData entry;
-        assignScalar(obj, "id", entry.id);
-        assignScalar(obj, "rank", entry.rank);
-        assignScalar(obj, "high_score", entry.highScore);
-        assignString(obj, "image", entry.image);
-        assignScalar(obj, "reaction_count", entry.reactionCount);
-        assignScalar(obj, "score_count", entry.scoreCount);
-        assignScalar(obj, "is_nfc_verified", entry.isNfcVerified);
-        assignScalar(obj, "is_verified", entry.isVerified);
-        assignScalar(obj, "is_vpin", entry.isVpin);
-        assignString(obj, "created", entry.created);
-
-        const auto playerIt = obj.find("player");
-        if (playerIt != obj.end() && !playerIt->is_null()) {
-            if (!playerIt->is_object()) {
-                return nullptr;
-            }
+const char *LeaderboardData::string(LeaderboardString field, size_t index) const
+{
+    const auto &ref = strings[static_cast<size_t>(field)][index];
+    return ref.size > 0 ? arena.data() + ref.offset : nullptr;
+}
 
-            const auto &player = *playerIt;
-            assignString(player, "id", entry.player.id);
-            assignString(player, "username", entry.player.username);
-            assignString(player, "display_name", entry.player.displayName);
-            assignString(player, "initials", entry.player.initials);
-            assignString(player, "avatar", entry.player.avatar);
-            assignScalar(player, "follower_count", entry.player.followerCount);
-            assignScalar(player, "following_count", entry.player.followingCount);
-            assignString(player, "last_login", entry.player.lastLogin);
-        }
+std::string_view LeaderboardData::stringView(LeaderboardString field, size_t index) const
+{
+    const auto &ref = strings[static_cast<size_t>(field)][index];
+    return {arena.data() + ref.offset, ref.size};
+}
+
+LeaderboardDataPtr parseLeaderboardData(const std::string &reply)
+{
+    auto leaderboard = std::make_shared<LeaderboardData>();
+    // Strings can't take more than the reply itself, so the arena is allocated once
+    leaderboard->arena.reserve(reply.size());
 
-        leaderboard->entries.push_back(std::move(entry));
+    LeaderboardSaxHandler handler(*leaderboard);
+    if (!json::sax_parse(reply, &handler)) {
+        return nullptr;
     }
 
-    return leaderboard.release();
+    leaderboard->arena.shrink_to_fit();
+    return leaderboard;
+}
+
+sb_leaderboard_t *parseLeaderboardJson(const std::string &reply)
+{
+    auto data = parseLeaderboardData(reply);
+    return data ? makeLeaderboardHandle(std::move(data)) : nullptr;
+}
+
+sb_leaderboard_t *makeLeaderboardHandle(LeaderboardDataPtr data,
+                                        std::chrono::system_clock::time_point updatedAt)
+{
+    return new sb_leaderboard_t {std::move(data), updatedAt};
 }
 
 } // namespace detail
 } // namespace scorbit
 
-size_t sb_leaderboard_entries_count(const sb_leaderboard_t *leaderboard)
+sb_leaderboard_t *sb_leaderboard_retain(const sb_leaderboard_t *leaderboard)
 {
-    return leaderboard ? leaderboard->entries.size() : 0;
+    if (leaderboard == nullptr || !leaderboard->data) {
+        return nullptr;
+    }
+
+    return scorbit::detail::makeLeaderboardHandle(leaderboard->data, leaderboard->updatedAt);
 }
 
-bool sb_leaderboard_entry_id(const sb_leaderboard_t *leaderboard, size_t index, uint64_t *id)
+void sb_leaderboard_release(sb_leaderboard_t *leaderboard)
 {
-    const auto *entry = getEntry(leaderboard, index);
-    if (entry == nullptr || id == nullptr) {
-        return false;
+    scorbit::detail::destroyLeaderboard(leaderboard);
+}
+
+int64_t sb_leaderboard_updated_at(const sb_leaderboard_t *leaderboard)
+{
+    if (leaderboard == nullptr || leaderboard->updatedAt.time_since_epoch().count() == 0) {
+        return 0;
     }
 
-    *id = entry->id;
-    return true;
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+                   leaderboard->updatedAt.time_since_epoch())
+            .count();
 }
 
-bool sb_leaderboard_entry_rank(const sb_leaderboard_t *leaderboard, size_t index, int *rank)
+size_t sb_leaderboard_entries_count(const sb_leaderboard_t *leaderboard)
 {
-    const auto *entry = getEntry(leaderboard, index);
-    if (entry == nullptr || rank == nullptr) {
-        return false;
-    }
+    return leaderboard && leaderboard->data ? leaderboard->data->size() : 0;
+}
 
-    *rank = entry->rank;
-    return true;
+bool sb_leaderboard_entry_id(const sb_leaderboard_t *leaderboard, size_t index, uint64_t *id)
+{
+    return getValue(leaderboard, index, &LeaderboardData::ids, id);
+}
+
+bool sb_leaderboard_entry_rank(const sb_leaderboard_t *leaderboard, size_t index, int *rank)
+{
+    return getValue(leaderboard, index, &LeaderboardData::ranks, rank);
 }
 
 bool sb_leaderboard_entry_high_score(const sb_leaderboard_t *leaderboard, size_t index,
                                      sb_score_t *high_score)
 {
-    const auto *entry = getEntry(leaderboard, index);
-    if (entry == nullptr || high_score == nullptr) {
-        return false;
-    }
-
-    *high_score = entry->highScore;
-    return true;
+    return getValue(leaderboard, index, &LeaderboardData::highScores, high_score);
 }
 
 bool sb_leaderboard_entry_image(const sb_leaderboard_t *leaderboard, size_t index,
                                 const char **image)
 {
-    const auto *entry = getEntry(leaderboard, index);
-    if (entry == nullptr || image == nullptr || entry->image.empty()) {
-        return false;
-    }
-
-    *image = entry->image.c_str();
-    return true;
+    return getString(leaderboard, index, LeaderboardString::Image, image);
 }
 
 bool sb_leaderboard_entry_reaction_count(const sb_leaderboard_t *leaderboard, size_t index,
                                          int *reaction_count)
 {
-    const auto *entry = getEntry(leaderboard, index);
-    if (entry == nullptr || reaction_count == nullptr) {
-        return false;
-    }
-
-    *reaction_count = entry->reactionCount;
-    return true;
+    return getValue(leaderboard, index, &LeaderboardData::reactionCounts, reaction_count);
 }
 
 bool sb_leaderboard_entry_score_count(const sb_leaderboard_t *leaderboard, size_t index,
                                       int *score_count)
 {
-    const auto *entry = getEntry(leaderboard, index);
-    if (entry == nullptr || score_count == nullptr) {
-        return false;
-    }
-
-    *score_count = entry->scoreCount;
-    return true;
+    return getValue(leaderboard, index, &LeaderboardData::scoreCounts, score_count);
 }
 
 bool sb_leaderboard_entry_is_nfc_verified(const sb_leaderboard_t *leaderboard, size_t index,
                                           bool *is_nfc_verified)
 {
-    const auto *entry = getEntry(leaderboard, index);
-    if (entry == nullptr || is_nfc_verified == nullptr) {
-        return false;
-    }
-
-    *is_nfc_verified = entry->isNfcVerified;
-    return true;
+    return getValue(leaderboard, index, &LeaderboardData::isNfcVerified, is_nfc_verified);
 }
 
 bool sb_leaderboard_entry_is_verified(const sb_leaderboard_t *leaderboard, size_t index,
                                       bool *is_verified)
 {
-    const auto *entry = getEntry(leaderboard, index);
-    if (entry == nullptr || is_verified == nullptr) {
-        return false;
-    }
-
-    *is_verified = entry->isVerified;
-    return true;
+    return getValue(leaderboard, index, &LeaderboardData::isVerified, is_verified);
 }
 
 bool sb_leaderboard_entry_is_vpin(const sb_leaderboard_t *leaderboard, size_t index, bool *is_vpin)
 {
-    const auto *entry = getEntry(leaderboard, index);
-    if (entry == nullptr || is_vpin == nullptr) {
-        return false;
-    }
-
-    *is_vpin = entry->isVpin;
-    return true;
+    return getValue(leaderboard, index, &LeaderboardData::isVpin, is_vpin);
 }
 
 bool sb_leaderboard_entry_created(const sb_leaderboard_t *leaderboard, size_t index,
                                   const char **created)
 {
-    const auto *entry = getEntry(leaderboard, index);
-    if (entry == nullptr || created == nullptr || entry->created.empty()) {
-        return false;
-    }
-
-    *created = entry->created.c_str();
-    return true;
+    return getString(leaderboard, index, LeaderboardString::Created, created);
 }
 
 bool sb_leaderboard_entry_player_id(const sb_leaderboard_t *leaderboard, size_t index,
                                     const char **id)
 {
-    const auto *entry = getEntry(leaderboard, index);
-    if (entry == nullptr || id == nullptr || entry->player.id.empty()) {
-        return false;
-    }
-
-    *id = entry->player.id.c_str();
-    return true;
+    return getString(leaderboard, index, LeaderboardString::PlayerId, id);
 }
 
 bool sb_leaderboard_entry_player_username(const sb_leaderboard_t *leaderboard, size_t index,
                                           const char **username)
 {
-    const auto *entry = getEntry(leaderboard, index);
-    if (entry == nullptr || username == nullptr || entry->player.username.empty()) {
-        return false;
-    }
-
-    *username = entry->player.username.c_str();
-    return true;
+    return getString(leaderboard, index, LeaderboardString::PlayerUsername, username);
 }
 
 bool sb_leaderboard_entry_player_display_name(const sb_leaderboard_t *leaderboard, size_t index,
                                               const char **display_name)
 {
-    const auto *entry = getEntry(leaderboard, index);
-    if (entry == nullptr || display_name == nullptr || entry->player.displayName.empty()) {
-        return false;
-    }
-
-    *display_name = entry->player.displayName.c_str();
-    return true;
+    return getString(leaderboard, index, LeaderboardString::PlayerDisplayName, display_name);
 }
 
 bool sb_leaderboard_entry_player_initials(const sb_leaderboard_t *leaderboard, size_t index,
                                           const char **initials)
 {
-    const auto *entry = getEntry(leaderboard, index);
-    if (entry == nullptr || initials == nullptr || entry->player.initials.empty()) {
-        return false;
-    }
-
-    *initials = entry->player.initials.c_str();
-    return true;
+    return getString(leaderboard, index, LeaderboardString::PlayerInitials, initials);
 }
 
 bool sb_leaderboard_entry_player_avatar(const sb_leaderboard_t *leaderboard, size_t index,
                                         const char **avatar)
 {
-    const auto *entry = getEntry(leaderboard, index);
-    if (entry == nullptr || avatar == nullptr || entry->player.avatar.empty()) {
-        return false;
-    }
-
-    *avatar = entry->player.avatar.c_str();
-    return true;
+    return getString(leaderboard, index, LeaderboardString::PlayerAvatar, avatar);
 }
 
 bool sb_leaderboard_entry_player_follower_count(const sb_leaderboard_t *leaderboard, size_t index,
                                                 int *follower_count)
 {
-    const auto *entry = getEntry(leaderboard, index);
-    if (entry == nullptr || follower_count == nullptr) {
-        return false;
-    }
-
-    *follower_count = entry->player.followerCount;
-    return true;
+    return getValue(leaderboard, index, &LeaderboardData::playerFollowerCounts, follower_count);
 }
 
 bool sb_leaderboard_entry_player_following_count(const sb_leaderboard_t *leaderboard, size_t index,
                                                  int *following_count)
 {
-    const auto *entry = getEntry(leaderboard, index);
-    if (entry == nullptr || following_count == nullptr) {
-        return false;
-    }
-
-    *following_count = entry->player.followingCount;
-    return true;
+    return getValue(leaderboard, index, &LeaderboardData::playerFollowingCounts, following_count);
 }
 
 bool sb_leaderboard_entry_player_last_login(const sb_leaderboard_t *leaderboard, size_t index,
                                             const char **last_login)
 {
-    const auto *entry = getEntry(leaderboard, index);
-    if (entry == nullptr || last_login == nullptr || entry->player.lastLogin.empty()) {
-        return false;
-    }
-
-    *last_login = entry->player.lastLogin.c_str();
-    return true;
+    return getString(leaderboard, index, LeaderboardString::PlayerLastLogin, last_login);
 }
@@ -0,0 +1,227 @@
+/*
+ * Scorbit SDK
+ *
+ * (c) 2025 Spinner Systems, Inc. (DBA Scorbit), scrobit.io, All Rights Reserved
+ *
+ * MIT License
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "leaderboard_cache.h"
+
+#include <utility>
+
+namespace scorbit {
+namespace detail {
+
+LeaderboardCache::LeaderboardCache(Clock::duration ttl, Clock::duration staleWindow,
+                                   size_t capacity)
+    : m_ttl(ttl)
+    , m_staleWindow(staleWindow)
+    , m_capacity(capacity)
+    , m_entries(capacity)
+{
+}
+
+void LeaderboardCache::setTtl(Clock::duration ttl, Clock::duration staleWindow)
+{
+    std::scoped_lock lock(m_mutex);
+    m_ttl = ttl;
+    m_staleWindow = staleWindow;
+}
+
+LeaderboardCache::Lookup LeaderboardCache::lookup(const LeaderboardQuery &query,
+                                                  Clock::time_point now)
+{
+    std::scoped_lock lock(m_mutex);
+
+    Entry entry;
+    if (!m_entries.get(query, entry) || !entry.data || entry.invalidated) {
+        return {};
+    }
+
+    const auto age = now - entry.fetchedAt;
+    if (age < m_ttl) {
+        return {Freshness::Fresh, std::move(entry.data), entry.updatedAt};
+    }
+    if (age < m_ttl + m_staleWindow) {
+        return {Freshness::Stale, std::move(entry.data), entry.updatedAt};
+    }
+    return {};
+}
+
+std::optional<uint64_t> LeaderboardCache::beginFetch(const LeaderboardQuery &query,
+                                                     DataCallback waiter, Validators *validators)
+{
+    std::scoped_lock lock(m_mutex);
+
+    // Fetches of older generations are left to their own waiters
+    auto [it, inserted] = m_inFlight[query].try_emplace(m_generation);
+    if (waiter) {
+        it->second.push_back(std::move(waiter));
+    }
+
+    if (inserted && validators) {
+        Entry entry;
+        if (m_entries.get(query, entry)) {
+            *validators = std::move(entry.validators);
+        } else {
+            *validators = {};
+        }
+    }
+
+    if (!inserted) {
+        return std::nullopt;
+    }
+    return m_generation;
+}
+
+void LeaderboardCache::completeFetch(const LeaderboardQuery &query, uint64_t generation,
+                                     LeaderboardDataPtr data, Validators validators,
+                                     Clock::time_point now)
+{
+    const auto updatedAt = std::chrono::system_clock::now();
+    {
+        std::scoped_lock lock(m_mutex);
+        if (generation == m_generation) {
+            m_entries.put(query, Entry {data, std::move(validators), now, updatedAt});
+        }
+    }
+
+    for (auto &waiter : takeWaiters(query, generation)) {
+        waiter(Error::Success, data, updatedAt);
+    }
+}
+
+void LeaderboardCache::completeNotModified(const LeaderboardQuery &query, uint64_t generation,
+                                           Validators validators, Clock::time_point now)
+{
+    LeaderboardDataPtr data;
+    const auto updatedAt = std::chrono::system_clock::now();
+    {
+        std::scoped_lock lock(m_mutex);
+        Entry entry;
+        if (m_entries.get(query, entry) && entry.data) {
+            data = entry.data;
+        }
+        // Fetch started before invalidate() confirms the outdated result, it's not fresh then
+        if (data && generation == m_generation) {
+            entry.updatedAt = updatedAt;
+            // Server may omit validators in 304 reply, then keep the ones we sent
+            if (!validators.etag.empty() || !validators.lastModified.empty()) {
+                entry.validators = std::move(validators);
+            }
+            entry.fetchedAt = now;
+            entry.invalidated = false;
+            m_entries.put(query, std::move(entry));
+        }
+    }
+
+    // Entry could be evicted or cleared while request was in flight, nothing to serve then
+    const auto error = data ? Error::Success : Error::ApiError;
+    for (auto &waiter : takeWaiters(query, generation)) {
+        waiter(error, data, updatedAt);
+    }
+}
+
+void LeaderboardCache::failFetch(const LeaderboardQuery &query, uint64_t generation, Error error)
+{
+    for (auto &waiter : takeWaiters(query, generation)) {
+        waiter(error, nullptr, {});
+    }
+}
+
+void LeaderboardCache::clear()
+{
+    std::scoped_lock lock(m_mutex);
+    ++m_generation;
+    m_entries = LRUCache<LeaderboardQuery, Entry>(m_capacity);
+}
+
+void LeaderboardCache::invalidate()
+{
+    std::scoped_lock lock(m_mutex);
+    ++m_generation;
+    m_entries.forEach([](const LeaderboardQuery &, Entry &entry) {
+        entry.invalidated = true;
+    });
+}
+
+std::vector<LeaderboardCache::DataCallback> LeaderboardCache::takeWaiters(
+        const LeaderboardQuery &query, uint64_t generation)
+{
+    std::scoped_lock lock(m_mutex);
+
+    std::vector<DataCallback> waiters;
+    if (auto it = m_inFlight.find(query); it != m_inFlight.end()) {
+        if (auto fetch = it->second.find(generation); fetch != it->second.end()) {
+            waiters = std::move(fetch->second);
+            it->second.erase(fetch);
+        }
+        if (it->second.empty()) {
+            m_inFlight.erase(it);
+        }
+    }
+    return waiters;
+}
+
+LeaderboardBatch::LeaderboardBatch(size_t count, LeaderboardMultiCallback callback)
+    : m_errors(count, Error::Unknown)
+    , m_leaderboards(count, nullptr)
+    , m_completed(count, false)
+    , m_remaining(count)
+    , m_callback(std::move(callback))
+{
+    if (count == 0 && m_callback) {
+        m_callback({}, {});
+    }
+}
+
+LeaderboardBatch::~LeaderboardBatch()
+{
+    // Not reported, e.g. the batch was abandoned on shutdown
+    for (auto *leaderboard : m_leaderboards) {
+        destroyLeaderboard(leaderboard);
+    }
+}
+
+void LeaderboardBatch::complete(size_t index, Error error, LeaderboardDataPtr data,
+                                LeaderboardCache::SystemTime updatedAt)
+{
+    {
+        std::scoped_lock lock(m_mutex);
+        if (index >= m_errors.size() || m_completed[index] || m_remaining == 0) {
+            return;
+        }
+        m_completed[index] = true;
+
+        m_errors[index] = error;
+        m_leaderboards[index] = data ? makeLeaderboardHandle(std::move(data), updatedAt) : nullptr;
+        if (--m_remaining > 0) {
+            return;
+        }
+    }
+
+    auto leaderboards = std::move(m_leaderboards);
+    m_leaderboards.clear();
+    if (m_callback) {
+        m_callback(std::move(m_errors), std::move(leaderboards));
+    } else {
+        for (auto *leaderboard : leaderboards) {
+            destroyLeaderboard(leaderboard);
+        }
+    }
+}
+
+} // namespace detail
+} // namespace scorbit
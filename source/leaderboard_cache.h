@@ -0,0 +1,162 @@
+/*
+ * Scorbit SDK
+ *
+ * (c) 2025 Spinner Systems, Inc. (DBA Scorbit), scrobit.io, All Rights Reserved
+ *
+ * MIT License
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "leaderboard_internal.h"
+#include "utils/lru_cache.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace scorbit {
+namespace detail {
+
+constexpr auto LEADERBOARD_CACHE_TTL = std::chrono::seconds {30};
+constexpr auto LEADERBOARD_CACHE_STALE_WINDOW = std::chrono::seconds {300};
+constexpr size_t LEADERBOARD_CACHE_MAX_ENTRIES = 64;
+
+/**
+ * @brief LeaderboardCache keeps parsed leaderboards shared between callers.
+ *
+ * Within TTL the result is fresh and served without request. After TTL, during stale window,
+ * the result is still served but should be revalidated in the background. Entries older than
+ * that are a miss, though their validators are kept for a conditional request.
+ *
+ * Concurrent requests for the same query are coalesced: only the first caller of beginFetch()
+ * fetches, the others wait for its result. Thread-safe, callbacks are called without lock held.
+ */
+class LeaderboardCache
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    using SystemTime = std::chrono::system_clock::time_point;
+    /// @p updatedAt is when the server last confirmed @p data
+    using DataCallback =
+            std::function<void(Error error, LeaderboardDataPtr data, SystemTime updatedAt)>;
+
+    enum class Freshness {
+        Miss,
+        Fresh,
+        Stale,
+    };
+
+    struct Lookup {
+        Freshness freshness {Freshness::Miss};
+        LeaderboardDataPtr data; // Set for Fresh and Stale
+        SystemTime updatedAt;
+    };
+
+    /// ETag and Last-Modified of cached result, sent as If-None-Match and If-Modified-Since
+    struct Validators {
+        std::string etag;
+        std::string lastModified;
+    };
+
+    LeaderboardCache(Clock::duration ttl = LEADERBOARD_CACHE_TTL,
+                     Clock::duration staleWindow = LEADERBOARD_CACHE_STALE_WINDOW,
+                     size_t capacity = LEADERBOARD_CACHE_MAX_ENTRIES);
+
+    void setTtl(Clock::duration ttl, Clock::duration staleWindow);
+
+    Lookup lookup(const LeaderboardQuery &query, Clock::time_point now = Clock::now());
+
+    /**
+     * Register @p waiter (may be empty, e.g. for background revalidation) for the query result.
+     * Fetch started before clear() or invalidate() is not joined, it may bring outdated result.
+     * @return Fetch generation if there was no fetch in flight and caller must fetch and then
+     * call completeFetch(), completeNotModified() or failFetch() with it. @p validators is filled
+     * in then.
+     */
+    std::optional<uint64_t> beginFetch(const LeaderboardQuery &query, DataCallback waiter,
+                                       Validators *validators = nullptr);
+
+    void completeFetch(const LeaderboardQuery &query, uint64_t generation,
+                       LeaderboardDataPtr data, Validators validators,
+                       Clock::time_point now = Clock::now());
+    /// Server replied 304, cached result is fresh again
+    void completeNotModified(const LeaderboardQuery &query, uint64_t generation,
+                             Validators validators, Clock::time_point now = Clock::now());
+    void failFetch(const LeaderboardQuery &query, uint64_t generation, Error error);
+
+    /// Drop cached results, e.g. when machine is unpaired. Fetches in flight still report to
+    /// their waiters, but their results are not cached and new requests don't join them.
+    void clear();
+    /// Make all cached results a miss, e.g. after new score, but keep validators. Results of
+    /// fetches in flight are not cached nor joined, they may predate the change.
+    void invalidate();
+
+private:
+    struct Entry {
+        LeaderboardDataPtr data;
+        Validators validators;
+        Clock::time_point fetchedAt;
+        SystemTime updatedAt;
+        bool invalidated {false}; // Data is known to be outdated, kept for conditional request
+    };
+
+    // Waiters of fetches in flight by the cache generation they started in
+    using InFlight = std::map<uint64_t, std::vector<DataCallback>>;
+
+    std::vector<DataCallback> takeWaiters(const LeaderboardQuery &query, uint64_t generation);
+
+    mutable std::mutex m_mutex;
+    Clock::duration m_ttl;
+    Clock::duration m_staleWindow;
+    size_t m_capacity;
+    LRUCache<LeaderboardQuery, Entry> m_entries;
+    std::unordered_map<LeaderboardQuery, InFlight> m_inFlight;
+    uint64_t m_generation {0}; // Bumped by clear() and invalidate()
+};
+
+/**
+ * @brief Collects results of several leaderboard queries and reports them in one callback.
+ *
+ * Thread-safe, the callback is called by the last complete() call, without lock held, and takes
+ * ownership of the leaderboard handles.
+ */
+class LeaderboardBatch
+{
+public:
+    LeaderboardBatch(size_t count, LeaderboardMultiCallback callback);
+    ~LeaderboardBatch();
+
+    /// Only the first completion of an index counts, repeated ones are ignored
+    void complete(size_t index, Error error, LeaderboardDataPtr data,
+                  LeaderboardCache::SystemTime updatedAt = {});
+
+private:
+    std::mutex m_mutex;
+    std::vector<Error> m_errors;
+    std::vector<sb_leaderboard_t *> m_leaderboards;
+    std::vector<bool> m_completed;
+    size_t m_remaining;
+    LeaderboardMultiCallback m_callback;
+};
+
+} // namespace detail
+} // namespace scorbit
@@ -22,53 +22,110 @@
 #include <scorbit_sdk/leaderboard_c.h>
 #include <scorbit_sdk/net_types.h>
 
+#include <array>
+#include <chrono>
+#include <cstdint>
 #include <functional>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace scorbit {
 namespace detail {
 
-struct LeaderboardPlayerData {
-    std::string id;
-    std::string username;
-    std::string displayName;
-    std::string initials;
-    std::string avatar;
-    int followerCount {0};
-    int followingCount {0};
-    std::string lastLogin;
+/// String fields of leaderboard entry, stored in LeaderboardData::arena
+enum class LeaderboardString : uint8_t {
+    Image,
+    Created,
+    PlayerId,
+    PlayerUsername,
+    PlayerDisplayName,
+    PlayerInitials,
+    PlayerAvatar,
+    PlayerLastLogin,
+
+    // IMPORTANT! This must be last entry!
+    Count,
 };
 
-struct LeaderboardEntryData {
-    uint64_t id {0};
-    int rank {0};
-    LeaderboardPlayerData player;
-    sb_score_t highScore {0};
-    std::string image;
-    int reactionCount {0};
-    int scoreCount {0};
-    bool isNfcVerified {false};
-    bool isVerified {false};
-    bool isVpin {false};
-    std::string created;
+/**
+ * Parsed leaderboard, immutable once created so it can be shared by cache and handles.
+ *
+ * Entries are stored as struct of arrays, one column per field. All strings live in one arena,
+ * NUL-terminated, so the C accessors can return pointers into it without extra allocations.
+ */
+struct LeaderboardData {
+    struct StringRef {
+        uint32_t offset {0};
+        uint32_t size {0}; // Without terminating NUL, 0 - not set
+    };
+
+    std::vector<uint64_t> ids;
+    std::vector<int> ranks;
+    std::vector<sb_score_t> highScores;
+    std::vector<int> reactionCounts;
+    std::vector<int> scoreCounts;
+    std::vector<uint8_t> isNfcVerified;
+    std::vector<uint8_t> isVerified;
+    std::vector<uint8_t> isVpin;
+    std::vector<int> playerFollowerCounts;
+    std::vector<int> playerFollowingCounts;
+    std::array<std::vector<StringRef>, static_cast<size_t>(LeaderboardString::Count)> strings;
+    std::string arena;
+
+    size_t size() const { return ids.size(); }
+
+    /// Append entry with default values, returns its index
+    size_t addEntry();
+    void setString(LeaderboardString field, size_t index, std::string_view value);
+
+    /// NUL-terminated string in the arena, nullptr if not set or empty
+    const char *string(LeaderboardString field, size_t index) const;
+    std::string_view stringView(LeaderboardString field, size_t index) const;
+};
+using LeaderboardDataPtr = std::shared_ptr<const LeaderboardData>;
+
+/// Identifies leaderboard request, also the cache key
+struct LeaderboardQuery {
+    LeaderboardScope scope {LeaderboardScope::Machine};
+    LeaderboardPeriod period {LeaderboardPeriod::AllTime};
+    std::string since;
+    LeaderboardVpinFilter vpinFilter {LeaderboardVpinFilter::Any};
+
+    bool operator==(const LeaderboardQuery &other) const = default;
 };
 
 using LeaderboardHandleCallback = std::function<void(Error error, sb_leaderboard_t *leaderboard)>;
+/// Results in the order of queries, leaderboard is nullptr if its error is not Success
+using LeaderboardMultiCallback = std::function<void(std::vector<Error> errors,
+                                                    std::vector<sb_leaderboard_t *> leaderboards)>;
 
+/// Returns nullptr if reply is not a leaderboard array, throws on malformed json
+LeaderboardDataPtr parseLeaderboardData(const std::string &reply);
 sb_leaderboard_t *parseLeaderboardJson(const std::string &reply);
 
+/// New handle which shares @p data, free it with destroyLeaderboard
+sb_leaderboard_t *makeLeaderboardHandle(LeaderboardDataPtr data,
+                                        std::chrono::system_clock::time_point updatedAt = {});
+
 } // namespace detail
 } // namespace scorbit
 
+template<>
+struct std::hash<scorbit::detail::LeaderboardQuery> {
+    size_t operator()(const scorbit::detail::LeaderboardQuery &query) const noexcept;
+};
+
 struct sb_leaderboard_t {
-    std::vector<scorbit::detail::LeaderboardEntryData> entries;
+    scorbit::detail::LeaderboardDataPtr data;
+    std::chrono::system_clock::time_point updatedAt; // When the server last confirmed the data
 };
 
 namespace scorbit {
 namespace detail {
 
-/** Non-exported: frees heap leaderboards from parseLeaderboardJson (not request_top_scores handles). */
+/** Non-exported: frees the handle, the shared leaderboard data stays alive while referenced. */
 inline void destroyLeaderboard(sb_leaderboard_t *leaderboard)
 {
     delete leaderboard;
@@ -0,0 +1,419 @@
+/*
+ * Scorbit SDK
+ *
+ * (c) 2025 Spinner Systems, Inc. (DBA Scorbit), scrobit.io, All Rights Reserved
+ *
+ * MIT License
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "local_scores.h"
+#include "utils/date_time_parser.h"
+#include <logger/logger.h>
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace scorbit {
+namespace detail {
+
+constexpr uint32_t LOCAL_SCORES_MAGIC = 0x534c4253; // "SBLS"
+constexpr uint16_t LOCAL_SCORES_VERSION = 1;
+
+struct LocalScoreIndex::Header {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t recordSize;
+    uint32_t capacity;
+    uint32_t count; // Updated after the record is written, so a torn write is not counted
+};
+
+struct LocalScoreIndex::Record {
+    int64_t playedAt;
+    int64_t score;
+    uint32_t player;
+    uint32_t reserved;
+    char playerId[40]; // NUL-terminated unless the whole field is used
+    char username[40];
+    char displayName[40];
+    char initials[8];
+};
+
+namespace {
+
+template<size_t N>
+void setField(char (&field)[N], const std::string &value)
+{
+    auto size = std::min(value.size(), N);
+    // Don't cut UTF-8 character in half
+    while (size > 0 && size < value.size() && (value[size] & 0xC0) == 0x80) {
+        --size;
+    }
+    std::memset(field, 0, N);
+    std::memcpy(field, value.data(), size);
+}
+
+template<size_t N>
+std::string getField(const char (&field)[N])
+{
+    return std::string(field, std::find(field, field + N, '\0'));
+}
+
+int64_t toUnixTimestamp(std::chrono::system_clock::time_point time)
+{
+    return std::chrono::duration_cast<std::chrono::seconds>(time.time_since_epoch()).count();
+}
+
+/// Oldest time of scores in the leaderboard, 0 - all of them, nullopt - unknown period
+std::optional<int64_t> localLeaderboardSince(const LeaderboardQuery &query,
+                                             std::chrono::system_clock::time_point now)
+{
+    if (!query.since.empty()) {
+        return std::max<int64_t>(parseIso8601ToUnixTimestamp(query.since), 0);
+    }
+
+    int days = 0;
+    switch (query.period) {
+    case LeaderboardPeriod::AllTime:
+        return 0;
+    case LeaderboardPeriod::Days14:
+        days = 14;
+        break;
+    case LeaderboardPeriod::Days30:
+        days = 30;
+        break;
+    case LeaderboardPeriod::Days90:
+        days = 90;
+        break;
+    case LeaderboardPeriod::Days180:
+        days = 180;
+        break;
+    case LeaderboardPeriod::Days365:
+        days = 365;
+        break;
+    default:
+        return std::nullopt;
+    }
+    return toUnixTimestamp(now - std::chrono::hours {24 * days});
+}
+
+void copyEntry(LeaderboardData &data, size_t index, const LeaderboardData &from, size_t fromIndex)
+{
+    data.ids[index] = from.ids[fromIndex];
+    data.highScores[index] = from.highScores[fromIndex];
+    data.reactionCounts[index] = from.reactionCounts[fromIndex];
+    data.scoreCounts[index] = from.scoreCounts[fromIndex];
+    data.isNfcVerified[index] = from.isNfcVerified[fromIndex];
+    data.isVerified[index] = from.isVerified[fromIndex];
+    data.isVpin[index] = from.isVpin[fromIndex];
+    data.playerFollowerCounts[index] = from.playerFollowerCounts[fromIndex];
+    data.playerFollowingCounts[index] = from.playerFollowingCounts[fromIndex];
+    for (size_t field = 0; field < static_cast<size_t>(LeaderboardString::Count); ++field) {
+        const auto key = static_cast<LeaderboardString>(field);
+        data.setString(key, index, from.stringView(key, fromIndex));
+    }
+}
+
+void copyEntry(LeaderboardData &data, size_t index, const LocalScore &score)
+{
+    data.highScores[index] = score.score;
+    data.setString(LeaderboardString::Created, index, formatUnixTimestampIso8601(score.playedAt));
+    data.setString(LeaderboardString::PlayerId, index, score.playerId);
+    data.setString(LeaderboardString::PlayerUsername, index, score.username);
+    data.setString(LeaderboardString::PlayerDisplayName, index, score.displayName);
+    data.setString(LeaderboardString::PlayerInitials, index, score.initials);
+}
+
+} // namespace
+
+LocalScoreIndex::LocalScoreIndex(size_t capacity)
+    : m_capacity(std::max<size_t>(capacity, 1))
+    , m_keepTop(std::min(LOCAL_SCORES_KEEP_TOP, m_capacity / 2))
+    , m_memory(storageSize())
+    , m_storage(m_memory.data())
+{
+    resetStorage(m_storage);
+}
+
+LocalScoreIndex::~LocalScoreIndex() = default;
+
+bool LocalScoreIndex::open(const std::string &path)
+{
+    std::scoped_lock lock(m_mutex);
+
+    if (!m_file.open(path, storageSize())) {
+        return false;
+    }
+
+    const auto *stored = reinterpret_cast<const Header *>(m_file.data());
+    if (stored->magic != LOCAL_SCORES_MAGIC || stored->version != LOCAL_SCORES_VERSION
+        || stored->recordSize != sizeof(Record) || stored->capacity != m_capacity
+        || stored->count > m_capacity) {
+        // New file or different layout, start over
+        resetStorage(m_file.data());
+    }
+
+    // Scores added before the file was opened are moved into it
+    const auto *pending = records();
+    const auto pendingCount = header()->count;
+    m_storage = m_file.data();
+    for (size_t i = 0; i < pendingCount; ++i) {
+        addRecord(pending[i]);
+    }
+    m_memory = {};
+
+    m_file.flush();
+    return true;
+}
+
+void LocalScoreIndex::add(const LocalScore &score)
+{
+    Record record {};
+    record.playedAt = score.playedAt;
+    record.score = score.score;
+    record.player = score.player;
+    setField(record.playerId, score.playerId);
+    setField(record.username, score.username);
+    setField(record.displayName, score.displayName);
+    setField(record.initials, score.initials);
+
+    std::scoped_lock lock(m_mutex);
+    addRecord(record);
+    m_file.flush();
+}
+
+std::vector<LocalScore> LocalScoreIndex::top(size_t limit, int64_t since) const
+{
+    std::scoped_lock lock(m_mutex);
+
+    const auto *scores = records();
+    const auto isBetter = [scores](uint32_t lhs, uint32_t rhs) {
+        if (scores[lhs].score != scores[rhs].score) {
+            return scores[lhs].score > scores[rhs].score;
+        }
+        // Who got the score first ranks higher
+        return scores[lhs].playedAt < scores[rhs].playedAt;
+    };
+
+    // Heap of the best scores found so far, the worst of them on top to be replaced
+    std::vector<uint32_t> best;
+    best.reserve(limit);
+    for (uint32_t i = 0; i < header()->count && limit > 0; ++i) {
+        if (scores[i].playedAt < since) {
+            continue;
+        }
+
+        if (best.size() < limit) {
+            best.push_back(i);
+            std::push_heap(best.begin(), best.end(), isBetter);
+        } else if (isBetter(i, best.front())) {
+            std::pop_heap(best.begin(), best.end(), isBetter);
+            best.back() = i;
+            std::push_heap(best.begin(), best.end(), isBetter);
+        }
+    }
+    std::sort_heap(best.begin(), best.end(), isBetter);
+
+    std::vector<LocalScore> result;
+    result.reserve(best.size());
+    for (const auto i : best) {
+        const auto &record = scores[i];
+        result.push_back({record.playedAt, record.score, record.player, getField(record.playerId),
+                          getField(record.username), getField(record.displayName),
+                          getField(record.initials)});
+    }
+    return result;
+}
+
+size_t LocalScoreIndex::size() const
+{
+    std::scoped_lock lock(m_mutex);
+    return header()->count;
+}
+
+LocalScoreIndex::Header *LocalScoreIndex::header() const
+{
+    return reinterpret_cast<Header *>(m_storage);
+}
+
+LocalScoreIndex::Record *LocalScoreIndex::records() const
+{
+    return reinterpret_cast<Record *>(m_storage + sizeof(Header));
+}
+
+size_t LocalScoreIndex::storageSize() const
+{
+    return sizeof(Header) + m_capacity * sizeof(Record);
+}
+
+void LocalScoreIndex::resetStorage(uint8_t *storage)
+{
+    static_assert(std::is_trivially_copyable_v<Record>);
+    static_assert(sizeof(Header) % alignof(Record) == 0);
+
+    std::memset(storage, 0, storageSize());
+    auto *h = reinterpret_cast<Header *>(storage);
+    h->magic = LOCAL_SCORES_MAGIC;
+    h->version = LOCAL_SCORES_VERSION;
+    h->recordSize = sizeof(Record);
+    h->capacity = static_cast<uint32_t>(m_capacity);
+}
+
+void LocalScoreIndex::addRecord(const Record &record)
+{
+    auto *h = header();
+    if (h->count < m_capacity) {
+        records()[h->count] = record;
+        ++h->count;
+    } else {
+        records()[evictionIndex()] = record;
+    }
+}
+
+size_t LocalScoreIndex::evictionIndex() const
+{
+    const auto *scores = records();
+    const size_t count = header()->count;
+
+    // Scores below the best ones are evicted oldest first
+    int64_t threshold = std::numeric_limits<int64_t>::min();
+    if (m_keepTop > 0) {
+        std::vector<int64_t> values(count);
+        std::transform(scores, scores + count, values.begin(),
+                       [](const Record &record) { return record.score; });
+        std::nth_element(values.begin(), values.begin() + (m_keepTop - 1), values.end(),
+                         std::greater<> {});
+        threshold = values[m_keepTop - 1];
+    }
+
+    size_t victim = count;
+    for (size_t i = 0; i < count; ++i) {
+        if ((m_keepTop == 0 || scores[i].score < threshold)
+            && (victim == count || scores[i].playedAt < scores[victim].playedAt)) {
+            victim = i;
+        }
+    }
+
+    if (victim == count) {
+        // All scores tie with the best ones, replace the oldest of the lowest
+        victim = static_cast<size_t>(
+                std::min_element(scores, scores + count,
+                                 [](const Record &lhs, const Record &rhs) {
+                                     return lhs.score != rhs.score ? lhs.score < rhs.score
+                                                                   : lhs.playedAt < rhs.playedAt;
+                                 })
+                - scores);
+    }
+    return victim;
+}
+
+LeaderboardDataPtr makeLocalLeaderboard(const LocalScoreIndex &index,
+                                        const LeaderboardQuery &query,
+                                        const LeaderboardData *server,
+                                        std::chrono::system_clock::time_point serverUpdatedAt,
+                                        std::chrono::system_clock::time_point now)
+{
+    const size_t serverSize = server ? server->size() : 0;
+    const auto limit = std::max(serverSize, LOCAL_LEADERBOARD_SIZE);
+
+    auto since = localLeaderboardSince(query, now);
+    if (!since) {
+        WRN("Local leaderboard has unknown period {}", static_cast<int>(query.period));
+        return nullptr;
+    }
+    if (server) {
+        since = std::max(*since, toUnixTimestamp(serverUpdatedAt));
+    }
+
+    // Scores played here are never virtual pinball ones. All of them are taken, as some drop out
+    // below when the player is listed already
+    std::vector<LocalScore> local;
+    if (query.vpinFilter != LeaderboardVpinFilter::VpinOnly) {
+        local = index.top(index.size(), *since);
+    }
+
+    // Server lists each player once with their best score, so do local scores: only the best one
+    // of a player stays, and only if it beats the player's server entry
+    std::unordered_map<std::string, sb_score_t> serverBest;
+    for (size_t s = 0; s < serverSize; ++s) {
+        const auto playerId = server->stringView(LeaderboardString::PlayerId, s);
+        if (!playerId.empty()) {
+            serverBest.emplace(playerId, server->highScores[s]);
+        }
+    }
+
+    std::unordered_set<std::string> seen;
+    std::erase_if(local, [&](const LocalScore &score) {
+        if (score.playerId.empty()) {
+            return false; // Not claimed, nobody to compare with
+        }
+        if (!seen.insert(score.playerId).second) {
+            return true;
+        }
+        const auto it = serverBest.find(score.playerId);
+        return it != serverBest.end() && score.score <= it->second;
+    });
+    if (local.size() > limit) {
+        local.resize(limit);
+    }
+
+    // Server entries of players who did better here are replaced by the local score
+    std::unordered_set<std::string> replaced;
+    for (const auto &score : local) {
+        if (serverBest.contains(score.playerId)) {
+            replaced.insert(score.playerId);
+        }
+    }
+    std::vector<size_t> serverEntries;
+    serverEntries.reserve(serverSize);
+    for (size_t s = 0; s < serverSize; ++s) {
+        const auto playerId = server->stringView(LeaderboardString::PlayerId, s);
+        if (playerId.empty() || !replaced.contains(std::string {playerId})) {
+            serverEntries.push_back(s);
+        }
+    }
+
+    auto data = std::make_shared<LeaderboardData>();
+    data->arena.reserve((server ? server->arena.size() : 0) + local.size() * 96);
+
+    // Both are ranked best first, server entry stays ahead on tie as it was there earlier
+    size_t s = 0;
+    size_t l = 0;
+    while (data->size() < limit && (s < serverEntries.size() || l < local.size())) {
+        const bool isLocal = l < local.size()
+                          && (s >= serverEntries.size()
+                              || local[l].score > server->highScores[serverEntries[s]]);
+        const auto i = data->addEntry();
+        if (isLocal) {
+            copyEntry(*data, i, local[l++]);
+        } else {
+            copyEntry(*data, i, *server, serverEntries[s++]);
+        }
+
+        // Equal scores share the rank
+        data->ranks[i] = i > 0 && data->highScores[i] == data->highScores[i - 1]
+                               ? data->ranks[i - 1]
+                               : static_cast<int>(i + 1);
+    }
+
+    return data;
+}
+
+} // namespace detail
+} // namespace scorbit
@@ -0,0 +1,110 @@
+/*
+ * Scorbit SDK
+ *
+ * (c) 2025 Spinner Systems, Inc. (DBA Scorbit), scrobit.io, All Rights Reserved
+ *
+ * MIT License
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "leaderboard_internal.h"
+#include "utils/mapped_file.h"
+#include <scorbit_sdk/common_types_c.h>
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace scorbit {
+namespace detail {
+
+constexpr size_t LOCAL_SCORES_CAPACITY = 2048; // Final scores kept, about 300 KB on disk
+constexpr size_t LOCAL_SCORES_KEEP_TOP = 100;  // All-time best scores are never evicted
+constexpr size_t LOCAL_LEADERBOARD_SIZE = 10;  // Minimum entries in local leaderboard
+
+/// Final score of a player in a game played on this machine
+struct LocalScore {
+    int64_t playedAt {0}; // Unix time, seconds
+    sb_score_t score {0};
+    sb_player_t player {0};
+    std::string playerId; // Empty if player was not claimed
+    std::string username;
+    std::string displayName;
+    std::string initials;
+};
+
+/**
+ * @brief Index of final scores played on this machine, answers top-N queries without network.
+ *
+ * Scores are fixed size records in a memory mapped file, so they survive restarts and adding a
+ * score doesn't wait for I/O. Without a file the index is kept in memory only. When full, the
+ * oldest score which is not among the all-time best ones is replaced. Thread-safe.
+ */
+class LocalScoreIndex
+{
+public:
+    explicit LocalScoreIndex(size_t capacity = LOCAL_SCORES_CAPACITY);
+    ~LocalScoreIndex();
+
+    /**
+     * @brief Keep scores in @p path, scores stored there before are loaded.
+     * @return false if the file can't be used, index stays in memory then
+     */
+    bool open(const std::string &path);
+
+    void add(const LocalScore &score);
+
+    /// Best @p limit scores played at or after @p since (Unix seconds), best first
+    std::vector<LocalScore> top(size_t limit, int64_t since = 0) const;
+
+    size_t size() const;
+
+private:
+    struct Header;
+    struct Record;
+
+    Header *header() const;
+    Record *records() const;
+    size_t storageSize() const;
+    void resetStorage(uint8_t *storage);
+    void addRecord(const Record &record);
+    size_t evictionIndex() const;
+
+    const size_t m_capacity;
+    const size_t m_keepTop;
+    mutable std::mutex m_mutex;
+    MappedFile m_file;
+    std::vector<uint8_t> m_memory; // Used until file is opened
+    uint8_t *m_storage {nullptr};
+};
+
+/**
+ * @brief Leaderboard of @p query answered locally.
+ *
+ * Local scores are merged into the machine leaderboard @p server, if there is one, and ranked
+ * again. Only scores played after the server leaderboard was fetched (@p serverUpdatedAt) are
+ * merged, older ones are already part of it. Like on the server, each player is listed once with
+ * their best score. Returns nullptr if the query period is unknown.
+ */
+LeaderboardDataPtr makeLocalLeaderboard(
+        const LocalScoreIndex &index, const LeaderboardQuery &query,
+        const LeaderboardData *server = nullptr,
+        std::chrono::system_clock::time_point serverUpdatedAt = {},
+        std::chrono::system_clock::time_point now = std::chrono::system_clock::now());
+
+} // namespace detail
+} // namespace scorbit
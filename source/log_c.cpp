@@ -19,6 +19,8 @@
 
 #include <scorbit_sdk/log_c.h>
 #include <logger/logger_callback.h>
+#include <chrono>
+#include <vector>
 
 bool sb_logger_callbacks_supported(void)
 {
@@ -36,7 +38,71 @@ void sb_add_logger_callback(sb_log_callback_t callback, void *user_data, size_t
             max_length);
 }
 
+void sb_log_set_batch_callback(sb_log_batch_callback_t callback, void *user_data,
+                               size_t max_count, int max_delay_ms, size_t max_length)
+{
+    if (!callback) {
+        logger::setBatchCallback({}, 0, {});
+        return;
+    }
+
+    constexpr size_t DEFAULT_MAX_COUNT = 64;
+    constexpr int DEFAULT_MAX_DELAY_MS = 100;
+
+    // Never invoked concurrently, so the conversion buffer is reused
+    std::vector<sb_log_record_t> cRecords;
+    logger::setBatchCallback(
+            [callback, user_data, cRecords](const std::vector<logger::LogRecord> &records) mutable {
+                cRecords.clear();
+                for (const auto &record : records) {
+                    cRecords.push_back({record.message.c_str(),
+                                        static_cast<sb_log_level_t>(record.level), record.file,
+                                        record.line, record.timestamp});
+                }
+                callback(cRecords.data(), cRecords.size(), user_data);
+            },
+            max_count > 0 ? max_count : DEFAULT_MAX_COUNT,
+            std::chrono::milliseconds {max_delay_ms > 0 ? max_delay_ms : DEFAULT_MAX_DELAY_MS},
+            max_length);
+}
+
 void sb_reset_logger(void)
 {
     logger::resetCallbacks();
 }
+
+void sb_log_set_level(sb_log_level_t level)
+{
+    logger::setLevel(static_cast<logger::LogLevel>(level));
+}
+
+sb_log_level_t sb_log_get_level(void)
+{
+    return static_cast<sb_log_level_t>(logger::level());
+}
+
+void sb_log_set_deferred_format(bool enabled, size_t buffer_size)
+{
+    if (buffer_size == 0) {
+        logger::setDeferredFormat(enabled);
+    } else {
+        logger::setDeferredFormat(enabled, buffer_size);
+    }
+}
+
+uint64_t sb_log_dropped_count(void)
+{
+    return logger::droppedCount();
+}
+
+size_t sb_log_rate_limited_sites(sb_log_site_stats_t *stats, size_t capacity)
+{
+    size_t count = 0;
+    logger::forEachRateLimitSite([stats, capacity, &count](const logger::RateLimitStats &site) {
+        if (stats && count < capacity) {
+            stats[count] = {site.file, site.line, site.logged, site.suppressed};
+        }
+        ++count;
+    });
+    return count;
+}
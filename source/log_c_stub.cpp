@@ -18,6 +18,7 @@
  */
 
 #include <scorbit_sdk/log_c.h>
+#include <logger/logger_spdlog.h>
 
 bool sb_logger_callbacks_supported(void)
 {
@@ -31,4 +32,47 @@ void sb_add_logger_callback(sb_log_callback_t callback, void *user_data, size_t
     (void)max_length;
 }
 
+void sb_log_set_batch_callback(sb_log_batch_callback_t callback, void *user_data,
+                               size_t max_count, int max_delay_ms, size_t max_length)
+{
+    (void)callback;
+    (void)user_data;
+    (void)max_count;
+    (void)max_delay_ms;
+    (void)max_length;
+}
+
 void sb_reset_logger(void) {}
+
+void sb_log_set_level(sb_log_level_t level)
+{
+    logger::setLevel(static_cast<logger::LogLevel>(level));
+}
+
+sb_log_level_t sb_log_get_level(void)
+{
+    return static_cast<sb_log_level_t>(logger::level());
+}
+
+void sb_log_set_deferred_format(bool enabled, size_t buffer_size)
+{
+    (void)enabled;
+    (void)buffer_size;
+}
+
+uint64_t sb_log_dropped_count(void)
+{
+    return logger::Logger::instance()->droppedCount();
+}
+
+size_t sb_log_rate_limited_sites(sb_log_site_stats_t *stats, size_t capacity)
+{
+    size_t count = 0;
+    logger::forEachRateLimitSite([stats, capacity, &count](const logger::RateLimitStats &site) {
+        if (stats && count < capacity) {
+            stats[count] = {site.file, site.line, site.logged, site.suppressed};
+        }
+        ++count;
+    });
+    return count;
+}
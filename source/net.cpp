@@ -21,9 +21,11 @@
 #include "net_util.h"
 #include "soft_key_resolver.h"
 #include "fmt_formatters.h"
+#include "flight_recorder.h"
 #include <logger/logger.h>
 #include "updater.h"
 #include "safe_multipart.h"
+#include "streaming_multipart.h"
 #include "utils/machine_fingerprint.h"
 #include "utils/date_time_parser.h"
 #include "utils/jwt_parser.h"
@@ -45,6 +47,7 @@
 #include <algorithm>
 #include <ranges>
 #include <fstream>
+#include <charconv>
 #include <optional>
 #include <future>
 
@@ -78,6 +81,12 @@ constexpr auto NUM_RETRIES = 3;
 
 constexpr auto REFRESH_TOKEN_BEFORE_EXPIRY = 5min; // Refresh token when 5 minutes remain
 
+constexpr auto CF_REFRESH_TOKEN_BEFORE_EXPIRY = 3min; // Centrifugo client asks for new token then
+constexpr auto CF_TOKEN_PREFETCH_BEFORE_EXPIRY = 5min; // New one is ready before client asks
+constexpr auto CF_TOKEN_MIN_VALIDITY = CF_REFRESH_TOKEN_BEFORE_EXPIRY + 1min;
+constexpr auto CF_TOKEN_RETRY_DELAY = 10s;
+constexpr auto CF_TOKEN_UNKNOWN_LIFETIME = 10min; // Token without expiration claim
+
 constexpr size_t DIAG_MAX_LOGS = 5;
 constexpr size_t DIAG_MAX_RECORDINGS = 2;
 constexpr uintmax_t DIAG_MAX_LOG_SIZE = 10 * 1024 * 1024 + 100;       // 10 MB
@@ -90,6 +99,11 @@ constexpr auto SESSION_UPDATE_NO_UUID_RETRY = 1000ms;
 constexpr auto TOP_SCORES_DEFER_RETRY = 1000ms;
 constexpr int TOP_SCORES_DEFER_MAX_ATTEMPTS = 30;
 constexpr auto CF_RETIRED_CLIENT_GRACE_PERIOD = 30s;
+constexpr auto CF_RECONNECT_MIN_DELAY = 1s;
+constexpr auto CF_RECONNECT_FIRST_DELAY = 10s; // Upper bound, jittered down to min delay
+constexpr auto CF_RECONNECT_MAX_DELAY = 5min;
+constexpr unsigned CF_RECONNECT_REUSE_ATTEMPTS = 2; // Then the client is built anew
+constexpr auto REPEATED_LOG_INTERVAL = 30s; // Repeating messages during outages, e.g. retries
 
 constexpr auto NFC_CHECK_TIME = 2000ms;    // Check NFC nonces every 1000 milliseconds
 constexpr auto NFC_BOOT_REASON_DELAY = 5s; // Check NFC boot reason every 5 seconds
@@ -97,8 +111,18 @@ constexpr auto NFC_BOOT_REASON_DELAY = 5s; // Check NFC boot reason every 5 seco
 constexpr auto MAX_BUFFER_DOWNLOAD_SIZE = 10 * 1024 * 1024; // 10 MB max size to download to memory
 constexpr auto PICTURE_BUFFER_RESERVE = 300 * 1024;         // 300 KB reserve for picture download
 
+constexpr size_t DOWNLOAD_ERROR_BODY_LIMIT = 4 * 1024; // Keep only the head of error replies
+
 constexpr auto MAX_SYSTEM_TIME_DRIFT_SECONDS = 20;
 
+// Machine info section of warm start cache
+constexpr auto JKEY_WARM_OPDB_ID {"opdb_id"};
+constexpr auto JKEY_WARM_MACHINE_UUID {"machine_uuid"};
+constexpr auto JKEY_WARM_VARIANT_UUID {"variant_uuid"};
+constexpr auto JKEY_WARM_GAME_SLUG {"game_slug"};
+constexpr auto JKEY_WARM_VENUE_UUID {"venue_uuid"};
+constexpr auto JKEY_WARM_TITLE {"title"};
+
 auto noop_task = []() { };
 
 std::optional<std::string_view> leaderboardPeriodParam(LeaderboardPeriod period)
@@ -121,12 +145,37 @@ std::optional<std::string_view> leaderboardPeriodParam(LeaderboardPeriod period)
     return std::nullopt;
 }
 
-std::string elideUrl(const std::string &url, size_t keep = 20)
+/// Period query parameter for valid leaderboard query (empty if not needed), nullopt if invalid
+std::optional<std::string_view> leaderboardQueryPeriodParam(const LeaderboardQuery &query)
+{
+    if (query.scope != LeaderboardScope::Machine && query.scope != LeaderboardScope::Variant
+        && query.scope != LeaderboardScope::Game) {
+        return std::nullopt;
+    }
+
+    if (query.vpinFilter != LeaderboardVpinFilter::Any
+        && query.vpinFilter != LeaderboardVpinFilter::VpinOnly
+        && query.vpinFilter != LeaderboardVpinFilter::RealOnly) {
+        return std::nullopt;
+    }
+
+    if (!query.since.empty()) {
+        return std::string_view {};
+    }
+    return leaderboardPeriodParam(query.period);
+}
+
+// Reports request result to the boot step after the reply is handled
+StringCallback withStepDone(StringCallback callback, BootSequence::Done done)
 {
-    if (url.size() <= keep * 2 + 3) {
-        return url;
+    if (!done) {
+        return callback;
     }
-    return url.substr(0, keep) + "..." + url.substr(url.size() - keep);
+    return [callback = std::move(callback), done = std::move(done)](Error error,
+                                                                    const std::string &reply) {
+        callback(error, reply);
+        done(error == Error::Success);
+    };
 }
 
 string getSignature(const SignerCallback &signer, const std::string &uuid,
@@ -153,7 +202,7 @@ std::string getJwtToken(const std::string &url, const std::string &authToken,
 {
     INF("API-CF getting JWT token from: {}", url);
 
-    // Note: This is synchronous as required by centrifugo library callback
+    // Blocking, called on the worker pool by the token prefetcher
     const auto r = cpr::Get(cpr::Url {url},
                             cpr::Header {{HDR_KEY_AUTHORIZATION, HDR_VAL_BEARER + authToken}},
                             cpr::Timeout {NET_TIMEOUT}, sslOptions);
@@ -182,13 +231,35 @@ std::string getJwtToken(const std::string &url, const std::string &authToken,
 
 Net::Net(DeviceInfo deviceInfo, std::vector<std::unique_ptr<IKeyResolver>> resolvers)
     : m_keyResolvers(std::move(resolvers))
+    , m_cfTokens([this]() { return fetchCfToken(); }, getJwtTokenLifetime,
+                 [this](task_t task) { m_worker.post(std::move(task)); },
+                 [this](steady_clock::duration delay, task_t task) {
+                     m_worker.startTimer(Worker::Timer::CentrifugoToken, delay, std::move(task));
+                 },
+                 {
+                         .prefetchBefore = CF_TOKEN_PREFETCH_BEFORE_EXPIRY,
+                         .minValidity = CF_TOKEN_MIN_VALIDITY,
+                         .retryDelay = CF_TOKEN_RETRY_DELAY,
+                         .unknownLifetime = CF_TOKEN_UNKNOWN_LIFETIME,
+                 })
     , m_deviceInfo(std::move(deviceInfo))
     , m_updater(*this, m_deviceInfo.usesEncryptedKey(), m_deviceInfo.scorbitdVersion,
                 m_deviceInfo.scorbitdPlatformId)
     , m_worker(m_deviceInfo.threadsNice)
+    , m_cfBackoff({.minDelay = CF_RECONNECT_MIN_DELAY,
+                   .firstCeiling = CF_RECONNECT_FIRST_DELAY,
+                   .maxDelay = CF_RECONNECT_MAX_DELAY})
     , m_eventManager(std::make_shared<EventManager>(m_worker.eventsStrand(),
                                                     std::move(m_deviceInfo.m_eventCallback)))
 {
+    if (!m_deviceInfo.flightRecorderPath.empty()) {
+        if (startFlightRecorder(m_deviceInfo.flightRecorderPath)) {
+            FlightRecorder::instance().event("SDK {} started", SCORBIT_SDK_VERSION);
+        } else {
+            WRN("API can't open flight recorder file {}", m_deviceInfo.flightRecorderPath);
+        }
+    }
+
     setHostname(m_deviceInfo.hostname, m_deviceInfo.cfHostname);
 
     if (!validateDeviceInfo()) {
@@ -200,7 +271,20 @@ Net::Net(DeviceInfo deviceInfo, std::vector<std::unique_ptr<IKeyResolver>> resol
     m_fingerprintHash = m_fingerprint.computeHash();
     INF("API fingerprint hash: {}", m_fingerprintHash);
 
+    m_playersManager.setCacheDir(m_deviceInfo.pictureCacheDir);
+    m_leaderboardCache.setTtl(std::chrono::seconds {m_deviceInfo.leaderboardCacheTtl},
+                              std::chrono::seconds {m_deviceInfo.leaderboardCacheStaleWindow});
+    if (!m_deviceInfo.localScoresPath.empty()
+        && !m_localScores.open(m_deviceInfo.localScoresPath)) {
+        WRN("API can't open local scores file {}, keeping them in memory",
+            m_deviceInfo.localScoresPath);
+    }
+    if (!m_deviceInfo.warmStartCachePath.empty()) {
+        loadWarmStartCache();
+    }
+
     initScorbitronObject();
+    registerPublicationHandlers();
     centrifugoSetup();
     m_worker.start();
 }
@@ -293,6 +377,7 @@ Net::~Net()
     if (!m_stop.exchange(true)) {
         stopHeartbeatTimer();
         stopTokenRefreshTimer();
+        m_cfTokens.stop();
         m_eventManager->stop();
         m_authCV.notify_all();
         m_shortCodeCV.notify_all();
@@ -325,6 +410,13 @@ AuthStatus Net::status() const
     return m_status;
 }
 
+void Net::setStatus(AuthStatus status)
+{
+    if (m_status.exchange(status) != status) {
+        FlightRecorder::instance().event("Auth status: {}", status);
+    }
+}
+
 const string &Net::hostname() const
 {
     return m_hostname;
@@ -370,6 +462,12 @@ void Net::setHostname(std::string hostname, std::string cfHostname)
     }
 }
 
+BootMetrics Net::bootMetrics() const
+{
+    std::scoped_lock lock(m_bootMutex);
+    return m_boot ? m_boot->metrics() : BootMetrics {};
+}
+
 bool Net::isAuthenticated() const
 {
     return m_status == AuthStatus::AuthenticatedPaired
@@ -408,9 +506,11 @@ void Net::submitGameData(const GameData &data, SessionFlags flags)
     // Queue in worker, so that it will not block the caller while waiting for lock
     m_worker.post([this, data, flags]() {
         int sessionCounterAfterUpdate = 0;
+        bool isGameOver = false;
         {
             std::scoped_lock lock(m_gameSessionsMutex);
             auto &session = m_gameSessions[data.id];
+            isGameOver = session.gameData.isGameActive && !data.isGameActive;
             session.gameData = data;
             session.history.push_back(data);
             sessionCounterAfterUpdate = session.sessionCounter;
@@ -418,6 +518,11 @@ void Net::submitGameData(const GameData &data, SessionFlags flags)
 
         const auto sessionId = data.id;
 
+        // Recorded before upload, so it's there even if the venue is offline
+        if (isGameOver) {
+            recordLocalScores(data);
+        }
+
         // If this is first data submission or it's finished send data right away
         if (!data.isGameActive || sessionCounterAfterUpdate == 1) {
             sendLatestGameData(sessionId);
@@ -440,59 +545,74 @@ void Net::sendHeartbeat()
 }
 
 void Net::getConfig()
+{
+    requestConfig({});
+}
+
+void Net::requestConfig(BootSequence::Done done)
 {
     INF("API get config");
-    m_worker.post(createGetRequestTask(
-            [this](Error error, const std::string &reply) {
-                if (error != Error::Success) {
-                    WRN("API get config error: {}", static_cast<int>(error));
-                    return;
-                }
-                INF("API get config: {}", reply);
 
-                try {
-                    json json = json::parse(reply);
+    auto callback = [this](Error error, const std::string &reply) {
+        if (error != Error::Success) {
+            WRN("API get config error: {}", static_cast<int>(error));
+            return;
+        }
+        INF("API get config: {}", reply);
 
-                    if (const auto it = json.find(JKEY_SCFG_VARIANT_ID);
-                        it != json.end() && it->is_string()) {
-                        m_machineInfo.variantUuid = it->get<std::string>();
-                    }
+        try {
+            json json = json::parse(reply);
 
-                    if (const auto it = json.find(JKEY_SCFG_VENUE_ID);
-                        it != json.end() && it->is_string()) {
-                        m_machineInfo.venueUuid = it->get<std::string>();
-                    }
+            if (const auto it = json.find(JKEY_SCFG_VARIANT_ID);
+                it != json.end() && it->is_string()) {
+                m_machineInfo.variantUuid = it->get<std::string>();
+            }
 
-                    if (const auto configIt = json.find(JKEY_SCFG_CONFIG);
-                        configIt != json.end() && configIt->is_object()) {
-                        if (const auto it = configIt->find(JKEY_SCFG_OPDB_ID);
-                            it != configIt->end() && it->is_string()) {
-                            it->get_to(m_machineInfo.opdbId);
-                        }
+            if (const auto it = json.find(JKEY_SCFG_VENUE_ID);
+                it != json.end() && it->is_string()) {
+                m_machineInfo.venueUuid = it->get<std::string>();
+            }
 
-                        if (const auto it = configIt->find(JKEY_SCFG_MACHINE_ID);
-                            it != configIt->end() && it->is_number_integer()) {
-                            it->get_to(m_deviceInfo.machineId);
-                        }
-                    }
+            if (const auto configIt = json.find(JKEY_SCFG_CONFIG);
+                configIt != json.end() && configIt->is_object()) {
+                if (const auto it = configIt->find(JKEY_SCFG_OPDB_ID);
+                    it != configIt->end() && it->is_string()) {
+                    it->get_to(m_machineInfo.opdbId);
+                }
 
-                    m_eventManager->push(std::make_shared<ConfigReceivedEvent>(json));
+                if (const auto it = configIt->find(JKEY_SCFG_MACHINE_ID);
+                    it != configIt->end() && it->is_number_integer()) {
+                    it->get_to(m_deviceInfo.machineId);
+                }
+            }
+            saveWarmStartMachine();
 
-                    if (const auto pricingIt = json.find(JKEY_SCFG_PRICING);
-                        pricingIt != json.end() && pricingIt->is_object()) {
-                        m_eventManager->push(std::make_shared<PricingReceivedEvent>(*pricingIt));
-                    }
+            // Same config was announced from warm start cache already
+            if (!m_warmStart.confirm(WARM_START_CONFIG, json)) {
+                return;
+            }
 
-                } catch (const std::exception &e) {
-                    ERR("API error parsing config reply: {}", e.what());
-                }
-            },
+            m_eventManager->push(std::make_shared<ConfigReceivedEvent>(json));
+
+            if (const auto pricingIt = json.find(JKEY_SCFG_PRICING);
+                pricingIt != json.end() && pricingIt->is_object()) {
+                m_eventManager->push(std::make_shared<PricingReceivedEvent>(*pricingIt));
+            }
+
+        } catch (const std::exception &e) {
+            ERR("API error parsing config reply: {}", e.what());
+        }
+    };
+
+    m_worker.post(createGetRequestTask(
+            withStepDone(std::move(callback), std::move(done)),
             [this]() {
                 const auto endpoint = url(URL_SCORBITRON_CONFIG);
                 cpr::Parameters parameters;
                 return make_tuple(endpoint, parameters);
             },
             {
+                    AuthStatus::AuthenticatedCheckingPairing,
                     AuthStatus::AuthenticatedUnpaired,
                     AuthStatus::AuthenticatedPaired,
             }));
@@ -555,7 +675,13 @@ const DeviceInfo &Net::deviceInfo() const
 
 bool Net::isLeaderboardContextReady(LeaderboardScope scope) const
 {
-    return detail::isLeaderboardContextReady(m_status, scope, m_machineInfo.machineUuid,
+    // Machine known from warm start, request waits only for the pairing check, not for retry
+    auto status = m_status.load();
+    if (status == AuthStatus::AuthenticatedCheckingPairing && m_warmStartPairing
+        && m_warmStartPaired) {
+        status = AuthStatus::AuthenticatedPaired;
+    }
+    return detail::isLeaderboardContextReady(status, scope, m_machineInfo.machineUuid,
                                              m_machineInfo.variantUuid, m_machineInfo.gameSlug);
 }
 
@@ -577,25 +703,21 @@ void Net::requestTopScoresImpl(LeaderboardScope scope, LeaderboardPeriod period,
 {
     m_worker.postQueue([this, scope, period, since, vpinFilter, deferAttempt,
                         callback = std::move(callback)]() mutable {
-        if (scope != LeaderboardScope::Machine && scope != LeaderboardScope::Variant
-            && scope != LeaderboardScope::Game) {
-            callback(Error::ApiError, nullptr);
-            return;
-        }
-
-        std::string_view periodParam;
-        if (since.empty()) {
-            const auto mappedPeriod = leaderboardPeriodParam(period);
-            if (!mappedPeriod.has_value()) {
+        const LeaderboardQuery query {scope, period, since, vpinFilter};
+        if (scope == LeaderboardScope::Local) {
+            // Never waits for pairing or network
+            auto data = localTopScores(query);
+            if (!data) {
                 callback(Error::ApiError, nullptr);
                 return;
             }
-            periodParam = *mappedPeriod;
+            callback(Error::Success,
+                     makeLeaderboardHandle(std::move(data), std::chrono::system_clock::now()));
+            return;
         }
 
-        if (vpinFilter != LeaderboardVpinFilter::Any
-            && vpinFilter != LeaderboardVpinFilter::VpinOnly
-            && vpinFilter != LeaderboardVpinFilter::RealOnly) {
+        const auto periodParam = leaderboardQueryPeriodParam(query);
+        if (!periodParam) {
             callback(Error::ApiError, nullptr);
             return;
         }
@@ -617,80 +739,344 @@ void Net::requestTopScoresImpl(LeaderboardScope scope, LeaderboardPeriod period,
                 static_cast<int>(scope), deferAttempt + 1, TOP_SCORES_DEFER_MAX_ATTEMPTS,
                 std::chrono::duration_cast<std::chrono::milliseconds>(TOP_SCORES_DEFER_RETRY)
                         .count());
-            m_worker.startTimer(Worker::Timer::LeaderboardDeferred, TOP_SCORES_DEFER_RETRY,
-                                [this, scope, period, since, vpinFilter, deferAttempt,
-                                 callback = std::move(callback)]() mutable {
-                                    requestTopScoresImpl(scope, period, since, vpinFilter,
-                                                         std::move(callback), deferAttempt + 1);
-                                });
+            deferLeaderboardRequest([this, scope, period, since, vpinFilter, deferAttempt,
+                                     callback = std::move(callback)]() mutable {
+                requestTopScoresImpl(scope, period, since, vpinFilter, std::move(callback),
+                                     deferAttempt + 1);
+            });
             return;
         }
 
-        auto deferredSetup = [this, scope, periodParam, since,
-                              vpinFilter]() -> std::tuple<cpr::Url, cpr::Parameters> {
-            cpr::Parameters parameters;
-            if (!since.empty()) {
-                parameters.Add({"since", since});
-            } else if (!periodParam.empty()) {
-                parameters.Add({"period", std::string {periodParam}});
-            }
+        fetchTopScores(query, std::string {*periodParam},
+                       [callback = std::move(callback)](Error error, LeaderboardDataPtr data,
+                                                        LeaderboardCache::SystemTime updatedAt) {
+                           callback(error, data ? makeLeaderboardHandle(std::move(data), updatedAt)
+                                                : nullptr);
+                       });
+    });
+}
 
-            switch (vpinFilter) {
-            case LeaderboardVpinFilter::Any:
-                break;
-            case LeaderboardVpinFilter::VpinOnly:
-                parameters.Add({"vpin", "true"});
-                break;
-            case LeaderboardVpinFilter::RealOnly:
-                parameters.Add({"vpin", "false"});
-                break;
+void Net::requestTopScoresMulti(std::vector<LeaderboardQuery> queries,
+                                LeaderboardMultiCallback callback)
+{
+    requestTopScoresMultiImpl(std::move(queries), std::move(callback), 0);
+}
+
+void Net::requestTopScoresMultiImpl(std::vector<LeaderboardQuery> queries,
+                                    LeaderboardMultiCallback callback, int deferAttempt)
+{
+    m_worker.postQueue([this, queries = std::move(queries), callback = std::move(callback),
+                        deferAttempt]() mutable {
+        const auto count = queries.size();
+        const auto terminalError = leaderboardRequestTerminalError();
+
+        // Readiness is checked for the whole batch, so it is deferred once, not per query
+        const auto isReady = [this](const LeaderboardQuery &query) {
+            return query.scope == LeaderboardScope::Local || !leaderboardQueryPeriodParam(query)
+                || isLeaderboardContextReady(query.scope);
+        };
+        if (!terminalError && !std::all_of(queries.begin(), queries.end(), isReady)) {
+            if (deferAttempt < TOP_SCORES_DEFER_MAX_ATTEMPTS) {
+                INF("API request {} top scores deferred, attempt {}/{}...", count,
+                    deferAttempt + 1, TOP_SCORES_DEFER_MAX_ATTEMPTS);
+                deferLeaderboardRequest([this, queries = std::move(queries),
+                                         callback = std::move(callback), deferAttempt]() mutable {
+                    requestTopScoresMultiImpl(std::move(queries), std::move(callback),
+                                              deferAttempt + 1);
+                });
+                return;
             }
 
-            switch (scope) {
-            case LeaderboardScope::Machine:
-                return make_tuple(url(URL_MACHINE_LEADERS), std::move(parameters));
-            case LeaderboardScope::Variant:
-                return make_tuple(url(URL_VARIANT_LEADERS,
-                                      fmt::arg(ARG_VARIANT_UUID, *m_machineInfo.variantUuid)),
-                                  std::move(parameters));
-            case LeaderboardScope::Game:
-                return make_tuple(
-                        url(URL_GAME_LEADERS, fmt::arg(ARG_GAME_SLUG, *m_machineInfo.gameSlug)),
-                        std::move(parameters));
-            default:
-                return make_tuple(url(URL_MACHINE_LEADERS), std::move(parameters));
+            // Don't hold back the queries which are ready, the others fail below
+            ERR("API request {} top scores gave up waiting after {} defer attempts", count,
+                TOP_SCORES_DEFER_MAX_ATTEMPTS);
+        }
+
+        auto batch = std::make_shared<LeaderboardBatch>(count, std::move(callback));
+
+        for (size_t i = 0; i < count; ++i) {
+            const auto &query = queries[i];
+            if (query.scope == LeaderboardScope::Local) {
+                auto data = localTopScores(query);
+                const auto error = data ? Error::Success : Error::ApiError;
+                batch->complete(i, error, std::move(data), std::chrono::system_clock::now());
+                continue;
             }
-        };
 
-        auto replyCallback = [callback = std::move(callback)](Error error,
-                                                              std::string reply) mutable {
-            if (error != Error::Success) {
-                callback(error, nullptr);
-                return;
+            if (terminalError) {
+                batch->complete(i, *terminalError, nullptr);
+                continue;
             }
 
-            std::unique_ptr<sb_leaderboard_t> leaderboard;
-            try {
-                leaderboard.reset(parseLeaderboardJson(reply));
-            } catch (const std::exception &e) {
-                ERR("API request top scores parse error: {}, reply: {}", e.what(), reply);
-                callback(Error::ApiError, nullptr);
-                return;
+            const auto periodParam = leaderboardQueryPeriodParam(query);
+            if (!periodParam || !isLeaderboardContextReady(query.scope)) {
+                batch->complete(i, Error::ApiError, nullptr);
+                continue;
             }
 
-            if (!leaderboard) {
-                ERR("API request top scores parse failed, reply: {}", reply);
-                callback(Error::ApiError, nullptr);
-                return;
+            // Queries are fetched concurrently, identical ones are coalesced by the cache
+            fetchTopScores(query, std::string {*periodParam},
+                           [batch, i](Error error, LeaderboardDataPtr data,
+                                      LeaderboardCache::SystemTime updatedAt) {
+                               batch->complete(i, error, std::move(data), updatedAt);
+                           });
+        }
+    });
+}
+
+void Net::prefetchLeaderboards()
+{
+    m_worker.postQueue([this] {
+        if (leaderboardRequestTerminalError()) {
+            return;
+        }
+
+        for (const auto &query : m_deviceInfo.leaderboardPrefetch) {
+            const auto periodParam = leaderboardQueryPeriodParam(query);
+            if (!periodParam || !isLeaderboardContextReady(query.scope)) {
+                continue;
             }
 
-            callback(Error::Success, leaderboard.release());
-        };
+            // Nobody waits for the result, it only lands in the cache. Fetch is conditional, so
+            // unchanged boards cost a 304 reply
+            DBG("API prefetch top scores (scope={})", static_cast<int>(query.scope));
+            startTopScoresFetch(query, std::string {*periodParam}, nullptr);
+        }
+    });
+}
 
-        createGetRequestTask(std::move(replyCallback), std::move(deferredSetup))();
+LeaderboardDataPtr Net::localTopScores(const LeaderboardQuery &query)
+{
+    auto machineQuery = query;
+    machineQuery.scope = LeaderboardScope::Machine;
+    const auto cached = m_leaderboardCache.lookup(machineQuery);
+
+    // Keep the machine leaderboard warm for the next time, local answer never waits for it
+    if (cached.freshness != LeaderboardCache::Freshness::Fresh
+        && !leaderboardRequestTerminalError() && isLeaderboardContextReady(machineQuery.scope)) {
+        if (const auto periodParam = leaderboardQueryPeriodParam(machineQuery)) {
+            startTopScoresFetch(machineQuery, std::string {*periodParam}, nullptr);
+        }
+    }
+
+    DBG("API request top scores answered locally, machine leaderboard cached: {}",
+        cached.data != nullptr);
+    return makeLocalLeaderboard(m_localScores, query, cached.data.get(), cached.updatedAt);
+}
+
+void Net::recordLocalScores(const GameData &data)
+{
+    const auto playedAt = std::chrono::duration_cast<std::chrono::seconds>(
+                                  std::chrono::system_clock::now().time_since_epoch())
+                                  .count();
+
+    for (const auto &[playerNum, playerState] : data.players) {
+        if (playerState.score() <= 0) {
+            continue;
+        }
+
+        LocalScore score;
+        score.playedAt = playedAt;
+        score.score = playerState.score();
+        score.player = playerNum;
+        if (const auto profile = m_playersManager.profile(playerNum);
+            profile.has_value() && profile->hasInfo()) {
+            score.playerId = profile->id;
+            score.username = profile->username;
+            score.displayName = profile->name;
+            score.initials = profile->initials;
+        }
+        m_localScores.add(score);
+    }
+}
+
+void Net::startLeaderboardPrefetchTimer()
+{
+    if (m_deviceInfo.leaderboardPrefetch.empty() || m_deviceInfo.leaderboardPrefetchInterval <= 0) {
+        return;
+    }
+
+    m_worker.startTimer(Worker::Timer::LeaderboardPrefetch,
+                        std::chrono::seconds {m_deviceInfo.leaderboardPrefetchInterval}, [this] {
+                            startLeaderboardPrefetchTimer();
+
+                            // Leave the network to the game while it's played
+                            std::scoped_lock lock(m_gameSessionsMutex);
+                            const auto isPlaying = std::any_of(
+                                    m_gameSessions.begin(), m_gameSessions.end(),
+                                    [](const auto &it) { return it.second.gameData.isGameActive; });
+                            if (!isPlaying) {
+                                prefetchLeaderboards();
+                            }
+                        });
+}
+
+void Net::deferLeaderboardRequest(task_t retry)
+{
+    // All deferred requests share one timer, so a new request doesn't cancel the earlier ones
+    m_deferredLeaderboardRequests.push_back(std::move(retry));
+    if (m_deferredLeaderboardRequests.size() > 1) {
+        return;
+    }
+
+    m_worker.startTimer(Worker::Timer::LeaderboardDeferred, TOP_SCORES_DEFER_RETRY, [this] {
+        m_worker.postQueue([this] {
+            auto requests = std::move(m_deferredLeaderboardRequests);
+            m_deferredLeaderboardRequests.clear();
+            for (auto &request : requests) {
+                request();
+            }
+        });
     });
 }
 
+void Net::fetchTopScores(const LeaderboardQuery &query, std::string periodParam,
+                         LeaderboardCache::DataCallback callback)
+{
+    auto cached = m_leaderboardCache.lookup(query);
+    if (cached.freshness == LeaderboardCache::Freshness::Fresh) {
+        DBG("API request top scores served from cache (scope={})", static_cast<int>(query.scope));
+        callback(Error::Success, std::move(cached.data), cached.updatedAt);
+        return;
+    }
+
+    if (cached.freshness == LeaderboardCache::Freshness::Stale) {
+        // Serve stale result right away and revalidate it in the background
+        DBG("API request top scores served stale (scope={}), revalidating",
+            static_cast<int>(query.scope));
+        callback(Error::Success, std::move(cached.data), cached.updatedAt);
+        callback = nullptr;
+    }
+
+    startTopScoresFetch(query, std::move(periodParam), std::move(callback));
+}
+
+void Net::startTopScoresFetch(const LeaderboardQuery &query, std::string periodParam,
+                              LeaderboardCache::DataCallback callback)
+{
+    LeaderboardCache::Validators validators;
+    const auto generation = m_leaderboardCache.beginFetch(query, std::move(callback), &validators);
+    if (!generation) {
+        DBG("API request top scores joined request in flight (scope={})",
+            static_cast<int>(query.scope));
+        return;
+    }
+
+    // Don't hold the queue while waiting for reply, so requests run concurrently and identical
+    // ones can be coalesced
+    m_worker.post(createTopScoresFetchTask(query, *generation, std::move(periodParam),
+                                           std::move(validators)));
+}
+
+task_t Net::createTopScoresFetchTask(const LeaderboardQuery &query, uint64_t generation,
+                                     std::string periodParam,
+                                     LeaderboardCache::Validators validators)
+{
+    auto deferredSetup = [this, query, periodParam]() -> std::tuple<cpr::Url, cpr::Parameters> {
+        cpr::Parameters parameters;
+        if (!query.since.empty()) {
+            parameters.Add({"since", query.since});
+        } else if (!periodParam.empty()) {
+            parameters.Add({"period", periodParam});
+        }
+
+        switch (query.vpinFilter) {
+        case LeaderboardVpinFilter::Any:
+            break;
+        case LeaderboardVpinFilter::VpinOnly:
+            parameters.Add({"vpin", "true"});
+            break;
+        case LeaderboardVpinFilter::RealOnly:
+            parameters.Add({"vpin", "false"});
+            break;
+        }
+
+        switch (query.scope) {
+        case LeaderboardScope::Machine:
+            return make_tuple(url(URL_MACHINE_LEADERS), std::move(parameters));
+        case LeaderboardScope::Variant:
+            return make_tuple(url(URL_VARIANT_LEADERS,
+                                  fmt::arg(ARG_VARIANT_UUID, *m_machineInfo.variantUuid)),
+                              std::move(parameters));
+        case LeaderboardScope::Game:
+            return make_tuple(
+                    url(URL_GAME_LEADERS, fmt::arg(ARG_GAME_SLUG, *m_machineInfo.gameSlug)),
+                    std::move(parameters));
+        default:
+            return make_tuple(url(URL_MACHINE_LEADERS), std::move(parameters));
+        }
+    };
+
+    // Filled in by the GET below, read in the reply callback of the same task
+    auto replyInfo = std::make_shared<std::pair<int, LeaderboardCache::Validators>>();
+
+    auto conditionalGet = [this, replyInfo, validators = std::move(validators)](
+                                  const cpr::Url &url, const cpr::Parameters &params,
+                                  cpr::Header header, const cpr::Timeout &timeout, bool) {
+        if (!validators.etag.empty()) {
+            header[HDR_KEY_IF_NONE_MATCH] = validators.etag;
+        }
+        if (!validators.lastModified.empty()) {
+            header[HDR_KEY_IF_MODIFIED_SINCE] = validators.lastModified;
+        }
+
+        // Curl handle is kept per worker thread, so its connections are reused by the next
+        // leaderboard request instead of doing TCP and TLS handshake again
+        thread_local cpr::Session session;
+        session.SetUrl(url);
+        session.SetParameters(params);
+        session.SetHeader(header);
+        session.SetTimeout(timeout);
+        session.SetSslOptions(sslOptions());
+        auto r = session.Get();
+
+        replyInfo->first = r.status_code;
+        replyInfo->second = {};
+        if (const auto it = r.header.find(HDR_KEY_ETAG); it != r.header.end()) {
+            replyInfo->second.etag = it->second;
+        }
+        if (const auto it = r.header.find(HDR_KEY_LAST_MODIFIED); it != r.header.end()) {
+            replyInfo->second.lastModified = it->second;
+        }
+        return r;
+    };
+
+    auto replyCallback = [this, query, generation, replyInfo](Error error, std::string reply) {
+        if (error != Error::Success) {
+            m_leaderboardCache.failFetch(query, generation, error);
+            return;
+        }
+
+        if (replyInfo->first == 304) {
+            DBG("API request top scores not modified (scope={})", static_cast<int>(query.scope));
+            m_leaderboardCache.completeNotModified(query, generation,
+                                                   std::move(replyInfo->second));
+            return;
+        }
+
+        LeaderboardDataPtr leaderboard;
+        try {
+            leaderboard = parseLeaderboardData(reply);
+        } catch (const std::exception &e) {
+            ERR("API request top scores parse error: {}, reply: {}", e.what(), reply);
+            m_leaderboardCache.failFetch(query, generation, Error::ApiError);
+            return;
+        }
+
+        if (!leaderboard) {
+            ERR("API request top scores parse failed, reply: {}", reply);
+            m_leaderboardCache.failFetch(query, generation, Error::ApiError);
+            return;
+        }
+
+        m_leaderboardCache.completeFetch(query, generation, std::move(leaderboard),
+                                         std::move(replyInfo->second));
+    };
+
+    return createHttpRequestTask(REST_GET, std::move(replyCallback), std::move(deferredSetup),
+                                 std::move(conditionalGet));
+}
+
 void Net::requestUnpair(StringCallback callback)
 {
     json j {
@@ -700,7 +1086,7 @@ void Net::requestUnpair(StringCallback callback)
     patchScorbitron(j.dump(),
                     [this, callback = std::move(callback)](Error error, std::string reply) {
                         if (error == Error::Success || error == Error::NotPaired) {
-                            m_status = AuthStatus::AuthenticatedUnpaired;
+                            setStatus(AuthStatus::AuthenticatedUnpaired);
                             error = Error::Success;
                         }
                         callback(error, reply);
@@ -708,25 +1094,47 @@ void Net::requestUnpair(StringCallback callback)
 }
 
 void Net::download(bool isAsync, StringCallback callback, const std::string &url,
-                   const std::string &filename, const HttpHeaders &headers)
+                   const std::string &filename, const HttpHeaders &headers,
+                   const DownloadOptions &options)
 {
     if (isAsync) {
-        m_worker.postQueue(
-                createDownloadFileTask(std::move(callback), url, filename, HttpHeaders(headers)));
+        m_worker.postQueue(createDownloadFileTask(std::move(callback), url, filename,
+                                                  HttpHeaders(headers), options));
     } else {
-        std::invoke(
-                createDownloadFileTask(std::move(callback), url, filename, HttpHeaders(headers)));
+        std::invoke(createDownloadFileTask(std::move(callback), url, filename,
+                                           HttpHeaders(headers), options));
     }
 }
 
-void Net::downloadBuffer(bool isAsync, VectorCallback callback, const std::string &url,
+void Net::downloadStream(bool isAsync, StringCallback callback, const std::string &url,
+                         const HttpHeaders &headers, const DownloadOptions &options,
+                         DataCallback onData)
+{
+    if (isAsync) {
+        m_worker.postQueue(createDownloadStreamTask(std::move(callback), url,
+                                                    HttpHeaders(headers), options,
+                                                    std::move(onData)));
+    } else {
+        std::invoke(createDownloadStreamTask(std::move(callback), url, HttpHeaders(headers),
+                                             options, std::move(onData)));
+    }
+}
+
+void Net::downloadBuffer(bool isAsync, BufferCallback callback, const std::string &url,
                          size_t reserveBufferSize, const HttpHeaders &headers)
 {
+    auto replyCallback = [callback = std::move(callback)](Error error, std::vector<uint8_t> data,
+                                                          const BufferReplyInfo &) {
+        if (callback) {
+            callback(error, std::move(data));
+        }
+    };
+
     if (isAsync) {
-        m_worker.postQueue(createDownloadBufferTask(std::move(callback), url, reserveBufferSize,
-                                                    HttpHeaders(headers)));
+        m_worker.postQueue(createDownloadBufferTask(std::move(replyCallback), url,
+                                                    reserveBufferSize, HttpHeaders(headers)));
     } else {
-        std::invoke(createDownloadBufferTask(std::move(callback), url, reserveBufferSize,
+        std::invoke(createDownloadBufferTask(std::move(replyCallback), url, reserveBufferSize,
                                              HttpHeaders(headers)));
     }
 }
@@ -1096,6 +1504,14 @@ void Net::uploadDiagnostics(std::vector<std::string> logPaths,
             archiveMemory.push_back({"logs/extra.log", std::move(logString)});
         }
 
+        if (const auto &recorder = FlightRecorder::instance(); recorder.isOpen()) {
+            if (!recorder.previousRun().empty()) {
+                archiveMemory.push_back(
+                        {"logs/flight_recorder_previous.log", recorder.previousRun()});
+            }
+            archiveMemory.push_back({"logs/flight_recorder.log", recorder.dump()});
+        }
+
         if (archiveFiles.empty() && archiveMemory.empty()) {
             WRN("Diagnostics: no files to upload");
             m_eventManager->push(std::make_shared<DiagnosticsUploadedEvent>(false));
@@ -1119,14 +1535,51 @@ void Net::uploadDiagnostics(std::vector<std::string> logPaths,
             INF("Diagnostics: archive will include: {}", listing);
         }
 
+        const auto &settings = m_deviceInfo.diagnosticsArchive;
+        const ArchiveOptions options {settings.compression == DiagnosticsCompression::Zstd
+                                              ? ArchiveCompression::Zstd
+                                              : ArchiveCompression::Gzip,
+                                      settings.level, settings.threads};
+        const auto extension =
+                options.compression == ArchiveCompression::Zstd ? "tar.zst" : "tar.gz";
+        const auto fileName = fmt::format("diagnostics.{}", extension);
+
+        if (settings.streamUpload) {
+            // The archive is created while it's uploaded, again on each retry
+            auto content = std::make_shared<const ArchiveContent>(
+                    ArchiveContent {std::move(archiveFiles), std::move(archiveMemory)});
+
+            auto callback = [this](Error error, std::string reply) {
+                if (error == Error::Success) {
+                    INF("API diagnostics upload: success");
+                    m_eventManager->push(std::make_shared<DiagnosticsUploadedEvent>(true));
+                } else {
+                    ERR("API diagnostics upload: failed, error code: {}, reply: {}",
+                        static_cast<int>(error), reply);
+                    m_eventManager->push(std::make_shared<DiagnosticsUploadedEvent>(false));
+                }
+            };
+
+            auto deferredSetup = [this, content, options, fileName]() {
+                return std::make_tuple(
+                        url(URL_SCORBITRON_DIAGNOSTICS),
+                        StreamingMultipart {"file", fileName,
+                                            std::make_shared<ArchiveStream>(content, options)});
+            };
+
+            auto task = createPostStreamRequestTask(std::move(callback), std::move(deferredSetup));
+            task();
+            return;
+        }
+
         const auto tempDir = fs::temp_directory_path();
         const auto unixTimeStamp = std::chrono::duration_cast<std::chrono::seconds>(
                                            std::chrono::system_clock::now().time_since_epoch())
                                            .count();
         const auto archivePath =
-                (tempDir / fmt::format("diagnostics_{}.tar.gz", unixTimeStamp)).string();
+                (tempDir / fmt::format("diagnostics_{}.{}", unixTimeStamp, extension)).string();
 
-        if (!createTarGz(archivePath, archiveFiles, archiveMemory)) {
+        if (!createTarGz(archivePath, archiveFiles, archiveMemory, options)) {
             ERR("Diagnostics: failed to create archive");
             m_eventManager->push(std::make_shared<DiagnosticsUploadedEvent>(false));
             return;
@@ -1142,7 +1595,7 @@ void Net::uploadDiagnostics(std::vector<std::string> logPaths,
 
         // Stream from disk via CPR (do not load the whole archive into memory).
         SafeMultipart multipart {cpr::Multipart {
-                {"file", cpr::Files {cpr::File {archivePath, "diagnostics.tar.gz"}}},
+                {"file", cpr::Files {cpr::File {archivePath, fileName}}},
         }};
 
         auto callback = [this, archivePath](Error error, std::string reply) {
@@ -1169,6 +1622,7 @@ void Net::uploadDiagnostics(std::vector<std::string> logPaths,
 task_t Net::createAuthenticateTask()
 {
     return [this]() {
+        const auto startedAt = steady_clock::now();
         const auto normalAuthentication = !m_isRefreshingToken;
         std::unique_lock lock(m_authMutex, std::defer_lock);
 
@@ -1177,8 +1631,10 @@ task_t Net::createAuthenticateTask()
             if (m_status != AuthStatus::NotAuthenticated) {
                 return;
             }
-            m_status = AuthStatus::Authenticating;
-            m_lastEmittedPairingState.reset();
+            setStatus(AuthStatus::Authenticating);
+            if (!m_warmStartPairing) {
+                m_lastEmittedPairingState.reset();
+            }
         }
 
         m_isRefreshingToken = true;
@@ -1212,7 +1668,7 @@ task_t Net::createAuthenticateTask()
         // Done after obtaining server time so provisioning uses accurate timestamps.
         if (!m_signer && !m_keyResolvers.empty()) {
             if (!resolveKeys(timestamp)) {
-                m_status = AuthStatus::AuthenticationFailed;
+                setStatus(AuthStatus::AuthenticationFailed);
                 ERR("API there is no functional key to authenticate");
                 m_authCV.notify_all();
                 return;
@@ -1223,7 +1679,7 @@ task_t Net::createAuthenticateTask()
             const auto signature = getSignature(m_signer, m_deviceInfo.uuid, timestamp);
             if (signature.empty()) {
                 ERR("Can't authenticate, signature is empty");
-                m_status = AuthStatus::AuthenticationFailed;
+                setStatus(AuthStatus::AuthenticationFailed);
                 stopTokenRefreshTimer();
                 m_authCV.notify_all();
                 return;
@@ -1254,7 +1710,7 @@ task_t Net::createAuthenticateTask()
                                cpr::Timeout {NET_TIMEOUT}, sslOptions());
 
             if (m_stop) {
-                m_status = AuthStatus::AuthenticationFailed;
+                setStatus(AuthStatus::AuthenticationFailed);
                 m_isRefreshingToken = false;
                 m_authCV.notify_all();
                 return;
@@ -1278,9 +1734,9 @@ task_t Net::createAuthenticateTask()
                     m_authCV.notify_all();
 
                     if (normalAuthentication) {
-                        m_status = AuthStatus::AuthenticatedCheckingPairing;
+                        setStatus(AuthStatus::AuthenticatedCheckingPairing);
                         INF("API authentication successful! Checking pairing status...");
-                        initializeConnectionState();
+                        initializeConnectionState(startedAt);
                     } else {
                         INF("API token refreshed successful!");
                         requestReleaseTrackInfo();
@@ -1288,7 +1744,7 @@ task_t Net::createAuthenticateTask()
                     break;
                 } catch (const std::exception &e) {
                     ERR("Error parsing authentication reply: {}", e.what());
-                    m_status = AuthStatus::AuthenticationFailed;
+                    setStatus(AuthStatus::AuthenticationFailed);
                     stopTokenRefreshTimer();
                     m_authCV.notify_all();
                     return;
@@ -1313,7 +1769,7 @@ task_t Net::createAuthenticateTask()
                 continue;
             }
 
-            m_status = AuthStatus::AuthenticationFailed;
+            setStatus(AuthStatus::AuthenticationFailed);
             stopTokenRefreshTimer();
             const auto msg = fmt::format("API authentication failed: code {}, {}", r.status_code,
                                          r.error.message);
@@ -1428,6 +1884,8 @@ task_t Net::createSessionCreateTask(int sessionId, GameStartOrigin origin,
                             INF("API created session id: {}, uuid: {}, address: {:x}", sessionId,
                                 gsIt->second.sessionUuid,
                                 reinterpret_cast<std::uintptr_t>(&gsIt->second.gameData));
+                            FlightRecorder::instance().event("Session {} created, uuid: {}",
+                                                             sessionId, gsIt->second.sessionUuid);
 
                             // Scores array will have players' profiles
                             if (const auto scoresIt = json.find(JKEY_SCR_SCORES);
@@ -1452,6 +1910,9 @@ task_t Net::createSessionCreateTask(int sessionId, GameStartOrigin origin,
             } catch (const std::exception &e) {
                 ERR("API error parsing game data reply: {}", e.what());
             }
+        } else {
+            FlightRecorder::instance().event("Session {} create failed, error: {}", sessionId,
+                                             static_cast<int>(error));
         }
     };
 
@@ -1539,11 +2000,20 @@ task_t Net::createSessionUpdateTask(int sessionId, SessionFlags flags)
     auto callback = [this, sessionId](Error error, std::string reply) {
         if (error == Error::Success) {
             INF("API update session: ok, id: {}, {}", sessionId, reply);
+            FlightRecorder::instance().event("Session {} updated", sessionId);
 
             // Erase the session if the game is finished
             std::scoped_lock lock(m_gameSessionsMutex);
             if (!m_gameSessions[sessionId].gameData.isGameActive) {
                 m_gameSessions.erase(sessionId);
+
+                // Final scores changed the boards, cached ones must not be served anymore.
+                // Prefetch refreshes them while players look at the game over screen, so the
+                // post-game request is answered from the cache.
+                m_leaderboardCache.invalidate();
+                if (!m_deviceInfo.leaderboardPrefetch.empty()) {
+                    prefetchLeaderboards();
+                }
             } else {
                 try {
                     json json = json::parse(reply);
@@ -1559,6 +2029,8 @@ task_t Net::createSessionUpdateTask(int sessionId, SessionFlags flags)
         } else {
             ERR("API update session: failed, id: {}, error code: {}", sessionId,
                 static_cast<int>(error));
+            FlightRecorder::instance().event("Session {} update failed, error: {}", sessionId,
+                                             static_cast<int>(error));
             // TODO: Sentry
             // FIXME: what to do with game session? Erase it or retry again?
         }
@@ -1644,7 +2116,7 @@ task_t Net::createHeartbeatTask()
                     m_updater.checkNewVersionAndUpdate(json);
 
                     if (m_status != status) {
-                        m_status = status;
+                        setStatus(status);
                         m_authCV.notify_all();
                     }
                 } catch (const std::exception &e) {
@@ -1660,7 +2132,7 @@ task_t Net::createHeartbeatTask()
                 break;
             }
 
-            m_status = AuthStatus::NotAuthenticated;
+            setStatus(AuthStatus::NotAuthenticated);
             stopTokenRefreshTimer();
             auto auth = createAuthenticateTask();
             auth();
@@ -1776,9 +2248,10 @@ void Net::sendLatestGameData(int sessionId)
 
         if (sessionUuid.empty()
             || m_centrifugo->state() != centrifugo::ConnectionState::Connected) {
-            INF("Skip publishing score yet: has session uuid: {}, centrifugo connected: {}",
-                !sessionUuid.empty(),
-                m_centrifugo->state() == centrifugo::ConnectionState::Connected);
+            INF_EVERY(REPEATED_LOG_INTERVAL,
+                      "Skip publishing score yet: has session uuid: {}, centrifugo connected: {}",
+                      !sessionUuid.empty(),
+                      m_centrifugo->state() == centrifugo::ConnectionState::Connected);
         } else {
             {
                 std::scoped_lock lock(m_gameSessionsMutex);
@@ -1868,18 +2341,63 @@ void Net::sendLatestGameData(int sessionId)
     });
 }
 
-void Net::initializeConnectionState()
+void Net::initializeConnectionState(std::chrono::steady_clock::time_point authStartedAt)
 {
-    // set authentication info and pair status
-    sendScorbitronObject();
-    requestReleaseTrackInfo();
+    // Independent requests run side by side, each one starts when what it needs is known
+    auto boot = makeConnectionBoot(
+            [this](task_t task) { m_worker.post(std::move(task)); }, authStartedAt,
+            {
+                    .scorbitronObject =
+                            [this](BootSequence::Done done) {
+                                sendScorbitronObject(std::move(done));
+                            },
+                    .cfToken =
+                            [this](BootSequence::Done done) {
+                                m_cfTokens.refresh([done](const std::string &token) {
+                                    done(!token.empty());
+                                });
+                            },
+                    .config = [this](BootSequence::Done done) { requestConfig(std::move(done)); },
+                    .machineObject =
+                            [this](BootSequence::Done done) {
+                                if (m_status == AuthStatus::AuthenticatedPaired) {
+                                    requestMachineObject(std::move(done));
+                                } else {
+                                    done(true); // Nothing to request for unpaired machine
+                                }
+                            },
+                    .releaseTrack =
+                            [this](BootSequence::Done done) {
+                                requestReleaseTrackInfo(std::move(done));
+                            },
+                    .nfcNonces =
+                            [this](BootSequence::Done done) { createNfcNonces(std::move(done)); },
+                    .centrifugo =
+                            [this](BootSequence::Done done) {
+                                // Token was just fetched, or the client fetches one itself
+                                restartCentrifugo(false);
+                                done(true);
+                            },
+            });
+
+    {
+        std::scoped_lock lock(m_bootMutex);
+        m_boot = boot;
+    }
+
+    boot->start([](const BootMetrics &metrics) {
+        std::string steps;
+        for (const auto &step : metrics.steps) {
+            steps += fmt::format(" {} {}+{}ms", step.name, step.startedAt.count(),
+                                 step.duration.count());
+        }
+        INF("API ready in {} ms:{}", metrics.timeToReady.count(), steps);
+        FlightRecorder::instance().event("Ready in {} ms", metrics.timeToReady.count());
+    });
 
-    getConfig(); // Get template
     requestFirmwaresList();
     sendHeartbeat();
     startHeartbeatTimer();
-    restartCentrifugo();
-    createNfcNonces();
 }
 
 void Net::initScorbitronObject()
@@ -1906,19 +2424,23 @@ void Net::initScorbitronObject()
     }
 }
 
-void Net::sendScorbitronObject()
+void Net::sendScorbitronObject(BootSequence::Done done)
 {
+    // Boot requests machine object as its own step
+    const bool requestMachine = !done;
     m_worker.post(createPatchRequestTask(
-            [this](Error error, std::string reply) {
-                if (error == Error::Success) {
-                    INF("API initial Scorbitron object sent: ok, {}", reply);
-                } else {
-                    ERR("API initial Scorbitron object sent: failed, error code: {}, "
-                        "reply: {}",
-                        static_cast<int>(error), reply);
-                }
-                parseScorbitronObject(error, reply);
-            },
+            withStepDone(
+                    [this, requestMachine](Error error, std::string reply) {
+                        if (error == Error::Success) {
+                            INF("API initial Scorbitron object sent: ok, {}", reply);
+                        } else {
+                            ERR("API initial Scorbitron object sent: failed, error code: {}, "
+                                "reply: {}",
+                                static_cast<int>(error), reply);
+                        }
+                        parseScorbitronObject(error, reply, requestMachine);
+                    },
+                    std::move(done)),
             [this]() {
                 std::string body;
                 {
@@ -1937,7 +2459,7 @@ void Net::sendScorbitronObject()
             }));
 }
 
-void Net::requestReleaseTrackInfo()
+void Net::requestReleaseTrackInfo(BootSequence::Done done)
 {
     INF("API request release track info using {}...", m_releaseTrackUrl);
 
@@ -1958,7 +2480,7 @@ void Net::requestReleaseTrackInfo()
     };
 
     m_worker.post(createGetRequestTask(
-            std::move(callback),
+            withStepDone(std::move(callback), std::move(done)),
             [this]() { return make_tuple(cpr::Url {m_releaseTrackUrl}, cpr::Parameters {}); },
             {
                     AuthStatus::AuthenticatedUnpaired,
@@ -1966,7 +2488,7 @@ void Net::requestReleaseTrackInfo()
             }));
 }
 
-void Net::requestMachineObject()
+void Net::requestMachineObject(BootSequence::Done done)
 {
     INF("API request machine object...");
 
@@ -1992,6 +2514,7 @@ void Net::requestMachineObject()
 
                 m_machineInfo.title = fmt::format("{} ({})", name, edition);
                 updateDiscoveryDescription();
+                saveWarmStartMachine();
             } catch (const std::exception &e) {
                 ERR("API reuquest machine object parse error: {}, reply: {}", e.what(), reply);
             }
@@ -2001,9 +2524,10 @@ void Net::requestMachineObject()
         }
     };
 
-    m_worker.post(createGetRequestTask(std::move(callback), [this]() {
-        return make_tuple(url(URL_MACHINE_OBJECT), cpr::Parameters {});
-    }));
+    m_worker.post(
+            createGetRequestTask(withStepDone(std::move(callback), std::move(done)), [this]() {
+                return make_tuple(url(URL_MACHINE_OBJECT), cpr::Parameters {});
+            }));
 }
 
 void Net::requestSessionData(const std::string &sessionUuid)
@@ -2097,6 +2621,7 @@ void Net::clearPairedMachineContext()
     m_machineInfo.venueUuid.reset();
     m_machineInfo.title = fmt::format("not paired");
     m_machineChannel.clear();
+    m_leaderboardCache.clear();
     updateDiscoveryDescription();
 }
 
@@ -2109,15 +2634,96 @@ void Net::emitPairingStatusEventIfChanged(bool isPaired)
     m_eventManager->push(std::make_shared<PairingStatusChangedEvent>(isPaired));
 }
 
+void Net::loadWarmStartCache()
+{
+    const auto identity = fmt::format("{}:{}:{}@{}", m_deviceInfo.provider,
+                                      m_deviceInfo.machineId, m_deviceInfo.uuid, m_hostname);
+    if (!m_warmStart.open(m_deviceInfo.warmStartCachePath, identity)) {
+        return;
+    }
+
+    // Provisional state, requests after authentication revalidate it
+    try {
+        if (const auto machine = m_warmStart.provisional(WARM_START_MACHINE)) {
+            const auto optionalString = [&machine](const char *key) -> std::optional<std::string> {
+                const auto it = machine->find(key);
+                if (it == machine->end() || !it->is_string()) {
+                    return std::nullopt;
+                }
+                return it->get<std::string>();
+            };
+            m_machineInfo.opdbId = machine->value(JKEY_WARM_OPDB_ID, std::string {});
+            m_machineInfo.machineUuid = machine->value(JKEY_WARM_MACHINE_UUID, std::string {});
+            m_machineInfo.variantUuid = optionalString(JKEY_WARM_VARIANT_UUID);
+            m_machineInfo.gameSlug = optionalString(JKEY_WARM_GAME_SLUG);
+            m_machineInfo.venueUuid = optionalString(JKEY_WARM_VENUE_UUID);
+            m_machineInfo.title = machine->value(JKEY_WARM_TITLE, std::string {});
+            if (!m_machineInfo.machineUuid.empty()) {
+                m_machineChannel = fmt::format("machine:{}", m_machineInfo.machineUuid);
+            }
+        }
+
+        if (const auto shortCode = m_warmStart.provisional(WARM_START_SHORT_CODE);
+            shortCode && shortCode->is_string()) {
+            std::scoped_lock lock(m_shortCodeMutex);
+            shortCode->get_to(m_cachedShortCode);
+        }
+
+        if (const auto object = m_warmStart.provisional(WARM_START_SCORBITRON_OBJECT)) {
+            const auto machineIt = object->find(JKEY_SOBJ_MACHINE_OBJ);
+            const bool isPaired = machineIt != object->end() && machineIt->is_object();
+            if (const auto trackIt = object->find(JKEY_SOBJ_RELEASE_TRACK);
+                trackIt != object->end() && trackIt->is_object()) {
+                m_releaseTrackUrl = trackIt->value(JKEY_SOBJ_RELEASE_URL, m_releaseTrackUrl);
+            }
+
+            m_eventManager->push(std::make_shared<ConfigReceivedEvent>(*object));
+            m_warmStartPaired = isPaired;
+            m_warmStartPairing = true;
+            emitPairingStatusEventIfChanged(isPaired);
+        }
+
+        if (const auto config = m_warmStart.provisional(WARM_START_CONFIG)) {
+            m_eventManager->push(std::make_shared<ConfigReceivedEvent>(*config));
+            if (const auto pricingIt = config->find(JKEY_SCFG_PRICING);
+                pricingIt != config->end() && pricingIt->is_object()) {
+                m_eventManager->push(std::make_shared<PricingReceivedEvent>(*pricingIt));
+            }
+        }
+    } catch (const std::exception &e) {
+        ERR("API warm start cache error: {}", e.what());
+    }
+
+    FlightRecorder::instance().event("Warm start, machine {}, paired: {}",
+                                     m_machineInfo.machineUuid, m_warmStartPaired.load());
+}
+
+void Net::saveWarmStartMachine()
+{
+    const auto optionalString = [](const std::optional<std::string> &value) {
+        return value ? json(*value) : json(nullptr);
+    };
+    m_warmStart.confirm(WARM_START_MACHINE,
+                        json {
+                                {JKEY_WARM_OPDB_ID, m_machineInfo.opdbId},
+                                {JKEY_WARM_MACHINE_UUID, m_machineInfo.machineUuid},
+                                {JKEY_WARM_VARIANT_UUID, optionalString(m_machineInfo.variantUuid)},
+                                {JKEY_WARM_GAME_SLUG, optionalString(m_machineInfo.gameSlug)},
+                                {JKEY_WARM_VENUE_UUID, optionalString(m_machineInfo.venueUuid)},
+                                {JKEY_WARM_TITLE, m_machineInfo.title},
+                        });
+}
+
 void Net::onPaired()
 {
-    m_status = AuthStatus::AuthenticatedPaired;
+    setStatus(AuthStatus::AuthenticatedPaired);
     sendScorbitronObject();
     requestReleaseTrackInfo();
     getConfig();
     requestFirmwaresList();
     sendHeartbeat();
     startHeartbeatTimer();
+    startLeaderboardPrefetchTimer();
     createNfcNonces();
     restartCentrifugo();
     emitPairingStatusEventIfChanged(true);
@@ -2125,14 +2731,15 @@ void Net::onPaired()
 
 void Net::onUnpaired()
 {
-    m_status = AuthStatus::AuthenticatedUnpaired;
+    setStatus(AuthStatus::AuthenticatedUnpaired);
+    m_worker.stopTimer(Worker::Timer::LeaderboardPrefetch);
     clearPairedMachineContext();
     m_authCV.notify_all();
     emitPairingStatusEventIfChanged(false);
     restartCentrifugo();
 }
 
-void Net::parseScorbitronObject(Error error, const std::string &reply)
+void Net::parseScorbitronObject(Error error, const std::string &reply, bool requestMachine)
 {
     if (error != Error::Success) {
         return;
@@ -2148,6 +2755,7 @@ void Net::parseScorbitronObject(Error error, const std::string &reply)
                 it->get_to(m_cachedShortCode);
             }
             m_shortCodeCV.notify_all();
+            m_warmStart.confirm(WARM_START_SHORT_CODE, *it);
         }
 
         bool isPaired {false};
@@ -2170,7 +2778,7 @@ void Net::parseScorbitronObject(Error error, const std::string &reply)
         if (!isPaired) {
             status = AuthStatus::AuthenticatedUnpaired;
             clearPairedMachineContext();
-        } else {
+        } else if (requestMachine) {
             requestMachineObject();
         }
 
@@ -2183,10 +2791,14 @@ void Net::parseScorbitronObject(Error error, const std::string &reply)
             }
         }
 
-        m_eventManager->push(std::make_shared<ConfigReceivedEvent>(json));
+        saveWarmStartMachine();
+        if (m_warmStart.confirm(WARM_START_SCORBITRON_OBJECT, json)) {
+            m_eventManager->push(std::make_shared<ConfigReceivedEvent>(json));
+        }
 
+        m_warmStartPairing = false;
         if (m_status != status) {
-            m_status = status;
+            setStatus(status);
             m_authCV.notify_all();
             emitPairingStatusEventIfChanged(isPaired);
         }
@@ -2244,20 +2856,24 @@ task_t Net::createHttpRequestTask(const char *requestType, StringCallback replyC
                                 resilientTransferTimeouts);
             reply = std::move(r.text);
 
-            if (r.status_code >= 200 && r.status_code < 300) {
+            // 304 is the reply to conditional request, the caller keeps its cached copy
+            if ((r.status_code >= 200 && r.status_code < 300) || r.status_code == 304) {
                 DBG("API {} request to {} OK, {}", requestType, url.str(), reply);
                 error = Error::Success;
                 break;
             }
 
-            ERR("API {} request to {} FAILED: code={}, {}, reply: {}", requestType, url.str(),
-                r.status_code, r.error.message, reply);
-
             if (r.status_code == 0) {
+                // No connection, retried every second until it's back
+                ERR_EVERY(REPEATED_LOG_INTERVAL, "API {} request to {} FAILED: {}", requestType,
+                          url.str(), r.error.message);
                 std::this_thread::sleep_for(1000ms);
                 continue;
             }
 
+            ERR("API {} request to {} FAILED: code={}, {}, reply: {}", requestType, url.str(),
+                r.status_code, r.error.message, reply);
+
             if (r.status_code != 401) {
                 break;
             }
@@ -2269,7 +2885,7 @@ task_t Net::createHttpRequestTask(const char *requestType, StringCallback replyC
                     || m_status == AuthStatus::AuthenticationFailed) {
                     continue;
                 }
-                m_status = AuthStatus::NotAuthenticated;
+                setStatus(AuthStatus::NotAuthenticated);
             }
             stopTokenRefreshTimer();
             auto auth = createAuthenticateTask();
@@ -2343,6 +2959,26 @@ task_t Net::createPostMultipartRequestTask(StringCallback replyCallback,
             std::move(allowedStatuses), false, true);
 }
 
+task_t Net::createPostStreamRequestTask(StringCallback replyCallback,
+                                        deferred_post_stream_setup_t deferredSetup,
+                                        std::vector<AuthStatus> allowedStatuses)
+{
+    return createHttpRequestTask(
+            REST_POST, std::move(replyCallback), std::move(deferredSetup),
+            [this](const cpr::Url &url, const StreamingMultipart &multipart, cpr::Header header,
+                   const cpr::Timeout &, bool) {
+                // The body is produced while it's sent, so always the transfer timeouts
+                header[HDR_KEY_CONTENT_TYPE] = multipart.contentType();
+                return cpr::Post(url, multipart.readCallback(), header,
+                                 cpr::Timeout {NET_TRANSFER_TOTAL_TIMEOUT},
+                                 cpr::ConnectTimeout {NET_CONNECT_TIMEOUT},
+                                 cpr::LowSpeed {NET_TRANSFER_LOW_SPEED_BPS,
+                                                NET_TRANSFER_LOW_SPEED_STALL_TIME},
+                                 sslOptions());
+            },
+            std::move(allowedStatuses), false, true);
+}
+
 task_t Net::createPatchRequestTask(StringCallback replyCallback,
                                    deferred_patch_setup_t deferredSetup,
                                    std::vector<AuthStatus> allowedStatuses)
@@ -2387,75 +3023,198 @@ task_t Net::createPatchMultipartRequestTask(StringCallback replyCallback,
 }
 
 task_t Net::createDownloadFileTask(StringCallback replyCallback, std::string url,
-                                   std::string filename, HttpHeaders extraHeaders)
+                                   std::string filename, HttpHeaders extraHeaders,
+                                   DownloadOptions options)
+{
+    return [this, callback = std::move(replyCallback), url = std::move(url),
+            filename = std::move(filename), extraHeaders = std::move(extraHeaders),
+            options = std::move(options)]() {
+        const auto fullUrl = this->url(url);
+        const bool isInternal = isInternalDownloadForAuth(fullUrl.str(), m_hostname, m_deviceInfo);
+
+        // Auth header is taken per request, token might be refreshed between retries
+        const auto makeHeaders = [this, isInternal, &extraHeaders]() {
+            auto headers = isInternal ? authHeader() : cpr::Header {};
+            for (const auto &[k, v] : extraHeaders) {
+                headers[k] = v;
+            }
+            return headers;
+        };
+
+        const FileDownloader downloader(sslOptions(),
+                                        {.connectTimeout = NET_CONNECT_TIMEOUT,
+                                         .transferTimeout = NET_TRANSFER_TOTAL_TIMEOUT,
+                                         .lowSpeedBps = NET_TRANSFER_LOW_SPEED_BPS,
+                                         .lowSpeedStallTime = NET_TRANSFER_LOW_SPEED_STALL_TIME,
+                                         .retries = NUM_RETRIES});
+        const auto [error, statusCode] =
+                downloader.download(fullUrl.str(), filename, makeHeaders, options);
+
+        if (callback) {
+            callback(error,
+                     fmt::format("HTTP CODE: {}, url: {}, to file: {}", statusCode, url, filename));
+        }
+    };
+}
+
+task_t Net::createDownloadStreamTask(StringCallback replyCallback, std::string url,
+                                     HttpHeaders extraHeaders, DownloadOptions options,
+                                     DataCallback onData)
 {
     return [this, callback = std::move(replyCallback), url = std::move(url),
-            filename = std::move(filename), extraHeaders = std::move(extraHeaders)]() {
+            extraHeaders = std::move(extraHeaders), options = std::move(options),
+            onData = std::move(onData)]() {
         Error error {Error::ApiError};
-        std::string reply;
         int statusCode = 0;
 
-        std::ofstream file(filename, std::ios::binary);
-        if (!file.is_open()) {
-            ERR("API Can't open file for writing: {}", filename);
-            error = Error::FileError;
-        } else {
-            const auto fullUrl = this->url(url);
-            const bool isInternal =
-                    isInternalDownloadForAuth(fullUrl.str(), m_hostname, m_deviceInfo);
+        const auto fullUrl = this->url(url);
+        const bool isInternal = isInternalDownloadForAuth(fullUrl.str(), m_hostname, m_deviceInfo);
+        const auto elidedUrl = elideUrl(fullUrl.str());
 
-            const auto elidedUrl = elideUrl(fullUrl.str());
+        Sha256Stream hasher;
+        int64_t offset = 0;
+        std::string validator; // ETag or Last-Modified, resumed range must be of the same file
 
-            for (int i = 0; i < NUM_RETRIES; ++i) {
-                INF("API Download file: {}", elidedUrl);
+        for (int i = 0; i < NUM_RETRIES; ++i) {
+            auto headers = isInternal ? authHeader() : cpr::Header {};
+            for (const auto &[k, v] : extraHeaders) {
+                headers[k] = v;
+            }
+            if (offset > 0) {
+                if (validator.empty()) {
+                    ERR("API Download stream: can't resume without ETag, received: {}, url: {}",
+                        offset, elidedUrl);
+                    break;
+                }
+                headers[HDR_KEY_RANGE] = rangeHeaderFrom(offset);
+                headers[HDR_KEY_IF_RANGE] = validator;
+            }
 
-                auto headers = isInternal ? authHeader() : cpr::Header {};
-                for (const auto &[k, v] : extraHeaders) {
-                    headers[k] = v;
+            INF("API Download stream: {}", elidedUrl);
+
+            int status = 0;
+            std::string etag;
+            std::string lastModified;
+            std::optional<ContentRange> contentRange;
+            bool bodyChecked = false;
+            bool bodyAccepted = false;
+            bool consumerFailed = false;
+            std::string errorBody;
+
+            auto onHeader = [&](std::string_view line, intptr_t) {
+                if (const auto code = parseHttpStatusLine(line)) {
+                    status = code;
+                    etag.clear();
+                    lastModified.clear();
+                    contentRange.reset();
+                } else if (const auto header = parseHttpHeaderLine(line)) {
+                    const auto &[key, value] = *header;
+                    if (key == "etag" && !value.starts_with("W/")) {
+                        etag = value;
+                    } else if (key == "last-modified") {
+                        lastModified = value;
+                    } else if (key == "content-range") {
+                        contentRange = parseContentRange(value);
+                    }
                 }
+                return true;
+            };
 
-                auto r = cpr::Download(file, fullUrl, cpr::Timeout {NET_TRANSFER_TOTAL_TIMEOUT},
-                                       cpr::ConnectTimeout {NET_CONNECT_TIMEOUT},
-                                       cpr::LowSpeed {NET_TRANSFER_LOW_SPEED_BPS,
-                                                      NET_TRANSFER_LOW_SPEED_STALL_TIME},
-                                       headers, sslOptions());
-                reply = std::move(r.text);
-                statusCode = r.status_code;
-
-                if (statusCode == 200) {
-                    DBG("API Download file: ok, {}", reply);
-                    error = Error::Success;
-                    break;
+            auto onWrite = [&](std::string_view data, intptr_t) {
+                if (!bodyChecked) {
+                    bodyChecked = true;
+                    // Bytes already passed on can't be taken back, so only the exact
+                    // continuation is accepted
+                    bodyAccepted = offset == 0
+                                 ? status == 200
+                                 : status == 206 && contentRange && contentRange->first == offset;
+                    if (bodyAccepted && offset == 0) {
+                        validator = etag.empty() ? lastModified : etag;
+                    }
                 }
 
-                error = Error::ApiError;
-                ERR("API Download file failed: code={}, message: {}, reply: {}, url: {}",
-                    statusCode, r.error.message, reply, elidedUrl);
+                if (!bodyAccepted) {
+                    if (errorBody.size() < DOWNLOAD_ERROR_BODY_LIMIT) {
+                        errorBody.append(
+                                data.substr(0, DOWNLOAD_ERROR_BODY_LIMIT - errorBody.size()));
+                    }
+                    return offset == 0; // Whole file instead of the range is of no use
+                }
 
-                if (statusCode >= 400) {
-                    break;
+                if (!onData(data)) {
+                    consumerFailed = true;
+                    return false; // Abort transfer
                 }
+                hasher.update(data);
+                offset += static_cast<int64_t>(data.size());
+                return true;
+            };
+
+            auto r = cpr::Get(
+                    fullUrl, headers, cpr::HeaderCallback {onHeader}, cpr::WriteCallback {onWrite},
+                    cpr::Timeout {NET_TRANSFER_TOTAL_TIMEOUT},
+                    cpr::ConnectTimeout {NET_CONNECT_TIMEOUT},
+                    cpr::LowSpeed {NET_TRANSFER_LOW_SPEED_BPS, NET_TRANSFER_LOW_SPEED_STALL_TIME},
+                    sslOptions());
+            statusCode = status != 0 ? status : static_cast<int>(r.status_code);
+
+            if (consumerFailed) {
+                ERR("API Download stream: data rejected after {} bytes, url: {}", offset,
+                    elidedUrl);
+                error = Error::FileError;
+                break;
+            }
+
+            const bool transferOk = r.error.code == cpr::ErrorCode::OK;
+            if (transferOk && (bodyAccepted || (statusCode == 200 && !bodyChecked))) {
+                DBG("API Download stream: ok, {} bytes", offset);
+                error = Error::Success;
+                break;
+            }
+
+            error = Error::ApiError;
+            ERR("API Download stream failed: code={}, message: {}, reply: {}, received: {}, "
+                "url: {}",
+                statusCode, r.error.message, errorBody, offset, elidedUrl);
+
+            if (statusCode >= 400 || (offset > 0 && bodyChecked && !bodyAccepted)) {
+                break;
+            }
+        }
+
+        if (error == Error::Success && options.expectedSize >= 0
+            && hasher.size() != static_cast<uint64_t>(options.expectedSize)) {
+            ERR("API Download stream: size mismatch, expected: {}, got: {}, url: {}",
+                options.expectedSize, hasher.size(), elidedUrl);
+            error = Error::FileError;
+        }
+
+        if (error == Error::Success && !options.expectedSha256.empty()) {
+            const auto digest = hasher.hexDigest();
+            if (sha256Matches(digest, options.expectedSha256)) {
+                DBG("API Download stream: sha256 ok, {}", digest);
+            } else {
+                ERR("API Download stream: sha256 mismatch, expected: {}, got: {}, url: {}",
+                    options.expectedSha256, digest, elidedUrl);
+                error = Error::FileError;
             }
         }
-        file.close();
 
         if (callback) {
-            callback(error,
-                     fmt::format("HTTP CODE: {}, url: {}, to file: {}", statusCode, url, filename));
+            callback(error, fmt::format("HTTP CODE: {}, url: {}, {} bytes", statusCode, url,
+                                        hasher.size()));
         }
     };
 }
 
-task_t Net::createDownloadBufferTask(VectorCallback replyCallback, std::string url,
+task_t Net::createDownloadBufferTask(BufferReplyCallback replyCallback, std::string url,
                                      size_t reserveBufferSize, HttpHeaders extraHeaders)
 {
     return [this, callback = std::move(replyCallback), url = std::move(url), reserveBufferSize,
             extraHeaders = std::move(extraHeaders)]() {
         Error error {Error::ApiError};
         std::vector<uint8_t> buffer;
-        if (reserveBufferSize > 0) {
-            buffer.reserve(reserveBufferSize);
-        }
+        BufferReplyInfo info;
 
         const auto fullUrl = this->url(url);
         const bool isInternal = isInternalDownloadForAuth(fullUrl.str(), m_hostname, m_deviceInfo);
@@ -2466,43 +3225,113 @@ task_t Net::createDownloadBufferTask(VectorCallback replyCallback, std::string u
         }
 
         const auto elidedUrl = elideUrl(fullUrl.str());
+        constexpr auto maxSize = static_cast<size_t>(MAX_BUFFER_DOWNLOAD_SIZE);
 
         for (int i = 0; i < NUM_RETRIES; ++i) {
             INF("API Download buffer: {}", elidedUrl);
 
+            buffer.clear();
+            buffer.reserve(std::min(reserveBufferSize, maxSize));
+
+            int status = 0;
+            std::string etag;
+            size_t limit = maxSize;
+            bool tooBig = false;
+            std::string errorBody;
+
+            // Body is written straight into the buffer, so big replies are stopped as soon as
+            // Content-Length or the received bytes exceed the limit
+            auto onHeader = [&](std::string_view line, intptr_t) {
+                if (const auto code = parseHttpStatusLine(line)) {
+                    status = code;
+                    limit = maxSize;
+                    etag.clear();
+                    return true;
+                }
+
+                const auto header = parseHttpHeaderLine(line);
+                if (header && header->first == "etag") {
+                    etag = header->second;
+                }
+                if (status != 200 || !header || header->first != "content-length") {
+                    return true;
+                }
+
+                size_t contentLength = 0;
+                const auto &value = header->second;
+                const auto [ptr, ec] =
+                        std::from_chars(value.data(), value.data() + value.size(), contentLength);
+                if (ec != std::errc {}) {
+                    return true;
+                }
+
+                if (contentLength > maxSize) {
+                    ERR("API Download buffer: too big, Content-Length: {}", contentLength);
+                    tooBig = true;
+                    return false; // Abort transfer
+                }
+
+                limit = contentLength;
+                buffer.reserve(contentLength);
+                return true;
+            };
+
+            auto onWrite = [&](std::string_view data, intptr_t) {
+                if (status != 200) {
+                    if (errorBody.size() < DOWNLOAD_ERROR_BODY_LIMIT) {
+                        errorBody.append(
+                                data.substr(0, DOWNLOAD_ERROR_BODY_LIMIT - errorBody.size()));
+                    }
+                    return true;
+                }
+
+                if (buffer.size() + data.size() > limit) {
+                    ERR("API Download buffer: too big, more than {} bytes", limit);
+                    tooBig = true;
+                    return false; // Abort transfer
+                }
+
+                const auto *bytes = reinterpret_cast<const uint8_t *>(data.data());
+                buffer.insert(buffer.end(), bytes, bytes + data.size());
+                return true;
+            };
+
             auto r = cpr::Get(
-                    fullUrl, headers, cpr::Timeout {NET_TRANSFER_TOTAL_TIMEOUT},
+                    fullUrl, headers, cpr::HeaderCallback {onHeader}, cpr::WriteCallback {onWrite},
+                    cpr::Timeout {NET_TRANSFER_TOTAL_TIMEOUT},
                     cpr::ConnectTimeout {NET_CONNECT_TIMEOUT},
                     cpr::LowSpeed {NET_TRANSFER_LOW_SPEED_BPS, NET_TRANSFER_LOW_SPEED_STALL_TIME},
                     sslOptions());
+            const auto statusCode = status != 0 ? status : static_cast<int>(r.status_code);
 
-            if (r.status_code == 200) {
-                const auto *data = reinterpret_cast<const uint8_t *>(r.text.data());
-                buffer.assign(data, data + r.text.size());
+            if (tooBig) {
+                buffer.clear();
+                error = Error::ApiError;
+                break;
+            }
 
-                if (buffer.size() > MAX_BUFFER_DOWNLOAD_SIZE) {
-                    ERR("API Download buffer: too big, {} bytes", buffer.size());
-                    buffer.clear();
-                    error = Error::ApiError;
-                    break;
-                }
+            info.statusCode = statusCode;
+            info.etag = std::move(etag);
 
-                DBG("API Download buffer: ok, {} bytes", buffer.size());
+            // 304 is only possible if caller asked for revalidation with If-None-Match
+            if ((statusCode == 200 || statusCode == 304) && r.error.code == cpr::ErrorCode::OK) {
+                DBG("API Download buffer: ok, code={}, {} bytes", statusCode, buffer.size());
                 error = Error::Success;
                 break;
             }
 
+            buffer.clear();
             error = Error::ApiError;
             ERR("API Download buffer failed: code={}, message: {}, reply: {}, url: {}",
-                r.status_code, r.error.message, r.text, elidedUrl);
+                statusCode, r.error.message, errorBody, elidedUrl);
 
-            if (r.status_code >= 400) {
+            if (statusCode >= 400) {
                 break;
             }
         }
 
         if (callback) {
-            callback(error, std::move(buffer));
+            callback(error, std::move(buffer), info);
         }
     };
 }
@@ -2562,21 +3391,51 @@ void Net::processScoresAndPlayersProfiles(const json &val, GameSession &gameSess
     if (m_deviceInfo.autoDownloadPlayerPics) {
         const auto toDownload = m_playersManager.picturesToDownload();
         for (const auto &[playerNum, pictureUrl] : toDownload) {
-            m_playersManager.setPicture(pictureUrl, Picture {});
-            downloadBuffer(true, // Async download
-                           [this, playerNum = playerNum,
-                            pictureUrl = pictureUrl](Error error, std::vector<uint8_t> data) {
-                               if (error == Error::Success) {
-                                   m_playersManager.setPicture(pictureUrl, data);
-                                   m_eventManager->push(std::make_shared<PlayerPictureReadyEvent>(
-                                           playerNum, std::move(data)));
-                               } else {
-                                   ERR("Picture download failed: {}", static_cast<int>(error));
-                                   m_playersManager.removePicture(pictureUrl);
-                               }
-                           },
-                           pictureUrl, PICTURE_BUFFER_RESERVE,
-                           {{HDR_KEY_ACCEPT_CONTENT, HDR_VAL_CONTENT_OCTET}});
+            HttpHeaders headers {{HDR_KEY_ACCEPT_CONTENT, HDR_VAL_CONTENT_OCTET}};
+
+            // Picture from disk cache is shown right away and then revalidated with the server
+            const auto cached = m_playersManager.loadFromDisk(pictureUrl);
+            if (cached.picture) {
+                m_eventManager->push(
+                        std::make_shared<PlayerPictureReadyEvent>(playerNum, cached.picture));
+                if (!cached.etag.empty()) {
+                    headers.emplace_back(HDR_KEY_IF_NONE_MATCH, cached.etag);
+                } else if (!cached.lastModified.empty()) {
+                    headers.emplace_back(HDR_KEY_IF_MODIFIED_SINCE, cached.lastModified);
+                }
+            } else {
+                m_playersManager.setPicture(pictureUrl, Picture {}); // Mark as pending
+            }
+
+            m_worker.postQueue(createDownloadBufferTask(
+                    [this, playerNum = playerNum, pictureUrl = pictureUrl,
+                     cachedPicture = cached.picture](Error error, std::vector<uint8_t> data,
+                                                     const BufferReplyInfo &info) {
+                        if (error != Error::Success) {
+                            ERR("Picture download failed: {}", static_cast<int>(error));
+                            if (!cachedPicture) {
+                                m_playersManager.removePicture(pictureUrl);
+                            }
+                            return;
+                        }
+
+                        if (info.statusCode == 304) {
+                            DBG("Picture not modified: {}", pictureUrl);
+                            return;
+                        }
+
+                        // Server may send the same picture again, it's already shown
+                        const bool unchanged = cachedPicture && *cachedPicture == data;
+                        auto picture = m_playersManager.setPicture(pictureUrl, std::move(data),
+                                                                   info.etag);
+                        if (unchanged) {
+                            DBG("Picture unchanged: {}", pictureUrl);
+                            return;
+                        }
+                        m_eventManager->push(
+                                std::make_shared<PlayerPictureReadyEvent>(playerNum, picture));
+                    },
+                    pictureUrl, PICTURE_BUFFER_RESERVE, std::move(headers)));
         }
     }
 }
@@ -2606,40 +3465,39 @@ void Net::retireCentrifugoClient()
             {.retiredAt = steady_clock::now(), .client = std::move(m_centrifugo)});
 }
 
-void Net::centrifugoSetup(bool fetchFreshToken)
+std::string Net::fetchCfToken() const
+{
+    std::string authToken;
+    {
+        std::shared_lock lock(m_tokenMutex);
+        authToken = m_stoken;
+    }
+    if (authToken.empty()) {
+        return {};
+    }
+    return getJwtToken(url(URL_SCORBITRON_CF_TOKEN).str(), authToken, sslOptions());
+}
+
+void Net::centrifugoSetup()
 {
     // Create centrifugo client
     centrifugo::ClientConfig config;
     config.name = "scorbit_sdk";
     config.version = SCORBIT_SDK_VERSION;
-    config.refreshTokenBeforeExpiry = 3min;
-    auto initialCfToken = std::make_shared<std::string>();
-
-    if (fetchFreshToken) {
-        std::string authToken;
-        {
-            std::shared_lock lock(m_tokenMutex);
-            authToken = m_stoken;
-        }
-        if (!authToken.empty()) {
-            *initialCfToken =
-                    getJwtToken(url(URL_SCORBITRON_CF_TOKEN).str(), authToken, sslOptions());
-        }
-    }
+    config.refreshTokenBeforeExpiry = CF_REFRESH_TOKEN_BEFORE_EXPIRY;
 
-    config.getToken = [this, initialCfToken]() -> std::string {
+    // Called on centrifugo strand, which carries the publications too, so the token is prefetched
+    config.getToken = [this]() -> std::string {
         if (m_stop) {
             return {};
         }
 
-        if (!initialCfToken->empty()) {
-            auto token = std::move(*initialCfToken);
-            initialCfToken->clear();
+        if (auto token = m_cfTokens.current(); !token.empty()) {
             return token;
         }
 
-        std::shared_lock lock(m_tokenMutex);
-        return getJwtToken(url(URL_SCORBITRON_CF_TOKEN).str(), m_stoken, sslOptions());
+        WRN("API-CF no prefetched token, fetching it on centrifugo strand");
+        return fetchCfToken();
     };
 
     config.logHandler = [](centrifugo::LogEntry entry) {
@@ -2681,11 +3539,12 @@ void Net::centrifugoSetup(bool fetchFreshToken)
     });
 
     m_centrifugo->onError(withActiveClient([](const centrifugo::Error &error) {
-        ERR("API-CF Error: ({}, {})", error.ec.value(), error.message);
+        ERR_EVERY(REPEATED_LOG_INTERVAL, "API-CF Error: ({}, {})", error.ec.value(), error.message);
     }));
 
     m_centrifugo->onConnecting(withActiveClient([](centrifugo::Error const &error) {
-        INF("API-CF Connecting to Centrifugo server... ({}, {})", error.ec.value(), error.message);
+        INF_EVERY(REPEATED_LOG_INTERVAL, "API-CF Connecting to Centrifugo server... ({}, {})",
+                  error.ec.value(), error.message);
     }));
 
     m_centrifugo->onConnected(withActiveClient([this] {
@@ -2694,19 +3553,22 @@ void Net::centrifugoSetup(bool fetchFreshToken)
         }
 
         INF("API-CF Connected to Centrifugo!");
+        FlightRecorder::instance().event("Centrifugo connected");
+        m_cfBackoff.reset();
+        m_cfStreams.reconnected();
         pruneRetiredCentrifugoClients();
         requestCreditsStatusIfReady();
     }));
 
-    m_centrifugo->onDisconnected(withActiveClient([this, withActiveClient](
-                                                          centrifugo::Error const &error) {
+    m_centrifugo->onDisconnected(withActiveClient([this](centrifugo::Error const &error) {
         WRN("API-CF Disconnected from Centrifugo ({}, {})", error.ec.value(), error.message);
+        FlightRecorder::instance().event("Centrifugo disconnected ({}, {})", error.ec.value(),
+                                         error.message);
 
         if (m_stop) {
             return;
         }
 
-        constexpr auto RECONNECT_DELAY = 10s;
         constexpr auto RESTART_DELAY = 100ms;
 
         if (m_restartCentrifugoPending.exchange(false)) {
@@ -2726,12 +3588,7 @@ void Net::centrifugoSetup(bool fetchFreshToken)
         case 3500:
         case 3501:
         case 3502:
-            if (!m_stop) {
-                INF("API-CF reset and setup centrifugo client in {}", RECONNECT_DELAY);
-                m_worker.startTimer(Worker::Timer::CentrifugoReconnect, RECONNECT_DELAY,
-                                    withActiveClient([this] { setupAndConnectCentrifugo(true); }));
-                // m_worker.post([this]() { m_centrifugo.reset(); }); // TODO: if we need to reset?
-            }
+            scheduleCentrifugoReconnect(error.ec.value());
             break;
 
         default:
@@ -2758,75 +3615,36 @@ void Net::centrifugoSetup(bool fetchFreshToken)
         }
 
         try {
-            INF("API-CF Publication received on channel: {}, data: {}, offset: {}", channel,
-                pub.data.dump(), pub.offset);
+            DBG("API-CF Publication received on channel: {}, data: {}, offset: {}", channel,
+                JsonDump {pub.data}, pub.offset);
             if (pub.info) {
-                INF("API-CF Publication info, from user: {}, client: {}", pub.info->user,
+                DBG("API-CF Publication info, from user: {}, client: {}", pub.info->user,
                     pub.info->client);
             }
 
-            if (channel.starts_with(CF_CHN_CONTROL_MACHINE)) {
-                const auto &j = pub.data;
-                if (const auto payloadIt = j.find(JKEY_CHN_PAYLOAD);
-                    payloadIt != j.end() && payloadIt->is_object()) {
-                    const auto type = j.value(JKEY_CHN_TYPE, "");
+            // History recovered after reconnect may bring publications which were handled
+            const auto position = m_cfStreams.accept(channel, pub.offset,
+                                                     std::hash<std::string> {}(pub.data.dump()));
+            if (position.duplicate) {
+                DBG("API-CF Replayed publication on channel: {}, offset: {}, skipped", channel,
+                    pub.offset);
+                return;
+            }
+            if (position.newStream || position.missed > 0) {
+                WRN("API-CF Stream of channel: {} lost publications, new stream: {}, missed: {}",
+                    channel, position.newStream, position.missed);
+                FlightRecorder::instance().event("Centrifugo stream gap on {}, missed: {}",
+                                                 channel, position.missed);
+                // Credits are what the host must not get out of sync on
+                requestCreditsStatusIfReady();
+            }
 
-                    if (type == JVAL_CHN_TYPE_START_GAME) {
-                        const int playerCount = payloadIt->value(JKEY_SESS_PLAYER_COUNT, 1);
-                        setNumberOfPlayersRequested(playerCount);
-                        m_eventManager->push(
-                                std::make_shared<GameStartRequestedEvent>(playerCount));
-                    } else if (type == JVAL_TYPE_ACTION) {
-                        const auto method = payloadIt->value(JKEY_METHOD, "");
-                        const auto name = payloadIt->value(JKEY_ACTION_NAME, "");
-                        if (method == JVAL_METHOD_GET) {
-                            if (name == JVAL_ACITON_GET_SCORBITRON_SESSION) {
-                                const auto url = payloadIt->value(JKEY_URL, "");
-                                const auto sessionUuid = parseUrlUuid(url, URL_SESSIONS_ID);
-                                requestSessionData(sessionUuid);
-                            }
-                        } else if (method == JVAL_METHOD_MSG) {
-                            requestCreditsStatusEvent(); // TODO add extra condition
-                        }
-                    } else if (type == JVAL_CHN_TYPE_ADD_CREDITS) {
-                        const int credits = payloadIt->value(JKEY_CREDITS_COUNT, 1);
-                        const auto transaction =
-                                payloadIt->value(JKEY_CREDITS_TRANSACTION, std::string {});
-                        m_eventManager->push(
-                                std::make_shared<CreditsAddRequestedEvent>(credits, transaction));
-                    } else if (type == JVAL_CHN_TYPE_DIAG_PROBE) {
-                        handleDiagnosticProbe(*payloadIt);
-                    } else {
-                        WRN("API-CF Unknown publication type: {}", type);
-                    }
-                }
-            } else if (channel.starts_with(CF_CHN_CONTROL_SCORBITRON)) {
-                const auto &j = pub.data;
-                if (const auto payloadIt = j.find(JKEY_CHN_PAYLOAD);
-                    payloadIt != j.end() && payloadIt->is_object()) {
-                    const auto type = j.value(JKEY_CHN_TYPE, "");
-                    if (type == JVAL_TYPE_ACTION) {
-                        const auto method = payloadIt->value(JKEY_METHOD, "");
-                        const auto name = payloadIt->value(JKEY_ACTION_NAME, "");
-                        if (method == JVAL_METHOD_SIGNAL
-                            && name == JVAL_ACTION_UPLOAD_DIAGNOSTICS) {
-                            INF("API-CF Diagnostics upload requested via control channel");
-                            m_eventManager->push(
-                                    std::make_shared<DiagnosticsUploadRequestedEvent>(false));
-                        } else if (method == JVAL_METHOD_SIGNAL
-                                   && name == JVAL_ACTION_SCORBITRON_PAIRED) {
-                            INF("API-CF Scorbitron paired signal received");
-                            onPaired();
-                        } else if (method == JVAL_METHOD_SIGNAL
-                                   && name == JVAL_ACTION_SCORBITRON_UNPAIRED) {
-                            INF("API-CF Scorbitron unpaired signal received");
-                            onUnpaired();
-                        } else if (method == JVAL_METHOD_GET
-                                   && name == JVAL_ACTION_CONFIG_REFRESH) {
-                            INF("API-CF Config refresh requested via control channel");
-                            getConfig();
-                        }
-                    }
+            if (!m_publicationRouter.dispatch(channel, pub.data)) {
+                if (channel.starts_with(CF_CHN_CONTROL_MACHINE)) {
+                    WRN("API-CF Unhandled publication on channel: {}, data: {}", channel,
+                        JsonDump {pub.data});
+                } else {
+                    DBG("API-CF Unhandled publication on channel: {}", channel);
                 }
             }
         } catch (const std::exception &e) {
@@ -2835,6 +3653,75 @@ void Net::centrifugoSetup(bool fetchFreshToken)
     }));
 }
 
+void Net::registerPublicationHandlers()
+{
+    const auto onMachine = [this](std::string_view type, std::string_view method,
+                                  std::string_view action, PublicationRouter::Handler handler) {
+        m_publicationRouter.add({CF_CHN_CONTROL_MACHINE, type, method, action}, std::move(handler),
+                                true);
+    };
+    const auto onScorbitron = [this](std::string_view method, std::string_view action,
+                                     PublicationRouter::Handler handler) {
+        m_publicationRouter.add({CF_CHN_CONTROL_SCORBITRON, JVAL_TYPE_ACTION, method, action},
+                                std::move(handler), true);
+    };
+
+    onMachine(JVAL_CHN_TYPE_START_GAME, {}, {}, [this](const json &payload) {
+        const int playerCount = payload.value(JKEY_SESS_PLAYER_COUNT, 1);
+        setNumberOfPlayersRequested(playerCount);
+        m_eventManager->push(std::make_shared<GameStartRequestedEvent>(playerCount));
+    });
+    onMachine(JVAL_TYPE_ACTION, JVAL_METHOD_GET, JVAL_ACITON_GET_SCORBITRON_SESSION,
+              [this](const json &payload) {
+                  const auto url = payload.value(JKEY_URL, "");
+                  requestSessionData(parseUrlUuid(url, URL_SESSIONS_ID));
+              });
+    onMachine(JVAL_TYPE_ACTION, JVAL_METHOD_MSG, {}, [this](const json &) {
+        requestCreditsStatusEvent(); // TODO add extra condition
+    });
+    onMachine(JVAL_CHN_TYPE_ADD_CREDITS, {}, {}, [this](const json &payload) {
+        const int credits = payload.value(JKEY_CREDITS_COUNT, 1);
+        const auto transaction = payload.value(JKEY_CREDITS_TRANSACTION, std::string {});
+        m_eventManager->push(std::make_shared<CreditsAddRequestedEvent>(credits, transaction));
+    });
+    onMachine(JVAL_CHN_TYPE_DIAG_PROBE, {}, {},
+              [this](const json &payload) { handleDiagnosticProbe(payload); });
+
+    onScorbitron(JVAL_METHOD_SIGNAL, JVAL_ACTION_UPLOAD_DIAGNOSTICS, [this](const json &) {
+        INF("API-CF Diagnostics upload requested via control channel");
+        m_eventManager->push(std::make_shared<DiagnosticsUploadRequestedEvent>(false));
+    });
+    onScorbitron(JVAL_METHOD_SIGNAL, JVAL_ACTION_SCORBITRON_PAIRED, [this](const json &) {
+        INF("API-CF Scorbitron paired signal received");
+        onPaired();
+    });
+    onScorbitron(JVAL_METHOD_SIGNAL, JVAL_ACTION_SCORBITRON_UNPAIRED, [this](const json &) {
+        INF("API-CF Scorbitron unpaired signal received");
+        onUnpaired();
+    });
+    onScorbitron(JVAL_METHOD_GET, JVAL_ACTION_CONFIG_REFRESH, [this](const json &) {
+        INF("API-CF Config refresh requested via control channel");
+        getConfig();
+    });
+
+    // Integrator handlers go last, SDK routes are exclusive, so they can neither replace the SDK
+    // ones nor take some of their publications. They run on the worker, not to hold the
+    // centrifugo strand.
+    for (const auto &handler : m_deviceInfo.controlHandlers) {
+        const bool added = m_publicationRouter.add(
+                {CF_CHN_CONTROL_MACHINE, handler.type, handler.method, handler.action},
+                [this, type = handler.type, callback = handler.callback](const json &payload) {
+                    m_worker.post([type, callback, payload = payload.dump()] {
+                        callback(type, payload);
+                    });
+                });
+        if (!added) {
+            WRN("API-CF Control handler type: {}, method: {}, action: {} is taken, ignored",
+                handler.type, handler.method, handler.action);
+        }
+    }
+}
+
 void Net::centrifugoConnect()
 {
     if (m_stop || !m_centrifugo) {
@@ -2854,25 +3741,35 @@ void Net::centrifugoConnect()
 
 void Net::setupAndConnectCentrifugo(bool fetchFreshToken)
 {
+    if (fetchFreshToken) {
+        // Client is created when the token is here, nothing waits for it on centrifugo strand
+        m_cfTokens.refresh([this](const std::string &) {
+            if (!m_stop) {
+                setupAndConnectCentrifugo(false);
+            }
+        });
+        return;
+    }
+
     pruneRetiredCentrifugoClients();
-    centrifugoSetup(fetchFreshToken);
+    centrifugoSetup();
     centrifugoConnect();
 }
 
-void Net::restartCentrifugo()
+void Net::restartCentrifugo(bool fetchFreshToken)
 {
     m_worker.stopTimer(Worker::Timer::CentrifugoReconnect);
 
     if (!m_centrifugo) {
         m_restartCentrifugoPending = false;
-        setupAndConnectCentrifugo(true);
+        setupAndConnectCentrifugo(fetchFreshToken);
         return;
     }
 
     if (m_centrifugo->state() == centrifugo::ConnectionState::Disconnected) {
         m_restartCentrifugoPending = false;
         retireCentrifugoClient();
-        setupAndConnectCentrifugo(true);
+        setupAndConnectCentrifugo(fetchFreshToken);
         return;
     }
 
@@ -2880,42 +3777,84 @@ void Net::restartCentrifugo()
     m_centrifugo->disconnect();
 }
 
+void Net::scheduleCentrifugoReconnect(int disconnectCode)
+{
+    // Codes 3500-3502 are terminal, the client doesn't reconnect by itself. Reconnecting the same
+    // client is cheaper than building a new one, unless it was told its request was bad or it
+    // keeps failing.
+    constexpr int INVALID_TOKEN = 3500;
+    constexpr int BAD_REQUEST = 3501;
+
+    const auto attempt = m_cfBackoff.attempts();
+    const auto delay = m_cfBackoff.next();
+    const bool rebuild = disconnectCode == BAD_REQUEST || attempt >= CF_RECONNECT_REUSE_ATTEMPTS;
+    const bool freshToken = rebuild || disconnectCode == INVALID_TOKEN;
+    INF("API-CF {} centrifugo client in {}, attempt: {}", rebuild ? "rebuild" : "reconnect",
+        delay, attempt + 1);
+
+    auto *const client = m_centrifugo.get();
+    m_worker.startTimer(
+            Worker::Timer::CentrifugoReconnect, delay, [this, client, rebuild, freshToken] {
+                if (m_stop || !isActiveCentrifugoClient(client)) {
+                    return;
+                }
+
+                if (rebuild) {
+                    retireCentrifugoClient();
+                    setupAndConnectCentrifugo(true);
+                } else if (freshToken) {
+                    m_cfTokens.refresh([this, client](const std::string &) {
+                        if (!m_stop && isActiveCentrifugoClient(client)) {
+                            centrifugoConnect();
+                        }
+                    });
+                } else {
+                    centrifugoConnect();
+                }
+            });
+}
+
 std::optional<std::chrono::seconds> Net::getTimeUntilTokenExpiration() const
 {
     std::shared_lock tokenLock(m_tokenMutex);
     return getJwtTokenTimeUntilExpiration(m_stoken);
 }
 
-void Net::createNfcNonces()
+void Net::createNfcNonces(BootSequence::Done done)
 {
     if (!m_isNfcCapable) {
+        if (done) {
+            done(true);
+        }
         return;
     }
 
-    m_worker.post(createPostRequestTask(
-            [this](Error error, std::string reply) {
-                if (error == Error::Success) {
-                    INF("API create NFC nonces: ok");
-                    try {
-                        json j = json::parse(reply);
-                        if (const auto it = j.find(JVAL_NONCES); it != j.end() && it->is_array()) {
-                            {
-                                std::scoped_lock lock(m_noncesMutex);
-                                it->get_to(m_nonces);
-                            }
-                            setNfcTag();
-                            INF("API created {} NFC nonces", m_nonces.size());
-                        } else {
-                            ERR("API create NFC nonces: can't find nonces in reply");
-                        }
-                    } catch (const std::exception &e) {
-                        ERR("API error parsing NFC nonces reply: {}", e.what());
+    auto callback = [this](Error error, std::string reply) {
+        if (error == Error::Success) {
+            INF("API create NFC nonces: ok");
+            try {
+                json j = json::parse(reply);
+                if (const auto it = j.find(JVAL_NONCES); it != j.end() && it->is_array()) {
+                    {
+                        std::scoped_lock lock(m_noncesMutex);
+                        it->get_to(m_nonces);
                     }
+                    setNfcTag();
+                    INF("API created {} NFC nonces", m_nonces.size());
                 } else {
-                    ERR("API create NFC nonces: failed, error code: {}, reply: {}",
-                        static_cast<int>(error), reply);
+                    ERR("API create NFC nonces: can't find nonces in reply");
                 }
-            },
+            } catch (const std::exception &e) {
+                ERR("API error parsing NFC nonces reply: {}", e.what());
+            }
+        } else {
+            ERR("API create NFC nonces: failed, error code: {}, reply: {}",
+                static_cast<int>(error), reply);
+        }
+    };
+
+    m_worker.post(createPostRequestTask(
+            withStepDone(std::move(callback), std::move(done)),
             [this]() {
                 const auto endpoint = url(URL_SCORBITRON_NFC_NONCE_CREATE);
                 INF("API create NFC nonces: requesting new batch...");
@@ -21,6 +21,10 @@
 
 #include <scorbit_sdk/net_types.h>
 #include "leaderboard_internal.h"
+#include "leaderboard_cache.h"
+#include "local_scores.h"
+#include "warm_start_cache.h"
+#include "publication_router.h"
 #include "net_base.h"
 #include "key_resolver.h"
 #include "game_data.h"
@@ -28,7 +32,13 @@
 #include "updater.h"
 #include "identifiers.h"
 #include "event_manager.h"
+#include "boot_sequence.h"
+#include "token_prefetcher.h"
+#include "reconnect_backoff.h"
+#include "stream_positions.h"
 #include "utils/machine_fingerprint.h"
+#include "utils/download_range.h"
+#include "file_downloader.h"
 #include <centrifugo.h>
 #include <fmt/format.h>
 #include <cpr/cpr.h>
@@ -51,12 +61,23 @@ std::string getSignature(const SignerCallback &signer, const std::string &uuid,
                          const std::string &timestamp);
 
 class SafeMultipart;
+class StreamingMultipart;
+
+/// Response details for buffer downloads, used to revalidate cached data
+struct BufferReplyInfo {
+    int statusCode {0};
+    std::string etag;
+};
+using BufferReplyCallback =
+        std::function<void(Error error, std::vector<uint8_t> data, const BufferReplyInfo &info)>;
 
 class Net : public NetBase
 {
     using deferred_get_setup_t = std::function<std::tuple<cpr::Url, cpr::Parameters>()>;
     using deferred_post_setup_t = std::function<std::tuple<cpr::Url, cpr::Body>()>;
     using deferred_post_multipart_setup_t = std::function<std::tuple<cpr::Url, SafeMultipart>()>;
+    using deferred_post_stream_setup_t =
+            std::function<std::tuple<cpr::Url, StreamingMultipart>()>;
     using deferred_patch_setup_t = std::function<std::tuple<cpr::Url, cpr::Body>()>;
     using deferred_patch_multipart_setup_t = std::function<std::tuple<cpr::Url, SafeMultipart>()>;
 
@@ -114,14 +135,23 @@ public:
 
     const DeviceInfo &deviceInfo() const override;
 
+    /// Timing of the startup steps after the last authentication, not ready while they run
+    BootMetrics bootMetrics() const;
+
     void requestTopScores(LeaderboardScope scope, LeaderboardPeriod period,
                           const std::string &since, LeaderboardVpinFilter vpinFilter,
                           LeaderboardHandleCallback callback) override;
+    void requestTopScoresMulti(std::vector<LeaderboardQuery> queries,
+                               LeaderboardMultiCallback callback) override;
     void requestUnpair(StringCallback callback) override;
 
     void download(bool isAsync, StringCallback callback, const std::string &url,
-                  const std::string &filename, const HttpHeaders &headers) override;
-    void downloadBuffer(bool isAsync, VectorCallback callback, const std::string &url,
+                  const std::string &filename, const HttpHeaders &headers,
+                  const DownloadOptions &options) override;
+    void downloadStream(bool isAsync, StringCallback callback, const std::string &url,
+                        const HttpHeaders &headers, const DownloadOptions &options,
+                        DataCallback onData) override;
+    void downloadBuffer(bool isAsync, BufferCallback callback, const std::string &url,
                         size_t reserveBufferSize, const HttpHeaders &headers) override;
 
     PlayerProfilesManager &playersManager() override;
@@ -166,12 +196,13 @@ private:
 
     void sendLatestGameData(int sessionId);
 
-    void initializeConnectionState();
+    void initializeConnectionState(std::chrono::steady_clock::time_point authStartedAt);
     void initScorbitronObject();
-    void sendScorbitronObject();
+    void sendScorbitronObject(BootSequence::Done done = {});
 
-    void requestReleaseTrackInfo();
-    void requestMachineObject();
+    void requestConfig(BootSequence::Done done);
+    void requestReleaseTrackInfo(BootSequence::Done done = {});
+    void requestMachineObject(BootSequence::Done done = {});
 
     void requestSessionData(const std::string &sessionUuid);
 
@@ -181,7 +212,7 @@ private:
     task_t createUploadTask(const std::string &endpoint, const std::string &name,
                             SafeMultipart &&multipart);
 
-    void parseScorbitronObject(Error error, const std::string &reply);
+    void parseScorbitronObject(Error error, const std::string &reply, bool requestMachine = true);
 
     // Generic HTTP request task creator
     template<typename DeferredSetupT, typename HttpMethodT>
@@ -203,6 +234,10 @@ private:
                                           deferred_post_multipart_setup_t deferredSetup,
                                           std::vector<AuthStatus> allowedStatuses = {
                                                   AuthStatus::AuthenticatedPaired});
+    task_t createPostStreamRequestTask(StringCallback replyCallback,
+                                       deferred_post_stream_setup_t deferredSetup,
+                                       std::vector<AuthStatus> allowedStatuses = {
+                                               AuthStatus::AuthenticatedPaired});
     task_t createPatchRequestTask(StringCallback replyCallback,
                                   deferred_patch_setup_t deferredSetup,
                                   std::vector<AuthStatus> allowedStatuses = {
@@ -212,8 +247,12 @@ private:
             std::vector<AuthStatus> allowedStatuses = {AuthStatus::AuthenticatedPaired},
             bool includeFingerprintHash = false);
     task_t createDownloadFileTask(StringCallback replyCallback, std::string url,
-                                  std::string filename, HttpHeaders extraHeaders);
-    task_t createDownloadBufferTask(VectorCallback replyCallback, std::string url,
+                                  std::string filename, HttpHeaders extraHeaders,
+                                  DownloadOptions options);
+    task_t createDownloadStreamTask(StringCallback replyCallback, std::string url,
+                                    HttpHeaders extraHeaders, DownloadOptions options,
+                                    DataCallback onData);
+    task_t createDownloadBufferTask(BufferReplyCallback replyCallback, std::string url,
                                     size_t reserveBufferSize, HttpHeaders extraHeaders);
 
     cpr::Header header() const;
@@ -221,30 +260,51 @@ private:
     cpr::SslOptions sslOptions() const;
 
     bool checkAllowedStatuses(const std::vector<AuthStatus> &allowedStatuses) const;
+    void setStatus(AuthStatus status); // Transitions are kept by the flight recorder
 
     bool isLeaderboardContextReady(LeaderboardScope scope) const;
     std::optional<Error> leaderboardRequestTerminalError() const;
     void requestTopScoresImpl(LeaderboardScope scope, LeaderboardPeriod period,
                               const std::string &since, LeaderboardVpinFilter vpinFilter,
                               LeaderboardHandleCallback callback, int deferAttempt);
+    void requestTopScoresMultiImpl(std::vector<LeaderboardQuery> queries,
+                                   LeaderboardMultiCallback callback, int deferAttempt);
+    void deferLeaderboardRequest(task_t retry);
+    void fetchTopScores(const LeaderboardQuery &query, std::string periodParam,
+                        LeaderboardCache::DataCallback callback);
+    void startTopScoresFetch(const LeaderboardQuery &query, std::string periodParam,
+                             LeaderboardCache::DataCallback callback);
+    void prefetchLeaderboards();
+    LeaderboardDataPtr localTopScores(const LeaderboardQuery &query);
+    void recordLocalScores(const GameData &data);
+    void startLeaderboardPrefetchTimer();
+    task_t createTopScoresFetchTask(const LeaderboardQuery &query, uint64_t generation,
+                                    std::string periodParam,
+                                    LeaderboardCache::Validators validators);
     void processScoresAndPlayersProfiles(const nlohmann::json &val, GameSession &gameSession);
 
     bool isActiveCentrifugoClient(const centrifugo::Client *client) const;
     void pruneRetiredCentrifugoClients();
     void retireCentrifugoClient();
-    void centrifugoSetup(bool fetchFreshToken = false);
+    void centrifugoSetup();
+    // Routes of control channel publications, set up once in constructor
+    void registerPublicationHandlers();
     void centrifugoConnect();
     void setupAndConnectCentrifugo(bool fetchFreshToken = false);
-    void restartCentrifugo();
+    void restartCentrifugo(bool fetchFreshToken = true);
+    void scheduleCentrifugoReconnect(int disconnectCode);
+    std::string fetchCfToken() const;
 
     void clearPairedMachineContext();
     void emitPairingStatusEventIfChanged(bool isPaired);
+    void loadWarmStartCache();
+    void saveWarmStartMachine();
     void onPaired();
     void onUnpaired();
 
     std::optional<std::chrono::seconds> getTimeUntilTokenExpiration() const;
 
-    void createNfcNonces();
+    void createNfcNonces(BootSequence::Done done = {});
     void startNfcCheckTimer();
     void setNfcTag();
     void checkNfcBootReason();
@@ -317,6 +377,10 @@ private:
     std::string m_machineChannel;
     std::string m_releaseTrackUrl;
 
+    mutable std::mutex m_bootMutex;
+    std::shared_ptr<BootSequence> m_boot; // Startup steps after the last authentication
+    TokenPrefetcher m_cfTokens; // Centrifugo tokens, fetched on the worker pool ahead of time
+
     std::string m_lastNfcBootReason;
     MachineFingerprint m_fingerprint;
     std::string m_fingerprintHash;
@@ -344,6 +408,14 @@ private:
 
     Updater m_updater;
     PlayerProfilesManager m_playersManager;
+    LeaderboardCache m_leaderboardCache;
+    LocalScoreIndex m_localScores;
+    WarmStartCache m_warmStart;
+    // Pairing announced from warm start cache, until the scorbitron object reply confirms it
+    std::atomic_bool m_warmStartPairing {false};
+    std::atomic_bool m_warmStartPaired {false};
+    PublicationRouter m_publicationRouter;
+    std::vector<task_t> m_deferredLeaderboardRequests; // Accessed on m_worker queue only
 
     std::shared_ptr<nfc::ProbesManager> m_probesManager;
 
@@ -364,6 +436,9 @@ private:
     // unwind safely without retaining every historical client for the rest of the process.
     std::deque<RetiredCentrifugoClient> m_retiredCentrifugoClients;
     std::atomic_bool m_restartCentrifugoPending {false};
+    // Accessed on centrifugo strand only, they outlive clients so a new one continues the streams
+    ReconnectBackoff m_cfBackoff;
+    StreamPositions m_cfStreams;
 
     std::optional<bool> m_lastEmittedPairingState;
 
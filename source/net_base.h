@@ -27,9 +27,11 @@
 #include "player_profiles_manager.h"
 #include "event_classes.h"
 #include "session_flags.h"
+#include "file_downloader.h"
 #include <boost/signals2.hpp>
 #include <cstdint>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <optional>
 #include <atomic>
@@ -45,6 +47,12 @@ namespace detail {
 
 struct GameData;
 
+/// Receives downloaded buffer by value, so it can be moved through without a copy
+using BufferCallback = std::function<void(Error error, std::vector<uint8_t> data)>;
+
+/// Receives downloaded bytes in order as they arrive, false aborts the download
+using DataCallback = std::function<bool(std::string_view data)>;
+
 class NetBase
 {
 public:
@@ -74,13 +82,36 @@ public:
                                   const std::string &since,
                                   LeaderboardVpinFilter vpinFilter,
                                   LeaderboardHandleCallback callback) = 0;
+    virtual void requestTopScoresMulti(std::vector<LeaderboardQuery> queries,
+                                       LeaderboardMultiCallback callback) = 0;
     virtual void requestUnpair(StringCallback callback) = 0;
 
     virtual void download(bool isAsync, StringCallback callback, const std::string &url,
-                          const std::string &filename, const HttpHeaders &headers) = 0;
-    virtual void downloadBuffer(bool isAsync, VectorCallback callback, const std::string &url,
+                          const std::string &filename, const HttpHeaders &headers,
+                          const DownloadOptions &options) = 0;
+    virtual void downloadBuffer(bool isAsync, BufferCallback callback, const std::string &url,
                                 size_t reserveBufferSize, const HttpHeaders &headers) = 0;
 
+    /**
+     * Download passing the bytes to @p onData instead of a file. Interrupted transfer is
+     * continued with Range requests, but can't start over, so it fails if server doesn't honor
+     * the range. Size and sha256 of @p options are verified after the last byte, @p callback is
+     * called at the end with the result.
+     */
+    virtual void downloadStream(bool isAsync, StringCallback callback, const std::string &url,
+                                const HttpHeaders &headers, const DownloadOptions &options,
+                                DataCallback onData)
+    {
+        (void)isAsync;
+        (void)url;
+        (void)headers;
+        (void)options;
+        (void)onData;
+        if (callback) {
+            callback(Error::Unknown, "Streaming download is not supported");
+        }
+    }
+
     virtual PlayerProfilesManager &playersManager() = 0;
 
     virtual void patchScorbitron(std::string body, StringCallback callback,
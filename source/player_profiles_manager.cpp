@@ -20,13 +20,27 @@
 #include "player_profiles_manager.h"
 #include <logger/logger.h>
 #include "identifiers.h"
+#include "utils/date_time_parser.h"
+#include "utils/download_range.h"
 
 #include <nlohmann/json.hpp>
 #include <fmt/format.h>
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <ctime>
+#include <fstream>
+#include <iterator>
+
+namespace fs = boost::filesystem;
 
 namespace scorbit {
 namespace detail {
 
+constexpr size_t PICTURE_ENTRY_OVERHEAD = 256; // Key and bookkeeping, pending entries cost this
+constexpr auto PICTURE_FILE_EXT = ".img";
+constexpr auto PICTURE_ETAG_EXT = ".etag";
+
 bool operator==(const PlayerProfile &lhs, const PlayerProfile &rhs)
 {
     return lhs.player == rhs.player && lhs.id == rhs.id && lhs.preferInitials == rhs.preferInitials
@@ -105,10 +119,40 @@ PlayerProfilesManager::setProfiles(const nlohmann::json &val, const std::string
     return std::nullopt;
 }
 
-void PlayerProfilesManager::setPicture(const std::string &avatarUrl, std::vector<uint8_t> picture)
+size_t PlayerProfilesManager::PictureCost::operator()(const CachedPicture &entry) const
 {
-    std::scoped_lock lock(m_picturesMutex);
-    m_picturesCache.put(avatarUrl, std::move(picture));
+    return PICTURE_ENTRY_OVERHEAD + (entry.picture ? entry.picture->size() : 0) + entry.etag.size()
+         + entry.lastModified.size();
+}
+
+void PlayerProfilesManager::setCacheDir(const std::string &dir)
+{
+    m_cacheDir = dir;
+    if (m_cacheDir.empty()) {
+        return;
+    }
+
+    boost::system::error_code ec;
+    fs::create_directories(m_cacheDir, ec);
+    if (ec) {
+        WRN("Can't create pictures cache dir: {}, {}", m_cacheDir, ec.message());
+        m_cacheDir.clear();
+    }
+}
+
+PicturePtr PlayerProfilesManager::setPicture(const std::string &avatarUrl, Picture picture,
+                                             std::string etag)
+{
+    CachedPicture entry {std::make_shared<const Picture>(std::move(picture)), std::move(etag)};
+    {
+        std::scoped_lock lock(m_picturesMutex);
+        m_picturesCache.put(avatarUrl, entry);
+    }
+
+    if (!entry.picture->empty()) {
+        saveToDisk(avatarUrl, entry);
+    }
+    return entry.picture;
 }
 
 void PlayerProfilesManager::removePicture(const std::string &avatarUrl)
@@ -132,12 +176,130 @@ bool PlayerProfilesManager::hasPicture(const std::string &avatarUrl) const
     return m_picturesCache.has(avatarUrl);
 }
 
-const Picture &PlayerProfilesManager::picture(const std::string &avatarUrl) const
+PicturePtr PlayerProfilesManager::picture(const std::string &avatarUrl) const
 {
+    CachedPicture entry;
     std::scoped_lock lock(m_picturesMutex);
-    m_storedPicture.clear();
-    m_picturesCache.get(avatarUrl, m_storedPicture);
-    return m_storedPicture;
+    if (!m_picturesCache.get(avatarUrl, entry) || !entry.picture || entry.picture->empty()) {
+        return nullptr;
+    }
+    return entry.picture;
+}
+
+CachedPicture PlayerProfilesManager::loadFromDisk(const std::string &avatarUrl)
+{
+    if (m_cacheDir.empty()) {
+        return {};
+    }
+
+    const auto path = diskPath(avatarUrl);
+    std::ifstream file(path + PICTURE_FILE_EXT, std::ios::binary);
+    if (!file.is_open()) {
+        return {};
+    }
+
+    Picture data {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    if (data.empty()) {
+        return {};
+    }
+
+    std::string etag;
+    std::ifstream etagFile(path + PICTURE_ETAG_EXT);
+    std::getline(etagFile, etag);
+
+    CachedPicture entry {std::make_shared<const Picture>(std::move(data)), std::move(etag)};
+
+    // ETag file is rewritten on every save and never touched, so its mtime is the download time
+    boost::system::error_code ec;
+    if (const auto savedAt = fs::last_write_time(path + PICTURE_ETAG_EXT, ec); !ec) {
+        entry.lastModified = formatUnixTimestampHttpDate(savedAt);
+    }
+
+    {
+        std::scoped_lock lock(m_picturesMutex);
+        m_picturesCache.put(avatarUrl, entry);
+    }
+
+    // Touch it, so pruning removes least recently used pictures first
+    fs::last_write_time(path + PICTURE_FILE_EXT, std::time(nullptr), ec);
+
+    DBG("Picture loaded from disk cache: {}", avatarUrl);
+    return entry;
+}
+
+std::string PlayerProfilesManager::diskPath(const std::string &avatarUrl) const
+{
+    Sha256Stream hasher;
+    hasher.update(avatarUrl);
+    return (fs::path(m_cacheDir) / hasher.hexDigest()).string();
+}
+
+void PlayerProfilesManager::saveToDisk(const std::string &avatarUrl,
+                                       const CachedPicture &entry) const
+{
+    if (m_cacheDir.empty()) {
+        return;
+    }
+
+    const auto path = diskPath(avatarUrl);
+    {
+        std::ofstream file(path + PICTURE_FILE_EXT, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char *>(entry.picture->data()),
+                   static_cast<std::streamsize>(entry.picture->size()));
+        if (!file) {
+            WRN("Can't save picture to disk cache: {}", path);
+            return;
+        }
+
+        std::ofstream etagFile(path + PICTURE_ETAG_EXT, std::ios::trunc);
+        etagFile << entry.etag;
+    }
+
+    pruneDisk();
+}
+
+void PlayerProfilesManager::pruneDisk() const
+{
+    struct CachedFile {
+        std::time_t time;
+        uintmax_t size;
+        fs::path path;
+    };
+
+    std::vector<CachedFile> files;
+    uintmax_t totalSize = 0;
+
+    boost::system::error_code ec;
+    for (fs::directory_iterator it(m_cacheDir, ec), end; !ec && it != end; it.increment(ec)) {
+        const auto &path = it->path();
+        if (path.extension().string() != PICTURE_FILE_EXT) {
+            continue;
+        }
+
+        boost::system::error_code fileEc;
+        const auto size = fs::file_size(path, fileEc);
+        const auto time = fs::last_write_time(path, fileEc);
+        if (!fileEc) {
+            files.push_back({time, size, path});
+            totalSize += size;
+        }
+    }
+
+    if (totalSize <= MAX_PICTURES_DISK_CACHE_BYTES) {
+        return;
+    }
+
+    std::sort(files.begin(), files.end(),
+              [](const auto &a, const auto &b) { return a.time < b.time; });
+
+    for (const auto &file : files) {
+        if (totalSize <= MAX_PICTURES_DISK_CACHE_BYTES) {
+            break;
+        }
+        fs::remove(file.path, ec);
+        fs::remove(fs::path(file.path).replace_extension(PICTURE_ETAG_EXT), ec);
+        totalSize -= file.size;
+    }
 }
 
 std::map<sb_player_t, std::string> PlayerProfilesManager::picturesToDownload() const
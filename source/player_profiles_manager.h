@@ -28,13 +28,15 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <optional>
 
 namespace scorbit {
 namespace detail {
 
-constexpr auto MAX_PICTURES_CACHED = 8; // Maximum number of pictures to cache
+constexpr size_t MAX_PICTURES_CACHE_BYTES = 4 * 1024 * 1024;       // Memory budget for pictures
+constexpr size_t MAX_PICTURES_DISK_CACHE_BYTES = 32 * 1024 * 1024; // Disk budget for pictures
 
 /**
  * @brief PlayerProfile holds the player profile information.
@@ -55,6 +57,14 @@ struct PlayerProfile {
 };
 
 using Picture = std::vector<uint8_t>; // The profile picture binary (jpg)
+using PicturePtr = std::shared_ptr<const Picture>;
+
+/// Cached picture with its validators, used to revalidate it with If-None-Match/If-Modified-Since
+struct CachedPicture {
+    PicturePtr picture;
+    std::string etag;
+    std::string lastModified; // HTTP date when the picture was saved to disk, empty if not known
+};
 
 bool operator==(const PlayerProfile &lhs, const PlayerProfile &rhs);
 bool operator!=(const PlayerProfile &lhs, const PlayerProfile &rhs);
@@ -75,20 +85,44 @@ public:
     std::optional<std::vector<PlayerProfile>> setProfiles(const nlohmann::json &val,
                                                           const std::string &machineUuid);
 
-    void setPicture(const std::string &avatarUrl, std::vector<uint8_t> picture);
+    /**
+     * Directory where downloaded pictures are persisted between runs, empty - memory only.
+     * Must be set before pictures are requested.
+     */
+    void setCacheDir(const std::string &dir);
+
+    /// Stores the picture and returns shared pointer to it, empty picture marks pending download
+    PicturePtr setPicture(const std::string &avatarUrl, Picture picture, std::string etag = {});
     void removePicture(const std::string &avatarUrl);
 
     std::optional<PlayerProfile> profile(sb_player_t player) const;
 
     bool hasPicture(const std::string &avatarUrl) const;
-    const Picture &picture(const std::string &avatarUrl) const;
+
+    /// Returns cached picture or nullptr, the picture is shared and never copied
+    PicturePtr picture(const std::string &avatarUrl) const;
+
+    /**
+     * Loads the picture persisted on disk into memory cache.
+     * @return picture, its ETag and save time, picture is nullptr if it's not on disk
+     */
+    CachedPicture loadFromDisk(const std::string &avatarUrl);
 
     std::map<sb_player_t, std::string> picturesToDownload() const;
 
 private:
+    struct PictureCost {
+        size_t operator()(const CachedPicture &entry) const;
+    };
+
+    std::string diskPath(const std::string &avatarUrl) const;
+    void saveToDisk(const std::string &avatarUrl, const CachedPicture &entry) const;
+    void pruneDisk() const;
+
     std::vector<PlayerProfile> m_profiles;
-    mutable Picture m_storedPicture;
-    mutable LRUCache<std::string, Picture> m_picturesCache {MAX_PICTURES_CACHED};
+    std::string m_cacheDir;
+    mutable LRUCache<std::string, CachedPicture, PictureCost> m_picturesCache {
+            MAX_PICTURES_CACHE_BYTES};
     mutable std::mutex m_profilesMutex;
     mutable std::mutex m_picturesMutex;
 };
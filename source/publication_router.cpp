@@ -0,0 +1,164 @@
+/*
+ * Scorbit SDK
+ *
+ * (c) 2025 Spinner Systems, Inc. (DBA Scorbit), scrobit.io, All Rights Reserved
+ *
+ * MIT License
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "publication_router.h"
+#include "identifiers.h"
+
+#include <algorithm>
+
+namespace scorbit {
+namespace detail {
+
+namespace {
+
+constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ull;
+constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
+uint64_t fnv1a(uint64_t hash, std::string_view value)
+{
+    for (const char c : value) {
+        hash = (hash ^ static_cast<uint8_t>(c)) * FNV_PRIME;
+    }
+    // Separator, so that "ab" + "c" differs from "a" + "bc"
+    return (hash ^ 0xff) * FNV_PRIME;
+}
+
+/// String member of json object, empty if missing or not a string. Doesn't copy.
+std::string_view stringField(const nlohmann::json &object, const char *key)
+{
+    const auto it = object.find(key);
+    if (it == object.end() || !it->is_string()) {
+        return {};
+    }
+    return it->get_ref<const std::string &>();
+}
+
+/// Dispatch order of routes matching the same publication, lower wins
+int specificity(std::string_view method, std::string_view action)
+{
+    return (method.empty() ? 2 : 0) + (action.empty() ? 1 : 0);
+}
+
+/// Route field matches the same publications as the other one, some of them at least
+bool overlaps(std::string_view field, std::string_view other)
+{
+    return field.empty() || other.empty() || field == other;
+}
+
+} // namespace
+
+bool PublicationRouter::add(const Route &route, Handler handler, bool exclusive)
+{
+    auto prefixIt = std::find(m_prefixes.begin(), m_prefixes.end(), route.channelPrefix);
+    if (prefixIt == m_prefixes.end()) {
+        prefixIt = m_prefixes.emplace(m_prefixes.end(), route.channelPrefix);
+    }
+    const auto prefix = static_cast<size_t>(prefixIt - m_prefixes.begin());
+
+    const auto *existing = find(prefix, route.type, route.method, route.action);
+    if (existing && existing->method == route.method && existing->action == route.action) {
+        return false;
+    }
+    if (shadowsExclusive(prefix, route)) {
+        return false;
+    }
+
+    m_routes.emplace(hash(prefix, route.type, route.method, route.action),
+                     Entry {prefix, std::string {route.type}, std::string {route.method},
+                            std::string {route.action}, std::move(handler), exclusive});
+    return true;
+}
+
+bool PublicationRouter::dispatch(std::string_view channel, const nlohmann::json &data) const
+{
+    const auto prefixIt =
+            std::find_if(m_prefixes.begin(), m_prefixes.end(), [channel](const auto &prefix) {
+                return channel.starts_with(prefix);
+            });
+    if (prefixIt == m_prefixes.end() || !data.is_object()) {
+        return false;
+    }
+
+    const auto payloadIt = data.find(JKEY_CHN_PAYLOAD);
+    if (payloadIt == data.end() || !payloadIt->is_object()) {
+        return false;
+    }
+
+    const auto prefix = static_cast<size_t>(prefixIt - m_prefixes.begin());
+    const auto type = stringField(data, JKEY_CHN_TYPE);
+    const auto method = stringField(*payloadIt, JKEY_METHOD);
+    const auto action = stringField(*payloadIt, JKEY_ACTION_NAME);
+
+    // The most specific route first
+    const auto *entry = find(prefix, type, method, action);
+    if (!entry) {
+        entry = find(prefix, type, method, {});
+    }
+    if (!entry) {
+        entry = find(prefix, type, {}, action);
+    }
+    if (!entry) {
+        entry = find(prefix, type, {}, {});
+    }
+    if (!entry) {
+        return false;
+    }
+
+    entry->handler(*payloadIt);
+    return true;
+}
+
+uint64_t PublicationRouter::hash(size_t prefix, std::string_view type, std::string_view method,
+                                 std::string_view action)
+{
+    auto hash = (FNV_OFFSET_BASIS ^ prefix) * FNV_PRIME;
+    hash = fnv1a(hash, type);
+    hash = fnv1a(hash, method);
+    return fnv1a(hash, action);
+}
+
+const PublicationRouter::Entry *PublicationRouter::find(size_t prefix, std::string_view type,
+                                                        std::string_view method,
+                                                        std::string_view action) const
+{
+    const auto [begin, end] = m_routes.equal_range(hash(prefix, type, method, action));
+    for (auto it = begin; it != end; ++it) {
+        const auto &entry = it->second;
+        if (entry.prefix == prefix && entry.type == type && entry.method == method
+            && entry.action == action) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+bool PublicationRouter::shadowsExclusive(size_t prefix, const Route &route) const
+{
+    // Runs only when routes are added, a scan is fine
+    const auto routeSpecificity = specificity(route.method, route.action);
+    return std::any_of(m_routes.begin(), m_routes.end(), [&](const auto &item) {
+        const auto &entry = item.second;
+        return entry.exclusive && entry.prefix == prefix && entry.type == route.type
+            && overlaps(entry.method, route.method) && overlaps(entry.action, route.action)
+            && routeSpecificity < specificity(entry.method, entry.action);
+    });
+}
+
+} // namespace detail
+} // namespace scorbit
@@ -0,0 +1,93 @@
+/*
+ * Scorbit SDK
+ *
+ * (c) 2025 Spinner Systems, Inc. (DBA Scorbit), scrobit.io, All Rights Reserved
+ *
+ * MIT License
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <nlohmann/json.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace scorbit {
+namespace detail {
+
+/**
+ * @brief Dispatches control channel publications to the handlers registered for their kind.
+ *
+ * Kind of publication is its channel prefix, "type" and, for actions, payload "method" and
+ * "name". Routes are hashed when added, so dispatch costs a few hash lookups no matter how many
+ * handlers there are. Empty method or action of the route matches any, the most specific route
+ * wins: exact match, then method only, action only and type only. Routes must be added before
+ * dispatching starts.
+ */
+class PublicationRouter
+{
+public:
+    /// Receives the payload object of the publication
+    using Handler = std::function<void(const nlohmann::json &payload)>;
+
+    struct Route {
+        std::string_view channelPrefix;
+        std::string_view type;
+        std::string_view method; // Empty - any
+        std::string_view action; // Empty - any
+    };
+
+    /**
+     * @brief Adds @p handler of publications matching @p route.
+     *
+     * Exclusive route keeps every publication it matches, so a route that would win some of them
+     * is refused when added later.
+     *
+     * @return false if the same route is already registered or an exclusive one would lose
+     * publications to it, the handler is not added then
+     */
+    bool add(const Route &route, Handler handler, bool exclusive = false);
+
+    /// @return false if it's not a control publication or no route matches it
+    bool dispatch(std::string_view channel, const nlohmann::json &data) const;
+
+    size_t size() const { return m_routes.size(); }
+
+private:
+    struct Entry {
+        size_t prefix; // Index in m_prefixes
+        std::string type;
+        std::string method;
+        std::string action;
+        Handler handler;
+        bool exclusive;
+    };
+
+    static uint64_t hash(size_t prefix, std::string_view type, std::string_view method,
+                         std::string_view action);
+    const Entry *find(size_t prefix, std::string_view type, std::string_view method,
+                      std::string_view action) const;
+    bool shadowsExclusive(size_t prefix, const Route &route) const;
+
+    std::vector<std::string> m_prefixes;
+    std::unordered_multimap<uint64_t, Entry> m_routes; // Multi in case of hash collision
+};
+
+} // namespace detail
+} // namespace scorbit
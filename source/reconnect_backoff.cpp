@@ -0,0 +1,62 @@
+/*
+ * Scorbit SDK
+ *
+ * (c) 2025 Spinner Systems, Inc. (DBA Scorbit), scrobit.io, All Rights Reserved
+ *
+ * MIT License
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "reconnect_backoff.h"
+
+#include <algorithm>
+
+namespace scorbit {
+namespace detail {
+
+namespace {
+
+std::uint64_t randomSeed()
+{
+    std::random_device rd;
+    return (static_cast<std::uint64_t>(rd()) << 32) | rd();
+}
+
+} // namespace
+
+ReconnectBackoff::ReconnectBackoff(Policy policy)
+    : ReconnectBackoff(policy, randomSeed())
+{
+}
+
+ReconnectBackoff::ReconnectBackoff(Policy policy, std::uint64_t seed)
+    : m_policy(policy)
+    , m_rng(seed)
+{
+}
+
+std::chrono::milliseconds ReconnectBackoff::next()
+{
+    constexpr unsigned MAX_SHIFT = 20; // Ceiling hits maxDelay long before, no overflow
+
+    const auto shift = std::min(m_attempts, MAX_SHIFT);
+    const auto ceiling = std::min(m_policy.firstCeiling.count() << shift, m_policy.maxDelay.count());
+    const auto low = std::min(m_policy.minDelay.count(), ceiling);
+    ++m_attempts;
+
+    std::uniform_int_distribution<std::chrono::milliseconds::rep> dist {low, ceiling};
+    return std::chrono::milliseconds {dist(m_rng)};
+}
+
+} // namespace detail
+} // namespace scorbit
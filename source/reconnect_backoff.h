@@ -0,0 +1,64 @@
+/*
+ * Scorbit SDK
+ *
+ * (c) 2025 Spinner Systems, Inc. (DBA Scorbit), scrobit.io, All Rights Reserved
+ *
+ * MIT License
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <random>
+
+namespace scorbit {
+namespace detail {
+
+/**
+ * @brief Exponential reconnect backoff with jitter.
+ *
+ * Delay of attempt n is picked uniformly from [minDelay, min(maxDelay, firstCeiling * 2^n)], so
+ * clients dropped at the same moment, e.g. by a server deploy, don't come back at the same moment.
+ * Not thread-safe.
+ */
+class ReconnectBackoff
+{
+public:
+    struct Policy {
+        std::chrono::milliseconds minDelay;
+        std::chrono::milliseconds firstCeiling; // Upper bound of the first attempt
+        std::chrono::milliseconds maxDelay;
+    };
+
+    explicit ReconnectBackoff(Policy policy);
+    ReconnectBackoff(Policy policy, std::uint64_t seed);
+
+    /// Delay before the next attempt, counts the attempt
+    std::chrono::milliseconds next();
+
+    /// Connected, start over
+    void reset() { m_attempts = 0; }
+
+    /// Attempts since the last reset()
+    unsigned attempts() const { return m_attempts; }
+
+private:
+    Policy m_policy;
+    std::mt19937_64 m_rng;
+    unsigned m_attempts {0};
+};
+
+} // namespace detail
+} // namespace scorbit
@@ -23,14 +23,18 @@
 #include "net_util.h"
 #include "utils/decrypt.h"
 #include "utils/machine_fingerprint.h"
-#include <tpm/crypto_helpers.h>
 #include <logger/logger.h>
 #include <utils/bytearray.h>
 #include <nlohmann/json.hpp>
 #include <obfuscate.h>
 #include <openssl/crypto.h>
 #include <openssl/sha.h>
+#include <algorithm>
+#include <condition_variable>
 #include <cstring>
+#include <thread>
+#include <unordered_map>
+#include <utility>
 
 using json = nlohmann::json;
 
@@ -41,6 +45,9 @@ namespace {
 
 constexpr int ECDSA_P256_KEY_SIZE = 32;
 
+// Secure heap for the parsed device key, OpenSSL needs a power of two
+constexpr size_t SECURE_KEY_HEAP_SIZE = 32 * 1024;
+
 std::string buildHmacMessage(const std::string &provider, const std::string &uuid,
                              uint64_t serialNumber, const std::string &encryptedKey)
 {
@@ -49,6 +56,224 @@ std::string buildHmacMessage(const std::string &provider, const std::string &uui
 
 } // namespace
 
+/// Wipes idle keys of all soft signers on one thread
+class IdleKeyWiper
+{
+public:
+    static IdleKeyWiper &instance()
+    {
+        // Never destroyed, signers may outlive function statics
+        static auto *wiper = new IdleKeyWiper();
+        return *wiper;
+    }
+
+    /// Calls signer->wipeIfIdle() at @p deadline, replaces the deadline scheduled before
+    void schedule(SoftKeySigner *signer, std::chrono::steady_clock::time_point deadline)
+    {
+        {
+            std::lock_guard lock(m_mutex);
+            m_deadlines[signer] = deadline;
+        }
+        m_cv.notify_all();
+    }
+
+    /// The signer is not called once this returns
+    void cancel(SoftKeySigner *signer)
+    {
+        std::unique_lock lock(m_mutex);
+        m_cv.wait(lock, [this, signer] { return m_calling != signer; });
+        m_deadlines.erase(signer); // After the wait, the call may have scheduled it again
+    }
+
+private:
+    IdleKeyWiper()
+        : m_thread(&IdleKeyWiper::run, this)
+    {
+    }
+
+    void run()
+    {
+        std::unique_lock lock(m_mutex);
+        for (;;) {
+            if (m_deadlines.empty()) {
+                m_cv.wait(lock);
+                continue;
+            }
+
+            // Few signers, usually one
+            const auto next = std::min_element(
+                    m_deadlines.begin(), m_deadlines.end(),
+                    [](const auto &lhs, const auto &rhs) { return lhs.second < rhs.second; });
+            if (const auto deadline = next->second; std::chrono::steady_clock::now() < deadline) {
+                m_cv.wait_until(lock, deadline); // Not the entry, it may be erased meanwhile
+                continue;
+            }
+
+            // Unlocked while calling, the signer locks itself and may schedule again
+            m_calling = next->first;
+            m_deadlines.erase(next);
+            lock.unlock();
+            m_calling->wipeIfIdle();
+            lock.lock();
+            m_calling = nullptr;
+            m_cv.notify_all();
+        }
+    }
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::unordered_map<SoftKeySigner *, std::chrono::steady_clock::time_point> m_deadlines;
+    SoftKeySigner *m_calling {nullptr};
+    std::thread m_thread;
+};
+
+SoftKeySigner::SoftKeySigner(std::string encryptedDeviceKey, std::string password,
+                             std::chrono::milliseconds idleTtl)
+    : m_encryptedDeviceKey(std::move(encryptedDeviceKey))
+    , m_password(std::move(password))
+    , m_idleTtl(idleTtl)
+{
+    if (m_idleTtl.count() > 0) {
+        enableSecureKeyMemory(SECURE_KEY_HEAP_SIZE);
+    }
+}
+
+SoftKeySigner::~SoftKeySigner()
+{
+    if (m_idleTtl.count() > 0) {
+        IdleKeyWiper::instance().cancel(this);
+    }
+    {
+        std::lock_guard lock(m_mutex);
+        releaseKey();
+    }
+
+    OPENSSL_cleanse(m_password.data(), m_password.size());
+}
+
+Signature SoftKeySigner::sign(const Digest &digest)
+{
+    std::lock_guard lock(m_mutex);
+    if (!loadKey()) {
+        return {};
+    }
+
+    utils::ByteArray digestBa(digest.data(), digest.size());
+    utils::ByteArray sig;
+    const bool ok = m_key.sign(digestBa, sig);
+
+    if (m_idleTtl.count() <= 0) {
+        releaseKey();
+    }
+
+    if (!ok) {
+        ERR("SoftKeyResolver: signing failed");
+        return {};
+    }
+    return Signature(sig.begin(), sig.end());
+}
+
+std::vector<Signature> SoftKeySigner::signBatch(const std::vector<Digest> &digests)
+{
+    std::vector<utils::ByteArray> hashes;
+    hashes.reserve(digests.size());
+    for (const auto &digest : digests) {
+        hashes.emplace_back(digest.data(), digest.size());
+    }
+
+    std::vector<utils::ByteArray> sigs;
+    {
+        std::lock_guard lock(m_mutex);
+        if (!loadKey()) {
+            return {};
+        }
+
+        const bool ok = m_key.signBatch(hashes, sigs);
+
+        if (m_idleTtl.count() <= 0) {
+            releaseKey();
+        }
+
+        if (!ok) {
+            ERR("SoftKeyResolver: batch signing failed");
+            return {};
+        }
+    }
+
+    std::vector<Signature> signatures;
+    signatures.reserve(sigs.size());
+    for (const auto &sig : sigs) {
+        signatures.emplace_back(sig.begin(), sig.end());
+    }
+    return signatures;
+}
+
+bool SoftKeySigner::isKeyCached() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_key.isValid();
+}
+
+void SoftKeySigner::wipe()
+{
+    std::lock_guard lock(m_mutex);
+    releaseKey();
+}
+
+bool SoftKeySigner::loadKey()
+{
+    m_lastUse = std::chrono::steady_clock::now();
+    if (m_key.isValid()) {
+        return true;
+    }
+
+    auto decrypted = decryptSecret(m_encryptedDeviceKey, m_password);
+    if (decrypted.empty()) {
+        ERR("SoftKeyResolver: failed to decrypt device key for signing");
+        return false;
+    }
+
+    utils::ByteArray key(decrypted.data(), decrypted.size());
+    m_key = EcdsaSigningKey(key);
+
+    OPENSSL_cleanse(decrypted.data(), decrypted.size());
+    OPENSSL_cleanse(key.data(), key.size());
+
+    if (!m_key.isValid()) {
+        ERR("SoftKeyResolver: failed to parse device key for signing");
+        return false;
+    }
+
+    if (m_idleTtl.count() > 0) {
+        IdleKeyWiper::instance().schedule(this, m_lastUse + m_idleTtl);
+    }
+    return true;
+}
+
+void SoftKeySigner::releaseKey()
+{
+    if (m_key.isValid()) {
+        m_key.reset();
+        DBG("SoftKeyResolver: cached device key wiped");
+    }
+}
+
+void SoftKeySigner::wipeIfIdle()
+{
+    std::lock_guard lock(m_mutex);
+    if (!m_key.isValid()) {
+        return;
+    }
+
+    // Used meanwhile, check again when it's idle for the TTL since then
+    const auto deadline = m_lastUse + m_idleTtl;
+    if (std::chrono::steady_clock::now() >= deadline) {
+        releaseKey();
+    } else {
+        IdleKeyWiper::instance().schedule(this, deadline);
+    }
+}
+
 bool SoftKeyResolver::tryResolve(DeviceInfo &info, const std::string &serverTimestamp)
 {
     if (!info.hasSoftKeyProvisioning()) {
@@ -65,6 +290,7 @@ bool SoftKeyResolver::tryResolve(DeviceInfo &info, const std::string &serverTime
 
     utils::ByteArray providerKeyBa(providerKey.data(), providerKey.size());
     m_deviceKeyPassword = providerKeyBa.hex();
+    m_keyCacheTtl = std::chrono::seconds {info.signingKeyCacheTtl};
 
     bool success = tryLoadKey(info) || provisionNewKey(info, providerKey, serverTimestamp);
 
@@ -80,30 +306,14 @@ bool SoftKeyResolver::tryResolve(DeviceInfo &info, const std::string &serverTime
 
 SignerCallback SoftKeyResolver::createSigner() const
 {
-    auto encDevKey = m_encryptedDeviceKey;
-    auto password = m_deviceKeyPassword;
-
-    return [encDevKey, password](const Digest &digest) -> Signature {
-        auto decrypted = decryptSecret(encDevKey, password);
-        if (decrypted.empty()) {
-            ERR("SoftKeyResolver: failed to decrypt device key for signing");
-            return {};
-        }
-
-        utils::ByteArray key(decrypted.data(), decrypted.size());
-        utils::ByteArray digestBa(digest.data(), digest.size());
-        utils::ByteArray sig;
-        bool ok = ecdsaSign(key, digestBa, sig);
-
-        OPENSSL_cleanse(decrypted.data(), decrypted.size());
-        decrypted.clear();
+    auto signer = createSoftSigner();
+    return [signer](const Digest &digest) -> Signature { return signer->sign(digest); };
+}
 
-        if (!ok) {
-            ERR("SoftKeyResolver: signing failed");
-            return {};
-        }
-        return Signature(sig.begin(), sig.end());
-    };
+std::shared_ptr<SoftKeySigner> SoftKeyResolver::createSoftSigner() const
+{
+    return std::make_shared<SoftKeySigner>(m_encryptedDeviceKey, m_deviceKeyPassword,
+                                           m_keyCacheTtl);
 }
 
 bool SoftKeyResolver::tryLoadKey(DeviceInfo &info)
@@ -20,19 +20,72 @@
 #pragma once
 
 #include "key_resolver.h"
+#include <tpm/crypto_helpers.h>
+#include <chrono>
 #include <cstdint>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
 namespace scorbit {
 namespace detail {
 
+/**
+ * Signs with the encrypted soft device key.
+ *
+ * The key is decrypted on first signature and kept parsed, in the secure heap, until it isn't
+ * used for the idle TTL. Then it's wiped, by a thread shared by all signers, and decrypted again on
+ * the next signature. TTL 0 decrypts the key for every signature and keeps nothing.
+ */
+class SoftKeySigner
+{
+public:
+    SoftKeySigner(std::string encryptedDeviceKey, std::string password,
+                  std::chrono::milliseconds idleTtl);
+    ~SoftKeySigner();
+
+    SoftKeySigner(const SoftKeySigner &) = delete;
+    SoftKeySigner &operator=(const SoftKeySigner &) = delete;
+
+    Signature sign(const Digest &digest);
+
+    /**
+     * Sign several digests with one key load and one signing context.
+     * @return Signatures in the order of @p digests, empty on failure.
+     */
+    std::vector<Signature> signBatch(const std::vector<Digest> &digests);
+
+    bool isKeyCached() const;
+
+    /// Wipe the parsed key now, the next signature decrypts it again.
+    void wipe();
+
+private:
+    friend class IdleKeyWiper;
+
+    bool loadKey(); // m_mutex must be held
+    void releaseKey(); // m_mutex must be held
+    void wipeIfIdle(); // Called by IdleKeyWiper when the idle TTL may have passed
+
+    const std::string m_encryptedDeviceKey;
+    std::string m_password;
+    const std::chrono::milliseconds m_idleTtl;
+
+    mutable std::mutex m_mutex;
+    EcdsaSigningKey m_key;
+    std::chrono::steady_clock::time_point m_lastUse;
+};
+
 class SoftKeyResolver : public IKeyResolver
 {
 public:
     bool tryResolve(DeviceInfo &info, const std::string &serverTimestamp) override;
     SignerCallback createSigner() const override;
 
+    /// Signer with the batch API, shared by callbacks from @ref createSigner.
+    std::shared_ptr<SoftKeySigner> createSoftSigner() const;
+
 private:
     bool tryLoadKey(DeviceInfo &info);
     bool provisionNewKey(DeviceInfo &info, const std::vector<uint8_t> &providerKey,
@@ -40,6 +93,7 @@ private:
 
     std::string m_encryptedDeviceKey;
     std::string m_deviceKeyPassword;
+    std::chrono::seconds m_keyCacheTtl {0};
 };
 
 } // namespace detail
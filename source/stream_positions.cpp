@@ -0,0 +1,108 @@
+/*
+ * Scorbit SDK
+ *
+ * (c) 2025 Spinner Systems, Inc. (DBA Scorbit), scrobit.io, All Rights Reserved
+ *
+ * MIT License
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "stream_positions.h"
+
+#include <algorithm>
+
+namespace scorbit {
+namespace detail {
+
+namespace {
+
+// New stream starts at offset 1, the first publication we get may be a bit later
+constexpr std::uint64_t RESTART_MAX_OFFSET = 16;
+
+} // namespace
+
+StreamPositions::StreamPositions(std::size_t window)
+    : m_window(std::max<std::size_t>(window, 1))
+{
+}
+
+StreamPositions::Result StreamPositions::accept(std::string_view channel, std::uint64_t offset,
+                                                std::size_t payloadHash)
+{
+    Result result;
+    if (offset == 0) {
+        return result;
+    }
+
+    auto &stream = m_streams[std::string {channel}];
+
+    if (offset <= stream.lastOffset) {
+        const bool wasVerifying = std::exchange(stream.verify, false);
+        if (!wasVerifying || !startsNewStream(stream, offset, payloadHash)) {
+            result.duplicate = true;
+            return result;
+        }
+
+        result.newStream = true;
+        stream = Stream {};
+    } else {
+        if (stream.lastOffset != 0) {
+            result.missed = offset - stream.lastOffset - 1;
+        }
+        stream.verify = false;
+    }
+
+    stream.lastOffset = offset;
+    remember(stream, offset, payloadHash);
+    return result;
+}
+
+void StreamPositions::reconnected()
+{
+    for (auto &[channel, stream] : m_streams) {
+        stream.verify = true;
+    }
+}
+
+std::uint64_t StreamPositions::lastOffset(std::string_view channel) const
+{
+    const auto it = m_streams.find(std::string {channel});
+    return it == m_streams.end() ? 0 : it->second.lastOffset;
+}
+
+bool StreamPositions::startsNewStream(const Stream &stream, std::uint64_t offset,
+                                      std::size_t payloadHash) const
+{
+    // Older than the window, a long replay looks the same unless offsets started over
+    if (offset < stream.recent.front().first) {
+        return offset <= RESTART_MAX_OFFSET;
+    }
+    return !seen(stream, offset, payloadHash);
+}
+
+bool StreamPositions::seen(const Stream &stream, std::uint64_t offset,
+                           std::size_t payloadHash) const
+{
+    return std::ranges::find(stream.recent, std::pair {offset, payloadHash}) != stream.recent.end();
+}
+
+void StreamPositions::remember(Stream &stream, std::uint64_t offset, std::size_t payloadHash)
+{
+    stream.recent.emplace_back(offset, payloadHash);
+    if (stream.recent.size() > m_window) {
+        stream.recent.pop_front();
+    }
+}
+
+} // namespace detail
+} // namespace scorbit
@@ -0,0 +1,83 @@
+/*
+ * Scorbit SDK
+ *
+ * (c) 2025 Spinner Systems, Inc. (DBA Scorbit), scrobit.io, All Rights Reserved
+ *
+ * MIT License
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+namespace scorbit {
+namespace detail {
+
+/**
+ * @brief Last seen position of each Centrifugo channel stream, drops replayed publications.
+ *
+ * History recovery after a reconnect may deliver publications which were already handled, so a
+ * publication at or below the last seen offset is a duplicate. Stream epoch can only change
+ * across reconnects, and offsets start over then: the first publication per channel after
+ * reconnected() which is at or below the last offset starts a new stream if it isn't one of the
+ * last @p window seen with the same payload. Below the window, it must also be close to offset 1,
+ * otherwise it's a replay longer than the window. Offset 0 means the channel keeps no history,
+ * such publications are never dropped. Not thread-safe.
+ */
+class StreamPositions
+{
+public:
+    static constexpr std::size_t DEFAULT_WINDOW = 128;
+
+    struct Result {
+        bool duplicate {false};
+        bool newStream {false};   // Offsets started over, e.g. server lost its history
+        std::uint64_t missed {0}; // Publications skipped between the last seen and this one
+    };
+
+    explicit StreamPositions(std::size_t window = DEFAULT_WINDOW);
+
+    /// @p payloadHash tells replay of a seen publication from a new stream at the same offset
+    Result accept(std::string_view channel, std::uint64_t offset, std::size_t payloadHash);
+
+    /// Connection was lost, streams are checked again by their next publication
+    void reconnected();
+
+    /// 0 if nothing was seen on @p channel yet
+    std::uint64_t lastOffset(std::string_view channel) const;
+
+private:
+    struct Stream {
+        std::uint64_t lastOffset {0};
+        std::deque<std::pair<std::uint64_t, std::size_t>> recent; // Offset, payload hash
+        bool verify {false};
+    };
+
+    bool startsNewStream(const Stream &stream, std::uint64_t offset,
+                         std::size_t payloadHash) const;
+    bool seen(const Stream &stream, std::uint64_t offset, std::size_t payloadHash) const;
+    void remember(Stream &stream, std::uint64_t offset, std::size_t payloadHash);
+
+    std::size_t m_window;
+    std::unordered_map<std::string, Stream> m_streams;
+};
+
+} // namespace detail
+} // namespace scorbit
@@ -0,0 +1,119 @@
+/*
+ * Scorbit SDK
+ *
+ * (c) 2025 Spinner Systems, Inc. (DBA Scorbit), scrobit.io, All Rights Reserved
+ *
+ * MIT License
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "utils/archiver.h"
+#include <cpr/callback.h>
+#include <fmt/format.h>
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+
+namespace scorbit {
+namespace detail {
+
+/**
+ * @brief The StreamingMultipart class is a multipart/form-data body with a single file part whose
+ * content is read from an ArchiveStream while the request is sent.
+ *
+ * The size of the body isn't known up front, so it goes with chunked transfer encoding. Copies
+ * share the same stream, a new StreamingMultipart must be made for each attempt.
+ */
+class StreamingMultipart
+{
+    struct State {
+        std::string prefix;
+        std::string suffix;
+        std::shared_ptr<ArchiveStream> stream;
+        size_t prefixPosition {0};
+        size_t suffixPosition {0};
+        bool streamDone {false};
+    };
+
+public:
+    StreamingMultipart(const std::string &fieldName, const std::string &fileName,
+                       std::shared_ptr<ArchiveStream> stream)
+        : m_boundary(makeBoundary())
+        , m_state(std::make_shared<State>())
+    {
+        m_state->prefix = fmt::format("--{}\r\nContent-Disposition: form-data; name=\"{}\"; "
+                                      "filename=\"{}\"\r\nContent-Type: "
+                                      "application/octet-stream\r\n\r\n",
+                                      m_boundary, fieldName, fileName);
+        m_state->suffix = fmt::format("\r\n--{}--\r\n", m_boundary);
+        m_state->stream = std::move(stream);
+    }
+
+    std::string contentType() const
+    {
+        return fmt::format("multipart/form-data; boundary={}", m_boundary);
+    }
+
+    /// Body callback, aborts the request if the archive fails
+    cpr::ReadCallback readCallback() const
+    {
+        return cpr::ReadCallback {[state = m_state](char *buffer, size_t &size, intptr_t) {
+            size = read(*state, buffer, size);
+            return size > 0 || !state->streamDone || state->stream->succeeded();
+        }};
+    }
+
+private:
+    static size_t read(State &state, char *buffer, size_t size)
+    {
+        auto copy = [&buffer, &size](const std::string &from, size_t &position) {
+            const auto n = std::min(size, from.size() - position);
+            std::memcpy(buffer, from.data() + position, n);
+            position += n;
+            return n;
+        };
+
+        if (state.prefixPosition < state.prefix.size()) {
+            return copy(state.prefix, state.prefixPosition);
+        }
+
+        if (!state.streamDone) {
+            if (const auto n = state.stream->read(buffer, size); n > 0) {
+                return n;
+            }
+            state.streamDone = true;
+            if (!state.stream->succeeded()) {
+                return 0;
+            }
+        }
+
+        return copy(state.suffix, state.suffixPosition);
+    }
+
+    static std::string makeBoundary()
+    {
+        std::random_device rd;
+        std::mt19937_64 gen {(static_cast<uint64_t>(rd()) << 32) | rd()};
+        return fmt::format("scorbit{:016x}{:016x}", gen(), gen());
+    }
+
+    std::string m_boundary;
+    std::shared_ptr<State> m_state;
+};
+
+} // namespace detail
+} // namespace scorbit
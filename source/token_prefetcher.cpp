@@ -0,0 +1,194 @@
+/*
+ * Scorbit SDK
+ *
+ * (c) 2025 Spinner Systems, Inc. (DBA Scorbit), scrobit.io, All Rights Reserved
+ *
+ * MIT License
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "token_prefetcher.h"
+
+#include <logger/logger.h>
+
+#include <algorithm>
+#include <utility>
+
+namespace scorbit {
+namespace detail {
+
+TokenPrefetcher::TokenPrefetcher(Fetch fetch, Lifetime lifetime, Executor executor,
+                                 Scheduler scheduler, Timing timing)
+    : m_fetch(std::move(fetch))
+    , m_lifetime(std::move(lifetime))
+    , m_executor(std::move(executor))
+    , m_scheduler(std::move(scheduler))
+    , m_timing(timing)
+{
+}
+
+std::string TokenPrefetcher::current()
+{
+    std::optional<unsigned> generation;
+    {
+        std::scoped_lock lock(m_mutex);
+        if (isValid(std::chrono::steady_clock::now())) {
+            return m_token;
+        }
+        generation = beginFetch();
+    }
+    launch(generation);
+    return {};
+}
+
+void TokenPrefetcher::get(Callback callback)
+{
+    std::optional<unsigned> generation;
+    std::string token;
+    {
+        std::scoped_lock lock(m_mutex);
+        if (m_stopped) {
+            return;
+        }
+        if (isValid(std::chrono::steady_clock::now())) {
+            token = m_token;
+        } else {
+            m_waiters.push_back(std::move(callback));
+            generation = beginFetch();
+        }
+    }
+
+    if (!token.empty()) {
+        callback(token);
+    }
+    launch(generation);
+}
+
+void TokenPrefetcher::refresh(Callback callback)
+{
+    std::optional<unsigned> generation;
+    {
+        std::scoped_lock lock(m_mutex);
+        if (m_stopped) {
+            return;
+        }
+        ++m_generation;
+        m_token.clear();
+        if (callback) {
+            m_waiters.push_back(std::move(callback));
+        }
+        generation = beginFetch();
+    }
+    launch(generation);
+}
+
+void TokenPrefetcher::stop()
+{
+    std::scoped_lock lock(m_mutex);
+    m_stopped = true;
+    m_waiters.clear();
+}
+
+bool TokenPrefetcher::isValid(std::chrono::steady_clock::time_point now) const
+{
+    return !m_token.empty() && now + m_timing.minValidity < m_expiresAt;
+}
+
+std::optional<unsigned> TokenPrefetcher::beginFetch()
+{
+    // Fetch in flight of older generation starts a new one when it's finished
+    if (m_fetching || m_stopped) {
+        return std::nullopt;
+    }
+    m_fetching = true;
+    return m_generation;
+}
+
+void TokenPrefetcher::launch(std::optional<unsigned> generation)
+{
+    if (generation) {
+        m_executor([this, generation = *generation] { finishFetch(generation, m_fetch()); });
+    }
+}
+
+void TokenPrefetcher::finishFetch(unsigned generation, std::string token)
+{
+    std::vector<Callback> waiters;
+    bool stale = false;
+    std::optional<unsigned> again;
+    std::chrono::steady_clock::duration nextFetchIn {};
+    {
+        std::scoped_lock lock(m_mutex);
+        m_fetching = false;
+        if (m_stopped) {
+            return;
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        if (generation != m_generation) {
+            DBG("Token fetched before refresh, fetching again");
+            stale = true;
+            again = beginFetch();
+        } else if (token.empty()) {
+            nextFetchIn = m_timing.retryDelay;
+            waiters = std::exchange(m_waiters, {});
+            if (isValid(now)) {
+                token = m_token; // Previous one is still good
+            }
+        } else {
+            const auto lifetime = m_lifetime(token);
+            const auto expiresAt = now
+                    + (lifetime ? std::chrono::steady_clock::duration {*lifetime}
+                                : m_timing.unknownLifetime);
+            waiters = std::exchange(m_waiters, {});
+            if (now + m_timing.minValidity < expiresAt) {
+                m_token = token;
+                m_expiresAt = expiresAt;
+                // Never sooner than after a failure, even if the token is short lived
+                nextFetchIn = std::max(m_expiresAt - m_timing.prefetchBefore - now,
+                                       m_timing.retryDelay);
+            } else {
+                // Already expired or about to, no better than a failed fetch
+                WRN("Token fetched expires in {} s, fetching again later",
+                    std::chrono::duration_cast<std::chrono::seconds>(expiresAt - now).count());
+                nextFetchIn = m_timing.retryDelay;
+                token = isValid(now) ? m_token : std::string {};
+            }
+        }
+    }
+
+    if (stale) {
+        launch(again);
+        return;
+    }
+
+    schedule(nextFetchIn);
+    for (const auto &waiter : waiters) {
+        waiter(token);
+    }
+}
+
+void TokenPrefetcher::schedule(std::chrono::steady_clock::duration delay)
+{
+    m_scheduler(delay, [this] {
+        std::optional<unsigned> generation;
+        {
+            std::scoped_lock lock(m_mutex);
+            generation = beginFetch();
+        }
+        launch(generation);
+    });
+}
+
+} // namespace detail
+} // namespace scorbit
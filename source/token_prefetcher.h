@@ -0,0 +1,102 @@
+/*
+ * Scorbit SDK
+ *
+ * (c) 2025 Spinner Systems, Inc. (DBA Scorbit), scrobit.io, All Rights Reserved
+ *
+ * MIT License
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace scorbit {
+namespace detail {
+
+/**
+ * @brief Keeps a short lived token fetched ahead of time, so its users never wait for the fetch.
+ *
+ * Fetch is blocking and runs on the executor. A new token is fetched @p prefetchBefore its
+ * expiry, but not sooner than @p retryDelay, the same delay as after a failed fetch. current()
+ * only returns a token valid for at least @p minValidity more, otherwise it starts a fetch and
+ * returns empty string. A fetched token which is already about to expire counts as a failure.
+ *
+ * Thread-safe. Callbacks are called without lock held, on the executor or on the calling thread
+ * if the token is ready. The executor and scheduler must not run tasks after the object is
+ * destroyed.
+ */
+class TokenPrefetcher
+{
+public:
+    using Fetch = std::function<std::string()>; // Empty string - failed
+    /// How long a just fetched token is valid, better not from the local clock
+    using Lifetime =
+            std::function<std::optional<std::chrono::seconds>(const std::string &token)>;
+    using Executor = std::function<void(std::function<void()> task)>;
+    using Scheduler =
+            std::function<void(std::chrono::steady_clock::duration delay, std::function<void()>)>;
+    using Callback = std::function<void(const std::string &token)>; // Empty if fetch failed
+
+    struct Timing {
+        std::chrono::steady_clock::duration prefetchBefore; // Before expiry
+        std::chrono::steady_clock::duration minValidity;    // Left when token is handed out
+        std::chrono::steady_clock::duration retryDelay;
+        std::chrono::steady_clock::duration unknownLifetime; // Lifetime couldn't be read
+    };
+
+    TokenPrefetcher(Fetch fetch, Lifetime lifetime, Executor executor, Scheduler scheduler,
+                    Timing timing);
+
+    /// Token valid long enough, empty if there is none, it's being fetched then
+    std::string current();
+
+    /// Call @p callback with current token, or when one is fetched
+    void get(Callback callback);
+
+    /// Drop current token, e.g. when its claims changed, and fetch a new one
+    void refresh(Callback callback = {});
+
+    /// No more fetches nor callbacks
+    void stop();
+
+private:
+    bool isValid(std::chrono::steady_clock::time_point now) const;
+    /// Called with lock held, @return generation to launch() after the lock is released
+    std::optional<unsigned> beginFetch();
+    void launch(std::optional<unsigned> generation);
+    void finishFetch(unsigned generation, std::string token);
+    void schedule(std::chrono::steady_clock::duration delay);
+
+    const Fetch m_fetch;
+    const Lifetime m_lifetime;
+    const Executor m_executor;
+    const Scheduler m_scheduler;
+    const Timing m_timing;
+
+    std::mutex m_mutex;
+    std::string m_token;
+    std::chrono::steady_clock::time_point m_expiresAt;
+    std::vector<Callback> m_waiters;
+    unsigned m_generation {0}; // Fetches started before refresh() are discarded
+    bool m_fetching {false};
+    bool m_stopped {false};
+};
+
+} // namespace detail
+} // namespace scorbit
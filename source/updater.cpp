@@ -20,6 +20,8 @@
 #include "updater.h"
 #include <logger/logger.h>
 #include "utils/archiver.h"
+#include "utils/binary_patch.h"
+#include "utils/download_range.h"
 #include <platform_id.h>
 #include <utils/fs_read_write.h>
 #include <scorbit_sdk/version.h>
@@ -28,6 +30,7 @@
 #include <nlohmann/json.hpp>
 #include <boost/dll/runtime_symbol_info.hpp>
 #include <boost/predef.h>
+#include <algorithm>
 #include <regex>
 
 #ifndef SCORBIT_SDK_PRODUCTION_KEY_HASH
@@ -45,6 +48,9 @@ constexpr auto SCORBITD_PATTERN = R"(^scorbitd(\.exe)?$)";
 constexpr auto SDK_LIBRARY_PATTERN = R"(^(lib)?scorbit_sdk\.(so(\.\d+)*|(\d+\.)*dylib|dll)$)";
 constexpr auto SDK_URL_PATTERN = R"(^.*scorbit_sdk-((\d+\.?)+)-(\w+)\.(tar\.gz|tgz)$)";
 constexpr auto SCORBITD_NAME_PATTERN = R"(^scorbitd-((\d+\.?)+)-(\w+)\.(tar\.gz|tgz)$)";
+constexpr int DOWNLOAD_SEGMENTS = 2; // Parallel range requests when archive size is known
+constexpr auto DELTA_FORMAT = "bsdiff";
+constexpr auto DELTA_PATCH_NAME = "update.patch";
 
 namespace fs = boost::filesystem;
 using namespace scorbit;
@@ -62,6 +68,15 @@ fs::path findFile(const fs::path &dir, const std::regex &pattern)
     return {};
 }
 
+void removeUpdateDir(const fs::path &dir)
+{
+    boost::system::error_code ec;
+    fs::remove_all(dir, ec);
+    if (ec) {
+        ERR("Updater: error removing temp update directory: {}", ec.message());
+    }
+}
+
 } // namespace
 
 namespace scorbit {
@@ -154,6 +169,23 @@ Updater::UrlInfo Updater::parseUrls(const nlohmann::json &obj) const
 
     try {
         info.version = obj["version"].get<std::string>();
+
+        // Patches are picked by hash of the current binary, so platform doesn't matter
+        if (const auto it = obj.find("deltas"); it != obj.end() && it->is_array()) {
+            for (const auto &delta : *it) {
+                if (delta.value("format", DELTA_FORMAT) != DELTA_FORMAT) {
+                    continue;
+                }
+                DeltaInfo deltaInfo;
+                delta["download_url"].get_to(deltaInfo.url);
+                delta["from_sha256"].get_to(deltaInfo.fromSha256);
+                delta["target_sha256"].get_to(deltaInfo.targetSha256);
+                deltaInfo.sha256 = delta.value("sha256", "");
+                deltaInfo.size = delta.value("size", -1);
+                info.deltas.push_back(std::move(deltaInfo));
+            }
+        }
+
         const auto assets = obj["assets_json"];
 
         // Find the first asset with the correct platform
@@ -199,6 +231,7 @@ Updater::UrlInfo Updater::parseUrls(const nlohmann::json &obj) const
                     asset["download_url"].get_to(info.url);
                     asset["content_type"].get_to(info.contentType);
                     asset["size"].get_to(info.size);
+                    info.sha256 = asset.value("sha256", "");
                     return info;
                 }
             }
@@ -218,14 +251,7 @@ bool Updater::update(const std::string &archive, const BinaryInfo &binaryInfo) c
     const auto tempDir = binaryInfo.path.parent_path() / UPDATE_DIR;
 
     // RAII cleanup guard
-    auto cleanup = [&tempDir]() {
-        boost::system::error_code ec;
-        fs::remove_all(tempDir, ec);
-        if (ec) {
-            ERR("Updater: error removing temp update directory: {}", ec.message());
-        }
-    };
-    std::shared_ptr<void> guard(nullptr, [&](void *) { cleanup(); });
+    std::shared_ptr<void> guard(nullptr, [&tempDir](void *) { removeUpdateDir(tempDir); });
 
     try {
         // update from tgz archive
@@ -467,8 +493,33 @@ bool Updater::tryToRemountAndUpdate(const UrlInfo &urlInfo, const BinaryInfo &bi
 
 bool Updater::downloadAndupdateTgz(const UrlInfo &urlInfo, const BinaryInfo &binaryInfo) const
 {
-    auto tempFile = fs::temp_directory_path() / fs::unique_path();
-    tempFile.replace_extension(".tar.gz");
+    auto updated = downloadAndPatch(urlInfo, binaryInfo);
+    if (!updated) {
+        updated = downloadAndUpdateStreamed(urlInfo, binaryInfo);
+    }
+    if (updated) {
+        if (*updated) {
+            const auto msg = fmt::format("Updated successfully, ver: {}", urlInfo.version);
+            feedback(msg);
+            INF("Updater: {}", msg);
+        }
+        return *updated;
+    }
+
+    // Stable name, so interrupted download can be resumed by the next update attempt
+    const auto tempName = fmt::format("scorbit_update-{}-{:x}.tar.gz", urlInfo.version,
+                                      std::hash<std::string> {}(urlInfo.url));
+    const auto tempFile = fs::temp_directory_path() / tempName;
+
+    DownloadOptions options;
+    options.expectedSha256 = urlInfo.sha256;
+    options.expectedSize = urlInfo.size;
+    options.keepPartial = true;
+    options.segments = DOWNLOAD_SEGMENTS;
+
+    if (urlInfo.sha256.empty()) {
+        WRN("Updater: no sha256 in release info, archive won't be verified");
+    }
 
     INF("Updater: downloading to temp file: {}", tempFile.string());
     bool success = false;
@@ -501,11 +552,144 @@ bool Updater::downloadAndupdateTgz(const UrlInfo &urlInfo, const BinaryInfo &bin
                     ERR("Updater: download failed: {}", msg);
                 }
             },
-            urlInfo.url, tempFile.string(), {{HDR_KEY_ACCEPT_CONTENT, HDR_VAL_CONTENT_OCTET}});
+            urlInfo.url, tempFile.string(), {{HDR_KEY_ACCEPT_CONTENT, HDR_VAL_CONTENT_OCTET}},
+            options);
 
     return success;
 }
 
+std::optional<bool> Updater::downloadAndPatch(const UrlInfo &urlInfo,
+                                              const BinaryInfo &binaryInfo) const
+{
+    if (urlInfo.deltas.empty()) {
+        return std::nullopt;
+    }
+
+    Sha256Stream hasher;
+    if (!hasher.updateFromFile(binaryInfo.path.string())) {
+        WRN("Updater: can't read current binary for delta update: {}", binaryInfo.path.string());
+        return std::nullopt;
+    }
+    const auto currentSha256 = hasher.hexDigest();
+
+    const auto delta = std::find_if(
+            urlInfo.deltas.begin(), urlInfo.deltas.end(), [&currentSha256](const auto &delta) {
+                return sha256Matches(currentSha256, delta.fromSha256);
+            });
+    if (delta == urlInfo.deltas.end()) {
+        INF("Updater: no delta for current binary {}, full update", currentSha256);
+        return std::nullopt;
+    }
+
+    const auto stagingDir = binaryInfo.path.parent_path() / UPDATE_DIR;
+    std::shared_ptr<void> guard(nullptr, [&stagingDir](void *) { removeUpdateDir(stagingDir); });
+    const auto patchPath = (stagingDir / DELTA_PATCH_NAME).string();
+    const auto newPath = (stagingDir / binaryInfo.path.filename()).string();
+
+    try {
+        fs::create_directories(stagingDir);
+
+        DownloadOptions options;
+        options.expectedSha256 = delta->sha256;
+        options.expectedSize = delta->size;
+
+        INF("Updater: downloading delta: {}", delta->url);
+        bool downloaded = false;
+        m_net.download(
+                false, // Must be synced download, block until download finished
+                [&downloaded](Error error, const std::string &message) {
+                    downloaded = error == Error::Success;
+                    if (!downloaded) {
+                        WRN("Updater: delta download failed: {}, {}", static_cast<int>(error),
+                            message);
+                    }
+                },
+                delta->url, patchPath, {{HDR_KEY_ACCEPT_CONTENT, HDR_VAL_CONTENT_OCTET}},
+                options);
+
+        if (!downloaded || !applyBinaryPatch(binaryInfo.path.string(), patchPath, newPath)) {
+            WRN("Updater: delta update failed, falling back to the full archive");
+            return std::nullopt;
+        }
+
+        // Patch applied to a different binary gives garbage, only the hash can tell
+        hasher.reset();
+        if (!hasher.updateFromFile(newPath)
+            || !sha256Matches(hasher.hexDigest(), delta->targetSha256)) {
+            WRN("Updater: patched binary sha256 mismatch, expected: {}, got: {}, falling back "
+                "to the full archive",
+                delta->targetSha256, hasher.hexDigest());
+            return std::nullopt;
+        }
+
+        fs::permissions(newPath, fs::status(binaryInfo.path).permissions());
+        INF("Updater: replacing current file: {} by patched: {}", binaryInfo.path.string(),
+            newPath);
+        return replaceBinary(binaryInfo.path.string(), newPath);
+    } catch (const fs::filesystem_error &e) {
+        WRN("Updater: delta update failed, falling back to the full archive: {}", e.what());
+        return std::nullopt;
+    }
+}
+
+std::optional<bool> Updater::downloadAndUpdateStreamed(const UrlInfo &urlInfo,
+                                                       const BinaryInfo &binaryInfo) const
+{
+    const auto stagingDir = binaryInfo.path.parent_path() / UPDATE_DIR;
+    std::shared_ptr<void> guard(nullptr, [&stagingDir](void *) { removeUpdateDir(stagingDir); });
+
+    DownloadOptions options;
+    options.expectedSha256 = urlInfo.sha256;
+    options.expectedSize = urlInfo.size;
+
+    // Only the binary is written, the rest of the archive is read through
+    ArchiveExtractor extractor(stagingDir.string(), [&binaryInfo](const std::string &name) {
+        return std::regex_search(name, binaryInfo.re);
+    });
+
+    INF("Updater: downloading and extracting to: {}", stagingDir.string());
+    Error downloadError {Error::Unknown};
+
+    m_net.downloadStream(
+            false, // Must be synced download, extractor is on the stack
+            [&downloadError](Error error, const std::string &message) {
+                downloadError = error;
+                if (error != Error::Success) {
+                    WRN("Updater: streamed download failed: {}, {}", static_cast<int>(error),
+                        message);
+                }
+            },
+            urlInfo.url, {{HDR_KEY_ACCEPT_CONTENT, HDR_VAL_CONTENT_OCTET}}, options,
+            [&extractor](std::string_view data) {
+                return extractor.write(data.data(), data.size());
+            });
+
+    // Nothing is replaced before the whole archive is verified
+    if (downloadError != Error::Success || !extractor.finish()) {
+        WRN("Updater: streamed update failed, falling back to downloading the archive");
+        return std::nullopt;
+    }
+
+    if (extractor.files().empty()) {
+        const auto msg = fmt::format("File is not found in the archive");
+        feedback(msg);
+        ERR("Updater: {}", msg);
+        return false;
+    }
+
+    try {
+        const auto newLibPath = fs::canonical(extractor.files().front());
+        INF("Updater: replacing current file: {} by: {}", binaryInfo.path.string(),
+            newLibPath.string());
+        return replaceBinary(binaryInfo.path.string(), newLibPath.string());
+    } catch (const fs::filesystem_error &e) {
+        const auto msg = fmt::format("Error occurred while updating library: {}", e.what());
+        feedback(msg);
+        ERR("Updater: {}", msg);
+        return false;
+    }
+}
+
 void Updater::feedback(std::string_view out) const
 {
     if (m_feedback.empty()) {
@@ -25,19 +25,32 @@
 #include <boost/filesystem.hpp>
 #include <string>
 #include <atomic>
+#include <optional>
 #include <regex>
 #include <string_view>
+#include <vector>
 
 namespace scorbit {
 namespace detail {
 
 class Updater
 {
+    /// Binary patch from one build to the version of UrlInfo
+    struct DeltaInfo {
+        std::string url;
+        std::string fromSha256;   // Hex digest of the binary the patch applies to
+        std::string targetSha256; // Hex digest of the patched binary
+        std::string sha256;       // Hex digest of the patch, empty if not in release manifest
+        int size {-1};
+    };
+
     struct UrlInfo {
         std::string url;
         std::string version;
         std::string contentType;
         int size {-1};
+        std::string sha256; // Hex digest of the archive, empty if not in release manifest
+        std::vector<DeltaInfo> deltas;
     };
 
     struct BinaryInfo {
@@ -69,6 +82,14 @@ private:
     bool tryToRemountAndUpdate(const UrlInfo &urlInfo, const BinaryInfo &binaryInfo);
     bool downloadAndupdateTgz(const UrlInfo &urlInfo, const BinaryInfo &binaryInfo) const;
 
+    /// Patch the current binary, nullopt - no patch for it or failed, archive should be used
+    std::optional<bool> downloadAndPatch(const UrlInfo &urlInfo,
+                                         const BinaryInfo &binaryInfo) const;
+
+    /// Extract the binary while downloading, nullopt - failed, archive should be downloaded
+    std::optional<bool> downloadAndUpdateStreamed(const UrlInfo &urlInfo,
+                                                  const BinaryInfo &binaryInfo) const;
+
     void feedback(std::string_view out) const;
 
 protected:
@@ -23,12 +23,19 @@
 #include <boost/filesystem.hpp>
 #include <archive.h>
 #include <archive_entry.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
 #include <fstream>
 #include <memory>
+#include <string_view>
 
 namespace {
 
 constexpr auto READ_BLOCK_SIZE = 10240;
+constexpr size_t ARCHIVE_CHUNK_SIZE = 64 * 1024;             // Files are read by this much
+constexpr size_t ARCHIVE_STREAM_BUFFER_SIZE = 256 * 1024; // Waiting in ArchiveStream
+constexpr size_t EXTRACTOR_BUFFER_SIZE = 256 * 1024;      // Waiting in ArchiveExtractor
 
 namespace fs = boost::filesystem;
 
@@ -155,59 +162,89 @@ bool extract(const std::string &archivePath, const std::string &outputDir)
     return r == ARCHIVE_EOF;
 }
 
-bool createTarGz(const std::string &outputPath, const std::vector<ArchiveFileEntry> &files,
-                 const std::vector<ArchiveMemoryEntry> &memoryEntries)
-{
-    if (files.empty() && memoryEntries.empty()) {
-        WRN("No entries to archive");
-        return false;
-    }
+namespace {
 
+ArchiveWriterPtr newArchiveWriter(const ArchiveOptions &options)
+{
     ArchiveWriterPtr writer(archive_write_new());
     if (!writer) {
         ERR("Failed to allocate libarchive writer");
-        return false;
+        return writer;
     }
 
-    archive_write_add_filter_gzip(writer.get());
+    std::string_view filter = "gzip";
+    if (options.compression == ArchiveCompression::Zstd) {
+        // ARCHIVE_WARN - libarchive runs external zstd program
+        if (archive_write_add_filter_zstd(writer.get()) >= ARCHIVE_WARN) {
+            filter = "zstd";
+        } else {
+            WRN("zstd is not supported, falling back to gzip: {}",
+                archiveErrorString(writer.get()));
+            writer.reset(archive_write_new());
+            if (!writer) {
+                ERR("Failed to allocate libarchive writer");
+                return writer;
+            }
+        }
+    }
+    if (filter == "gzip") {
+        archive_write_add_filter_gzip(writer.get());
+    }
     archive_write_set_format_pax_restricted(writer.get());
 
-    if (archive_write_open_filename(writer.get(), outputPath.c_str()) != ARCHIVE_OK) {
-        ERR("Failed to open archive '{}': {}", outputPath, archiveErrorString(writer.get()));
-        return false;
+    const auto setOption = [&writer, filter](const char *option, int value) {
+        if (archive_write_set_filter_option(writer.get(), filter.data(), option,
+                                            std::to_string(value).c_str())
+            != ARCHIVE_OK) {
+            WRN("Can't set {} {} to {}: {}", filter, option, value,
+                archiveErrorString(writer.get()));
+        }
+    };
+    if (options.level > 0) {
+        setOption("compression-level", options.level);
+    }
+    // libarchive compresses gzip on the calling thread only
+    if (options.threads > 1 && filter == "zstd") {
+        setOption("threads", options.threads);
     }
 
-    auto writeEntry = [&](const std::string &archivePath, const char *data, size_t size) -> bool {
-        auto *entry = archive_entry_new();
-        if (!entry) {
-            ERR("Failed to allocate archive entry");
-            return false;
-        }
+    return writer;
+}
 
-        archive_entry_set_pathname(entry, archivePath.c_str());
-        archive_entry_set_size(entry, static_cast<la_int64_t>(size));
-        archive_entry_set_filetype(entry, AE_IFREG);
-        archive_entry_set_perm(entry, 0644);
+bool writeEntryHeader(archive *writer, const std::string &archivePath, size_t size)
+{
+    std::unique_ptr<archive_entry, decltype(&archive_entry_free)> entry(archive_entry_new(),
+                                                                        archive_entry_free);
+    if (!entry) {
+        ERR("Failed to allocate archive entry");
+        return false;
+    }
 
-        if (archive_write_header(writer.get(), entry) != ARCHIVE_OK) {
-            ERR("Failed to write header for '{}': {}", archivePath,
-                archiveErrorString(writer.get()));
-            archive_entry_free(entry);
-            return false;
-        }
+    archive_entry_set_pathname(entry.get(), archivePath.c_str());
+    archive_entry_set_size(entry.get(), static_cast<la_int64_t>(size));
+    archive_entry_set_filetype(entry.get(), AE_IFREG);
+    archive_entry_set_perm(entry.get(), 0644);
 
-        if (size > 0) {
-            if (archive_write_data(writer.get(), data, size) < static_cast<la_ssize_t>(size)) {
-                ERR("Failed to write data for '{}': {}", archivePath,
-                    archiveErrorString(writer.get()));
-                archive_entry_free(entry);
-                return false;
-            }
-        }
+    if (archive_write_header(writer, entry.get()) != ARCHIVE_OK) {
+        ERR("Failed to write header for '{}': {}", archivePath, archiveErrorString(writer));
+        return false;
+    }
+    return true;
+}
 
-        archive_entry_free(entry);
-        return true;
-    };
+bool writeEntryData(archive *writer, const std::string &archivePath, const char *data, size_t size)
+{
+    if (size > 0 && archive_write_data(writer, data, size) < static_cast<la_ssize_t>(size)) {
+        ERR("Failed to write data for '{}': {}", archivePath, archiveErrorString(writer));
+        return false;
+    }
+    return true;
+}
+
+bool writeEntries(archive *writer, const std::vector<ArchiveFileEntry> &files,
+                  const std::vector<ArchiveMemoryEntry> &memoryEntries)
+{
+    std::vector<char> buffer;
 
     for (const auto &file : files) {
         try {
@@ -216,19 +253,32 @@ bool createTarGz(const std::string &outputPath, const std::vector<ArchiveFileEnt
                 continue;
             }
 
-            const auto fileSize = fs::file_size(file.sourcePath);
+            const auto fileSize = static_cast<size_t>(fs::file_size(file.sourcePath));
             std::ifstream ifs(file.sourcePath, std::ios::binary);
             if (!ifs.is_open()) {
                 ERR("Failed to open source file: {}", file.sourcePath);
                 continue;
             }
 
-            std::vector<char> buffer(fileSize);
-            ifs.read(buffer.data(), static_cast<std::streamsize>(fileSize));
-
-            if (!writeEntry(file.archivePath, buffer.data(), buffer.size())) {
+            if (!writeEntryHeader(writer, file.archivePath, fileSize)) {
                 return false;
             }
+
+            // Logs may be written meanwhile: the entry keeps the size it had, if the file
+            // shrinks, libarchive pads the entry with zeros
+            buffer.resize(ARCHIVE_CHUNK_SIZE);
+            for (size_t left = fileSize; left > 0;) {
+                ifs.read(buffer.data(),
+                         static_cast<std::streamsize>(std::min(left, buffer.size())));
+                const auto read = static_cast<size_t>(ifs.gcount());
+                if (read == 0) {
+                    break;
+                }
+                if (!writeEntryData(writer, file.archivePath, buffer.data(), read)) {
+                    return false;
+                }
+                left -= read;
+            }
         } catch (const fs::filesystem_error &e) {
             ERR("Filesystem error for '{}': {}", file.sourcePath, e.what());
             continue;
@@ -236,13 +286,284 @@ bool createTarGz(const std::string &outputPath, const std::vector<ArchiveFileEnt
     }
 
     for (const auto &mem : memoryEntries) {
-        if (!writeEntry(mem.archivePath, mem.data.data(), mem.data.size())) {
+        if (!writeEntryHeader(writer, mem.archivePath, mem.data.size())
+            || !writeEntryData(writer, mem.archivePath, mem.data.data(), mem.data.size())) {
             return false;
         }
     }
 
+    if (archive_write_close(writer) != ARCHIVE_OK) {
+        ERR("Failed to finish archive: {}", archiveErrorString(writer));
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+bool createTarGz(const std::string &outputPath, const std::vector<ArchiveFileEntry> &files,
+                 const std::vector<ArchiveMemoryEntry> &memoryEntries,
+                 const ArchiveOptions &options)
+{
+    if (files.empty() && memoryEntries.empty()) {
+        WRN("No entries to archive");
+        return false;
+    }
+
+    auto writer = newArchiveWriter(options);
+    if (!writer) {
+        return false;
+    }
+
+    if (archive_write_open_filename(writer.get(), outputPath.c_str()) != ARCHIVE_OK) {
+        ERR("Failed to open archive '{}': {}", outputPath, archiveErrorString(writer.get()));
+        return false;
+    }
+
+    return writeEntries(writer.get(), files, memoryEntries);
+}
+
+bool writeArchive(const ArchiveSink &sink, const std::vector<ArchiveFileEntry> &files,
+                  const std::vector<ArchiveMemoryEntry> &memoryEntries,
+                  const ArchiveOptions &options)
+{
+    if (files.empty() && memoryEntries.empty()) {
+        WRN("No entries to archive");
+        return false;
+    }
+
+    auto writer = newArchiveWriter(options);
+    if (!writer) {
+        return false;
+    }
+
+    // No padding of the last block, the bytes are not written to a tape
+    archive_write_set_bytes_in_last_block(writer.get(), 1);
+
+    const auto write = [](archive *a, void *clientData, const void *buffer, size_t length) {
+        const auto &sinkFunc = *static_cast<const ArchiveSink *>(clientData);
+        if (!sinkFunc(static_cast<const char *>(buffer), length)) {
+            archive_set_error(a, ECANCELED, "Archive cancelled");
+            return la_ssize_t {-1};
+        }
+        return static_cast<la_ssize_t>(length);
+    };
+
+    if (archive_write_open2(writer.get(), const_cast<ArchiveSink *>(&sink), nullptr, write,
+                            nullptr, nullptr)
+        != ARCHIVE_OK) {
+        ERR("Failed to open archive stream: {}", archiveErrorString(writer.get()));
+        return false;
+    }
+
+    return writeEntries(writer.get(), files, memoryEntries);
+}
+
+ArchiveStream::ArchiveStream(std::shared_ptr<const ArchiveContent> content,
+                             const ArchiveOptions &options)
+    : m_thread([this, content = std::move(content), options]() {
+        const bool succeeded = writeArchive(
+                [this](const char *data, size_t size) { return push(data, size); },
+                content->files, content->memoryEntries, options);
+
+        std::scoped_lock lock(m_mutex);
+        m_succeeded = succeeded;
+        m_done = true;
+        m_cv.notify_all();
+    })
+{
+}
+
+ArchiveStream::~ArchiveStream()
+{
+    {
+        std::scoped_lock lock(m_mutex);
+        m_cancelled = true;
+        m_cv.notify_all();
+    }
+    m_thread.join();
+}
+
+bool ArchiveStream::push(const char *data, size_t size)
+{
+    std::unique_lock lock(m_mutex);
+    m_cv.wait(lock, [this] {
+        return m_cancelled || m_buffer.size() - m_readPosition < ARCHIVE_STREAM_BUFFER_SIZE;
+    });
+    if (m_cancelled) {
+        return false;
+    }
+
+    // Drop what was read, before the buffer grows
+    m_buffer.erase(0, m_readPosition);
+    m_readPosition = 0;
+    m_buffer.append(data, size);
+    m_cv.notify_all();
     return true;
 }
 
+size_t ArchiveStream::read(char *buffer, size_t size)
+{
+    std::unique_lock lock(m_mutex);
+    m_cv.wait(lock, [this] { return m_done || m_readPosition < m_buffer.size(); });
+
+    const auto count = std::min(size, m_buffer.size() - m_readPosition);
+    std::memcpy(buffer, m_buffer.data() + m_readPosition, count);
+    m_readPosition += count;
+    m_cv.notify_all();
+    return count;
+}
+
+bool ArchiveStream::succeeded() const
+{
+    std::scoped_lock lock(m_mutex);
+    return m_done && m_succeeded;
+}
+
+ArchiveExtractor::ArchiveExtractor(std::string outputDir, Filter filter)
+    : m_outputDir(std::move(outputDir))
+    , m_filter(std::move(filter))
+    , m_thread([this]() { run(); })
+{
+}
+
+ArchiveExtractor::~ArchiveExtractor()
+{
+    {
+        std::scoped_lock lock(m_mutex);
+        m_cancelled = true;
+        m_cv.notify_all();
+    }
+    m_thread.join();
+}
+
+bool ArchiveExtractor::write(const char *data, size_t size)
+{
+    std::unique_lock lock(m_mutex);
+    m_cv.wait(lock, [this] { return m_done || m_pending.size() < EXTRACTOR_BUFFER_SIZE; });
+    if (m_done) {
+        // Bytes after the end of tar (padding, gzip trailer) are not needed
+        return m_succeeded;
+    }
+
+    m_pending.append(data, size);
+    m_cv.notify_all();
+    return true;
+}
+
+bool ArchiveExtractor::finish()
+{
+    std::unique_lock lock(m_mutex);
+    m_endOfData = true;
+    m_cv.notify_all();
+    m_cv.wait(lock, [this] { return m_done; });
+    return m_succeeded;
+}
+
+int64_t ArchiveExtractor::pull(const void **buffer)
+{
+    std::unique_lock lock(m_mutex);
+    m_cv.wait(lock, [this] { return m_cancelled || m_endOfData || !m_pending.empty(); });
+    if (m_cancelled) {
+        return -1;
+    }
+
+    // Swap, so the buffers are reused and writer can go on while this one is extracted
+    m_reading.clear();
+    std::swap(m_reading, m_pending);
+    m_cv.notify_all();
+
+    *buffer = m_reading.data();
+    return static_cast<int64_t>(m_reading.size());
+}
+
+void ArchiveExtractor::run()
+{
+    bool succeeded = false;
+    const auto done = [this, &succeeded]() {
+        std::scoped_lock lock(m_mutex);
+        m_succeeded = succeeded;
+        m_done = true;
+        m_cv.notify_all();
+    };
+
+    try {
+        fs::create_directories(m_outputDir);
+    } catch (const fs::filesystem_error &e) {
+        ERR("Failed to create output directory '{}': {}", m_outputDir, e.what());
+        done();
+        return;
+    }
+
+    ArchiveReaderPtr reader(archive_read_new());
+    ArchiveWriterPtr writer(archive_write_disk_new());
+    if (!reader || !writer) {
+        ERR("Failed to allocate libarchive objects");
+        done();
+        return;
+    }
+
+    archive_read_support_filter_all(reader.get());
+    archive_read_support_format_all(reader.get());
+    archive_write_disk_set_options(writer.get(), ARCHIVE_EXTRACT_TIME | ARCHIVE_EXTRACT_PERM);
+
+    const auto read = [](archive *a, void *clientData, const void **buffer) {
+        const auto size = static_cast<ArchiveExtractor *>(clientData)->pull(buffer);
+        if (size < 0) {
+            archive_set_error(a, ECANCELED, "Extraction cancelled");
+        }
+        return static_cast<la_ssize_t>(size);
+    };
+
+    if (archive_read_open(reader.get(), this, nullptr, read, nullptr) != ARCHIVE_OK) {
+        ERR("Failed to open archive stream: {}", archiveErrorString(reader.get()));
+        done();
+        return;
+    }
+
+    struct archive_entry *entry = nullptr;
+    int r = ARCHIVE_OK;
+
+    while ((r = archive_read_next_header(reader.get(), &entry)) == ARCHIVE_OK) {
+        const auto fileName = fs::path(archive_entry_pathname(entry)).filename().string();
+        if (archive_entry_filetype(entry) != AE_IFREG || !m_filter(fileName)) {
+            // Not decompressed to disk, only read through
+            r = archive_read_data_skip(reader.get());
+            if (r < ARCHIVE_OK) {
+                break;
+            }
+            continue;
+        }
+
+        // Flat, so no entry can be written outside of the output directory
+        const auto fullPath = (fs::path(m_outputDir) / fileName).string();
+        archive_entry_set_pathname(entry, fullPath.c_str());
+
+        r = archive_write_header(writer.get(), entry);
+        if (r < ARCHIVE_OK) {
+            ERR("Failed to write header: {}", archiveErrorString(writer.get()));
+            break;
+        }
+        r = copy_data(reader.get(), writer.get());
+        if (r < ARCHIVE_OK) {
+            ERR("Data copy error: {}", archiveErrorString(writer.get()));
+            break;
+        }
+        r = archive_write_finish_entry(writer.get());
+        if (r < ARCHIVE_OK) {
+            ERR("Failed to finish entry: {}", archiveErrorString(writer.get()));
+            break;
+        }
+        m_files.push_back(fullPath);
+    }
+
+    if (r != ARCHIVE_EOF) {
+        ERR("Archive read error: {}", archiveErrorString(reader.get()));
+    }
+
+    succeeded = r == ARCHIVE_EOF;
+    done();
+}
+
 } // namespace detail
 } // namespace scorbit
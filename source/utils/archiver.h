@@ -19,7 +19,13 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace scorbit {
@@ -37,8 +43,114 @@ struct ArchiveMemoryEntry {
     std::string data;        // in-memory content
 };
 
+enum class ArchiveCompression {
+    Gzip,
+    Zstd, // Falls back to gzip if libarchive is built without zstd
+};
+
+struct ArchiveOptions {
+    ArchiveCompression compression {ArchiveCompression::Gzip};
+    int level {0};   // 0 - default level of the compression
+    int threads {1}; // Compression threads, zstd only
+};
+
+/// Receives archive bytes as they are produced, false aborts the archive
+using ArchiveSink = std::function<bool(const char *data, size_t size)>;
+
+/// Files are read in chunks, so memory use doesn't depend on their size
 bool createTarGz(const std::string &outputPath, const std::vector<ArchiveFileEntry> &files,
-                 const std::vector<ArchiveMemoryEntry> &memoryEntries = {});
+                 const std::vector<ArchiveMemoryEntry> &memoryEntries = {},
+                 const ArchiveOptions &options = {});
+
+/// Same as createTarGz(), but the archive is passed to @p sink instead of a file
+bool writeArchive(const ArchiveSink &sink, const std::vector<ArchiveFileEntry> &files,
+                  const std::vector<ArchiveMemoryEntry> &memoryEntries = {},
+                  const ArchiveOptions &options = {});
+
+struct ArchiveContent {
+    std::vector<ArchiveFileEntry> files;
+    std::vector<ArchiveMemoryEntry> memoryEntries;
+};
+
+/**
+ * @brief Archive created on a background thread while it's read, e.g. by an upload.
+ *
+ * The archive is never stored, only a few hundred KB of it wait to be read.
+ * Destroying the stream before the end aborts the archive.
+ */
+class ArchiveStream
+{
+public:
+    ArchiveStream(std::shared_ptr<const ArchiveContent> content, const ArchiveOptions &options);
+    ~ArchiveStream();
+
+    ArchiveStream(const ArchiveStream &) = delete;
+    ArchiveStream &operator=(const ArchiveStream &) = delete;
+
+    /// Copy up to @p size bytes to @p buffer, waits for them, 0 - end of the archive
+    size_t read(char *buffer, size_t size);
+
+    /// After read() returned 0, whether the archive is complete
+    bool succeeded() const;
+
+private:
+    bool push(const char *data, size_t size);
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::string m_buffer;
+    size_t m_readPosition {0};
+    bool m_done {false};
+    bool m_succeeded {false};
+    bool m_cancelled {false};
+    std::thread m_thread; // Last, other members must be valid while it runs
+};
+
+/**
+ * @brief Archive extracted on a background thread while it's written, e.g. by a download.
+ *
+ * Only regular files whose name passes the filter are extracted, flat into the output directory,
+ * other entries are skipped without being written. write() waits while a few hundred KB are
+ * not extracted yet, so a slow disk slows the download down instead of growing memory.
+ */
+class ArchiveExtractor
+{
+public:
+    using Filter = std::function<bool(const std::string &fileName)>;
+
+    ArchiveExtractor(std::string outputDir, Filter filter);
+    ~ArchiveExtractor();
+
+    ArchiveExtractor(const ArchiveExtractor &) = delete;
+    ArchiveExtractor &operator=(const ArchiveExtractor &) = delete;
+
+    /// Next bytes of the archive, false - extraction failed, no point to write more
+    bool write(const char *data, size_t size);
+
+    /// No more data, waits for extraction to end, true if the whole archive was read
+    bool finish();
+
+    /// Paths of extracted files, valid after finish()
+    const std::vector<std::string> &files() const { return m_files; }
+
+private:
+    void run();
+    int64_t pull(const void **buffer); // -1 if cancelled
+
+    const std::string m_outputDir;
+    const Filter m_filter;
+    std::vector<std::string> m_files;
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::string m_pending; // Written, not taken by the extractor yet
+    std::string m_reading; // Taken, libarchive reads it until the next pull()
+    bool m_endOfData {false};
+    bool m_done {false};
+    bool m_succeeded {false};
+    bool m_cancelled {false};
+    std::thread m_thread; // Last, other members must be valid while it runs
+};
 
 } // namespace detail
 } // namespace scorbit
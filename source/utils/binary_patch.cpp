@@ -0,0 +1,235 @@
+/*
+ * Scorbit SDK
+ *
+ * (c) 2025 Spinner Systems, Inc. (DBA Scorbit), scrobit.io, All Rights Reserved
+ *
+ * MIT License
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "binary_patch.h"
+#include <logger/logger.h>
+
+#include <archive.h>
+#include <archive_entry.h>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+constexpr std::string_view PATCH_MAGIC = "ENDSLEY/BSDIFF43";
+constexpr size_t PATCH_HEADER_SIZE = 24; // Magic and size of the new file
+constexpr size_t PATCH_CHUNK_SIZE = 64 * 1024;
+
+/// bsdiff stores 64-bit integers as little endian magnitude with sign in the top bit
+int64_t offtin(const uint8_t *buf)
+{
+    int64_t y = buf[7] & 0x7F;
+    for (int i = 6; i >= 0; --i) {
+        y = y * 256 + buf[i];
+    }
+    return (buf[7] & 0x80) ? -y : y;
+}
+
+/// Decompressed body of the patch, read from after the header
+class PatchBody
+{
+public:
+    explicit PatchBody(const std::string &path)
+        : m_file(path, std::ios::binary)
+        , m_reader(archive_read_new())
+    {
+        if (!m_file || !m_reader) {
+            return;
+        }
+        m_file.seekg(PATCH_HEADER_SIZE);
+
+        archive_read_support_filter_all(m_reader.get());
+        archive_read_support_format_raw(m_reader.get());
+
+        const auto read = [](archive *, void *clientData, const void **buffer) {
+            auto &self = *static_cast<PatchBody *>(clientData);
+            self.m_file.read(self.m_buffer.data(),
+                             static_cast<std::streamsize>(self.m_buffer.size()));
+            *buffer = self.m_buffer.data();
+            return static_cast<la_ssize_t>(self.m_file.gcount());
+        };
+
+        archive_entry *entry = nullptr;
+        m_open = archive_read_open(m_reader.get(), this, nullptr, read, nullptr) == ARCHIVE_OK
+              && archive_read_next_header(m_reader.get(), &entry) == ARCHIVE_OK;
+        if (!m_open) {
+            const char *msg = archive_error_string(m_reader.get());
+            ERR("Binary patch: can't read patch body: {}", msg ? msg : "unknown error");
+        }
+    }
+
+    bool isOpen() const { return m_open; }
+
+    /// Exactly @p size bytes or false
+    bool read(void *data, size_t size)
+    {
+        auto *out = static_cast<char *>(data);
+        while (size > 0) {
+            const auto n = archive_read_data(m_reader.get(), out, size);
+            if (n <= 0) {
+                return false;
+            }
+            out += n;
+            size -= static_cast<size_t>(n);
+        }
+        return true;
+    }
+
+private:
+    struct ReaderDeleter {
+        void operator()(archive *a) const { archive_read_free(a); }
+    };
+
+    std::ifstream m_file;
+    std::array<char, PATCH_CHUNK_SIZE> m_buffer {};
+    std::unique_ptr<archive, ReaderDeleter> m_reader;
+    bool m_open {false};
+};
+
+} // namespace
+
+namespace scorbit {
+namespace detail {
+
+bool applyBinaryPatch(const std::string &oldPath, const std::string &patchPath,
+                      const std::string &outputPath)
+{
+    std::ifstream patch(patchPath, std::ios::binary);
+    std::array<uint8_t, PATCH_HEADER_SIZE> header {};
+    patch.read(reinterpret_cast<char *>(header.data()), header.size());
+    if (!patch || std::string_view(reinterpret_cast<const char *>(header.data()),
+                                   PATCH_MAGIC.size())
+                          != PATCH_MAGIC) {
+        ERR("Binary patch: not a bsdiff patch: {}", patchPath);
+        return false;
+    }
+    patch.close();
+
+    const auto newSize = offtin(header.data() + PATCH_MAGIC.size());
+    if (newSize < 0) {
+        ERR("Binary patch: corrupt header: {}", patchPath);
+        return false;
+    }
+
+    std::ifstream old(oldPath, std::ios::binary | std::ios::ate);
+    if (!old) {
+        ERR("Binary patch: can't open old file: {}", oldPath);
+        return false;
+    }
+    const auto oldSize = static_cast<int64_t>(old.tellg());
+
+    auto body = std::make_unique<PatchBody>(patchPath); // Has 64 KB buffer
+    if (!body->isOpen()) {
+        return false;
+    }
+
+    std::ofstream out(outputPath, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        ERR("Binary patch: can't create: {}", outputPath);
+        return false;
+    }
+
+    std::vector<char> diff(PATCH_CHUNK_SIZE);
+    std::vector<char> from(PATCH_CHUNK_SIZE);
+    int64_t oldPos = 0;
+    int64_t newPos = 0;
+
+    const auto corrupt = [&patchPath]() {
+        ERR("Binary patch: corrupt patch: {}", patchPath);
+        return false;
+    };
+
+    while (newPos < newSize) {
+        std::array<uint8_t, 24> control {};
+        if (!body->read(control.data(), control.size())) {
+            return corrupt();
+        }
+        const auto diffSize = offtin(control.data());
+        const auto extraSize = offtin(control.data() + 8);
+        const auto seek = offtin(control.data() + 16);
+        // Subtracted, as the sizes come from the patch and their sum may overflow
+        if (diffSize < 0 || extraSize < 0 || diffSize > newSize - newPos
+            || extraSize > newSize - newPos - diffSize) {
+            return corrupt();
+        }
+
+        // Diff bytes are added to old ones, old file is read where it overlaps
+        for (int64_t done = 0; done < diffSize;) {
+            const auto n = static_cast<size_t>(
+                    std::min<int64_t>(diffSize - done, static_cast<int64_t>(diff.size())));
+            if (!body->read(diff.data(), n)) {
+                return corrupt();
+            }
+
+            const auto position = oldPos + done;
+            const auto first = std::clamp<int64_t>(position, 0, oldSize);
+            const auto last = std::clamp<int64_t>(position + static_cast<int64_t>(n), 0, oldSize);
+            if (last > first) {
+                old.seekg(first);
+                old.read(from.data(), last - first);
+                if (!old) {
+                    ERR("Binary patch: can't read old file: {}", oldPath);
+                    return false;
+                }
+                for (int64_t i = first; i < last; ++i) {
+                    diff[static_cast<size_t>(i - position)] +=
+                            from[static_cast<size_t>(i - first)];
+                }
+            }
+
+            out.write(diff.data(), static_cast<std::streamsize>(n));
+            done += static_cast<int64_t>(n);
+        }
+        newPos += diffSize;
+        oldPos += diffSize;
+
+        for (int64_t done = 0; done < extraSize;) {
+            const auto n = static_cast<size_t>(
+                    std::min<int64_t>(extraSize - done, static_cast<int64_t>(diff.size())));
+            if (!body->read(diff.data(), n)) {
+                return corrupt();
+            }
+            out.write(diff.data(), static_cast<std::streamsize>(n));
+            done += static_cast<int64_t>(n);
+        }
+        newPos += extraSize;
+
+        // bsdiff never seeks outside the old file, the next diff starts at its match there
+        if (seek < -oldPos || seek > oldSize - oldPos) {
+            return corrupt();
+        }
+        oldPos += seek;
+    }
+
+    out.close();
+    if (!out) {
+        ERR("Binary patch: failed to write: {}", outputPath);
+        return false;
+    }
+    return true;
+}
+
+} // namespace detail
+} // namespace scorbit
@@ -0,0 +1,41 @@
+/*
+ * Scorbit SDK
+ *
+ * (c) 2025 Spinner Systems, Inc. (DBA Scorbit), scrobit.io, All Rights Reserved
+ *
+ * MIT License
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <string>
+
+namespace scorbit {
+namespace detail {
+
+/**
+ * @brief Create @p outputPath from @p oldPath and a bsdiff patch (ENDSLEY/BSDIFF43 format).
+ *
+ * The patch body after the header may be compressed with any filter libarchive reads (bzip2,
+ * as written by bsdiff, or gzip, xz, zstd). Files are processed in chunks, memory use doesn't
+ * depend on their size. The result must be verified by the caller, a patch made against
+ * another old file produces garbage without an error.
+ *
+ * @return false if the patch is malformed or files can't be read or written
+ */
+bool applyBinaryPatch(const std::string &oldPath, const std::string &patchPath,
+                      const std::string &outputPath);
+
+} // namespace detail
+} // namespace scorbit
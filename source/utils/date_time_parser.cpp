@@ -21,6 +21,7 @@
 
 #include <chrono>
 #include <iomanip>
+#include <locale>
 #include <sstream>
 
 #ifdef _WIN32
@@ -32,6 +33,42 @@
 namespace scorbit {
 namespace detail {
 
+namespace {
+
+int64_t utcToUnixTimestamp(std::tm &tm)
+{
+    // timegm interprets tm as UTC (unlike mktime which uses local time)
+#ifdef _WIN32
+    const auto epoch = _mkgmtime(&tm);
+#else
+    const auto epoch = timegm(&tm);
+#endif
+
+    if (epoch == static_cast<time_t>(-1)) {
+        return -1;
+    }
+
+    return static_cast<int64_t>(epoch);
+}
+
+std::string formatUtc(int64_t timestamp, const char *format)
+{
+    const auto time = static_cast<time_t>(timestamp);
+    std::tm tm {};
+#ifdef _WIN32
+    gmtime_s(&tm, &time);
+#else
+    gmtime_r(&time, &tm);
+#endif
+
+    std::ostringstream oss;
+    oss.imbue(std::locale::classic()); // Day and month names must be English
+    oss << std::put_time(&tm, format);
+    return oss.str();
+}
+
+} // namespace
+
 int64_t parseHttpDateToUnixTimestamp(const std::string &httpDate)
 {
     std::tm tm {};
@@ -42,18 +79,38 @@ int64_t parseHttpDateToUnixTimestamp(const std::string &httpDate)
         return -1;
     }
 
-    // timegm interprets tm as UTC (unlike mktime which uses local time)
-#ifdef _WIN32
-    const auto epoch = _mkgmtime(&tm);
-#else
-    const auto epoch = timegm(&tm);
-#endif
+    return utcToUnixTimestamp(tm);
+}
 
-    if (epoch == static_cast<time_t>(-1)) {
+int64_t parseIso8601ToUnixTimestamp(const std::string &dateTime)
+{
+    std::tm tm {};
+    std::istringstream ss(dateTime);
+    ss >> std::get_time(&tm, "%Y-%m-%d");
+    if (ss.fail()) {
         return -1;
     }
 
-    return static_cast<int64_t>(epoch);
+    // Time is optional, fraction of seconds and Z suffix are ignored
+    if (ss.peek() == 'T' || ss.peek() == ' ') {
+        ss.get();
+        ss >> std::get_time(&tm, "%H:%M:%S");
+        if (ss.fail()) {
+            return -1;
+        }
+    }
+
+    return utcToUnixTimestamp(tm);
+}
+
+std::string formatUnixTimestampIso8601(int64_t timestamp)
+{
+    return formatUtc(timestamp, "%Y-%m-%dT%H:%M:%SZ");
+}
+
+std::string formatUnixTimestampHttpDate(int64_t timestamp)
+{
+    return formatUtc(timestamp, "%a, %d %b %Y %H:%M:%S GMT");
 }
 
 bool setSystemTime(int64_t timestamp)
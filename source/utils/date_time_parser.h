@@ -29,6 +29,16 @@ namespace detail {
 // E.g. Wed, 21 Oct 2037 07:28:00 GMT
 int64_t parseHttpDateToUnixTimestamp(const std::string &httpDate);
 
+// Parse UTC ISO-8601 date or date and time to Unix timestamp, -1 if invalid
+// E.g. 2026-04-01 or 2026-04-01T10:00:00Z
+int64_t parseIso8601ToUnixTimestamp(const std::string &dateTime);
+
+// Format Unix timestamp as UTC ISO-8601, e.g. 2026-04-01T10:00:00Z
+std::string formatUnixTimestampIso8601(int64_t timestamp);
+
+// Format Unix timestamp as HTTP date, e.g. Fri, 21 Mar 2025 12:34:56 GMT
+std::string formatUnixTimestampHttpDate(int64_t timestamp);
+
 bool setSystemTime(int64_t timestamp);
 
 } // namespace detail
@@ -0,0 +1,228 @@
+/*
+ * Scorbit SDK
+ *
+ * (c) 2025 Spinner Systems, Inc. (DBA Scorbit), scrobit.io, All Rights Reserved
+ *
+ * MIT License
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "download_range.h"
+#include <openssl/evp.h>
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cctype>
+#include <fstream>
+
+namespace scorbit {
+namespace detail {
+
+constexpr size_t HASH_READ_BLOCK_SIZE = 64 * 1024;
+
+namespace {
+
+std::string_view trim(std::string_view s)
+{
+    while (!s.empty() && std::isspace(static_cast<unsigned char>(s.front()))) {
+        s.remove_prefix(1);
+    }
+    while (!s.empty() && std::isspace(static_cast<unsigned char>(s.back()))) {
+        s.remove_suffix(1);
+    }
+    return s;
+}
+
+bool parseInt(std::string_view s, int64_t &value)
+{
+    s = trim(s);
+    if (s.empty()) {
+        return false;
+    }
+    const auto [ptr, ec] = std::from_chars(s.data(), s.data() + s.size(), value);
+    return ec == std::errc {} && ptr == s.data() + s.size();
+}
+
+} // namespace
+
+Sha256Stream::Sha256Stream()
+    : m_ctx {EVP_MD_CTX_new()}
+{
+    reset();
+}
+
+Sha256Stream::~Sha256Stream()
+{
+    EVP_MD_CTX_free(m_ctx);
+}
+
+void Sha256Stream::reset()
+{
+    EVP_DigestInit_ex(m_ctx, EVP_sha256(), nullptr);
+    m_size = 0;
+}
+
+void Sha256Stream::update(const void *data, size_t size)
+{
+    EVP_DigestUpdate(m_ctx, data, size);
+    m_size += size;
+}
+
+bool Sha256Stream::updateFromFile(const std::string &path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    std::vector<char> buffer(HASH_READ_BLOCK_SIZE);
+    while (file) {
+        file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        const auto n = file.gcount();
+        if (n > 0) {
+            update(buffer.data(), static_cast<size_t>(n));
+        }
+    }
+    return file.eof();
+}
+
+std::string Sha256Stream::hexDigest() const
+{
+    std::array<unsigned char, EVP_MAX_MD_SIZE> digest {};
+    unsigned int len = 0;
+
+    // Finalize a copy so the stream can be continued
+    EVP_MD_CTX *copy = EVP_MD_CTX_new();
+    EVP_MD_CTX_copy_ex(copy, m_ctx);
+    EVP_DigestFinal_ex(copy, digest.data(), &len);
+    EVP_MD_CTX_free(copy);
+
+    static constexpr char HEX[] = "0123456789abcdef";
+    std::string hex;
+    hex.reserve(len * 2);
+    for (unsigned int i = 0; i < len; ++i) {
+        hex.push_back(HEX[digest[i] >> 4]);
+        hex.push_back(HEX[digest[i] & 0x0f]);
+    }
+    return hex;
+}
+
+bool sha256Matches(std::string_view hexDigest, std::string_view expected)
+{
+    expected = trim(expected);
+    if (expected.empty() || expected.size() != hexDigest.size()) {
+        return false;
+    }
+    return std::equal(hexDigest.begin(), hexDigest.end(), expected.begin(), [](char a, char b) {
+        return std::tolower(static_cast<unsigned char>(a))
+               == std::tolower(static_cast<unsigned char>(b));
+    });
+}
+
+std::string elideUrl(const std::string &url, size_t keep)
+{
+    if (url.size() <= keep * 2 + 3) {
+        return url;
+    }
+    return url.substr(0, keep) + "..." + url.substr(url.size() - keep);
+}
+
+std::string rangeHeaderFrom(int64_t offset)
+{
+    return "bytes=" + std::to_string(offset) + "-";
+}
+
+std::optional<ContentRange> parseContentRange(std::string_view value)
+{
+    value = trim(value);
+    constexpr std::string_view UNIT = "bytes ";
+    if (!value.starts_with(UNIT)) {
+        return std::nullopt;
+    }
+    value.remove_prefix(UNIT.size());
+
+    const auto dash = value.find('-');
+    const auto slash = value.find('/');
+    if (dash == std::string_view::npos || slash == std::string_view::npos || dash > slash) {
+        return std::nullopt;
+    }
+
+    ContentRange range;
+    if (!parseInt(value.substr(0, dash), range.first)
+        || !parseInt(value.substr(dash + 1, slash - dash - 1), range.last)
+        || range.last < range.first) {
+        return std::nullopt;
+    }
+
+    const auto total = trim(value.substr(slash + 1));
+    if (total != "*" && (!parseInt(total, range.total) || range.total <= range.last)) {
+        return std::nullopt;
+    }
+
+    return range;
+}
+
+int parseHttpStatusLine(std::string_view line)
+{
+    if (!line.starts_with("HTTP/")) {
+        return 0;
+    }
+    const auto space = line.find(' ');
+    if (space == std::string_view::npos) {
+        return 0;
+    }
+    line.remove_prefix(space + 1);
+
+    int code = 0;
+    const auto [ptr, ec] = std::from_chars(line.data(), line.data() + line.size(), code);
+    if (ec != std::errc {} || code < 100 || code > 999) {
+        return 0;
+    }
+    return code;
+}
+
+std::optional<std::pair<std::string, std::string>> parseHttpHeaderLine(std::string_view line)
+{
+    const auto colon = line.find(':');
+    if (colon == std::string_view::npos || colon == 0 || line.starts_with("HTTP/")) {
+        return std::nullopt;
+    }
+
+    std::string key(trim(line.substr(0, colon)));
+    std::transform(key.begin(), key.end(), key.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return std::make_pair(std::move(key), std::string(trim(line.substr(colon + 1))));
+}
+
+std::vector<std::pair<int64_t, int64_t>> splitByteRanges(int64_t totalSize, int segments)
+{
+    std::vector<std::pair<int64_t, int64_t>> ranges;
+    if (totalSize <= 0) {
+        return ranges;
+    }
+
+    const auto count = std::clamp<int64_t>(segments, 1, totalSize);
+    const auto chunk = totalSize / count;
+    const auto remainder = totalSize % count;
+
+    int64_t first = 0;
+    for (int64_t i = 0; i < count; ++i) {
+        const auto length = chunk + (i < remainder ? 1 : 0);
+        ranges.emplace_back(first, first + length - 1);
+        first += length;
+    }
+    return ranges;
+}
+
+} // namespace detail
+} // namespace scorbit
@@ -0,0 +1,100 @@
+/*
+ * Scorbit SDK
+ *
+ * (c) 2025 Spinner Systems, Inc. (DBA Scorbit), scrobit.io, All Rights Reserved
+ *
+ * MIT License
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+struct evp_md_ctx_st;
+
+namespace scorbit {
+namespace detail {
+
+/**
+ * @brief Incremental SHA-256, fed chunk by chunk while a download is in progress
+ */
+class Sha256Stream
+{
+public:
+    Sha256Stream();
+    ~Sha256Stream();
+
+    Sha256Stream(const Sha256Stream &) = delete;
+    Sha256Stream &operator=(const Sha256Stream &) = delete;
+
+    void reset();
+    void update(const void *data, size_t size);
+    void update(std::string_view data) { update(data.data(), data.size()); }
+
+    /**
+     * @brief Feed the whole content of the file (e.g. partially downloaded file on resume)
+     * @return false if file can't be read, hash state is undefined then and must be reset
+     */
+    bool updateFromFile(const std::string &path);
+
+    /// Lowercase hex digest of the data fed so far, stream can be continued afterwards
+    std::string hexDigest() const;
+
+    uint64_t size() const { return m_size; }
+
+private:
+    evp_md_ctx_st *m_ctx {nullptr};
+    uint64_t m_size {0};
+};
+
+/// Compare hex digests case-insensitively, empty expected digest never matches
+bool sha256Matches(std::string_view hexDigest, std::string_view expected);
+
+/// Shortened URL for logs, keeps @p keep characters of its start and end
+std::string elideUrl(const std::string &url, size_t keep = 20);
+
+/// Value for "Range" header requesting everything from @p offset up to the end
+std::string rangeHeaderFrom(int64_t offset);
+
+struct ContentRange {
+    int64_t first {0};
+    int64_t last {0};
+    int64_t total {-1}; // -1 if server sent "*"
+};
+
+/// Parse "Content-Range: bytes first-last/total" header value
+std::optional<ContentRange> parseContentRange(std::string_view value);
+
+/// Parse status code from status line "HTTP/1.1 206 Partial Content", 0 if not a status line
+int parseHttpStatusLine(std::string_view line);
+
+/**
+ * @brief Parse raw response header line "Key: value"
+ * @return pair of lowercase key and trimmed value, nullopt for status line or garbage
+ */
+std::optional<std::pair<std::string, std::string>> parseHttpHeaderLine(std::string_view line);
+
+/**
+ * @brief Split [0, totalSize) into at most @p segments inclusive byte ranges of similar size
+ * @return pairs of (first, last), empty if totalSize <= 0
+ */
+std::vector<std::pair<int64_t, int64_t>> splitByteRanges(int64_t totalSize, int segments);
+
+} // namespace detail
+} // namespace scorbit
@@ -20,6 +20,7 @@
 #include "jwt_parser.h"
 #include <logger/logger.h>
 #include <nlohmann/json.hpp>
+#include <algorithm>
 #include <sstream>
 #include <openssl/bio.h>
 #include <openssl/evp.h>
@@ -27,7 +28,9 @@
 namespace scorbit {
 namespace detail {
 
-std::optional<std::chrono::system_clock::time_point> parseJwtExpiration(const std::string &jwtToken)
+namespace {
+
+std::optional<nlohmann::json> parseJwtPayload(const std::string &jwtToken)
 {
     try {
         // JWT tokens have three parts separated by dots: header.payload.signature
@@ -78,24 +81,34 @@ std::optional<std::chrono::system_clock::time_point> parseJwtExpiration(const st
         }
 
         // Parse JSON payload
-        const auto json = nlohmann::json::parse(decodedPayload);
+        return nlohmann::json::parse(decodedPayload);
 
-        if (!json.contains("exp") || !json["exp"].is_number()) {
-            ERR("JWT token parsing failed: no expiration time found");
-            return std::nullopt;
-        }
+    } catch (const std::exception &e) {
+        ERR("JWT token parsing failed: {}", e.what());
+        return std::nullopt;
+    }
+}
 
-        // Convert Unix timestamp to system_clock time_point
-        const auto expTimestamp = json["exp"].get<int64_t>();
-        const auto expTime = std::chrono::system_clock::from_time_t(expTimestamp);
+} // namespace
 
-        INF("JWT token expires at: {}", expTimestamp);
-        return expTime;
+std::optional<std::chrono::system_clock::time_point> parseJwtExpiration(const std::string &jwtToken)
+{
+    const auto json = parseJwtPayload(jwtToken);
+    if (!json) {
+        return std::nullopt;
+    }
 
-    } catch (const std::exception &e) {
-        ERR("JWT token parsing failed: {}", e.what());
+    if (!json->contains("exp") || !(*json)["exp"].is_number()) {
+        ERR("JWT token parsing failed: no expiration time found");
         return std::nullopt;
     }
+
+    // Convert Unix timestamp to system_clock time_point
+    const auto expTimestamp = (*json)["exp"].get<int64_t>();
+    const auto expTime = std::chrono::system_clock::from_time_t(expTimestamp);
+
+    INF("JWT token expires at: {}", expTimestamp);
+    return expTime;
 }
 
 bool isJwtTokenExpired(const std::string &jwtToken)
@@ -124,5 +137,27 @@ std::optional<std::chrono::seconds> getJwtTokenTimeUntilExpiration(const std::st
     return std::chrono::duration_cast<std::chrono::seconds>(*expiration - now);
 }
 
+std::optional<std::chrono::seconds> getJwtTokenLifetime(const std::string &jwtToken)
+{
+    const auto json = parseJwtPayload(jwtToken);
+    if (!json) {
+        return std::nullopt;
+    }
+
+    const auto exp = json->find("exp");
+    if (exp == json->end() || !exp->is_number()) {
+        ERR("JWT token parsing failed: no expiration time found");
+        return std::nullopt;
+    }
+
+    // Both claims come from the issuer clock, local clock may be off by any amount
+    if (const auto iat = json->find("iat"); iat != json->end() && iat->is_number()) {
+        const auto lifetime = exp->get<int64_t>() - iat->get<int64_t>();
+        return std::chrono::seconds(std::max<int64_t>(lifetime, 0));
+    }
+
+    return getJwtTokenTimeUntilExpiration(jwtToken);
+}
+
 } // namespace detail
 } // namespace scorbit
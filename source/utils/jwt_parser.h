@@ -49,5 +49,13 @@ bool isJwtTokenExpired(const std::string &jwtToken);
  */
 std::optional<std::chrono::seconds> getJwtTokenTimeUntilExpiration(const std::string &jwtToken);
 
+/**
+ * @brief Get how long JWT token is valid since it was issued
+ * @param jwtToken The JWT token string
+ * @return exp - iat, so it doesn't depend on the local clock, time until expiration if there is no
+ * iat claim, nullopt if parsing fails
+ */
+std::optional<std::chrono::seconds> getJwtTokenLifetime(const std::string &jwtToken);
+
 } // namespace detail
 } // namespace scorbit
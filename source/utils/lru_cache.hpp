@@ -21,16 +21,33 @@
 
 #include <unordered_map>
 #include <list>
+#include <cstddef>
+#include <utility>
 
 namespace scorbit {
 namespace detail {
 
-template<typename Key, typename Value>
+/// Default cost of the cache entry, so capacity is the number of entries
+struct LRUUnitCost {
+    template<typename Value>
+    size_t operator()(const Value &) const
+    {
+        return 1;
+    }
+};
+
+/**
+ * Least recently used cache. Capacity is the total cost of all entries, the cost of the entry is
+ * given by @p Cost functor (e.g. size in bytes). Entry which alone costs more than capacity is
+ * not cached.
+ */
+template<typename Key, typename Value, typename Cost = LRUUnitCost>
 class LRUCache
 {
 public:
-    LRUCache(size_t capacity)
+    LRUCache(size_t capacity, Cost cost = {})
         : m_capacity(capacity)
+        , m_costFn(std::move(cost))
     {
     }
 
@@ -46,28 +63,35 @@ public:
             return false;
 
         // Move key to front (most recently used)
-        m_usage.splice(m_usage.begin(), m_usage, it->second.second);
-        value = it->second.first;
+        m_usage.splice(m_usage.begin(), m_usage, it->second.usageIt);
+        value = it->second.value;
         return true;
     }
 
     template<typename V>
     void put(const Key &key, V &&value)
     {
+        const auto cost = m_costFn(value);
+
         auto it = m_cache.find(key);
         if (it != m_cache.end()) {
             // Update value and move to front
-            it->second.first = std::forward<V>(value);
-            m_usage.splice(m_usage.begin(), m_usage, it->second.second);
+            m_totalCost -= it->second.cost;
+            it->second.value = std::forward<V>(value);
+            it->second.cost = cost;
+            m_totalCost += cost;
+            m_usage.splice(m_usage.begin(), m_usage, it->second.usageIt);
         } else {
             // New entry
-            if (m_cache.size() == m_capacity) {
-                auto last = m_usage.back();
-                m_usage.pop_back();
-                m_cache.erase(last);
-            }
             m_usage.push_front(key);
-            m_cache[key] = {std::forward<V>(value), m_usage.begin()};
+            m_cache[key] = {std::forward<V>(value), m_usage.begin(), cost};
+            m_totalCost += cost;
+        }
+
+        // Evict least recently used, the new entry is evicted last if it doesn't fit at all
+        while (m_totalCost > m_capacity && !m_usage.empty()) {
+            const Key last = m_usage.back();
+            erase(last);
         }
     }
 
@@ -75,15 +99,36 @@ public:
     {
         auto it = m_cache.find(key);
         if (it != m_cache.end()) {
-            m_usage.erase(it->second.second);
+            m_totalCost -= it->second.cost;
+            m_usage.erase(it->second.usageIt);
             m_cache.erase(it);
         }
     }
 
+    /// Visit all entries in place, usage order and costs are not updated
+    template<typename Fn>
+    void forEach(Fn &&fn)
+    {
+        for (auto &[key, entry] : m_cache) {
+            fn(key, entry.value);
+        }
+    }
+
+    size_t size() const { return m_cache.size(); }
+    size_t totalCost() const { return m_totalCost; }
+
 private:
+    struct Entry {
+        Value value;
+        typename std::list<Key>::iterator usageIt;
+        size_t cost;
+    };
+
     size_t m_capacity;
+    size_t m_totalCost {0};
+    Cost m_costFn;
     std::list<Key> m_usage;
-    std::unordered_map<Key, std::pair<Value, typename std::list<Key>::iterator>> m_cache;
+    std::unordered_map<Key, Entry> m_cache;
 };
 
 } // namespace detail
@@ -0,0 +1,142 @@
+/*
+ * Scorbit SDK
+ *
+ * (c) 2025 Spinner Systems, Inc. (DBA Scorbit), scrobit.io, All Rights Reserved
+ *
+ * MIT License
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "mapped_file.h"
+
+#ifdef _WIN32
+#    include <fstream>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+namespace scorbit {
+namespace detail {
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+#ifdef _WIN32
+
+bool MappedFile::open(const std::string &path, size_t size)
+{
+    close();
+
+    m_buffer.assign(size, 0);
+    if (std::ifstream file {path, std::ios::binary}) {
+        file.read(reinterpret_cast<char *>(m_buffer.data()), static_cast<std::streamsize>(size));
+    }
+
+    m_path = path;
+    m_data = m_buffer.data();
+    m_size = size;
+    flush(); // Create the file right away, so failure is reported by open()
+
+    std::ifstream check {path, std::ios::binary};
+    if (!check) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (m_data) {
+        flush();
+    }
+    m_data = nullptr;
+    m_size = 0;
+    m_buffer.clear();
+    m_path.clear();
+}
+
+void MappedFile::flush()
+{
+    if (!m_data) {
+        return;
+    }
+
+    std::ofstream file {m_path, std::ios::binary | std::ios::trunc};
+    file.write(reinterpret_cast<const char *>(m_data), static_cast<std::streamsize>(m_size));
+}
+
+#else
+
+bool MappedFile::open(const std::string &path, size_t size)
+{
+    close();
+
+    if (size == 0) {
+        return false;
+    }
+
+    const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat st {};
+    if (::fstat(fd, &st) != 0
+        || (static_cast<size_t>(st.st_size) != size
+            && ::ftruncate(fd, static_cast<off_t>(size)) != 0)) {
+        ::close(fd);
+        return false;
+    }
+
+    void *addr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED) {
+        ::close(fd);
+        return false;
+    }
+
+    m_fd = fd;
+    m_data = static_cast<uint8_t *>(addr);
+    m_size = size;
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (m_data) {
+        ::munmap(m_data, m_size);
+    }
+    if (m_fd >= 0) {
+        ::close(m_fd);
+    }
+    m_data = nullptr;
+    m_size = 0;
+    m_fd = -1;
+}
+
+void MappedFile::flush()
+{
+    if (m_data) {
+        ::msync(m_data, m_size, MS_ASYNC);
+    }
+}
+
+#endif
+
+} // namespace detail
+} // namespace scorbit
@@ -0,0 +1,68 @@
+/*
+ * Scorbit SDK
+ *
+ * (c) 2025 Spinner Systems, Inc. (DBA Scorbit), scrobit.io, All Rights Reserved
+ *
+ * MIT License
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace scorbit {
+namespace detail {
+
+/**
+ * @brief File mapped to memory, writes to data() land in the file without explicit I/O.
+ *
+ * Without mmap (Windows) the content is kept in memory and written back by flush() and close().
+ */
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    /// Map @p path resized to @p size bytes, the file is created if missing, new bytes are zero
+    bool open(const std::string &path, size_t size);
+    void close();
+
+    /// Schedule write of modified pages, doesn't wait for the disk
+    void flush();
+
+    bool isOpen() const { return m_data != nullptr; }
+    uint8_t *data() { return m_data; }
+    const uint8_t *data() const { return m_data; }
+    size_t size() const { return m_size; }
+
+private:
+    uint8_t *m_data {nullptr};
+    size_t m_size {0};
+#ifdef _WIN32
+    std::string m_path;
+    std::vector<uint8_t> m_buffer;
+#else
+    int m_fd {-1};
+#endif
+};
+
+} // namespace detail
+} // namespace scorbit
@@ -0,0 +1,206 @@
+/*
+ * Scorbit SDK
+ *
+ * (c) 2025 Spinner Systems, Inc. (DBA Scorbit), scrobit.io, All Rights Reserved
+ *
+ * MIT License
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "warm_start_cache.h"
+#include "utils/download_range.h"
+
+#include <logger/logger.h>
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+#include <fcntl.h>
+#ifdef _WIN32
+#    include <io.h>
+#else
+#    include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace scorbit {
+namespace detail {
+
+namespace {
+
+// First line is "<magic> <sha256 of the rest>", the rest is JSON document
+constexpr std::string_view WARM_START_MAGIC = "SBWS1";
+constexpr auto JKEY_IDENTITY = "identity";
+constexpr auto JKEY_SECTIONS = "sections";
+
+std::string sha256(std::string_view data)
+{
+    Sha256Stream hasher;
+    hasher.update(data);
+    return hasher.hexDigest();
+}
+
+// Flush file contents, or directory entries, from OS cache to the storage
+bool syncToStorage(const fs::path &path)
+{
+#ifdef _WIN32
+    // Rename is journaled by NTFS and directories can't be flushed this way
+    if (fs::is_directory(path)) {
+        return true;
+    }
+    const int fd = _wopen(path.c_str(), _O_RDWR | _O_BINARY);
+    if (fd < 0) {
+        return false;
+    }
+    const bool ok = _commit(fd) == 0;
+    _close(fd);
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    const bool ok = ::fsync(fd) == 0;
+    ::close(fd);
+#endif
+    return ok;
+}
+
+} // namespace
+
+bool WarmStartCache::open(const std::string &path, const std::string &identity)
+{
+    std::scoped_lock lock(m_mutex);
+    m_path = path;
+    m_identity = identity;
+    m_sections = nlohmann::json::object();
+    m_provisional.clear();
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        DBG("Warm start cache {} not found", path);
+        return false;
+    }
+    const std::string content {std::istreambuf_iterator<char>(file),
+                               std::istreambuf_iterator<char>()};
+
+    const auto lineEnd = content.find('\n');
+    const auto header = std::string_view {content}.substr(0, lineEnd);
+    if (lineEnd == std::string::npos || !header.starts_with(WARM_START_MAGIC)
+        || header.size() <= WARM_START_MAGIC.size() + 1) {
+        WRN("Warm start cache {} has unknown format, ignored", path);
+        return false;
+    }
+
+    const auto body = std::string_view {content}.substr(lineEnd + 1);
+    if (!sha256Matches(sha256(body), header.substr(WARM_START_MAGIC.size() + 1))) {
+        WRN("Warm start cache {} is corrupted, ignored", path);
+        return false;
+    }
+
+    try {
+        auto document = nlohmann::json::parse(body);
+        if (document.value(JKEY_IDENTITY, std::string {}) != identity) {
+            INF("Warm start cache {} belongs to another machine or server, ignored", path);
+            return false;
+        }
+
+        auto &sections = document.at(JKEY_SECTIONS);
+        if (!sections.is_object()) {
+            WRN("Warm start cache {} has no sections, ignored", path);
+            return false;
+        }
+        m_sections = std::move(sections);
+    } catch (const std::exception &e) {
+        WRN("Warm start cache {} parse error: {}", path, e.what());
+        return false;
+    }
+
+    for (const auto &[section, value] : m_sections.items()) {
+        m_provisional.insert(section);
+    }
+    INF("Warm start cache {} loaded, {} sections", path, m_provisional.size());
+    return true;
+}
+
+std::optional<nlohmann::json> WarmStartCache::provisional(const std::string &section) const
+{
+    std::scoped_lock lock(m_mutex);
+    if (!m_provisional.contains(section)) {
+        return std::nullopt;
+    }
+    return m_sections.at(section);
+}
+
+bool WarmStartCache::confirm(const std::string &section, const nlohmann::json &value)
+{
+    std::scoped_lock lock(m_mutex);
+    const bool wasProvisional = m_provisional.erase(section) > 0;
+    const auto it = m_sections.find(section);
+    const bool changed = it == m_sections.end() || *it != value;
+
+    if (changed && !m_path.empty()) {
+        m_sections[section] = value;
+        if (!save()) {
+            WRN("Warm start cache {} can't be written", m_path);
+        }
+    }
+
+    if (wasProvisional && !changed) {
+        DBG("Warm start cache section {} confirmed unchanged", section);
+        return false;
+    }
+    return true;
+}
+
+bool WarmStartCache::isOpen() const
+{
+    std::scoped_lock lock(m_mutex);
+    return !m_path.empty();
+}
+
+bool WarmStartCache::save() const
+{
+    const auto body = nlohmann::json {
+            {JKEY_IDENTITY, m_identity},
+            {JKEY_SECTIONS, m_sections},
+    }.dump();
+
+    // Written aside, synced and renamed, so power loss leaves either the old or the new file
+    const auto tempPath = m_path + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        file << WARM_START_MAGIC << ' ' << sha256(body) << '\n' << body;
+        file.close();
+        if (!file || !syncToStorage(tempPath)) {
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    fs::rename(tempPath, m_path, ec);
+    if (ec) {
+        return false;
+    }
+
+    // Rename itself is durable only after the directory is flushed
+    const auto dir = fs::path(m_path).parent_path();
+    if (!syncToStorage(dir.empty() ? fs::path(".") : dir)) {
+        DBG("Warm start cache dir {} can't be synced", dir.string());
+    }
+    return true;
+}
+
+} // namespace detail
+} // namespace scorbit
@@ -0,0 +1,81 @@
+/*
+ * Scorbit SDK
+ *
+ * (c) 2025 Spinner Systems, Inc. (DBA Scorbit), scrobit.io, All Rights Reserved
+ *
+ * MIT License
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <nlohmann/json.hpp>
+
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+
+namespace scorbit {
+namespace detail {
+
+constexpr auto WARM_START_MACHINE = "machine";
+constexpr auto WARM_START_SCORBITRON_OBJECT = "scorbitron_object";
+constexpr auto WARM_START_CONFIG = "config";
+constexpr auto WARM_START_SHORT_CODE = "short_code";
+
+/**
+ * @brief Machine state saved by the previous run, served at startup until the server confirms it.
+ *
+ * The state is a set of named JSON sections, e.g. machine info or the last config reply. Sections
+ * loaded from the file are provisional. When the server reply for a section arrives, confirm()
+ * compares it with the provisional one, so events are only emitted when something changed.
+ *
+ * The file is bound to an identity (scorbitron uuid and hostname) and protected by SHA-256, a
+ * truncated, corrupted or foreign file is ignored. It's replaced atomically and only written when
+ * a section changes. Without a file the cache does nothing. Thread-safe.
+ */
+class WarmStartCache
+{
+public:
+    /**
+     * Load sections saved in @p path for @p identity, confirmed sections are saved there.
+     * @return false if there is no usable cache, the file is replaced by the next save then
+     */
+    bool open(const std::string &path, const std::string &identity);
+
+    /// Section loaded at startup which is not confirmed yet
+    std::optional<nlohmann::json> provisional(const std::string &section) const;
+
+    /**
+     * Store server's @p value of @p section, the file is updated if it differs from stored one.
+     * @return true if the change has to be announced: @p value differs from the provisional
+     * section or the section was not provisional (not loaded, or confirmed already)
+     */
+    bool confirm(const std::string &section, const nlohmann::json &value);
+
+    /// Cache has a file, it may still be empty
+    bool isOpen() const;
+
+private:
+    bool save() const;
+
+    mutable std::mutex m_mutex;
+    std::string m_path;
+    std::string m_identity;
+    nlohmann::json m_sections = nlohmann::json::object();
+    std::set<std::string, std::less<>> m_provisional;
+};
+
+} // namespace detail
+} // namespace scorbit
@@ -26,6 +26,8 @@ constexpr auto NUM_OF_THREADS = 4;
 using namespace scorbit::detail;
 using namespace std::chrono_literals;
 
+constexpr auto TIMER_LOG_INTERVAL = 10s; // Short timers are stopped and restarted all the time
+
 // Define custom formatter
 template<>
 struct fmt::formatter<Worker::Timer> : fmt::formatter<std::string_view> {
@@ -60,6 +62,12 @@ struct fmt::formatter<Worker::Timer> : fmt::formatter<std::string_view> {
         case Worker::Timer::LeaderboardDeferred:
             name = "LeaderboardDeferred";
             break;
+        case Worker::Timer::LeaderboardPrefetch:
+            name = "LeaderboardPrefetch";
+            break;
+        case Worker::Timer::CentrifugoToken:
+            name = "CentrifugoToken";
+            break;
         case Worker::Timer::Count:
             break;
         }
@@ -82,6 +90,8 @@ Worker::Worker(int threadNiceValue)
               boost::asio::steady_timer {m_ioc},
               boost::asio::steady_timer {m_ioc},
               boost::asio::steady_timer {m_ioc},
+              boost::asio::steady_timer {m_ioc},
+              boost::asio::steady_timer {m_ioc},
       }}
 {
 }
@@ -169,7 +179,7 @@ void Worker::startTimer(Timer timerType, std::chrono::steady_clock::duration del
         if (!ec) {
             func();
         } else if (ec == boost::asio::error::operation_aborted) {
-            DBG("Timer {} cancelled", timerType);
+            DBG_EVERY(TIMER_LOG_INTERVAL, "Timer {} cancelled", timerType);
         } else {
             ERR("Timer error: {}", ec.to_string());
         }
@@ -183,7 +193,7 @@ void Worker::stopTimer(Timer timerType)
         return;
     }
 
-    DBG("Timer {} stopped", timerType);
+    DBG_EVERY(TIMER_LOG_INTERVAL, "Timer {} stopped", timerType);
 
     try {
         timer->cancel();
@@ -46,6 +46,8 @@ public:
         NfcBootReason,
         ModeExpiry,
         LeaderboardDeferred,
+        LeaderboardPrefetch,
+        CentrifugoToken,
 
         // IMPORTANT! This must be last entry!
         Count,
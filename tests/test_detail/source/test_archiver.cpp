@@ -19,9 +19,12 @@
 
 #include <utils/archiver.h>
 
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <boost/filesystem.hpp>
 #include <fstream>
+#include <random>
+#include <regex>
 
 using namespace scorbit::detail;
 namespace fs = boost::filesystem;
@@ -53,6 +56,27 @@ private:
     fs::path m_path;
 };
 
+std::string readFile(const fs::path &path)
+{
+    std::ifstream ifs(path.string(), std::ios::binary);
+    return {(std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>()};
+}
+
+/// Log-like content, compresses about as well as real logs
+std::string makeLog(size_t size, unsigned seed = 1)
+{
+    std::mt19937 random(seed);
+    std::string log;
+    log.reserve(size + 128);
+    while (log.size() < size) {
+        log += "[2026-04-01 10:00:00.123] [info] API GET request to https://api.scorbit.io/ OK, ";
+        log += std::to_string(random());
+        log += '\n';
+    }
+    log.resize(size);
+    return log;
+}
+
 } // namespace
 
 TEST_CASE("createTarGz with file entries")
@@ -200,3 +224,167 @@ TEST_CASE("createTarGz edge cases")
         CHECK(createTarGz(archivePath, files));
     }
 }
+
+TEST_CASE("createTarGz reads large files in chunks")
+{
+    TempDir tmpDir;
+
+    const auto content = makeLog(1024 * 1024 + 123);
+    auto srcPath = tmpDir.createFile("large.log", content);
+    auto extractDir = tmpDir.path() / "extracted";
+
+    SECTION("gzip")
+    {
+        auto archivePath = (tmpDir.path() / "large.tar.gz").string();
+        REQUIRE(createTarGz(archivePath, {{"logs/large.log", srcPath}}, {},
+                            ArchiveOptions {ArchiveCompression::Gzip, 1}));
+        REQUIRE(extract(archivePath, extractDir.string()));
+        CHECK(readFile(extractDir / "logs" / "large.log") == content);
+    }
+
+    SECTION("zstd with threads")
+    {
+        auto archivePath = (tmpDir.path() / "large.tar.zst").string();
+        REQUIRE(createTarGz(archivePath, {{"logs/large.log", srcPath}}, {},
+                            ArchiveOptions {ArchiveCompression::Zstd, 3, 2}));
+        REQUIRE(extract(archivePath, extractDir.string()));
+        CHECK(readFile(extractDir / "logs" / "large.log") == content);
+    }
+}
+
+TEST_CASE("ArchiveStream produces the archive while it is read")
+{
+    TempDir tmpDir;
+
+    const auto content = makeLog(3 * 1024 * 1024);
+    auto srcPath = tmpDir.createFile("stream.log", content);
+    auto archiveContent = std::make_shared<ArchiveContent>();
+    archiveContent->files = {{"logs/stream.log", srcPath}};
+    archiveContent->memoryEntries = {{"logs/extra.log", "extra content"}};
+
+    SECTION("Read to the end")
+    {
+        auto archivePath = tmpDir.path() / "stream.tar.gz";
+        {
+            ArchiveStream stream(archiveContent, {});
+            std::ofstream ofs(archivePath.string(), std::ios::binary);
+            char buffer[16 * 1024];
+            for (size_t size; (size = stream.read(buffer, sizeof(buffer))) > 0;) {
+                ofs.write(buffer, static_cast<std::streamsize>(size));
+            }
+            CHECK(stream.succeeded());
+        }
+
+        auto extractDir = tmpDir.path() / "extracted";
+        REQUIRE(extract(archivePath.string(), extractDir.string()));
+        CHECK(readFile(extractDir / "logs" / "stream.log") == content);
+        CHECK(readFile(extractDir / "logs" / "extra.log") == "extra content");
+    }
+
+    SECTION("Destroyed before the end")
+    {
+        ArchiveStream stream(archiveContent, {});
+        char buffer[1024];
+        CHECK(stream.read(buffer, sizeof(buffer)) > 0);
+        CHECK_FALSE(stream.succeeded());
+    }
+}
+
+TEST_CASE("ArchiveExtractor extracts matching files while the archive is written")
+{
+    TempDir tmp;
+    const auto binary = makeLog(300'000, 3);
+    const auto archivePath = (tmp.path() / "update.tar.gz").string();
+    REQUIRE(createTarGz(archivePath, {},
+                        {{"update/docs/readme.txt", "read me"},
+                         {"update/bin/scorbitd", binary},
+                         {"update/lib/libscorbit_sdk.so.1", "library"}}));
+    const auto archive = readFile(archivePath);
+    const auto outputDir = tmp.path() / "staging";
+
+    const std::regex re {R"(^scorbitd(\.exe)?$)"};
+    const auto filter = [&re](const std::string &name) { return std::regex_search(name, re); };
+
+    SECTION("Whole archive")
+    {
+        ArchiveExtractor extractor(outputDir.string(), filter);
+        for (size_t i = 0; i < archive.size(); i += 1000) {
+            REQUIRE(extractor.write(archive.data() + i, std::min<size_t>(1000, archive.size() - i)));
+        }
+        REQUIRE(extractor.finish());
+
+        REQUIRE(extractor.files() == std::vector<std::string> {(outputDir / "scorbitd").string()});
+        CHECK(readFile(outputDir / "scorbitd") == binary);
+        CHECK_FALSE(fs::exists(outputDir / "readme.txt"));
+        CHECK_FALSE(fs::exists(outputDir / "libscorbit_sdk.so.1"));
+        CHECK_FALSE(fs::exists(outputDir / "update"));
+    }
+
+    SECTION("Truncated archive")
+    {
+        ArchiveExtractor extractor(outputDir.string(), filter);
+        REQUIRE(extractor.write(archive.data(), archive.size() / 2));
+        CHECK_FALSE(extractor.finish());
+    }
+
+    SECTION("Not an archive")
+    {
+        ArchiveExtractor extractor(outputDir.string(), filter);
+        const std::string garbage(100'000, 'x');
+        extractor.write(garbage.data(), garbage.size());
+        CHECK_FALSE(extractor.finish());
+        CHECK_FALSE(extractor.write(garbage.data(), garbage.size()));
+    }
+
+    SECTION("Destroyed before the end")
+    {
+        ArchiveExtractor extractor(outputDir.string(), filter);
+        REQUIRE(extractor.write(archive.data(), archive.size() / 2));
+    }
+}
+
+TEST_CASE("Diagnostics archive benchmark", "[.][benchmark]")
+{
+    TempDir tmpDir;
+
+    // Largest payload uploadDiagnostics accepts: 5 logs of 10 MB and 2 recordings of 20 MB
+    std::vector<ArchiveFileEntry> files;
+    for (unsigned i = 0; i < 5; ++i) {
+        const auto name = "log" + std::to_string(i) + ".log";
+        files.push_back({"logs/" + name, tmpDir.createFile(name, makeLog(10 * 1024 * 1024, i))});
+    }
+    for (unsigned i = 0; i < 2; ++i) {
+        const auto name = "recording" + std::to_string(i) + ".bin";
+        files.push_back({"recordings/" + name,
+                         tmpDir.createFile(name, makeLog(20 * 1024 * 1024, 10 + i))});
+    }
+    const auto archivePath = (tmpDir.path() / "bench.tar").string();
+
+    BENCHMARK("gzip to file")
+    {
+        return createTarGz(archivePath, files);
+    };
+
+    BENCHMARK("gzip level 1 to file")
+    {
+        return createTarGz(archivePath, files, {}, ArchiveOptions {ArchiveCompression::Gzip, 1});
+    };
+
+    BENCHMARK("zstd 4 threads to file")
+    {
+        return createTarGz(archivePath, files, {},
+                           ArchiveOptions {ArchiveCompression::Zstd, 0, 4});
+    };
+
+    BENCHMARK("gzip streamed")
+    {
+        auto content = std::make_shared<ArchiveContent>(ArchiveContent {files, {}});
+        ArchiveStream stream(content, {});
+        std::vector<char> buffer(64 * 1024);
+        size_t total = 0;
+        for (size_t size; (size = stream.read(buffer.data(), buffer.size())) > 0;) {
+            total += size;
+        }
+        return total;
+    };
+}
@@ -0,0 +1,217 @@
+/*
+ * Scorbit SDK
+ *
+ * (c) 2025 Spinner Systems, Inc. (DBA Scorbit), scrobit.io, All Rights Reserved
+ *
+ * MIT License
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <utils/binary_patch.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <archive.h>
+#include <archive_entry.h>
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <limits>
+#include <random>
+
+using namespace scorbit::detail;
+namespace fs = boost::filesystem;
+
+namespace {
+
+struct Control {
+    int64_t diffSize;
+    int64_t extraSize;
+    int64_t seek;
+};
+
+std::string offtout(int64_t x)
+{
+    std::string buf(8, '\0');
+    auto y = static_cast<uint64_t>(x < 0 ? -x : x);
+    for (auto &c : buf) {
+        c = static_cast<char>(y & 0xFF);
+        y >>= 8;
+    }
+    if (x < 0) {
+        buf[7] = static_cast<char>(buf[7] | 0x80);
+    }
+    return buf;
+}
+
+/// What bsdiff writes for @p controls, which must describe @p newData
+std::string makePatchBody(const std::string &old, const std::string &newData,
+                          const std::vector<Control> &controls)
+{
+    std::string body;
+    int64_t oldPos = 0;
+    int64_t newPos = 0;
+    for (const auto &control : controls) {
+        body += offtout(control.diffSize) + offtout(control.extraSize) + offtout(control.seek);
+        for (int64_t i = 0; i < control.diffSize; ++i) {
+            const auto o = oldPos + i;
+            const char from = o >= 0 && o < static_cast<int64_t>(old.size()) ? old[o] : 0;
+            body += static_cast<char>(newData[newPos + i] - from);
+        }
+        newPos += control.diffSize;
+        oldPos += control.diffSize;
+        body += newData.substr(newPos, control.extraSize);
+        newPos += control.extraSize;
+        oldPos += control.seek;
+    }
+    return body;
+}
+
+std::string gzip(const std::string &data)
+{
+    std::string out(data.size() + 1024, '\0');
+    size_t used = 0;
+    auto *a = archive_write_new();
+    archive_write_add_filter_gzip(a);
+    archive_write_set_format_raw(a);
+    archive_write_open_memory(a, out.data(), out.size(), &used);
+    auto *entry = archive_entry_new();
+    archive_entry_set_filetype(entry, AE_IFREG);
+    archive_write_header(a, entry);
+    archive_write_data(a, data.data(), data.size());
+    archive_entry_free(entry);
+    archive_write_close(a);
+    archive_write_free(a);
+    out.resize(used);
+    return out;
+}
+
+std::string randomData(size_t size, unsigned seed)
+{
+    std::mt19937 random(seed);
+    std::string data(size, '\0');
+    for (auto &c : data) {
+        c = static_cast<char>(random());
+    }
+    return data;
+}
+
+class PatchFiles
+{
+public:
+    PatchFiles()
+        : m_dir(fs::temp_directory_path() / fs::unique_path("test_binary_patch_%%%%-%%%%"))
+    {
+        fs::create_directories(m_dir);
+    }
+    ~PatchFiles() { fs::remove_all(m_dir); }
+
+    std::string path(const std::string &name) const { return (m_dir / name).string(); }
+
+    std::string write(const std::string &name, const std::string &content) const
+    {
+        std::ofstream(path(name), std::ios::binary) << content;
+        return path(name);
+    }
+
+    std::string read(const std::string &name) const
+    {
+        std::ifstream ifs(path(name), std::ios::binary);
+        return {(std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>()};
+    }
+
+private:
+    fs::path m_dir;
+};
+
+} // namespace
+
+TEST_CASE("applyBinaryPatch")
+{
+    PatchFiles files;
+
+    // New version: few bytes changed, a block inserted, the tail moved
+    const auto old = randomData(300'000, 1);
+    const auto inserted = randomData(5000, 2);
+    auto newData = old.substr(0, 100'000) + inserted + old.substr(150'000);
+    newData[10] ^= 0x55;
+    newData[200'000] ^= 0x55;
+
+    const std::vector<Control> controls {
+            {100'000, 5000, 50'000},
+            {static_cast<int64_t>(old.size()) - 150'000, 0, 0},
+    };
+    const auto header = std::string {"ENDSLEY/BSDIFF43"} + offtout(newData.size());
+    const auto body = makePatchBody(old, newData, controls);
+    files.write("old", old);
+
+    SECTION("gzip compressed body")
+    {
+        files.write("patch", header + gzip(body));
+        REQUIRE(applyBinaryPatch(files.path("old"), files.path("patch"), files.path("new")));
+        CHECK(files.read("new") == newData);
+    }
+
+    SECTION("Uncompressed body")
+    {
+        files.write("patch", header + body);
+        REQUIRE(applyBinaryPatch(files.path("old"), files.path("patch"), files.path("new")));
+        CHECK(files.read("new") == newData);
+    }
+
+    SECTION("Truncated body")
+    {
+        files.write("patch", header + gzip(body.substr(0, body.size() / 2)));
+        CHECK_FALSE(applyBinaryPatch(files.path("old"), files.path("patch"), files.path("new")));
+    }
+
+    SECTION("Control past the end of the new file")
+    {
+        const auto tooLong = std::string {"ENDSLEY/BSDIFF43"} + offtout(1000);
+        files.write("patch", tooLong + gzip(body));
+        CHECK_FALSE(applyBinaryPatch(files.path("old"), files.path("patch"), files.path("new")));
+    }
+
+    SECTION("Sizes which overflow")
+    {
+        const auto max = std::numeric_limits<int64_t>::max();
+        files.write("patch", header + offtout(max) + offtout(max) + offtout(0));
+        CHECK_FALSE(applyBinaryPatch(files.path("old"), files.path("patch"), files.path("new")));
+
+        files.write("patch", header + offtout(10) + offtout(max - 5) + offtout(0) + body);
+        CHECK_FALSE(applyBinaryPatch(files.path("old"), files.path("patch"), files.path("new")));
+    }
+
+    SECTION("Seek outside the old file")
+    {
+        const auto max = std::numeric_limits<int64_t>::max();
+        for (const int64_t seek : std::initializer_list<int64_t> {-100'001, 200'001, max}) {
+            auto badSeek = makePatchBody(old, newData, {{100'000, 5000, 0}});
+            badSeek.replace(16, 8, offtout(seek)); // Seek of the first control
+            files.write("patch", header + gzip(badSeek));
+            CHECK_FALSE(applyBinaryPatch(files.path("old"), files.path("patch"),
+                                         files.path("new")));
+        }
+    }
+
+    SECTION("Not a patch")
+    {
+        files.write("patch", "BSDIFF40" + body);
+        CHECK_FALSE(applyBinaryPatch(files.path("old"), files.path("patch"), files.path("new")));
+    }
+
+    SECTION("Missing old file")
+    {
+        files.write("patch", header + gzip(body));
+        CHECK_FALSE(applyBinaryPatch(files.path("missing"), files.path("patch"),
+                                     files.path("new")));
+    }
+}
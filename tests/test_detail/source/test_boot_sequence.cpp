@@ -0,0 +1,354 @@
+/*
+ * Scorbit SDK
+ *
+ * (c) 2025 Spinner Systems, Inc. (DBA Scorbit), scrobit.io, All Rights Reserved
+ *
+ * MIT License
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "boot_sequence.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace scorbit::detail;
+using namespace std::chrono_literals;
+
+namespace {
+
+// Runs each task on its own thread, like requests posted to the worker pool
+class ThreadExecutor
+{
+public:
+    ~ThreadExecutor() { join(); }
+
+    BootSequence::Executor executor()
+    {
+        return [this](std::function<void()> task) {
+            std::scoped_lock lock(m_mutex);
+            m_threads.emplace_back(std::move(task));
+        };
+    }
+
+    void join()
+    {
+        for (;;) {
+            std::thread thread;
+            {
+                std::scoped_lock lock(m_mutex);
+                if (m_threads.empty()) {
+                    return;
+                }
+                thread = std::move(m_threads.front());
+                m_threads.pop_front();
+            }
+            thread.join();
+        }
+    }
+
+private:
+    std::mutex m_mutex;
+    std::deque<std::thread> m_threads;
+};
+
+// Runs tasks inline, the order is deterministic
+BootSequence::Executor inlineExecutor()
+{
+    return [](std::function<void()> task) { task(); };
+}
+
+const BootStepTiming &step(const BootMetrics &metrics, const std::string &name)
+{
+    for (const auto &s : metrics.steps) {
+        if (s.name == name) {
+            return s;
+        }
+    }
+    FAIL("No boot step " << name);
+    return metrics.steps.front();
+}
+
+// Stand-in for the API: each endpoint replies after its latency
+struct FakeApi {
+    std::map<std::string, std::chrono::milliseconds> latency;
+
+    BootSequence::Step request(const std::string &endpoint) const
+    {
+        return [delay = latency.at(endpoint)](BootSequence::Done done) {
+            std::this_thread::sleep_for(delay);
+            done(true);
+        };
+    }
+
+    ConnectionSteps connectionSteps() const
+    {
+        return {
+                .scorbitronObject = request("scorbitron_object"),
+                .cfToken = request("cf_token"),
+                .config = request("config"),
+                .machineObject = request("machine_object"),
+                .releaseTrack = request("release_track"),
+                .nfcNonces = request("nfc_nonces"),
+                .centrifugo = request("centrifugo"),
+        };
+    }
+};
+
+} // namespace
+
+TEST_CASE("BootSequence runs steps after their dependencies", "[BootSequence]")
+{
+    std::vector<std::string> order;
+    auto boot = std::make_shared<BootSequence>(inlineExecutor());
+    const auto record = [&order](std::string name) {
+        return [&order, name](BootSequence::Done done) {
+            order.push_back(name);
+            done(true);
+        };
+    };
+
+    REQUIRE(boot->add("a", {}, record("a")));
+    REQUIRE(boot->add("b", {"a"}, record("b")));
+    REQUIRE(boot->add("c", {"a"}, record("c")));
+    REQUIRE(boot->add("d", {"b", "c"}, record("d")));
+
+    bool ready = false;
+    boot->start([&ready](const BootMetrics &metrics) {
+        ready = true;
+        CHECK(metrics.ready);
+    });
+
+    CHECK(ready);
+    CHECK(order == std::vector<std::string> {"a", "b", "c", "d"});
+    for (const auto &s : boot->metrics().steps) {
+        CHECK(s.result == BootStepTiming::Result::Ok);
+    }
+}
+
+TEST_CASE("BootSequence waits for asynchronous done", "[BootSequence]")
+{
+    BootSequence::Done pending;
+    bool dependentRan = false;
+    bool ready = false;
+    auto boot = std::make_shared<BootSequence>(inlineExecutor());
+    REQUIRE(boot->add("request", {}, [&pending](BootSequence::Done done) { pending = done; }));
+    REQUIRE(boot->add("after", {"request"}, [&dependentRan](BootSequence::Done done) {
+        dependentRan = true;
+        done(true);
+    }));
+
+    boot->start([&ready](const BootMetrics &) { ready = true; });
+    CHECK_FALSE(dependentRan);
+    CHECK_FALSE(ready);
+    CHECK_FALSE(boot->metrics().ready);
+
+    pending(true);
+    pending(false); // Only the first call counts
+    CHECK(dependentRan);
+    CHECK(ready);
+    CHECK(step(boot->metrics(), "request").result == BootStepTiming::Result::Ok);
+}
+
+TEST_CASE("BootSequence skips dependents of failed step", "[BootSequence]")
+{
+    bool skippedRan = false;
+    bool independentRan = false;
+    auto boot = std::make_shared<BootSequence>(inlineExecutor());
+    REQUIRE(boot->add("fails", {}, [](BootSequence::Done done) { done(false); }));
+    REQUIRE(boot->add("throws", {}, [](BootSequence::Done) { throw std::runtime_error("x"); }));
+    REQUIRE(boot->add("dependent", {"fails"}, [&skippedRan](BootSequence::Done done) {
+        skippedRan = true;
+        done(true);
+    }));
+    REQUIRE(boot->add("transitive", {"dependent", "throws"}, [](BootSequence::Done done) {
+        done(true);
+    }));
+    REQUIRE(boot->add("independent", {}, [&independentRan](BootSequence::Done done) {
+        independentRan = true;
+        done(true);
+    }));
+
+    bool ready = false;
+    boot->start([&ready](const BootMetrics &) { ready = true; });
+
+    CHECK(ready);
+    CHECK_FALSE(skippedRan);
+    CHECK(independentRan);
+    const auto metrics = boot->metrics();
+    CHECK(step(metrics, "fails").result == BootStepTiming::Result::Failed);
+    CHECK(step(metrics, "throws").result == BootStepTiming::Result::Failed);
+    CHECK(step(metrics, "dependent").result == BootStepTiming::Result::Skipped);
+    CHECK(step(metrics, "transitive").result == BootStepTiming::Result::Skipped);
+    CHECK(step(metrics, "independent").result == BootStepTiming::Result::Ok);
+}
+
+TEST_CASE("BootSequence validates steps", "[BootSequence]")
+{
+    auto boot = std::make_shared<BootSequence>(inlineExecutor());
+    const auto noop = [](BootSequence::Done done) { done(true); };
+
+    CHECK(boot->add("a", {}, noop));
+    CHECK_FALSE(boot->add("a", {}, noop));
+    CHECK_FALSE(boot->add("b", {"unknown"}, noop));
+    CHECK_FALSE(boot->addFinished("a", std::chrono::steady_clock::now()));
+    CHECK(boot->metrics().steps.size() == 1);
+
+    boot->start();
+    CHECK_FALSE(boot->add("late", {}, noop));
+    CHECK(boot->metrics().ready);
+}
+
+TEST_CASE("BootSequence counts finished steps into time to ready", "[BootSequence]")
+{
+    auto boot = std::make_shared<BootSequence>(inlineExecutor());
+    REQUIRE(boot->addFinished("auth", std::chrono::steady_clock::now() - 200ms));
+    REQUIRE(boot->addFinished("failed", std::chrono::steady_clock::now(), false));
+    REQUIRE(boot->add("after_auth", {"auth"}, [](BootSequence::Done done) { done(true); }));
+    REQUIRE(boot->add("after_failed", {"failed"}, [](BootSequence::Done done) { done(true); }));
+
+    boot->start();
+
+    const auto metrics = boot->metrics();
+    CHECK(metrics.ready);
+    CHECK(metrics.timeToReady >= 200ms);
+    CHECK(step(metrics, "auth").startedAt == 0ms);
+    CHECK(step(metrics, "auth").duration >= 200ms);
+    CHECK(step(metrics, "after_auth").result == BootStepTiming::Result::Ok);
+    CHECK(step(metrics, "after_failed").result == BootStepTiming::Result::Skipped);
+}
+
+TEST_CASE("BootSequence time to ready is its critical path", "[BootSequence]")
+{
+    const FakeApi api {.latency = {
+                               {"scorbitron_object", 150ms},
+                               {"cf_token", 100ms},
+                               {"config", 100ms},
+                               {"machine_object", 100ms},
+                               {"release_track", 100ms},
+                               {"nfc_nonces", 100ms},
+                               {"centrifugo", 50ms},
+                       }};
+    std::chrono::milliseconds serial {0};
+    for (const auto &[endpoint, latency] : api.latency) {
+        serial += latency;
+    }
+
+    ThreadExecutor threads;
+    auto boot = makeConnectionBoot(threads.executor(), std::chrono::steady_clock::now(),
+                                   api.connectionSteps());
+    REQUIRE(boot->metrics().steps.size() == 8);
+
+    std::promise<BootMetrics> ready;
+    boot->start([&ready](const BootMetrics &metrics) { ready.set_value(metrics); });
+    auto future = ready.get_future();
+    REQUIRE(future.wait_for(5s) == std::future_status::ready);
+    const auto metrics = future.get();
+    threads.join();
+
+    // Critical path is scorbitron_object then one of its dependents: 250 ms, serial is 700 ms
+    CHECK(metrics.ready);
+    CHECK(metrics.timeToReady >= 250ms);
+    CHECK(metrics.timeToReady < serial - 200ms);
+    CHECK(step(metrics, "cf_token").startedAt < step(metrics, "scorbitron_object").duration);
+    CHECK(step(metrics, "config").startedAt < step(metrics, "scorbitron_object").duration);
+    CHECK(step(metrics, "machine_object").startedAt >= 150ms);
+    for (const auto &s : metrics.steps) {
+        CHECK(s.result == BootStepTiming::Result::Ok);
+    }
+}
+
+TEST_CASE("Failed Scorbitron object doesn't hold back config and NFC nonces", "[BootSequence]")
+{
+    const FakeApi api {.latency = {
+                               {"scorbitron_object", 0ms},
+                               {"cf_token", 0ms},
+                               {"config", 0ms},
+                               {"machine_object", 0ms},
+                               {"release_track", 0ms},
+                               {"nfc_nonces", 0ms},
+                               {"centrifugo", 0ms},
+                       }};
+    auto steps = api.connectionSteps();
+    steps.scorbitronObject = [](BootSequence::Done done) { done(false); };
+
+    auto boot = makeConnectionBoot(inlineExecutor(), std::chrono::steady_clock::now(),
+                                   std::move(steps));
+    boot->start();
+
+    const auto metrics = boot->metrics();
+    CHECK(metrics.ready);
+    CHECK(step(metrics, "scorbitron_object").result == BootStepTiming::Result::Failed);
+    CHECK(step(metrics, "config").result == BootStepTiming::Result::Ok);
+    CHECK(step(metrics, "nfc_nonces").result == BootStepTiming::Result::Ok);
+    CHECK(step(metrics, "centrifugo").result == BootStepTiming::Result::Ok);
+    CHECK(step(metrics, "machine_object").result == BootStepTiming::Result::Skipped);
+    CHECK(step(metrics, "release_track").result == BootStepTiming::Result::Skipped);
+}
+
+TEST_CASE("Failed Centrifugo token fetch doesn't hold back Centrifugo", "[BootSequence]")
+{
+    const FakeApi api {.latency = {
+                               {"scorbitron_object", 0ms},
+                               {"cf_token", 0ms},
+                               {"config", 0ms},
+                               {"machine_object", 0ms},
+                               {"release_track", 0ms},
+                               {"nfc_nonces", 0ms},
+                               {"centrifugo", 0ms},
+                       }};
+    auto steps = api.connectionSteps();
+    steps.cfToken = [](BootSequence::Done done) { done(false); };
+    bool centrifugoStarted = false;
+    steps.centrifugo = [&centrifugoStarted](BootSequence::Done done) {
+        centrifugoStarted = true;
+        done(true);
+    };
+
+    auto boot = makeConnectionBoot(inlineExecutor(), std::chrono::steady_clock::now(),
+                                   std::move(steps));
+    boot->start();
+
+    const auto metrics = boot->metrics();
+    CHECK(metrics.ready);
+    CHECK(centrifugoStarted);
+    CHECK(step(metrics, "cf_token").result == BootStepTiming::Result::Failed);
+    CHECK(step(metrics, "centrifugo").result == BootStepTiming::Result::Ok);
+}
+
+TEST_CASE("BootSequence runs steps added to run anyway after failed dependency",
+          "[BootSequence]")
+{
+    auto boot = std::make_shared<BootSequence>(inlineExecutor());
+    REQUIRE(boot->addFinished("failed", std::chrono::steady_clock::now(), false));
+    REQUIRE(boot->add("fails", {}, [](BootSequence::Done done) { done(false); }));
+    REQUIRE(boot->add("anyway", {"failed", "fails"}, [](BootSequence::Done done) { done(true); },
+                      true));
+    REQUIRE(boot->add("skipped", {"fails"}, [](BootSequence::Done done) { done(true); }));
+
+    boot->start();
+
+    const auto metrics = boot->metrics();
+    CHECK(metrics.ready);
+    CHECK(step(metrics, "anyway").result == BootStepTiming::Result::Ok);
+    CHECK(step(metrics, "skipped").result == BootStepTiming::Result::Skipped);
+}
@@ -34,3 +34,24 @@ TEST_CASE("parseHttpDateToUnixTimestamp - Invalid Dates") {
     CHECK(parseHttpDateToUnixTimestamp("21 Mar 2025 12:34:56") == -1);
     CHECK(parseHttpDateToUnixTimestamp("") == -1);
 }
+
+TEST_CASE("parseIso8601ToUnixTimestamp") {
+    CHECK(parseIso8601ToUnixTimestamp("2025-03-21T12:34:56Z") == 1742560496);
+    CHECK(parseIso8601ToUnixTimestamp("2025-03-21T12:34:56.789Z") == 1742560496);
+    CHECK(parseIso8601ToUnixTimestamp("2020-01-01") == 1577836800);
+    CHECK(parseIso8601ToUnixTimestamp("2020-01-01T") == -1);
+    CHECK(parseIso8601ToUnixTimestamp("Fri, 21 Mar 2025 12:34:56 GMT") == -1);
+    CHECK(parseIso8601ToUnixTimestamp("") == -1);
+}
+
+TEST_CASE("formatUnixTimestampIso8601") {
+    CHECK(formatUnixTimestampIso8601(1742560496) == "2025-03-21T12:34:56Z");
+    CHECK(formatUnixTimestampIso8601(0) == "1970-01-01T00:00:00Z");
+    CHECK(parseIso8601ToUnixTimestamp(formatUnixTimestampIso8601(946684799)) == 946684799);
+}
+
+TEST_CASE("formatUnixTimestampHttpDate") {
+    CHECK(formatUnixTimestampHttpDate(1742560496) == "Fri, 21 Mar 2025 12:34:56 GMT");
+    CHECK(formatUnixTimestampHttpDate(0) == "Thu, 01 Jan 1970 00:00:00 GMT");
+    CHECK(parseHttpDateToUnixTimestamp(formatUnixTimestampHttpDate(946684799)) == 946684799);
+}
@@ -0,0 +1,136 @@
+/*
+ * Scorbit SDK
+ *
+ * (c) 2025 Spinner Systems, Inc. (DBA Scorbit), scrobit.io, All Rights Reserved
+ *
+ * MIT License
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <utils/download_range.h>
+#include <catch2/catch_test_macros.hpp>
+#include <boost/filesystem.hpp>
+#include <fstream>
+
+using namespace scorbit::detail;
+namespace fs = boost::filesystem;
+
+namespace {
+
+// sha256("abc")
+constexpr auto ABC_SHA256 = "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad";
+
+} // namespace
+
+TEST_CASE("Sha256Stream", "[download]")
+{
+    Sha256Stream hasher;
+
+    SECTION("incremental equals one-shot")
+    {
+        hasher.update("a");
+        hasher.update("bc");
+        CHECK(hasher.hexDigest() == ABC_SHA256);
+        CHECK(hasher.size() == 3);
+    }
+
+    SECTION("digest doesn't finish the stream")
+    {
+        hasher.update("ab");
+        (void)hasher.hexDigest();
+        hasher.update("c");
+        CHECK(hasher.hexDigest() == ABC_SHA256);
+    }
+
+    SECTION("resume from partial file")
+    {
+        const auto path = fs::temp_directory_path() / fs::unique_path();
+        {
+            std::ofstream f(path.string(), std::ios::binary);
+            f << "ab";
+        }
+        REQUIRE(hasher.updateFromFile(path.string()));
+        hasher.update("c");
+        CHECK(hasher.hexDigest() == ABC_SHA256);
+        fs::remove(path);
+    }
+
+    SECTION("reset")
+    {
+        hasher.update("garbage");
+        hasher.reset();
+        hasher.update("abc");
+        CHECK(hasher.hexDigest() == ABC_SHA256);
+    }
+}
+
+TEST_CASE("sha256Matches", "[download]")
+{
+    CHECK(sha256Matches(ABC_SHA256,
+                        "BA7816BF8F01CFEA414140DE5DAE2223B00361A396177A9CB410FF61F20015AD"));
+    CHECK_FALSE(sha256Matches(ABC_SHA256, ""));
+    CHECK_FALSE(sha256Matches(ABC_SHA256, "ba7816bf"));
+}
+
+TEST_CASE("HTTP range helpers", "[download]")
+{
+    CHECK(rangeHeaderFrom(1024) == "bytes=1024-");
+
+    SECTION("Content-Range")
+    {
+        auto r = parseContentRange("bytes 100-199/1000");
+        REQUIRE(r);
+        CHECK(r->first == 100);
+        CHECK(r->last == 199);
+        CHECK(r->total == 1000);
+
+        r = parseContentRange("bytes 0-9/*");
+        REQUIRE(r);
+        CHECK(r->total == -1);
+
+        CHECK_FALSE(parseContentRange("bytes */1000"));
+        CHECK_FALSE(parseContentRange("bytes 10-5/1000"));
+        CHECK_FALSE(parseContentRange("items 0-9/10"));
+        CHECK_FALSE(parseContentRange("bytes 0-9/5"));
+    }
+
+    SECTION("status line")
+    {
+        CHECK(parseHttpStatusLine("HTTP/1.1 206 Partial Content\r\n") == 206);
+        CHECK(parseHttpStatusLine("HTTP/2 200\r\n") == 200);
+        CHECK(parseHttpStatusLine("Content-Length: 10\r\n") == 0);
+    }
+
+    SECTION("header line")
+    {
+        auto h = parseHttpHeaderLine("ETag: \"abc\"\r\n");
+        REQUIRE(h);
+        CHECK(h->first == "etag");
+        CHECK(h->second == "\"abc\"");
+
+        CHECK_FALSE(parseHttpHeaderLine("HTTP/1.1 200 OK\r\n"));
+        CHECK_FALSE(parseHttpHeaderLine("\r\n"));
+    }
+
+    SECTION("split ranges")
+    {
+        auto ranges = splitByteRanges(10, 3);
+        REQUIRE(ranges.size() == 3);
+        CHECK(ranges[0] == std::pair<int64_t, int64_t> {0, 3});
+        CHECK(ranges[1] == std::pair<int64_t, int64_t> {4, 6});
+        CHECK(ranges[2] == std::pair<int64_t, int64_t> {7, 9});
+
+        CHECK(splitByteRanges(2, 4).size() == 2);
+        CHECK(splitByteRanges(0, 4).empty());
+    }
+}
@@ -0,0 +1,426 @@
+/*
+ * Scorbit SDK
+ *
+ * (c) 2025 Spinner Systems, Inc. (DBA Scorbit), scrobit.io, All Rights Reserved
+ *
+ * MIT License
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "file_downloader.h"
+#include <catch2/catch_test_macros.hpp>
+#include <fmt/format.h>
+#include <boost/asio.hpp>
+#include <boost/filesystem.hpp>
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace scorbit;
+using namespace scorbit::detail;
+using namespace std::chrono_literals;
+namespace fs = boost::filesystem;
+namespace asio = boost::asio;
+using asio::ip::tcp;
+
+namespace {
+
+constexpr FileDownloader::Limits LIMITS {
+        .connectTimeout = 5s,
+        .transferTimeout = 0ms,
+        .lowSpeedBps = 1,
+        .lowSpeedStallTime = 10s,
+        .retries = 3,
+};
+
+/**
+ * Local HTTP server serving one file, with Range and If-Range support. It can drop connections
+ * in the middle of the body to act as a flaky link.
+ */
+class HttpStandIn
+{
+public:
+    struct Request {
+        std::map<std::string, std::string> headers; // Lowercase keys
+    };
+
+    explicit HttpStandIn(std::string content)
+        : m_content(std::move(content))
+        , m_acceptor(m_io, tcp::endpoint(asio::ip::address_v4::loopback(), 0))
+        , m_thread([this] { acceptLoop(); })
+    {
+    }
+
+    ~HttpStandIn()
+    {
+        m_stop = true;
+        // Wake up the blocking accept
+        tcp::socket socket(m_io);
+        boost::system::error_code ec;
+        socket.connect(m_acceptor.local_endpoint(), ec);
+        m_thread.join();
+        for (auto &t : m_connections) {
+            t.join();
+        }
+    }
+
+    std::string url() const
+    {
+        return "http://127.0.0.1:" + std::to_string(m_acceptor.local_endpoint().port()) + "/file";
+    }
+
+    /// The next @p count responses are cut after @p afterBytes bytes of the body
+    void dropResponses(int count, size_t afterBytes)
+    {
+        m_drops = count;
+        m_dropAfter = afterBytes;
+    }
+
+    void setEtag(std::string etag)
+    {
+        std::scoped_lock lock(m_mutex);
+        m_etag = std::move(etag);
+    }
+
+    void setRanges(bool supported) { m_ranges = supported; }
+
+    std::vector<Request> requests() const
+    {
+        std::scoped_lock lock(m_mutex);
+        return m_requests;
+    }
+
+private:
+    void acceptLoop()
+    {
+        while (true) {
+            tcp::socket socket(m_io);
+            boost::system::error_code ec;
+            m_acceptor.accept(socket, ec);
+            if (m_stop) {
+                return;
+            }
+            if (!ec) {
+                m_connections.emplace_back(
+                        [this, s = std::move(socket)]() mutable { serve(std::move(s)); });
+            }
+        }
+    }
+
+    void serve(tcp::socket socket)
+    {
+        boost::system::error_code ec;
+        asio::streambuf buffer;
+        asio::read_until(socket, buffer, "\r\n\r\n", ec);
+        if (ec) {
+            return;
+        }
+
+        Request request;
+        std::istream stream(&buffer);
+        std::string line;
+        std::getline(stream, line); // Request line
+        while (std::getline(stream, line) && line != "\r") {
+            const auto colon = line.find(':');
+            if (colon == std::string::npos) {
+                continue;
+            }
+            auto key = line.substr(0, colon);
+            std::ranges::transform(key, key.begin(), [](unsigned char c) { return std::tolower(c); });
+            auto value = line.substr(colon + 1);
+            value.erase(0, value.find_first_not_of(' '));
+            value.erase(value.find_last_not_of("\r ") + 1);
+            request.headers[key] = value;
+        }
+
+        std::string etag;
+        {
+            std::scoped_lock lock(m_mutex);
+            m_requests.push_back(request);
+            etag = m_etag;
+        }
+
+        size_t first = 0;
+        size_t last = m_content.size() - 1;
+        bool partial = false;
+        if (const auto range = request.headers.find("range");
+            m_ranges && range != request.headers.end()) {
+            const auto ifRange = request.headers.find("if-range");
+            if (ifRange == request.headers.end() || (!etag.empty() && ifRange->second == etag)) {
+                const auto spec = range->second.substr(std::string_view {"bytes="}.size());
+                const auto dash = spec.find('-');
+                first = std::stoull(spec.substr(0, dash));
+                if (dash + 1 < spec.size()) {
+                    last = std::stoull(spec.substr(dash + 1));
+                }
+                partial = true;
+            }
+        }
+
+        std::string head = partial ? "HTTP/1.1 206 Partial Content\r\n" : "HTTP/1.1 200 OK\r\n";
+        head += "Content-Length: " + std::to_string(last - first + 1) + "\r\n";
+        if (partial) {
+            head += "Content-Range: bytes " + std::to_string(first) + "-" + std::to_string(last)
+                  + "/" + std::to_string(m_content.size()) + "\r\n";
+        }
+        if (!etag.empty()) {
+            head += "ETag: " + etag + "\r\n";
+        }
+        head += "Connection: close\r\n\r\n";
+
+        auto body = std::string_view {m_content}.substr(first, last - first + 1);
+        if (m_drops.fetch_sub(1) > 0) {
+            body = body.substr(0, m_dropAfter);
+        }
+
+        asio::write(socket, asio::buffer(head), ec);
+        asio::write(socket, asio::buffer(body.data(), body.size()), ec);
+        socket.shutdown(tcp::socket::shutdown_both, ec);
+    }
+
+    std::string m_content;
+    asio::io_context m_io;
+    tcp::acceptor m_acceptor;
+    std::atomic_bool m_stop {false};
+    std::atomic_int m_drops {0};
+    std::atomic_size_t m_dropAfter {0};
+    std::atomic_bool m_ranges {true};
+    mutable std::mutex m_mutex;
+    std::string m_etag {"\"v1\""};
+    std::vector<Request> m_requests;
+    std::vector<std::thread> m_connections;
+    std::thread m_thread; // Last, starts when everything else is ready
+};
+
+std::string makeContent(size_t size)
+{
+    std::string content(size, '\0');
+    for (size_t i = 0; i < size; ++i) {
+        content[i] = static_cast<char>((i * 31 + i / 251) & 0xff);
+    }
+    return content;
+}
+
+std::string sha256Of(const std::string &content)
+{
+    Sha256Stream hasher;
+    hasher.update(content);
+    return hasher.hexDigest();
+}
+
+std::string readFile(const fs::path &path)
+{
+    std::ifstream file(path.string(), std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+std::string header(const HttpStandIn::Request &request, const std::string &key)
+{
+    const auto it = request.headers.find(key);
+    return it == request.headers.end() ? std::string {} : it->second;
+}
+
+struct TempDir {
+    fs::path path {fs::temp_directory_path() / fs::unique_path("sb-download-%%%%-%%%%")};
+    TempDir() { fs::create_directories(path); }
+    ~TempDir()
+    {
+        boost::system::error_code ec;
+        fs::remove_all(path, ec);
+    }
+};
+
+const FileDownloader::MakeHeaders NO_HEADERS = [] { return cpr::Header {}; };
+
+} // namespace
+
+TEST_CASE("Interrupted download continues with a range request", "[download]")
+{
+    const auto content = makeContent(100'000);
+    HttpStandIn server(content);
+    TempDir dir;
+    const auto filename = (dir.path / "file.bin").string();
+    const FileDownloader downloader({}, LIMITS);
+
+    DownloadOptions options;
+    options.expectedSha256 = sha256Of(content);
+    options.expectedSize = static_cast<int64_t>(content.size());
+
+    SECTION("with validator")
+    {
+        server.dropResponses(2, 10'000);
+
+        const auto [error, status] = downloader.download(server.url(), filename, NO_HEADERS, options);
+        CHECK(error == Error::Success);
+        CHECK(status == 206);
+        CHECK(sha256Of(readFile(filename)) == sha256Of(content));
+        CHECK_FALSE(fs::exists(filename + ".part"));
+
+        const auto requests = server.requests();
+        REQUIRE(requests.size() == 3);
+        CHECK(header(requests[0], "range").empty());
+        CHECK(header(requests[1], "range") == "bytes=10000-");
+        CHECK(header(requests[1], "if-range") == "\"v1\"");
+        CHECK(header(requests[2], "range") == "bytes=20000-");
+    }
+
+    SECTION("without validator no empty If-Range is sent")
+    {
+        server.setEtag({});
+        server.dropResponses(1, 10'000);
+
+        const auto [error, status] = downloader.download(server.url(), filename, NO_HEADERS, options);
+        CHECK(error == Error::Success);
+        CHECK(sha256Of(readFile(filename)) == sha256Of(content));
+
+        const auto requests = server.requests();
+        REQUIRE(requests.size() == 2);
+        CHECK(header(requests[1], "range") == "bytes=10000-");
+        CHECK_FALSE(requests[1].headers.contains("if-range"));
+    }
+
+    SECTION("gives up after retries")
+    {
+        server.dropResponses(3, 10'000);
+
+        const auto [error, status] = downloader.download(server.url(), filename, NO_HEADERS, options);
+        CHECK(error == Error::ApiError);
+        CHECK_FALSE(fs::exists(filename));
+        CHECK_FALSE(fs::exists(filename + ".part"));
+    }
+}
+
+TEST_CASE("Downloaded file must match sha256", "[download]")
+{
+    const auto content = makeContent(10'000);
+    HttpStandIn server(content);
+    TempDir dir;
+    const auto filename = (dir.path / "file.bin").string();
+
+    DownloadOptions options;
+    options.expectedSha256 = sha256Of("something else");
+    options.keepPartial = true;
+
+    const auto [error, status] =
+            FileDownloader({}, LIMITS).download(server.url(), filename, NO_HEADERS, options);
+    CHECK(error == Error::FileError);
+    CHECK_FALSE(fs::exists(filename));
+    CHECK_FALSE(fs::exists(filename + ".part")); // Corrupted, not worth resuming
+}
+
+TEST_CASE("Kept partial file is continued by the next download", "[download]")
+{
+    const auto content = makeContent(5 * 1024 * 1024);
+    HttpStandIn server(content);
+    TempDir dir;
+    const auto filename = (dir.path / "file.bin").string();
+
+    DownloadOptions options;
+    options.expectedSha256 = sha256Of(content);
+    options.keepPartial = true;
+
+    server.dropResponses(1, 30'000);
+    auto limits = LIMITS;
+    limits.retries = 1;
+    auto [error, status] =
+            FileDownloader({}, limits).download(server.url(), filename, NO_HEADERS, options);
+    CHECK(error == Error::ApiError);
+    CHECK(fs::file_size(filename + ".part") == 30'000);
+
+    SECTION("in one stream") {}
+
+    SECTION("instead of starting segments over")
+    {
+        options.expectedSize = static_cast<int64_t>(content.size());
+        options.segments = 2;
+    }
+
+    std::tie(error, status) =
+            FileDownloader({}, LIMITS).download(server.url(), filename, NO_HEADERS, options);
+    CHECK(error == Error::Success);
+    CHECK(sha256Of(readFile(filename)) == sha256Of(content));
+
+    const auto requests = server.requests();
+    REQUIRE(requests.size() == 2);
+    CHECK(header(requests.back(), "range") == "bytes=30000-");
+    CHECK(header(requests.back(), "if-range") == "\"v1\"");
+}
+
+TEST_CASE("Segmented download", "[download]")
+{
+    const auto content = makeContent(5 * 1024 * 1024);
+    HttpStandIn server(content);
+    TempDir dir;
+    const auto filename = (dir.path / "file.bin").string();
+    const FileDownloader downloader({}, LIMITS);
+
+    DownloadOptions options;
+    options.expectedSha256 = sha256Of(content);
+    options.expectedSize = static_cast<int64_t>(content.size());
+    options.segments = 2;
+    const auto secondStart = content.size() / 2;
+
+    SECTION("segments continue where they were interrupted")
+    {
+        server.dropResponses(2, 64 * 1024);
+
+        const auto [error, status] = downloader.download(server.url(), filename, NO_HEADERS, options);
+        CHECK(error == Error::Success);
+        CHECK(sha256Of(readFile(filename)) == sha256Of(content));
+
+        // Drops hit whichever segments ask first, none of them starts over
+        const auto requests = server.requests();
+        REQUIRE(requests.size() == 4);
+        std::map<int64_t, int> fromSegmentStart; // Segment start -> requests
+        for (const auto &request : requests) {
+            const auto range = header(request, "range");
+            const auto first = std::stoll(range.substr(std::string_view {"bytes="}.size()));
+            const int64_t segmentStart = first < static_cast<int64_t>(secondStart) ? 0 : secondStart;
+            CAPTURE(range);
+            CHECK((first - segmentStart) % (64 * 1024) == 0);
+            if (first == segmentStart) {
+                ++fromSegmentStart[segmentStart];
+            }
+        }
+        CHECK(fromSegmentStart[0] == 1);
+        CHECK(fromSegmentStart[static_cast<int64_t>(secondStart)] == 1);
+    }
+
+    SECTION("server ignoring ranges falls back to one stream")
+    {
+        server.setRanges(false);
+
+        const auto [error, status] = downloader.download(server.url(), filename, NO_HEADERS, options);
+        CHECK(error == Error::Success);
+        CHECK(status == 200);
+        CHECK(sha256Of(readFile(filename)) == sha256Of(content));
+    }
+
+    SECTION("failed segments leave the head of the file to continue from")
+    {
+        server.dropResponses(2 * LIMITS.retries, 64 * 1024);
+
+        const auto [error, status] = downloader.download(server.url(), filename, NO_HEADERS, options);
+        CHECK(error == Error::Success);
+        CHECK(sha256Of(readFile(filename)) == sha256Of(content));
+
+        // Single stream continues after what the first segment received
+        const auto requests = server.requests();
+        REQUIRE(requests.size() == 2 * LIMITS.retries + 1);
+        CHECK(header(requests.back(), "range") == fmt::format("bytes={}-", 3 * 64 * 1024));
+    }
+}
@@ -0,0 +1,169 @@
+/*
+ * Scorbit SDK
+ *
+ * (c) 2025 Spinner Systems, Inc. (DBA Scorbit), scrobit.io, All Rights Reserved
+ *
+ * MIT License
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "flight_recorder.h"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+using namespace scorbit::detail;
+
+namespace fs = boost::filesystem;
+
+namespace {
+
+struct TempFile {
+    const fs::path path {fs::temp_directory_path() / fs::unique_path("flight_recorder_%%%%-%%%%")};
+    ~TempFile() { fs::remove(path); }
+};
+
+std::vector<std::string> linesOf(const std::string &dump)
+{
+    std::vector<std::string> lines;
+    std::istringstream stream(dump);
+    for (std::string line; std::getline(stream, line);) {
+        // Strip the timestamp
+        lines.push_back(line.substr(line.find(' ') + 1));
+    }
+    return lines;
+}
+
+} // namespace
+
+TEST_CASE("Flight recorder keeps records for the next run", "[flight_recorder]")
+{
+    TempFile file;
+
+    {
+        FlightRecorder recorder;
+        recorder.log(logger::LogLevel::Info, "not open yet");
+        REQUIRE(recorder.open(file.path.string()));
+        CHECK(recorder.previousRun().empty());
+        CHECK(recorder.open(file.path.string()));
+        CHECK_FALSE(recorder.open(file.path.string() + ".other"));
+
+        recorder.log(logger::LogLevel::Info, "first");
+        recorder.event("Auth status: {}", "AuthenticatedPaired");
+        recorder.log(logger::LogLevel::Error, "multi\nline");
+        CHECK(linesOf(recorder.dump())
+              == std::vector<std::string> {"INF first", "EVT Auth status: AuthenticatedPaired",
+                                           "ERR multi line"});
+        // Destroyed without any shutdown, like a crash
+    }
+
+    FlightRecorder recorder;
+    REQUIRE(recorder.open(file.path.string()));
+    const std::vector<std::string> previous {
+            "INF first", "EVT Auth status: AuthenticatedPaired", "ERR multi line"};
+    CHECK(linesOf(recorder.previousRun()) == previous);
+
+    recorder.log(logger::LogLevel::Warn, "second run");
+    CHECK(linesOf(recorder.previousRun()) == previous);
+    CHECK(linesOf(recorder.dump()).back() == "WRN second run");
+    CHECK(recorder.dump().starts_with("20"));
+
+    // Long messages are cut, not lost
+    recorder.log(logger::LogLevel::Info, std::string(5000, 'x'));
+    CHECK(linesOf(recorder.dump()).back().size() == 4 + FLIGHT_RECORDER_MAX_TEXT);
+}
+
+TEST_CASE("Flight recorder overwrites the oldest records", "[flight_recorder]")
+{
+    TempFile file;
+    FlightRecorder recorder(1024);
+    REQUIRE(recorder.open(file.path.string()));
+
+    for (int i = 0; i < 200; ++i) {
+        recorder.log(logger::LogLevel::Debug, fmt::format("message {}", i));
+    }
+
+    const auto lines = linesOf(recorder.dump());
+    REQUIRE(lines.size() > 10);
+    REQUIRE(lines.size() < 200);
+    for (size_t i = 0; i < lines.size(); ++i) {
+        CHECK(lines[i] == fmt::format("DBG message {}", 200 - lines.size() + i));
+    }
+}
+
+TEST_CASE("Flight recorder skips torn records", "[flight_recorder]")
+{
+    TempFile file;
+    {
+        FlightRecorder recorder;
+        REQUIRE(recorder.open(file.path.string()));
+        recorder.log(logger::LogLevel::Info, "first");
+        recorder.log(logger::LogLevel::Info, "second");
+        recorder.log(logger::LogLevel::Info, "third");
+    }
+
+    {
+        std::fstream stream(file.path.string(), std::ios::in | std::ios::out | std::ios::binary);
+        std::string content((std::istreambuf_iterator<char>(stream)),
+                            std::istreambuf_iterator<char>());
+        const auto pos = content.find("second");
+        REQUIRE(pos != std::string::npos);
+        stream.seekp(static_cast<std::streamoff>(pos));
+        stream.write("SEC", 3); // Crashed while the text was written
+    }
+
+    FlightRecorder recorder;
+    REQUIRE(recorder.open(file.path.string()));
+    CHECK(linesOf(recorder.previousRun()) == std::vector<std::string> {"INF first", "INF third"});
+}
+
+TEST_CASE("Flight recorder multithread", "[flight_recorder]")
+{
+    TempFile file;
+    FlightRecorder recorder;
+    REQUIRE(recorder.open(file.path.string()));
+
+    constexpr int THREADS = 4;
+    constexpr int MESSAGES = 500;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&recorder, t]() {
+            for (int i = 0; i < MESSAGES; ++i) {
+                recorder.log(logger::LogLevel::Info, fmt::format("thread {} message {}", t, i));
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    CHECK(linesOf(recorder.dump()).size() == THREADS * MESSAGES);
+}
+
+TEST_CASE("Flight recorder benchmark", "[.][benchmark][flight_recorder]")
+{
+    TempFile file;
+    FlightRecorder recorder;
+    REQUIRE(recorder.open(file.path.string()));
+    const std::string message = "API GET request to https://api.scorbit.io/api/heartbeat/ OK";
+
+    BENCHMARK("Record log message")
+    {
+        recorder.log(logger::LogLevel::Info, message);
+    };
+}
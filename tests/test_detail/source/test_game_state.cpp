@@ -69,6 +69,9 @@ public:
                           LeaderboardHandleCallback) override
     {
     };
+    void requestTopScoresMulti(std::vector<LeaderboardQuery>, LeaderboardMultiCallback) override
+    {
+    };
     void requestUnpair(StringCallback) override {};
     MAKE_MOCK2(submitGameData, void(const scorbit::detail::GameData &, SessionFlags), override);
     MAKE_MOCK0(authenticate, void(), override);
@@ -79,8 +82,8 @@ public:
                void(const std::string &, const std::string &, bool, std::optional<std::string>),
                override);
     void download(bool isAsync, StringCallback, const std::string &, const std::string &,
-                  const HttpHeaders &) override { };
-    void downloadBuffer(bool isAsync, VectorCallback, const std::string &, size_t,
+                  const HttpHeaders &, const DownloadOptions &) override { };
+    void downloadBuffer(bool isAsync, BufferCallback, const std::string &, size_t,
                         const HttpHeaders &) override { };
     PlayerProfilesManager &playersManager() override { return m_playersManager; };
     void patchScorbitron(std::string, StringCallback, std::vector<AuthStatus>) override {};
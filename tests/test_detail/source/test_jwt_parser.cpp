@@ -32,7 +32,7 @@ using namespace std::chrono;
 
 namespace {
 
-std::string createTestJwtToken(int64_t expTimestamp)
+std::string createTestJwtToken(int64_t expTimestamp, int64_t iatTimestamp = 1640995200)
 {
     // Create JWT header
     nlohmann::json header;
@@ -43,7 +43,7 @@ std::string createTestJwtToken(int64_t expTimestamp)
     // Create JWT payload
     nlohmann::json payload;
     payload["sub"] = "test_user";
-    payload["iat"] = 1640995200; // 2022-01-01 00:00:00 UTC
+    payload["iat"] = iatTimestamp; // 2022-01-01 00:00:00 UTC by default
     payload["exp"] = expTimestamp;
     payload["iss"] = "test_issuer";
     std::string payloadStr = payload.dump();
@@ -345,6 +345,32 @@ TEST_CASE("getJwtTokenTimeUntilExpiration - Invalid Token", "[jwt_parser]")
     REQUIRE_FALSE(timeLeft.has_value());
 }
 
+TEST_CASE("getJwtTokenLifetime - Doesn't depend on local clock", "[jwt_parser]")
+{
+    // Issued and expiring two days ago by local clock, e.g. local clock is ahead
+    auto now = system_clock::now();
+    auto iatTimestamp = duration_cast<seconds>((now - hours(49)).time_since_epoch()).count();
+    auto expTimestamp = iatTimestamp + 3600;
+
+    auto lifetime = getJwtTokenLifetime(createTestJwtToken(expTimestamp, iatTimestamp));
+
+    REQUIRE(lifetime.has_value());
+    REQUIRE(lifetime->count() == 3600);
+}
+
+TEST_CASE("getJwtTokenLifetime - Expiration before issue time", "[jwt_parser]")
+{
+    auto lifetime = getJwtTokenLifetime(createTestJwtToken(1640995100, 1640995200));
+
+    REQUIRE(lifetime.has_value());
+    REQUIRE(lifetime->count() == 0);
+}
+
+TEST_CASE("getJwtTokenLifetime - Invalid Token", "[jwt_parser]")
+{
+    REQUIRE_FALSE(getJwtTokenLifetime("invalid.token.format").has_value());
+}
+
 TEST_CASE("JWT Token Edge Cases", "[jwt_parser]")
 {
     // Test with token that expires exactly now
@@ -21,6 +21,9 @@
 #include "leaderboard_internal.h"
 
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <nlohmann/json.hpp>
 
 #include <memory>
 
@@ -61,6 +64,20 @@ auto sampleLeaderboardJson()
     ])";
 }
 
+std::string largeLeaderboardJson(size_t count)
+{
+    const auto entry = nlohmann::json::parse(sampleLeaderboardJson()).front();
+    auto entries = nlohmann::json::array();
+    for (size_t i = 0; i < count; ++i) {
+        auto item = entry;
+        item["id"] = i + 1;
+        item["rank"] = i + 1;
+        item["player"]["username"] = "player" + std::to_string(i);
+        entries.push_back(std::move(item));
+    }
+    return entries.dump();
+}
+
 using LeaderboardPtr = std::unique_ptr<sb_leaderboard_t, decltype(&detail::destroyLeaderboard)>;
 
 } // namespace
@@ -131,4 +148,190 @@ TEST_CASE("Leaderboard parser rejects malformed payloads")
     CHECK_FALSE(parseLeaderboardJson(R"({"not":"an array"})"));
     CHECK_FALSE(parseLeaderboardJson(R"([{"player":"not-an-object"}])"));
     CHECK_THROWS(parseLeaderboardJson("not json"));
+    CHECK_THROWS(parseLeaderboardJson(R"([{"id": 1})"));
+    CHECK_FALSE(parseLeaderboardJson("[1]"));
+    CHECK_FALSE(parseLeaderboardJson(R"([{"player": [1]}])"));
+}
+
+TEST_CASE("Leaderboard parser skips unknown and mistyped fields")
+{
+    LeaderboardPtr leaderboard(parseLeaderboardJson(R"([
+        {
+            "id": 7,
+            "rank": "first",
+            "tournament": {"id": "t1", "rules": [{"image": "nested"}]},
+            "tags": ["a", {"created": "nested"}],
+            "image": null,
+            "player": {"id": "p1", "stats": {"username": "nested"}, "follower_count": 3},
+            "is_vpin": 1,
+            "is_verified": true,
+            "created": "2026-01-01"
+        },
+        {"id": 8, "player": null}
+    ])"),
+                               &detail::destroyLeaderboard);
+    REQUIRE(leaderboard);
+    REQUIRE(sb_leaderboard_entries_count(leaderboard.get()) == 2);
+
+    uint64_t id = 0;
+    int rank = -1;
+    int followers = 0;
+    bool isVpin = true;
+    bool isVerified = false;
+    const char *str = nullptr;
+
+    REQUIRE(sb_leaderboard_entry_id(leaderboard.get(), 0, &id));
+    CHECK(id == 7);
+    REQUIRE(sb_leaderboard_entry_rank(leaderboard.get(), 0, &rank));
+    CHECK(rank == 0);
+    CHECK_FALSE(sb_leaderboard_entry_image(leaderboard.get(), 0, &str));
+    REQUIRE(sb_leaderboard_entry_player_id(leaderboard.get(), 0, &str));
+    CHECK(std::string(str) == "p1");
+    CHECK_FALSE(sb_leaderboard_entry_player_username(leaderboard.get(), 0, &str));
+    REQUIRE(sb_leaderboard_entry_player_follower_count(leaderboard.get(), 0, &followers));
+    CHECK(followers == 3);
+    REQUIRE(sb_leaderboard_entry_is_vpin(leaderboard.get(), 0, &isVpin));
+    CHECK_FALSE(isVpin);
+    REQUIRE(sb_leaderboard_entry_is_verified(leaderboard.get(), 0, &isVerified));
+    CHECK(isVerified);
+    REQUIRE(sb_leaderboard_entry_created(leaderboard.get(), 0, &str));
+    CHECK(std::string(str) == "2026-01-01");
+
+    REQUIRE(sb_leaderboard_entry_id(leaderboard.get(), 1, &id));
+    CHECK(id == 8);
+    CHECK_FALSE(sb_leaderboard_entry_player_id(leaderboard.get(), 1, &str));
+    CHECK_FALSE(sb_leaderboard_entry_id(leaderboard.get(), 2, &id));
+}
+
+TEST_CASE("Leaderboard strings point into one arena")
+{
+    const auto reply = largeLeaderboardJson(100);
+    const auto data = parseLeaderboardData(reply);
+    REQUIRE(data);
+    REQUIRE(data->size() == 100);
+
+    const auto *begin = data->arena.data();
+    const auto *end = begin + data->arena.size();
+    for (size_t i = 0; i < data->size(); ++i) {
+        const auto *username = data->string(LeaderboardString::PlayerUsername, i);
+        REQUIRE(username >= begin);
+        REQUIRE(username < end);
+        CHECK(std::string(username) == "player" + std::to_string(i));
+        CHECK(data->ranks[i] == static_cast<int>(i + 1));
+    }
+}
+
+TEST_CASE("Leaderboard parser benchmark", "[.][benchmark]")
+{
+    const auto reply = largeLeaderboardJson(1000);
+
+    BENCHMARK("SAX parse 1000 entries")
+    {
+        return parseLeaderboardData(reply);
+    };
+
+    BENCHMARK("json DOM parse 1000 entries (reference)")
+    {
+        return nlohmann::json::parse(reply);
+    };
+}
+
+TEST_CASE("Leaderboard handles share immutable data")
+{
+    const auto data = parseLeaderboardData(sampleLeaderboardJson());
+    REQUIRE(data);
+
+    LeaderboardPtr first(makeLeaderboardHandle(data), &detail::destroyLeaderboard);
+    LeaderboardPtr second(makeLeaderboardHandle(data), &detail::destroyLeaderboard);
+
+    const char *firstName = nullptr;
+    const char *secondName = nullptr;
+    REQUIRE(sb_leaderboard_entry_player_username(first.get(), 0, &firstName));
+    REQUIRE(sb_leaderboard_entry_player_username(second.get(), 0, &secondName));
+    CHECK(firstName == secondName);
+
+    // Freeing one handle leaves the data of the other one intact
+    first.reset();
+    REQUIRE(sb_leaderboard_entry_player_username(second.get(), 0, &secondName));
+    CHECK(std::string(secondName) == "dilshodm");
+}
+
+TEST_CASE("Leaderboard view reads entries without copying")
+{
+    LeaderboardPtr leaderboard(parseLeaderboardJson(sampleLeaderboardJson()),
+                               &detail::destroyLeaderboard);
+    REQUIRE(leaderboard);
+
+    const auto view = LeaderboardView::borrow(leaderboard.get());
+    REQUIRE_FALSE(view.isOwned());
+    REQUIRE(view.size() == 1);
+
+    const auto entry = view[0];
+    CHECK(entry.id() == 3828382);
+    CHECK(entry.rank() == 1);
+    CHECK(entry.highScore() == 146250);
+    CHECK(entry.isVerified());
+    CHECK_FALSE(entry.isVpin());
+    CHECK(entry.playerDisplayName() == "Dilshod");
+    CHECK(entry.playerFollowerCount() == 14);
+    CHECK(entry.created() == "2026-03-31T08:14:10.091057Z");
+
+    const char *username = nullptr;
+    REQUIRE(sb_leaderboard_entry_player_username(leaderboard.get(), 0, &username));
+    CHECK(entry.playerUsername().data() == username);
+
+    size_t count = 0;
+    for (const auto &item : view) {
+        CHECK(item.playerUsername() == "dilshodm");
+        ++count;
+    }
+    CHECK(count == 1);
+}
+
+TEST_CASE("Retained leaderboard view outlives the original handle")
+{
+    LeaderboardPtr leaderboard(parseLeaderboardJson(sampleLeaderboardJson()),
+                               &detail::destroyLeaderboard);
+    REQUIRE(leaderboard);
+
+    LeaderboardView kept;
+    {
+        const auto borrowed = LeaderboardView::borrow(leaderboard.get());
+        kept = borrowed.retain();
+    }
+    REQUIRE(kept.isOwned());
+
+    leaderboard.reset(); // As the C API bridge does after the callback
+    REQUIRE(kept.size() == 1);
+    CHECK(kept[0].playerUsername() == "dilshodm");
+
+    auto moved = std::move(kept);
+    CHECK(moved.isOwned());
+    CHECK_FALSE(kept.isOwned());
+    CHECK(kept.empty());
+    CHECK(moved[0].image() == "https://cdn-staging.scorbit.io/leaderboards/3828382.jpg");
+
+    CHECK(sb_leaderboard_retain(nullptr) == nullptr);
+    sb_leaderboard_release(nullptr);
+}
+
+TEST_CASE("Leaderboard reports when it was updated")
+{
+    using namespace std::chrono;
+
+    const auto data = parseLeaderboardData(sampleLeaderboardJson());
+    REQUIRE(data);
+
+    LeaderboardPtr unknown(detail::makeLeaderboardHandle(data), &detail::destroyLeaderboard);
+    CHECK(sb_leaderboard_updated_at(unknown.get()) == 0);
+    CHECK(sb_leaderboard_updated_at(nullptr) == 0);
+
+    const system_clock::time_point updatedAt {milliseconds {1775037600123}};
+    LeaderboardPtr cached(detail::makeLeaderboardHandle(data, updatedAt),
+                          &detail::destroyLeaderboard);
+    CHECK(sb_leaderboard_updated_at(cached.get()) == 1775037600123);
+    CHECK(LeaderboardResult::fromC(cached.get()).updatedAt == updatedAt);
+
+    const auto view = LeaderboardView::borrow(cached.get()).retain();
+    CHECK(view.updatedAt() == updatedAt); // Retained handle keeps the timestamp
 }
@@ -0,0 +1,392 @@
+/*
+ * Scorbit SDK
+ *
+ * (c) 2025 Spinner Systems, Inc. (DBA Scorbit), scrobit.io, All Rights Reserved
+ *
+ * MIT License
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "leaderboard_cache.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <memory>
+
+using namespace scorbit;
+using namespace scorbit::detail;
+using namespace std::chrono_literals;
+
+namespace {
+
+LeaderboardDataPtr makeData(int rank)
+{
+    auto data = std::make_shared<LeaderboardData>();
+    data->ranks[data->addEntry()] = rank;
+    return data;
+}
+
+const LeaderboardQuery machineQuery {LeaderboardScope::Machine, LeaderboardPeriod::AllTime, "",
+                                     LeaderboardVpinFilter::Any};
+
+} // namespace
+
+TEST_CASE("Leaderboard cache key includes all query fields", "[leaderboard_cache]")
+{
+    auto other = machineQuery;
+    REQUIRE(other == machineQuery);
+    REQUIRE(std::hash<LeaderboardQuery> {}(other) == std::hash<LeaderboardQuery> {}(machineQuery));
+
+    other.period = LeaderboardPeriod::Days30;
+    REQUIRE_FALSE(other == machineQuery);
+
+    other = machineQuery;
+    other.since = "2026-01-01";
+    REQUIRE_FALSE(other == machineQuery);
+
+    other = machineQuery;
+    other.vpinFilter = LeaderboardVpinFilter::VpinOnly;
+    REQUIRE_FALSE(other == machineQuery);
+}
+
+TEST_CASE("Leaderboard cache freshness follows TTL and stale window", "[leaderboard_cache]")
+{
+    LeaderboardCache cache(30s, 300s);
+    const auto now = LeaderboardCache::Clock::now();
+
+    REQUIRE(cache.lookup(machineQuery, now).freshness == LeaderboardCache::Freshness::Miss);
+
+    auto fetch = cache.beginFetch(machineQuery, nullptr);
+    REQUIRE(fetch);
+    auto data = makeData(1);
+    cache.completeFetch(machineQuery, *fetch, data, {"\"v1\"", ""}, now);
+
+    auto lookup = cache.lookup(machineQuery, now + 10s);
+    REQUIRE(lookup.freshness == LeaderboardCache::Freshness::Fresh);
+    REQUIRE(lookup.data == data); // Shared, not copied
+
+    lookup = cache.lookup(machineQuery, now + 60s);
+    REQUIRE(lookup.freshness == LeaderboardCache::Freshness::Stale);
+    REQUIRE(lookup.data == data);
+
+    lookup = cache.lookup(machineQuery, now + 400s);
+    REQUIRE(lookup.freshness == LeaderboardCache::Freshness::Miss);
+    REQUIRE_FALSE(lookup.data);
+
+    SECTION("Expired entry keeps validators for conditional request")
+    {
+        LeaderboardCache::Validators validators;
+        REQUIRE(cache.beginFetch(machineQuery, nullptr, &validators));
+        REQUIRE(validators.etag == "\"v1\"");
+    }
+
+    SECTION("Zero TTL never serves without request")
+    {
+        cache.setTtl(0s, 0s);
+        REQUIRE(cache.lookup(machineQuery, now).freshness == LeaderboardCache::Freshness::Miss);
+    }
+
+    SECTION("Clear drops results")
+    {
+        cache.clear();
+        REQUIRE(cache.lookup(machineQuery, now).freshness == LeaderboardCache::Freshness::Miss);
+    }
+
+    SECTION("Invalidate forces refresh but keeps validators")
+    {
+        cache.invalidate();
+        REQUIRE(cache.lookup(machineQuery, now).freshness == LeaderboardCache::Freshness::Miss);
+
+        LeaderboardCache::Validators validators;
+        REQUIRE(cache.beginFetch(machineQuery, nullptr, &validators));
+        REQUIRE(validators.etag == "\"v1\"");
+    }
+}
+
+TEST_CASE("Leaderboard cache reports when result was updated", "[leaderboard_cache]")
+{
+    LeaderboardCache cache(30s, 300s);
+    const auto now = LeaderboardCache::Clock::now();
+    const auto before = std::chrono::system_clock::now();
+
+    LeaderboardCache::SystemTime fetched;
+    auto fetch = cache.beginFetch(machineQuery,
+                                  [&fetched](Error, LeaderboardDataPtr, auto updatedAt) {
+                                      fetched = updatedAt;
+                                  });
+    REQUIRE(fetch);
+    cache.completeFetch(machineQuery, *fetch, makeData(1), {"\"v1\"", ""}, now);
+    REQUIRE(fetched >= before);
+    REQUIRE(cache.lookup(machineQuery, now + 60s).updatedAt == fetched);
+
+    // 304 confirms the cached result, so it's up to date again
+    LeaderboardCache::SystemTime confirmed;
+    fetch = cache.beginFetch(machineQuery, [&confirmed](Error, LeaderboardDataPtr, auto updatedAt) {
+        confirmed = updatedAt;
+    });
+    REQUIRE(fetch);
+    cache.completeNotModified(machineQuery, *fetch, {}, now + 60s);
+    REQUIRE(confirmed >= fetched);
+    REQUIRE(cache.lookup(machineQuery, now + 70s).updatedAt == confirmed);
+}
+
+TEST_CASE("Leaderboard cache coalesces concurrent fetches", "[leaderboard_cache]")
+{
+    LeaderboardCache cache;
+
+    int calls = 0;
+    LeaderboardDataPtr received[2];
+    auto waiter = [&](int i) {
+        return [&, i](Error error, LeaderboardDataPtr data, LeaderboardCache::SystemTime) {
+            REQUIRE(error == Error::Success);
+            received[i] = std::move(data);
+            ++calls;
+        };
+    };
+
+    const auto fetch = cache.beginFetch(machineQuery, waiter(0));
+    REQUIRE(fetch);
+    REQUIRE_FALSE(cache.beginFetch(machineQuery, waiter(1))); // Joins the first one
+
+    auto otherQuery = machineQuery;
+    otherQuery.scope = LeaderboardScope::Game;
+    REQUIRE(cache.beginFetch(otherQuery, nullptr)); // Different key fetches on its own
+
+    const auto data = makeData(1);
+    cache.completeFetch(machineQuery, *fetch, data, {});
+    REQUIRE(calls == 2);
+    REQUIRE(received[0] == data);
+    REQUIRE(received[1] == data);
+
+    // Request is not in flight anymore, next caller fetches again
+    REQUIRE(cache.beginFetch(machineQuery, nullptr));
+}
+
+TEST_CASE("Leaderboard cache handles not modified and failed fetches", "[leaderboard_cache]")
+{
+    LeaderboardCache cache(30s, 0s);
+    const auto now = LeaderboardCache::Clock::now();
+    const auto data = makeData(1);
+
+    const auto first = cache.beginFetch(machineQuery, nullptr);
+    REQUIRE(first);
+    cache.completeFetch(machineQuery, *first, data, {"\"v1\"", "Wed, 01 Apr 2026 10:00:00 GMT"},
+                        now);
+    REQUIRE(cache.lookup(machineQuery, now + 40s).freshness == LeaderboardCache::Freshness::Miss);
+
+    SECTION("304 refreshes cached result")
+    {
+        LeaderboardDataPtr received;
+        LeaderboardCache::Validators validators;
+        const auto fetch = cache.beginFetch(
+                machineQuery,
+                [&received](Error error, LeaderboardDataPtr result, LeaderboardCache::SystemTime) {
+                    REQUIRE(error == Error::Success);
+                    received = std::move(result);
+                },
+                &validators);
+        REQUIRE(fetch);
+        REQUIRE(validators.etag == "\"v1\"");
+        REQUIRE(validators.lastModified == "Wed, 01 Apr 2026 10:00:00 GMT");
+
+        cache.completeNotModified(machineQuery, *fetch, {}, now + 40s);
+        REQUIRE(received == data);
+
+        const auto lookup = cache.lookup(machineQuery, now + 50s);
+        REQUIRE(lookup.freshness == LeaderboardCache::Freshness::Fresh);
+
+        // Validators are kept when 304 reply doesn't repeat them
+        LeaderboardCache::Validators kept;
+        REQUIRE(cache.beginFetch(machineQuery, nullptr, &kept));
+        REQUIRE(kept.etag == "\"v1\"");
+    }
+
+    SECTION("Failure is reported to all waiters")
+    {
+        int failures = 0;
+        auto waiter = [&failures](Error error, LeaderboardDataPtr result, auto) {
+            REQUIRE(error == Error::ApiError);
+            REQUIRE_FALSE(result);
+            ++failures;
+        };
+        const auto fetch = cache.beginFetch(machineQuery, waiter);
+        REQUIRE(fetch);
+        REQUIRE_FALSE(cache.beginFetch(machineQuery, waiter));
+
+        cache.failFetch(machineQuery, *fetch, Error::ApiError);
+        REQUIRE(failures == 2);
+        REQUIRE(cache.beginFetch(machineQuery, nullptr));
+    }
+
+    SECTION("304 without cached result fails")
+    {
+        cache.clear();
+        Error received = Error::Success;
+        const auto fetch = cache.beginFetch(machineQuery,
+                                            [&received](Error error, LeaderboardDataPtr, auto) {
+                                                received = error;
+                                            });
+        REQUIRE(fetch);
+        cache.completeNotModified(machineQuery, *fetch, {});
+        REQUIRE(received == Error::ApiError);
+    }
+}
+
+TEST_CASE("Leaderboard cache misses after game over", "[leaderboard_cache]")
+{
+    LeaderboardCache cache(30s, 300s);
+    const auto now = LeaderboardCache::Clock::now();
+
+    auto fetch = cache.beginFetch(machineQuery, nullptr);
+    REQUIRE(fetch);
+    cache.completeFetch(machineQuery, *fetch, makeData(1), {"\"v1\"", ""}, now);
+    REQUIRE(cache.lookup(machineQuery, now).freshness == LeaderboardCache::Freshness::Fresh);
+
+    // Final session update invalidates, the next request within TTL fetches the new board
+    cache.invalidate();
+    REQUIRE(cache.lookup(machineQuery, now + 1s).freshness == LeaderboardCache::Freshness::Miss);
+    REQUIRE(cache.lookup(machineQuery, now + 60s).freshness == LeaderboardCache::Freshness::Miss);
+
+    const auto updated = makeData(2);
+    fetch = cache.beginFetch(machineQuery, nullptr);
+    REQUIRE(fetch);
+    cache.completeFetch(machineQuery, *fetch, updated, {"\"v2\"", ""}, now + 2s);
+    const auto lookup = cache.lookup(machineQuery, now + 3s);
+    REQUIRE(lookup.freshness == LeaderboardCache::Freshness::Fresh);
+    REQUIRE(lookup.data == updated);
+}
+
+TEST_CASE("Leaderboard cache doesn't keep results fetched before it was reset",
+          "[leaderboard_cache]")
+{
+    LeaderboardCache cache(30s, 300s);
+    const auto now = LeaderboardCache::Clock::now();
+
+    int delivered = 0;
+    const auto waiter = [&delivered](Error error, LeaderboardDataPtr data, auto) {
+        REQUIRE(error == Error::Success);
+        REQUIRE(data);
+        ++delivered;
+    };
+
+    SECTION("Cleared on unpair")
+    {
+        const auto fetch = cache.beginFetch(machineQuery, waiter);
+        REQUIRE(fetch);
+        cache.clear();
+        cache.completeFetch(machineQuery, *fetch, makeData(1), {"\"v1\"", ""}, now);
+    }
+
+    SECTION("Invalidated by game over")
+    {
+        const auto first = cache.beginFetch(machineQuery, nullptr);
+        REQUIRE(first);
+        cache.completeFetch(machineQuery, *first, makeData(1), {"\"v1\"", ""}, now);
+
+        const auto fetch = cache.beginFetch(machineQuery, waiter);
+        REQUIRE(fetch);
+        cache.invalidate();
+
+        // Request after game over doesn't join the fetch of the old board
+        int afterGameOver = 0;
+        const auto next = cache.beginFetch(machineQuery, [&afterGameOver](Error, auto, auto) {
+            ++afterGameOver;
+        });
+        REQUIRE(next);
+        REQUIRE(*next != *fetch);
+
+        cache.completeNotModified(machineQuery, *fetch, {}, now + 40s);
+        REQUIRE(afterGameOver == 0);
+        cache.failFetch(machineQuery, *next, Error::ApiError);
+        REQUIRE(afterGameOver == 1);
+    }
+
+    REQUIRE(delivered == 1); // Waiters still get what was fetched for them
+    REQUIRE(cache.lookup(machineQuery, now + 41s).freshness == LeaderboardCache::Freshness::Miss);
+
+    // Fetch started after the reset is cached as usual
+    const auto fetch = cache.beginFetch(machineQuery, nullptr);
+    REQUIRE(fetch);
+    cache.completeFetch(machineQuery, *fetch, makeData(2), {"\"v2\"", ""}, now + 42s);
+    REQUIRE(cache.lookup(machineQuery, now + 43s).freshness == LeaderboardCache::Freshness::Fresh);
+}
+
+TEST_CASE("Leaderboard batch reports all results in one callback", "[leaderboard_cache]")
+{
+    int calls = 0;
+    std::vector<Error> errors;
+    std::vector<sb_leaderboard_t *> results;
+    LeaderboardBatch batch(3, [&](std::vector<Error> e, std::vector<sb_leaderboard_t *> r) {
+        errors = std::move(e);
+        results = std::move(r);
+        ++calls;
+    });
+
+    const auto first = makeData(1);
+    const auto third = makeData(3);
+    const auto updatedAt = std::chrono::system_clock::now();
+    batch.complete(2, Error::Success, third, updatedAt);
+    batch.complete(0, Error::Success, first);
+    REQUIRE(calls == 0);
+
+    batch.complete(1, Error::NotPaired, nullptr);
+    REQUIRE(calls == 1);
+    REQUIRE(errors == std::vector<Error> {Error::Success, Error::NotPaired, Error::Success});
+    REQUIRE(results[0]->data == first);
+    REQUIRE_FALSE(results[1]);
+    REQUIRE(results[2]->data == third);
+    REQUIRE(results[2]->updatedAt == updatedAt);
+
+    for (auto *leaderboard : results) {
+        destroyLeaderboard(leaderboard);
+    }
+
+    SECTION("Empty batch completes right away")
+    {
+        bool called = false;
+        LeaderboardBatch empty(0, [&called](std::vector<Error> e, std::vector<sb_leaderboard_t *>) {
+            REQUIRE(e.empty());
+            called = true;
+        });
+        REQUIRE(called);
+    }
+
+    SECTION("Repeated completion is ignored")
+    {
+        int repeatedCalls = 0;
+        std::vector<sb_leaderboard_t *> repeatedResults;
+        LeaderboardBatch repeated(2, [&](std::vector<Error>, std::vector<sb_leaderboard_t *> r) {
+            repeatedResults = std::move(r);
+            ++repeatedCalls;
+        });
+
+        repeated.complete(0, Error::Success, first);
+        repeated.complete(0, Error::Success, third); // Leaked and counted twice before
+        REQUIRE(repeatedCalls == 0);
+
+        repeated.complete(1, Error::Success, third);
+        REQUIRE(repeatedCalls == 1);
+        REQUIRE(repeatedResults[0]->data == first);
+        REQUIRE(repeatedResults[1]->data == third);
+        for (auto *leaderboard : repeatedResults) {
+            destroyLeaderboard(leaderboard);
+        }
+    }
+
+    SECTION("Abandoned batch releases completed results")
+    {
+        LeaderboardBatch abandoned(2, nullptr);
+        abandoned.complete(0, Error::Success, first);
+        // Destructor frees the handle, checked by sanitizers
+    }
+}
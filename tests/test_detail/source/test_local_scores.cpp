@@ -0,0 +1,307 @@
+/*
+ * Scorbit SDK
+ *
+ * (c) 2025 Spinner Systems, Inc. (DBA Scorbit), scrobit.io, All Rights Reserved
+ *
+ * MIT License
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "local_scores.h"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+
+using namespace scorbit;
+using namespace scorbit::detail;
+using namespace std::chrono_literals;
+
+namespace fs = boost::filesystem;
+
+namespace {
+
+constexpr int64_t DAY = 24 * 60 * 60;
+constexpr int64_t NOW = 1775037600; // 2026-04-01T10:00:00Z
+
+LocalScore makeScore(sb_score_t score, int64_t playedAt = NOW, std::string initials = {})
+{
+    LocalScore result;
+    result.playedAt = playedAt;
+    result.score = score;
+    result.player = 1;
+    result.initials = std::move(initials);
+    return result;
+}
+
+std::vector<sb_score_t> scoresOf(const std::vector<LocalScore> &scores)
+{
+    std::vector<sb_score_t> result;
+    for (const auto &score : scores) {
+        result.push_back(score.score);
+    }
+    return result;
+}
+
+const LeaderboardQuery localQuery {LeaderboardScope::Local, LeaderboardPeriod::AllTime, "",
+                                   LeaderboardVpinFilter::Any};
+
+std::chrono::system_clock::time_point timePoint(int64_t timestamp)
+{
+    return std::chrono::system_clock::time_point {std::chrono::seconds {timestamp}};
+}
+
+struct TempFile {
+    const fs::path path {fs::temp_directory_path() / fs::unique_path("local_scores_%%%%-%%%%")};
+    ~TempFile() { fs::remove(path); }
+};
+
+} // namespace
+
+TEST_CASE("Local scores top is ordered and filtered by time", "[local_scores]")
+{
+    LocalScoreIndex index;
+    index.add(makeScore(300, NOW - 20 * DAY));
+    index.add(makeScore(500, NOW - 2 * DAY, "AAA"));
+    index.add(makeScore(100, NOW));
+    index.add(makeScore(500, NOW - DAY, "BBB"));
+    index.add(makeScore(900, NOW - 400 * DAY));
+    REQUIRE(index.size() == 5);
+
+    CHECK(scoresOf(index.top(10)) == std::vector<sb_score_t> {900, 500, 500, 300, 100});
+    CHECK(scoresOf(index.top(2)) == std::vector<sb_score_t> {900, 500});
+    CHECK(scoresOf(index.top(10, NOW - 14 * DAY)) == std::vector<sb_score_t> {500, 500, 100});
+    CHECK(index.top(0).empty());
+
+    // Who got the score first ranks higher
+    const auto top = index.top(3);
+    CHECK(top[1].initials == "AAA");
+    CHECK(top[2].initials == "BBB");
+}
+
+TEST_CASE("Local scores keep the best ones when full", "[local_scores]")
+{
+    LocalScoreIndex index(4); // Keeps 2 best ones
+
+    index.add(makeScore(1000, NOW - 10));
+    index.add(makeScore(10, NOW - 9));
+    index.add(makeScore(900, NOW - 8));
+    index.add(makeScore(20, NOW - 7));
+    index.add(makeScore(30, NOW - 6)); // Replaces 10, the oldest below the best
+    index.add(makeScore(40, NOW - 5)); // Replaces 20
+
+    REQUIRE(index.size() == 4);
+    CHECK(scoresOf(index.top(10)) == std::vector<sb_score_t> {1000, 900, 40, 30});
+}
+
+TEST_CASE("Local scores are truncated to record fields", "[local_scores]")
+{
+    LocalScoreIndex index;
+    auto score = makeScore(100);
+    score.displayName = std::string(38, 'x') + "\xc3\xa9\xc3\xa9"; // Ends with "éé"
+    score.playerId = "player-uuid";
+    index.add(score);
+
+    const auto top = index.top(1);
+    REQUIRE(top.size() == 1);
+    CHECK(top[0].playerId == "player-uuid");
+    CHECK(top[0].displayName == std::string(38, 'x') + "\xc3\xa9"); // No half of character
+}
+
+TEST_CASE("Local scores persist in the file", "[local_scores]")
+{
+    TempFile file;
+
+    {
+        LocalScoreIndex index;
+        index.add(makeScore(100)); // Added before the file is opened
+        REQUIRE(index.open(file.path.string()));
+        index.add(makeScore(200, NOW, "ABC"));
+    }
+
+    {
+        LocalScoreIndex index;
+        REQUIRE(index.open(file.path.string()));
+        REQUIRE(index.size() == 2);
+        const auto top = index.top(10);
+        CHECK(scoresOf(top) == std::vector<sb_score_t> {200, 100});
+        CHECK(top[0].initials == "ABC");
+    }
+
+    SECTION("Different layout starts over")
+    {
+        LocalScoreIndex index(16);
+        REQUIRE(index.open(file.path.string()));
+        CHECK(index.size() == 0);
+    }
+
+    SECTION("Corrupted file starts over")
+    {
+        {
+            std::ofstream out(file.path.string(), std::ios::binary | std::ios::in);
+            out << "garbage";
+        }
+        LocalScoreIndex index;
+        REQUIRE(index.open(file.path.string()));
+        CHECK(index.size() == 0);
+    }
+
+    SECTION("Unusable path keeps scores in memory")
+    {
+        LocalScoreIndex index;
+        CHECK_FALSE(index.open((file.path / "missing" / "scores").string()));
+        index.add(makeScore(100));
+        CHECK(index.size() == 1);
+    }
+}
+
+TEST_CASE("Local leaderboard merges new scores into server one", "[local_scores]")
+{
+    LocalScoreIndex index;
+    index.add(makeScore(5000, NOW - 2 * DAY, "OLD")); // Already on the server
+    index.add(makeScore(7000, NOW - 60, "NEW"));
+    index.add(makeScore(3000, NOW - 30, "TIE"));
+
+    auto server = std::make_shared<LeaderboardData>();
+    for (const sb_score_t score : {8000, 5000, 3000}) {
+        const auto i = server->addEntry();
+        server->highScores[i] = score;
+        server->ids[i] = static_cast<uint64_t>(score);
+        server->setString(LeaderboardString::PlayerInitials, i, "SRV");
+    }
+
+    const auto now = timePoint(NOW);
+
+    SECTION("Without server leaderboard")
+    {
+        const auto data = makeLocalLeaderboard(index, localQuery, nullptr, {}, now);
+        REQUIRE(data->size() == 3);
+        CHECK(data->highScores == std::vector<sb_score_t> {7000, 5000, 3000});
+        CHECK(data->ranks == std::vector<int> {1, 2, 3});
+        CHECK(data->stringView(LeaderboardString::PlayerInitials, 0) == "NEW");
+        CHECK(data->stringView(LeaderboardString::Created, 0) == "2026-04-01T09:59:00Z");
+    }
+
+    SECTION("Merged with server leaderboard fetched a day ago")
+    {
+        const auto data = makeLocalLeaderboard(index, localQuery, server.get(),
+                                               timePoint(NOW - DAY), now);
+        REQUIRE(data->size() == 5);
+        CHECK(data->highScores == std::vector<sb_score_t> {8000, 7000, 5000, 3000, 3000});
+        CHECK(data->ranks == std::vector<int> {1, 2, 3, 4, 4});
+        CHECK(data->ids == std::vector<uint64_t> {8000, 0, 5000, 3000, 0});
+        CHECK(data->stringView(LeaderboardString::PlayerInitials, 1) == "NEW");
+        CHECK(data->stringView(LeaderboardString::PlayerInitials, 3) == "SRV");
+        CHECK(data->stringView(LeaderboardString::PlayerInitials, 4) == "TIE");
+    }
+
+    SECTION("Period applies to local scores")
+    {
+        auto query = localQuery;
+        query.period = LeaderboardPeriod::Days14;
+        index.add(makeScore(9000, NOW - 20 * DAY));
+        const auto data = makeLocalLeaderboard(index, query, nullptr, {}, now);
+        CHECK(data->highScores == std::vector<sb_score_t> {7000, 5000, 3000});
+
+        query.since = "2026-04-01T09:59:30Z";
+        CHECK(makeLocalLeaderboard(index, query, nullptr, {}, now)->highScores
+              == std::vector<sb_score_t> {3000});
+    }
+
+    SECTION("Virtual pinball only has no local scores")
+    {
+        auto query = localQuery;
+        query.vpinFilter = LeaderboardVpinFilter::VpinOnly;
+        CHECK(makeLocalLeaderboard(index, query, nullptr, {}, now)->size() == 0);
+    }
+}
+
+TEST_CASE("Local leaderboard lists each player once", "[local_scores]")
+{
+    const auto claimed = [](sb_score_t score, std::string playerId) {
+        auto result = makeScore(score, NOW - 60);
+        result.playerId = std::move(playerId);
+        return result;
+    };
+
+    LocalScoreIndex index;
+    index.add(claimed(4000, "alice"));
+    index.add(claimed(6000, "alice"));
+    index.add(claimed(2000, "alice"));
+    index.add(claimed(5000, "bob"));
+    index.add(makeScore(1000));
+    index.add(makeScore(1000));
+
+    auto server = std::make_shared<LeaderboardData>();
+    for (const auto &[score, playerId] :
+         std::vector<std::pair<sb_score_t, std::string>> {{7000, "bob"}, {5000, "alice"}}) {
+        const auto i = server->addEntry();
+        server->highScores[i] = score;
+        server->ids[i] = static_cast<uint64_t>(score);
+        server->setString(LeaderboardString::PlayerId, i, playerId);
+    }
+
+    const auto now = timePoint(NOW);
+
+    SECTION("Best local score of the player")
+    {
+        const auto data = makeLocalLeaderboard(index, localQuery, nullptr, {}, now);
+        CHECK(data->highScores == std::vector<sb_score_t> {6000, 5000, 1000, 1000});
+        CHECK(data->stringView(LeaderboardString::PlayerId, 0) == "alice");
+        CHECK(data->stringView(LeaderboardString::PlayerId, 1) == "bob");
+    }
+
+    SECTION("Better local score replaces server entry of the player")
+    {
+        const auto data = makeLocalLeaderboard(index, localQuery, server.get(),
+                                               timePoint(NOW - DAY), now);
+        CHECK(data->highScores == std::vector<sb_score_t> {7000, 6000, 1000, 1000});
+        CHECK(data->ids == std::vector<uint64_t> {7000, 0, 0, 0});
+        CHECK(data->stringView(LeaderboardString::PlayerId, 0) == "bob");
+        CHECK(data->stringView(LeaderboardString::PlayerId, 1) == "alice");
+    }
+
+    SECTION("Local score equal to server one is not listed twice")
+    {
+        index.add(claimed(7000, "bob"));
+        const auto data = makeLocalLeaderboard(index, localQuery, server.get(),
+                                               timePoint(NOW - DAY), now);
+        CHECK(data->highScores == std::vector<sb_score_t> {7000, 6000, 1000, 1000});
+        CHECK(data->ids == std::vector<uint64_t> {7000, 0, 0, 0});
+    }
+}
+
+TEST_CASE("Local leaderboard rejects unknown period", "[local_scores]")
+{
+    LocalScoreIndex index;
+    index.add(makeScore(1000));
+
+    auto query = localQuery;
+    query.period = static_cast<LeaderboardPeriod>(100);
+    CHECK(makeLocalLeaderboard(index, query, nullptr, {}, timePoint(NOW)) == nullptr);
+}
+
+TEST_CASE("Local scores benchmark", "[.][benchmark][local_scores]")
+{
+    LocalScoreIndex index;
+    for (int i = 0; i < static_cast<int>(LOCAL_SCORES_CAPACITY); ++i) {
+        index.add(makeScore((i * 7919) % 100000, NOW - i * 600));
+    }
+
+    BENCHMARK("top 10 of full index")
+    {
+        return index.top(LOCAL_LEADERBOARD_SIZE, NOW - 30 * DAY);
+    };
+}
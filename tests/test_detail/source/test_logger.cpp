@@ -20,12 +20,18 @@
 #include <logger/logger.h>
 #include <scorbit_sdk/log.h>
 
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_vector.hpp>
 #include <catch2/trompeloeil.hpp>
 #include <thread>
 #include <random>
 #include <chrono>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
 
 // clazy:excludeall=non-pod-global-static
 
@@ -217,3 +223,494 @@ TEST_CASE("logger multithread")
 
     resetLogger();
 }
+
+TEST_CASE("logger level threshold")
+{
+    std::vector<std::string> logs;
+    scorbit::addLoggerCallback([&logs](std::string_view msg, scorbit::LogLevel, const char *, int,
+                                       int64_t) { logs.emplace_back(msg); }, 512);
+
+    int formatted = 0;
+    const auto arg = [&formatted]() {
+        ++formatted;
+        return formatted;
+    };
+
+    setLogLevel(LogLevel::Warn);
+    CHECK(logLevel() == LogLevel::Warn);
+    DBG("Debug {}", arg());
+    INF("Info {}", arg());
+    WRN("Warn {}", arg());
+    ERR("Error {}", arg());
+    sleepForLogger();
+
+    // Arguments of disabled calls are not even evaluated
+    CHECK(formatted == 2);
+    CHECK(logs == std::vector<std::string> {"Warn 1", "Error 2"});
+
+    setLogLevel(LogLevel::Debug);
+    DBG("Debug {}", arg());
+    sleepForLogger();
+    CHECK(logs.back() == "Debug 3");
+
+    resetLogger();
+}
+
+TEST_CASE("logger disabled call benchmark", "[.][benchmark]")
+{
+    setLogLevel(LogLevel::Info);
+    const std::string reply(1000, 'x');
+
+    BENCHMARK("Disabled DBG")
+    {
+        DBG("API {} request to {} OK, {}", "GET", "https://api.scorbit.io/", reply);
+    };
+
+    setLogLevel(LogLevel::Debug);
+}
+
+TEST_CASE("logger rate limit")
+{
+    std::mutex mutex;
+    std::vector<std::string> logs;
+    scorbit::addLoggerCallback(
+            [&](std::string_view msg, scorbit::LogLevel, const char *, int, int64_t) {
+                std::scoped_lock lock(mutex);
+                logs.emplace_back(msg);
+            },
+            512);
+
+    const auto logRepeated = [](int i, std::chrono::milliseconds interval) {
+        WRN_EVERY(interval, "Connection failed {}", i);
+    };
+
+    for (int i = 0; i < 10; ++i) {
+        logRepeated(i, 50ms);
+    }
+    sleepForLogger();
+    {
+        std::scoped_lock lock(mutex);
+        CHECK(logs == std::vector<std::string> {"Connection failed 0"});
+    }
+
+    std::this_thread::sleep_for(60ms);
+    logRepeated(10, 50ms);
+    sleepForLogger();
+    {
+        std::scoped_lock lock(mutex);
+        CHECK(logs
+              == std::vector<std::string> {"Connection failed 0", "Suppressed 9 similar messages",
+                                           "Connection failed 10"});
+    }
+
+    // Quiet site goes straight through, without a summary
+    std::this_thread::sleep_for(60ms);
+    logRepeated(11, 50ms);
+    sleepForLogger();
+    {
+        std::scoped_lock lock(mutex);
+        CHECK(logs.size() == 4);
+        CHECK(logs.back() == "Connection failed 11");
+    }
+
+    // Calls below the log level are not counted
+    setLogLevel(LogLevel::Error);
+    logRepeated(12, 50ms);
+    setLogLevel(LogLevel::Debug);
+
+    const auto stats = logRateLimitedSites();
+    const auto site = std::find_if(stats.begin(), stats.end(), [](const LogSiteStats &s) {
+        return std::string_view(s.file) == "test_logger.cpp";
+    });
+    REQUIRE(site != stats.end());
+    CHECK(site->logged == 3);
+    CHECK(site->suppressed == 9);
+
+    resetLogger();
+}
+
+TEST_CASE("logger rate limited call benchmark", "[.][benchmark]")
+{
+    std::atomic<int> delivered {0};
+    scorbit::addLoggerCallback([&delivered](std::string_view, scorbit::LogLevel, const char *, int,
+                                            int64_t) { ++delivered; }, 512);
+    const std::string reply(1000, 'x');
+
+    BENCHMARK("Throttled WRN_EVERY")
+    {
+        WRN_EVERY(1h, "API {} request to {} FAILED, reply: {}", "GET", "https://api.scorbit.io/",
+                  reply);
+    };
+
+    resetLogger();
+}
+
+namespace {
+
+enum class Color { Red, Green };
+
+struct Wrapped {
+    int value;
+};
+
+} // namespace
+
+template<>
+struct fmt::formatter<Color> : fmt::formatter<std::string_view> {
+    auto format(Color c, fmt::format_context &ctx) const
+    {
+        return fmt::formatter<std::string_view>::format(c == Color::Red ? "red" : "green", ctx);
+    }
+};
+
+template<>
+struct fmt::formatter<Wrapped> : fmt::formatter<int> {
+    auto format(const Wrapped &w, fmt::format_context &ctx) const
+    {
+        return fmt::formatter<int>::format(w.value, ctx);
+    }
+};
+
+TEST_CASE("logger deferred format")
+{
+    std::mutex mutex;
+    std::vector<std::string> logs;
+    scorbit::addLoggerCallback(
+            [&](std::string_view msg, scorbit::LogLevel, const char *, int, int64_t) {
+                std::scoped_lock lock {mutex};
+                logs.emplace_back(msg);
+            }, 512);
+
+    const auto waitForLogs = [&](size_t count) {
+        for (int i = 0; i < 500; ++i) {
+            {
+                std::scoped_lock lock {mutex};
+                if (logs.size() >= count) {
+                    return;
+                }
+            }
+            sleepForLogger();
+        }
+    };
+
+    setLogDeferredFormat(true);
+
+    SECTION("Arguments are copied and formatted later")
+    {
+        std::string text = "player";
+        const char *cstr = "ramp";
+        INF("{} {} scored {} at {:.1f}, {}, {}", text, std::string_view {"one"}, 42, 1.5, cstr,
+            Color::Green);
+        text = "changed";
+        WRN("Wrapped {}", Wrapped {7}); // Formatted on the spot, not a plain value
+        ERR("No args");
+        waitForLogs(3);
+
+        std::scoped_lock lock {mutex};
+        CHECK(logs
+              == std::vector<std::string> {"player one scored 42 at 1.5, ramp, green", "Wrapped 7",
+                                           "No args"});
+    }
+
+    SECTION("Order of thread messages is kept")
+    {
+        constexpr int threadCount = 4;
+        constexpr int perThread = 200;
+        std::vector<std::thread> threads;
+        for (int t = 0; t < threadCount; ++t) {
+            threads.emplace_back([t]() {
+                for (int i = 0; i < perThread; ++i) {
+                    INF("{} {}", t, i);
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        waitForLogs(threadCount * perThread);
+
+        std::scoped_lock lock {mutex};
+        REQUIRE(logs.size() == threadCount * perThread);
+        std::vector<int> next(threadCount, 0);
+        for (const auto &log : logs) {
+            const auto space = log.find(' ');
+            const auto t = std::stoi(log.substr(0, space));
+            CHECK(std::stoi(log.substr(space + 1)) == next[t]++);
+        }
+    }
+
+    SECTION("Full buffer drops and counts messages")
+    {
+        const auto droppedBefore = logDroppedCount();
+        setLogDeferredFormat(true, 4096);
+
+        // New thread gets the small buffer; block the logger thread in the callback meanwhile
+        std::mutex blockMutex;
+        std::condition_variable blocked;
+        bool release = false;
+        std::atomic<bool> inCallback {false};
+        scorbit::addLoggerCallback(
+                [&](std::string_view msg, scorbit::LogLevel, const char *, int, int64_t) {
+                    if (msg == "block") {
+                        inCallback = true;
+                        std::unique_lock lock {blockMutex};
+                        blocked.wait(lock, [&] { return release; });
+                    }
+                }, 512);
+
+        std::thread([&]() {
+            ERR("block"); // Error wakes the logger thread right away
+            while (!inCallback) {
+                sleepForLogger();
+            }
+            for (int i = 0; i < 1000; ++i) {
+                INF("Message {}", i);
+            }
+        }).join();
+
+        {
+            std::scoped_lock lock {blockMutex};
+            release = true;
+        }
+        blocked.notify_all();
+
+        const auto dropped = logDroppedCount() - droppedBefore;
+        CHECK(dropped > 0);
+        CHECK(dropped < 1000);
+        waitForLogs(1001 - dropped + 1);
+
+        std::scoped_lock lock {mutex};
+        CHECK(logs.size() == 1001 - dropped + 1);
+        CHECK(std::count(logs.begin(), logs.end(),
+                         fmt::format("Log buffer full, dropped {} messages", dropped))
+              == 1);
+    }
+
+    setLogDeferredFormat(false);
+    resetLogger();
+}
+
+TEST_CASE("logger batch callback")
+{
+    std::mutex mutex;
+    std::vector<std::vector<std::string>> batches;
+    const auto collect = [&](const LogRecord *records, size_t count) {
+        std::vector<std::string> batch;
+        for (size_t i = 0; i < count; ++i) {
+            batch.emplace_back(records[i].message);
+        }
+        std::scoped_lock lock {mutex};
+        batches.push_back(std::move(batch));
+    };
+    const auto waitForBatches = [&](size_t count) {
+        for (int i = 0; i < 500; ++i) {
+            {
+                std::scoped_lock lock {mutex};
+                if (batches.size() >= count) {
+                    return;
+                }
+            }
+            sleepForLogger();
+        }
+    };
+
+    SECTION("Delivered by count")
+    {
+        setLoggerBatchCallback(collect, 3, 10000);
+        for (int i = 0; i < 7; ++i) {
+            INF("Message {}", i);
+        }
+        waitForBatches(2);
+
+        std::scoped_lock lock {mutex};
+        REQUIRE(batches.size() == 2);
+        CHECK(batches[0] == std::vector<std::string> {"Message 0", "Message 1", "Message 2"});
+        CHECK(batches[1] == std::vector<std::string> {"Message 3", "Message 4", "Message 5"});
+    }
+
+    SECTION("Delivered after delay")
+    {
+        setLoggerBatchCallback(collect, 100, 20);
+        const auto start = std::chrono::steady_clock::now();
+        INF("First");
+        INF("Second");
+        waitForBatches(1);
+
+        std::scoped_lock lock {mutex};
+        CHECK(std::chrono::steady_clock::now() - start >= 20ms);
+        REQUIRE(batches.size() == 1);
+        CHECK(batches[0] == std::vector<std::string> {"First", "Second"});
+    }
+
+    SECTION("Error is delivered right away")
+    {
+        setLoggerBatchCallback(collect, 100, 10000);
+        INF("Info");
+        ERR("Error");
+        waitForBatches(1);
+
+        std::scoped_lock lock {mutex};
+        REQUIRE(batches.size() == 1);
+        CHECK(batches[0] == std::vector<std::string> {"Info", "Error"});
+    }
+
+    SECTION("Long message is truncated, details are kept")
+    {
+        std::vector<LogRecord> copies;
+        std::string message;
+        setLoggerBatchCallback(
+                [&](const LogRecord *records, size_t count) {
+                    std::scoped_lock lock {mutex};
+                    copies.assign(records, records + count);
+                    message = records[0].message;
+                    batches.emplace_back();
+                },
+                1, 0, 8);
+        WRN("Long message");
+        const int line = __LINE__ - 1;
+        waitForBatches(1);
+
+        std::scoped_lock lock {mutex};
+        REQUIRE(copies.size() == 1);
+        CHECK(message.size() == 7);
+        CHECK(copies[0].level == SB_WARN);
+        CHECK(copies[0].line == line);
+        CHECK(std::string_view {copies[0].file} == "test_logger.cpp");
+    }
+
+    SECTION("Replaced callback gets its batch first")
+    {
+        std::atomic<bool> logged {false};
+        scorbit::addLoggerCallback([&](std::string_view, scorbit::LogLevel, const char *, int,
+                                       int64_t) { logged = true; }, 512);
+        setLoggerBatchCallback(collect, 100, 10000);
+        INF("Pending");
+        for (int i = 0; i < 500 && !logged; ++i) {
+            sleepForLogger();
+        }
+        sleepForLogger(); // Batched right after the other callbacks
+
+        setLoggerBatchCallback([](const LogRecord *, size_t) {});
+
+        std::scoped_lock lock {mutex};
+        REQUIRE(batches.size() == 1);
+        CHECK(batches[0] == std::vector<std::string> {"Pending"});
+    }
+
+    SECTION("Removed callback is not invoked")
+    {
+        setLoggerBatchCallback(collect, 1, 0);
+        setLoggerBatchCallback({});
+        INF("Nobody");
+        sleepForLogger();
+
+        std::scoped_lock lock {mutex};
+        CHECK(batches.empty());
+    }
+
+    resetLogger();
+}
+
+namespace {
+
+struct ReceivedLogs {
+    std::mutex mutex;
+    std::vector<std::string> first;
+    std::vector<std::string> second;
+    std::vector<std::string> batch;
+};
+
+void secondCallback(const char *message, sb_log_level_t, const char *, int, int64_t,
+                    void *userData)
+{
+    auto &received = *static_cast<ReceivedLogs *>(userData);
+    std::scoped_lock lock {received.mutex};
+    received.second.emplace_back(message);
+}
+
+void batchCallback(const sb_log_record_t *records, size_t count, void *userData)
+{
+    auto &received = *static_cast<ReceivedLogs *>(userData);
+    std::scoped_lock lock {received.mutex};
+    for (size_t i = 0; i < count; ++i) {
+        received.batch.emplace_back(records[i].message);
+    }
+}
+
+void setupCallback(const char *message, sb_log_level_t, const char *, int, int64_t,
+                   void *userData)
+{
+    const std::string_view text {message};
+    if (text == "Add") {
+        sb_add_logger_callback(secondCallback, userData, 512);
+    } else if (text == "Batch") {
+        sb_log_set_batch_callback(batchCallback, userData, 1, 0, 512);
+    } else if (text == "Reset") {
+        sb_reset_logger();
+    }
+
+    auto &received = *static_cast<ReceivedLogs *>(userData);
+    std::scoped_lock lock {received.mutex};
+    received.first.emplace_back(text);
+}
+
+} // namespace
+
+TEST_CASE("logger callbacks may set up the logger")
+{
+    // Would deadlock if the logger was locked while calling them
+    ReceivedLogs received;
+    sb_add_logger_callback(setupCallback, &received, 512);
+
+    for (const auto *message : {"Add", "Batch", "Message", "Reset", "Ignored"}) {
+        INF("{}", message);
+    }
+    for (int i = 0; i < 500; ++i) {
+        {
+            std::scoped_lock lock {received.mutex};
+            if (received.first.size() >= 4) {
+                break;
+            }
+        }
+        sleepForLogger();
+    }
+    sleepForLogger();
+
+    std::scoped_lock lock {received.mutex};
+    CHECK(received.first == std::vector<std::string> {"Add", "Batch", "Message", "Reset"});
+    CHECK(received.second == std::vector<std::string> {"Batch", "Message"});
+    CHECK(received.batch == std::vector<std::string> {"Batch", "Message"});
+}
+
+TEST_CASE("logger call site latency benchmark", "[.][benchmark]")
+{
+    scorbit::addLoggerCallback([](std::string_view, scorbit::LogLevel, const char *, int,
+                                  int64_t) {}, 512);
+
+    const auto p99 = [](bool deferred) {
+        setLogDeferredFormat(deferred);
+        constexpr int count = 2000;
+        std::vector<std::chrono::nanoseconds> latencies;
+        latencies.reserve(count * 10);
+        for (int batch = 0; batch < 10; ++batch) {
+            for (int i = 0; i < count; ++i) {
+                const auto start = std::chrono::steady_clock::now();
+                INF("API sending game data to channel: {}, score: {}, feature: {}",
+                    "machine:1234", i * 1000, "ramp");
+                latencies.push_back(std::chrono::steady_clock::now() - start);
+            }
+            sleepForLogger(); // Let the logger thread catch up, as between game updates
+            std::this_thread::sleep_for(20ms);
+        }
+        std::sort(latencies.begin(), latencies.end());
+        return latencies[latencies.size() * 99 / 100];
+    };
+
+    const auto immediate = p99(false);
+    const auto deferred = p99(true);
+    std::cout << "Log call p99, immediate: " << immediate.count()
+              << " ns, deferred: " << deferred.count() << " ns" << std::endl;
+
+    setLogDeferredFormat(false);
+    resetLogger();
+}
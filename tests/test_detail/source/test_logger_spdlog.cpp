@@ -0,0 +1,124 @@
+/*
+ * Scorbit SDK
+ *
+ * (c) 2025 Spinner Systems, Inc. (DBA Scorbit), scrobit.io, All Rights Reserved
+ *
+ * MIT License
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <logger/logger_spdlog.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <boost/filesystem.hpp>
+#include <fmt/format.h>
+
+#include <fstream>
+#include <string>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+namespace fs = boost::filesystem;
+
+namespace {
+
+/// Directory of the log files, logging goes back to the console when done, so they are closed
+struct LogDir {
+    const fs::path path {fs::temp_directory_path() / fs::unique_path("logger_spdlog_%%%%-%%%%")};
+    const fs::path file {path / "sdk.log"};
+
+    LogDir() { fs::create_directories(path); }
+
+    ~LogDir()
+    {
+        logger::Logger::instance()->initLogger(logger::LogLevel::Debug, logger::NONE, "", 0, 0);
+        fs::remove_all(path);
+    }
+};
+
+void logInfo(const std::string &message)
+{
+    logger::Logger::instance()->logImpl(message, logger::LogLevel::Info, __FILE__, __LINE__);
+}
+
+size_t countLines(const fs::path &path)
+{
+    std::ifstream in(path.string());
+    size_t count = 0;
+    for (std::string line; std::getline(in, line);) {
+        ++count;
+    }
+    return count;
+}
+
+} // namespace
+
+TEST_CASE("spdlog logger gzips rotated files", "[logger_spdlog]")
+{
+    LogDir dir;
+    logger::Logger::instance()->initLogger(logger::LogLevel::Debug, logger::NONE,
+                                           dir.file.string(), 1024, 3);
+
+    const std::string line(100, 'x');
+    for (int i = 0; i < 15; ++i) {
+        logInfo(line); // Rotates once, when 1 KiB is written
+    }
+    logger::Logger::instance()->flush();
+
+    // Compressed on a background thread, the rotated file is removed when done
+    std::vector<std::string> gzipped;
+    std::vector<std::string> uncompressed;
+    for (int i = 0; i < 500; ++i) {
+        gzipped.clear();
+        uncompressed.clear();
+        for (const auto &entry : fs::directory_iterator(dir.path)) {
+            if (entry.path() == dir.file) {
+                continue;
+            }
+            auto &files = entry.path().extension() == ".gz" ? gzipped : uncompressed;
+            files.push_back(entry.path().filename().string());
+        }
+        if (!gzipped.empty() && uncompressed.empty()) {
+            break;
+        }
+        std::this_thread::sleep_for(10ms);
+    }
+
+    CHECK(gzipped.size() == 1);
+    CHECK(uncompressed.empty());
+}
+
+TEST_CASE("spdlog async logger counts messages it drops", "[logger_spdlog]")
+{
+    LogDir dir;
+    logger::LoggerOptions options;
+    options.async = true;
+    options.queueSize = 16;
+    options.overflow = logger::Overflow::DropNew;
+    options.flushInterval = 0ms; // Periodic flush could be dropped and counted as well
+    logger::Logger::instance()->initLogger(logger::LogLevel::Debug, logger::NONE,
+                                           dir.file.string(), 64 * 1024 * 1024, 2, 512, options);
+
+    constexpr size_t COUNT = 20000;
+    for (size_t i = 0; i < COUNT; ++i) {
+        logInfo(fmt::format("Message {}", i));
+    }
+    const auto dropped = logger::Logger::instance()->droppedCount();
+
+    // Replaced pool writes out its queue
+    logger::Logger::instance()->initLogger(logger::LogLevel::Debug, logger::NONE, "", 0, 0);
+
+    CHECK(dropped > 0);
+    CHECK(countLines(dir.file) + dropped == COUNT);
+}
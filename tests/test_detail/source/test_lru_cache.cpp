@@ -87,3 +87,39 @@ TEST_CASE("LRUCache basic put/get operations", "[lru]") {
         CHECK(cache.has("url2"));
     }
 }
+
+TEST_CASE("LRUCache with size budget", "[lru]") {
+    const auto bytes = [](const std::vector<uint8_t> &v) { return v.size(); };
+    LRUCache<std::string, std::vector<uint8_t>, decltype(bytes)> cache(10, bytes);
+
+    SECTION("Evicts until total size fits") {
+        cache.put("url1", std::vector<uint8_t>(4));
+        cache.put("url2", std::vector<uint8_t>(4));
+        CHECK(cache.totalCost() == 8);
+
+        cache.put("url3", std::vector<uint8_t>(6)); // Should evict url1 only
+        CHECK_FALSE(cache.has("url1"));
+        CHECK(cache.has("url2"));
+        CHECK(cache.has("url3"));
+        CHECK(cache.totalCost() == 10);
+
+        cache.put("url4", std::vector<uint8_t>(5)); // Should evict url2 and url3
+        CHECK_FALSE(cache.has("url2"));
+        CHECK_FALSE(cache.has("url3"));
+        CHECK(cache.totalCost() == 5);
+    }
+
+    SECTION("Overwrite updates size") {
+        cache.put("url1", std::vector<uint8_t>(4));
+        cache.put("url1", std::vector<uint8_t>(2));
+        CHECK(cache.totalCost() == 2);
+        CHECK(cache.size() == 1);
+    }
+
+    SECTION("Entry bigger than budget is not cached") {
+        cache.put("url1", std::vector<uint8_t>(4));
+        cache.put("big", std::vector<uint8_t>(11));
+        CHECK_FALSE(cache.has("big"));
+        CHECK(cache.totalCost() == 0);
+    }
+}
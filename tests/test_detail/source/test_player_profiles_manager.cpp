@@ -18,10 +18,12 @@
  */
 
 #include "player_profiles_manager.h"
+#include "utils/date_time_parser.h"
 
 #include <nlohmann/json.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <trompeloeil.hpp>
+#include <boost/filesystem.hpp>
 
 using namespace scorbit;
 using namespace scorbit::detail;
@@ -72,7 +74,11 @@ TEST_CASE("PlayerProfile 1 player")
     REQUIRE(pm.hasPicture(avatarUrl));
 
     auto p1Picture = pm.picture(avatarUrl);
-    CHECK(p1Picture == picture);
+    REQUIRE(p1Picture);
+    CHECK(*p1Picture == picture);
+
+    // Picture is shared, not copied
+    CHECK(pm.picture(avatarUrl) == p1Picture);
 }
 
 TEST_CASE("PlayerProfile 2 players with unclaimed slot")
@@ -256,3 +262,53 @@ TEST_CASE("No change returns nullopt")
     auto result2 = pm.setProfiles(profiles, TEST_MACHINE_UUID);
     CHECK_FALSE(result2.has_value());
 }
+
+TEST_CASE("Player pictures cache")
+{
+    const std::string avatarUrl {"https://cdn-staging.scorbit.io/profile_pictures/dilshodm.jpg"};
+    const Picture picture {1, 2, 3};
+
+    SECTION("pending download is not a picture")
+    {
+        PlayerProfilesManager pm;
+        pm.setPicture(avatarUrl, Picture {});
+        CHECK(pm.hasPicture(avatarUrl));
+        CHECK_FALSE(pm.picture(avatarUrl));
+    }
+
+    SECTION("memory budget evicts least recently used")
+    {
+        PlayerProfilesManager pm;
+        const Picture big(MAX_PICTURES_CACHE_BYTES / 2);
+        pm.setPicture("url1", big);
+        pm.setPicture("url2", big);
+        CHECK_FALSE(pm.hasPicture("url1"));
+        CHECK(pm.hasPicture("url2"));
+    }
+
+    SECTION("persisted on disk with etag")
+    {
+        namespace fs = boost::filesystem;
+        const auto dir = fs::temp_directory_path() / fs::unique_path();
+        {
+            PlayerProfilesManager pm;
+            pm.setCacheDir(dir.string());
+            pm.setPicture(avatarUrl, picture, "\"etag1\"");
+        }
+
+        PlayerProfilesManager pm;
+        pm.setCacheDir(dir.string());
+        CHECK_FALSE(pm.hasPicture(avatarUrl));
+
+        const auto cached = pm.loadFromDisk(avatarUrl);
+        REQUIRE(cached.picture);
+        CHECK(*cached.picture == picture);
+        CHECK(cached.etag == "\"etag1\"");
+        CHECK(parseHttpDateToUnixTimestamp(cached.lastModified) > 0);
+        CHECK(pm.picture(avatarUrl) == cached.picture);
+
+        CHECK_FALSE(pm.loadFromDisk("https://example.com/other.jpg").picture);
+
+        fs::remove_all(dir);
+    }
+}
@@ -0,0 +1,192 @@
+/*
+ * Scorbit SDK
+ *
+ * (c) 2025 Spinner Systems, Inc. (DBA Scorbit), scrobit.io, All Rights Reserved
+ *
+ * MIT License
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "publication_router.h"
+#include "identifiers.h"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace scorbit::detail;
+using json = nlohmann::json;
+
+namespace {
+
+json publication(std::string_view type, std::string_view method = {},
+                 std::string_view action = {})
+{
+    json payload = json::object();
+    if (!method.empty()) {
+        payload[JKEY_METHOD] = method;
+    }
+    if (!action.empty()) {
+        payload[JKEY_ACTION_NAME] = action;
+    }
+    return {{JKEY_CHN_TYPE, type}, {JKEY_CHN_PAYLOAD, payload}};
+}
+
+} // namespace
+
+TEST_CASE("PublicationRouter dispatch", "[PublicationRouter]")
+{
+    PublicationRouter router;
+    std::vector<std::string> called;
+    const auto handler = [&called](std::string name) {
+        return [&called, name](const json &) { called.push_back(name); };
+    };
+
+    REQUIRE(router.add({CF_CHN_CONTROL_MACHINE, "start_game", {}, {}}, handler("start")));
+    REQUIRE(router.add({CF_CHN_CONTROL_MACHINE, "action", "MSG", {}}, handler("msg")));
+    REQUIRE(router.add({CF_CHN_CONTROL_MACHINE, "action", "MSG", "custom"}, handler("custom")));
+    REQUIRE(router.add({CF_CHN_CONTROL_MACHINE, "action", "GET", "session"}, handler("get")));
+    REQUIRE(router.add({CF_CHN_CONTROL_SCORBITRON, "action", "SIGNAL", "paired"},
+                       handler("paired")));
+    REQUIRE(router.size() == 5);
+
+    const std::string machineChannel = "control_machine:1234";
+    const std::string scorbitronChannel = "control_scorbitron:abcd";
+
+    SECTION("Routes by channel prefix and type")
+    {
+        REQUIRE(router.dispatch(machineChannel, publication("start_game")));
+        REQUIRE(router.dispatch(scorbitronChannel, publication("action", "SIGNAL", "paired")));
+        REQUIRE_FALSE(router.dispatch(scorbitronChannel, publication("start_game")));
+        REQUIRE_FALSE(router.dispatch(machineChannel, publication("action", "SIGNAL", "paired")));
+        REQUIRE_FALSE(router.dispatch("machine:1234", publication("start_game")));
+        REQUIRE(called == std::vector<std::string> {"start", "paired"});
+    }
+
+    SECTION("The most specific route wins")
+    {
+        REQUIRE(router.dispatch(machineChannel, publication("action", "MSG", "custom")));
+        REQUIRE(router.dispatch(machineChannel, publication("action", "MSG", "other")));
+        REQUIRE(router.dispatch(machineChannel, publication("action", "MSG")));
+        REQUIRE(router.dispatch(machineChannel, publication("action", "GET", "session")));
+        REQUIRE_FALSE(router.dispatch(machineChannel, publication("action", "GET", "other")));
+        REQUIRE_FALSE(router.dispatch(machineChannel, publication("action")));
+        REQUIRE(called == std::vector<std::string> {"custom", "msg", "msg", "get"});
+    }
+
+    SECTION("Action only route goes before type only one")
+    {
+        REQUIRE(router.add({CF_CHN_CONTROL_MACHINE, "action", {}, "session"}, handler("any")));
+        REQUIRE(router.add({CF_CHN_CONTROL_MACHINE, "action", {}, {}}, handler("type")));
+        REQUIRE(router.dispatch(machineChannel, publication("action", "POST", "session")));
+        REQUIRE(router.dispatch(machineChannel, publication("action", "GET", "session")));
+        REQUIRE(router.dispatch(machineChannel, publication("action", "MSG", "session")));
+        REQUIRE(router.dispatch(machineChannel, publication("action", "POST", "other")));
+        REQUIRE(called == std::vector<std::string> {"any", "get", "msg", "type"});
+    }
+
+    SECTION("Taken route is not replaced")
+    {
+        REQUIRE_FALSE(router.add({CF_CHN_CONTROL_MACHINE, "action", "MSG", {}}, handler("other")));
+        REQUIRE(router.size() == 5);
+        REQUIRE(router.dispatch(machineChannel, publication("action", "MSG")));
+        REQUIRE(called == std::vector<std::string> {"msg"});
+    }
+
+    SECTION("Exclusive route is not shadowed")
+    {
+        PublicationRouter sdkRouter;
+        REQUIRE(sdkRouter.add({CF_CHN_CONTROL_MACHINE, "action", "MSG", {}}, handler("msg"), true));
+        REQUIRE(sdkRouter.add({CF_CHN_CONTROL_MACHINE, "action", {}, "paired"}, handler("paired"),
+                              true));
+
+        // Would take some of the publications of the exclusive routes
+        REQUIRE_FALSE(sdkRouter.add({CF_CHN_CONTROL_MACHINE, "action", "MSG", "custom"},
+                                    handler("custom")));
+        REQUIRE_FALSE(sdkRouter.add({CF_CHN_CONTROL_MACHINE, "action", "GET", {}}, handler("get")));
+        REQUIRE_FALSE(sdkRouter.add({CF_CHN_CONTROL_MACHINE, "action", "GET", "paired"},
+                                    handler("get")));
+
+        // Exclusive routes win the publications these have in common with them
+        REQUIRE(sdkRouter.add({CF_CHN_CONTROL_MACHINE, "action", {}, "custom"}, handler("custom")));
+        REQUIRE(sdkRouter.add({CF_CHN_CONTROL_MACHINE, "action", {}, {}}, handler("type")));
+        REQUIRE(sdkRouter.add({CF_CHN_CONTROL_SCORBITRON, "action", "MSG", "custom"},
+                              handler("scorbitron")));
+        REQUIRE(sdkRouter.size() == 5);
+
+        REQUIRE(sdkRouter.dispatch(machineChannel, publication("action", "MSG", "custom")));
+        REQUIRE(sdkRouter.dispatch(machineChannel, publication("action", "GET", "custom")));
+        REQUIRE(sdkRouter.dispatch(machineChannel, publication("action", "GET", "paired")));
+        REQUIRE(sdkRouter.dispatch(machineChannel, publication("action", "GET")));
+        REQUIRE(called == std::vector<std::string> {"msg", "custom", "paired", "type"});
+    }
+
+    SECTION("Field boundaries are part of the route")
+    {
+        // "action" + "MSG" + "" must not collide with "actionMSG" + "" + ""
+        REQUIRE(router.add({CF_CHN_CONTROL_MACHINE, "actionMSG", {}, {}}, handler("joined")));
+        REQUIRE(router.dispatch(machineChannel, publication("actionMSG")));
+        REQUIRE(router.dispatch(machineChannel, publication("action", "MSG")));
+        REQUIRE(called == std::vector<std::string> {"joined", "msg"});
+    }
+
+    SECTION("Malformed publications are not dispatched")
+    {
+        REQUIRE_FALSE(router.dispatch(machineChannel, json::array()));
+        REQUIRE_FALSE(router.dispatch(machineChannel, json {{JKEY_CHN_TYPE, "start_game"}}));
+        REQUIRE_FALSE(router.dispatch(machineChannel,
+                                      json {{JKEY_CHN_TYPE, "start_game"}, {JKEY_CHN_PAYLOAD, 1}}));
+        REQUIRE_FALSE(router.dispatch(
+                machineChannel, json {{JKEY_CHN_TYPE, 5}, {JKEY_CHN_PAYLOAD, json::object()}}));
+
+        auto data = publication("action", "MSG");
+        data[JKEY_CHN_PAYLOAD][JKEY_ACTION_NAME] = 42; // Not a string - no action
+        REQUIRE(router.dispatch(machineChannel, data));
+        REQUIRE(called == std::vector<std::string> {"msg"});
+    }
+
+    SECTION("Handler receives payload")
+    {
+        PublicationRouter payloadRouter;
+        json received;
+        payloadRouter.add({CF_CHN_CONTROL_MACHINE, "add_credits", {}, {}},
+                          [&received](const json &payload) { received = payload; });
+
+        const json data = {{JKEY_CHN_TYPE, "add_credits"}, {JKEY_CHN_PAYLOAD, {{"count", 3}}}};
+        REQUIRE(payloadRouter.dispatch(machineChannel, data));
+        REQUIRE(received == json {{"count", 3}});
+    }
+}
+
+TEST_CASE("PublicationRouter benchmark", "[.][benchmark][PublicationRouter]")
+{
+    PublicationRouter router;
+    int count = 0;
+    for (const auto *type : {"start_game", "add_credits", "diag_probe"}) {
+        router.add({CF_CHN_CONTROL_MACHINE, type, {}, {}}, [&count](const json &) { ++count; });
+    }
+    for (const auto *action : {"upload", "paired", "unpaired", "refresh"}) {
+        router.add({CF_CHN_CONTROL_SCORBITRON, "action", "SIGNAL", action},
+                   [&count](const json &) { ++count; });
+    }
+
+    const std::string channel = "control_scorbitron:abcd";
+    const auto data = publication("action", "SIGNAL", "unpaired");
+
+    BENCHMARK("Dispatch action")
+    {
+        return router.dispatch(channel, data);
+    };
+}
@@ -0,0 +1,98 @@
+/*
+ * Scorbit SDK
+ *
+ * (c) 2025 Spinner Systems, Inc. (DBA Scorbit), scrobit.io, All Rights Reserved
+ *
+ * MIT License
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "reconnect_backoff.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+using namespace scorbit::detail;
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr ReconnectBackoff::Policy POLICY {
+        .minDelay = 1s,
+        .firstCeiling = 10s,
+        .maxDelay = 5min,
+};
+
+} // namespace
+
+TEST_CASE("Reconnect delay grows exponentially up to the limit")
+{
+    ReconnectBackoff backoff {POLICY, 42};
+
+    std::chrono::milliseconds ceiling = POLICY.firstCeiling;
+    for (unsigned attempt = 0; attempt < 30; ++attempt) {
+        CAPTURE(attempt);
+        CHECK(backoff.attempts() == attempt);
+        const auto delay = backoff.next();
+        CHECK(delay >= POLICY.minDelay);
+        CHECK(delay <= ceiling);
+        ceiling = std::min<std::chrono::milliseconds>(ceiling * 2, POLICY.maxDelay);
+    }
+    CHECK(ceiling == POLICY.maxDelay);
+
+    backoff.reset();
+    CHECK(backoff.attempts() == 0);
+    CHECK(backoff.next() <= POLICY.firstCeiling);
+}
+
+TEST_CASE("Reconnect delay is reproducible with the same seed")
+{
+    ReconnectBackoff a {POLICY, 7};
+    ReconnectBackoff b {POLICY, 7};
+    for (int i = 0; i < 10; ++i) {
+        CHECK(a.next() == b.next());
+    }
+}
+
+TEST_CASE("Disconnect storm is spread out")
+{
+    // Server drops all machines at once, the first two reconnects are rejected as well
+    constexpr int MACHINES = 2000;
+    constexpr int REJECTED_ATTEMPTS = 2;
+
+    std::map<long, int> perSecond; // Second of successful reconnect -> machines
+    std::chrono::milliseconds latest {0};
+    for (int machine = 0; machine < MACHINES; ++machine) {
+        ReconnectBackoff backoff {POLICY, static_cast<std::uint64_t>(machine) + 1};
+        std::chrono::milliseconds at {0};
+        for (int attempt = 0; attempt <= REJECTED_ATTEMPTS; ++attempt) {
+            at += backoff.next();
+        }
+        ++perSecond[std::chrono::duration_cast<std::chrono::seconds>(at).count()];
+        latest = std::max(latest, at);
+    }
+
+    // Worst case is 10s + 20s + 40s, best 3 * 1s
+    CHECK(latest <= 70s);
+    CHECK(perSecond.begin()->first >= 3);
+
+    // Fixed delay would bring all of them in the same second
+    const auto peak = std::ranges::max_element(perSecond, {}, [](auto const &p) {
+                          return p.second;
+                      })->second;
+    CHECK(peak < MACHINES / 10);
+    CHECK(perSecond.size() > 30);
+}
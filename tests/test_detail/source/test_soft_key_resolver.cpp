@@ -23,8 +23,11 @@
 #include "net.h"
 
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <nlohmann/json.hpp>
+#include <tpm/crypto_helpers.h>
 #include <utils/bytearray.h>
+#include <thread>
 
 // clazy:excludeall=non-pod-global-static
 
@@ -454,6 +457,188 @@ TEST_CASE("SoftKeyResolver createSigner is deterministic for same key", "[SoftKe
     // ECDSA signatures are non-deterministic (random k), so sig1 != sig2 is expected
 }
 
+// =============================================================================
+// SoftKeySigner - cached device key
+// =============================================================================
+
+namespace {
+
+struct TestDeviceKey {
+    utils::ByteArray publicKey;
+    std::string encryptedKey;
+    std::string password = deviceKeyPassword();
+
+    TestDeviceKey()
+    {
+        utils::ByteArray privateKey;
+        REQUIRE(generateEcdsaKeyPair(publicKey, privateKey));
+        encryptedKey = encryptSecret(std::vector<uint8_t>(privateKey.begin(), privateKey.end()),
+                                     password);
+    }
+
+    bool verify(const Digest &digest, const Signature &signature) const
+    {
+        return ecdsaVerify(publicKey, utils::ByteArray(digest.data(), digest.size()),
+                           utils::ByteArray(signature.data(), signature.size()));
+    }
+};
+
+Digest makeDigest(uint8_t seed)
+{
+    Digest digest {};
+    for (size_t i = 0; i < digest.size(); ++i) {
+        digest[i] = static_cast<uint8_t>(seed + i);
+    }
+    return digest;
+}
+
+} // namespace
+
+TEST_CASE("SoftKeySigner signs with the cached device key", "[SoftKeySigner]")
+{
+    TestDeviceKey key;
+    SoftKeySigner signer(key.encryptedKey, key.password, std::chrono::minutes {1});
+    REQUIRE_FALSE(signer.isKeyCached());
+
+    const auto digest = makeDigest(1);
+    const auto signature = signer.sign(digest);
+    REQUIRE(signature.size() == 64);
+    CHECK(key.verify(digest, signature));
+    CHECK(signer.isKeyCached());
+
+    SECTION("Batch signatures are in digest order")
+    {
+        const std::vector<Digest> digests {makeDigest(2), makeDigest(3), makeDigest(4)};
+        const auto signatures = signer.signBatch(digests);
+        REQUIRE(signatures.size() == digests.size());
+        for (size_t i = 0; i < digests.size(); ++i) {
+            CHECK(key.verify(digests[i], signatures[i]));
+        }
+    }
+
+    SECTION("Wiped key is decrypted again")
+    {
+        signer.wipe();
+        CHECK_FALSE(signer.isKeyCached());
+
+        const auto again = signer.sign(digest);
+        CHECK(key.verify(digest, again));
+        CHECK(signer.isKeyCached());
+    }
+}
+
+TEST_CASE("SoftKeySigner wipes the key after idle TTL", "[SoftKeySigner]")
+{
+    TestDeviceKey key;
+    SoftKeySigner signer(key.encryptedKey, key.password, std::chrono::milliseconds {50});
+
+    REQUIRE_FALSE(signer.sign(makeDigest(1)).empty());
+    CHECK(signer.isKeyCached());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds {300});
+    CHECK_FALSE(signer.isKeyCached());
+
+    const auto digest = makeDigest(2);
+    CHECK(key.verify(digest, signer.sign(digest)));
+}
+
+TEST_CASE("SoftKeySigners wipe their keys after their own idle TTL", "[SoftKeySigner]")
+{
+    TestDeviceKey key;
+    SoftKeySigner shortTtl(key.encryptedKey, key.password, std::chrono::milliseconds {50});
+    SoftKeySigner longTtl(key.encryptedKey, key.password, std::chrono::minutes {1});
+    {
+        // Destroyed while its wipe is pending
+        SoftKeySigner destroyed(key.encryptedKey, key.password, std::chrono::milliseconds {50});
+        REQUIRE_FALSE(destroyed.sign(makeDigest(1)).empty());
+    }
+
+    REQUIRE_FALSE(shortTtl.sign(makeDigest(1)).empty());
+    REQUIRE_FALSE(longTtl.sign(makeDigest(1)).empty());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds {300});
+    CHECK_FALSE(shortTtl.isKeyCached());
+    CHECK(longTtl.isKeyCached());
+}
+
+TEST_CASE("SoftKeySigner with zero TTL keeps no key", "[SoftKeySigner]")
+{
+    TestDeviceKey key;
+    SoftKeySigner signer(key.encryptedKey, key.password, std::chrono::milliseconds {0});
+
+    const auto digest = makeDigest(1);
+    CHECK(key.verify(digest, signer.sign(digest)));
+    CHECK_FALSE(signer.isKeyCached());
+
+    const auto signatures = signer.signBatch({makeDigest(2), makeDigest(3)});
+    CHECK(signatures.size() == 2);
+    CHECK_FALSE(signer.isKeyCached());
+}
+
+TEST_CASE("SoftKeySigner fails with wrong password", "[SoftKeySigner]")
+{
+    TestDeviceKey key;
+    SoftKeySigner signer(key.encryptedKey, "wrong_password", std::chrono::minutes {1});
+
+    CHECK(signer.sign(makeDigest(1)).empty());
+    CHECK(signer.signBatch({makeDigest(2)}).empty());
+    CHECK_FALSE(signer.isKeyCached());
+}
+
+TEST_CASE("SoftKeySigner benchmark", "[.][benchmark]")
+{
+    TestDeviceKey key;
+    const auto digest = makeDigest(1);
+
+    SoftKeySigner perSignature(key.encryptedKey, key.password, std::chrono::milliseconds {0});
+    SoftKeySigner cached(key.encryptedKey, key.password, std::chrono::minutes {1});
+    cached.sign(digest);
+
+    BENCHMARK("Sign, decrypt per signature")
+    {
+        return perSignature.sign(digest);
+    };
+
+    BENCHMARK("Sign, cached key")
+    {
+        return cached.sign(digest);
+    };
+
+    const std::vector<Digest> digests(16, digest);
+    BENCHMARK("Sign batch of 16, cached key")
+    {
+        return cached.signBatch(digests);
+    };
+
+    // Authentication signatures of many SDK instances running side by side
+    constexpr int INSTANCES = 16;
+    constexpr int AUTHS_PER_INSTANCE = 8;
+    const auto authenticateAll = [&](std::chrono::milliseconds ttl) {
+        std::vector<std::thread> threads;
+        for (int i = 0; i < INSTANCES; ++i) {
+            threads.emplace_back([&] {
+                SoftKeySigner signer(key.encryptedKey, key.password, ttl);
+                for (int n = 0; n < AUTHS_PER_INSTANCE; ++n) {
+                    signer.sign(digest);
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+    };
+
+    BENCHMARK("16 instances x 8 authentications, decrypt per signature")
+    {
+        authenticateAll(std::chrono::milliseconds {0});
+    };
+
+    BENCHMARK("16 instances x 8 authentications, cached key")
+    {
+        authenticateAll(std::chrono::minutes {1});
+    };
+}
+
 // =============================================================================
 // encrypt/decrypt round-trip (utility sanity check)
 // =============================================================================
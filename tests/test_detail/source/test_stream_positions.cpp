@@ -0,0 +1,208 @@
+/*
+ * Scorbit SDK
+ *
+ * (c) 2025 Spinner Systems, Inc. (DBA Scorbit), scrobit.io, All Rights Reserved
+ *
+ * MIT License
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "stream_positions.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <functional>
+#include <string>
+
+using namespace scorbit::detail;
+
+namespace {
+
+constexpr auto CHANNEL = "machine:control:1";
+
+std::size_t hashOf(const std::string &payload)
+{
+    return std::hash<std::string> {}(payload);
+}
+
+std::string payloadAt(std::uint64_t offset)
+{
+    return R"({"type":"add_credits","transaction":)" + std::to_string(offset) + "}";
+}
+
+StreamPositions::Result accept(StreamPositions &positions, std::uint64_t offset,
+                               const std::string &channel = CHANNEL)
+{
+    return positions.accept(channel, offset, hashOf(payloadAt(offset)));
+}
+
+} // namespace
+
+TEST_CASE("Publications in order are all accepted")
+{
+    StreamPositions positions;
+    CHECK(positions.lastOffset(CHANNEL) == 0);
+
+    for (std::uint64_t offset = 1; offset <= 5; ++offset) {
+        const auto r = accept(positions, offset);
+        CHECK_FALSE(r.duplicate);
+        CHECK_FALSE(r.newStream);
+        CHECK(r.missed == 0);
+    }
+    CHECK(positions.lastOffset(CHANNEL) == 5);
+}
+
+TEST_CASE("Publication seen before is dropped")
+{
+    StreamPositions positions;
+    accept(positions, 1);
+    accept(positions, 2);
+
+    CHECK(accept(positions, 2).duplicate);
+    CHECK(accept(positions, 1).duplicate);
+    CHECK_FALSE(accept(positions, 3).duplicate);
+}
+
+TEST_CASE("History replayed after reconnect is deduplicated")
+{
+    StreamPositions positions;
+    for (std::uint64_t offset = 1; offset <= 10; ++offset) {
+        accept(positions, offset);
+    }
+
+    positions.reconnected();
+
+    // Server replays from somewhere before the last seen position, then carries on
+    for (std::uint64_t offset = 7; offset <= 10; ++offset) {
+        CAPTURE(offset);
+        CHECK(accept(positions, offset).duplicate);
+    }
+    const auto r = accept(positions, 11);
+    CHECK_FALSE(r.duplicate);
+    CHECK(r.missed == 0);
+    CHECK(positions.lastOffset(CHANNEL) == 11);
+}
+
+TEST_CASE("History replay longer than the window is deduplicated")
+{
+    StreamPositions positions;
+    const std::uint64_t last = 3 * StreamPositions::DEFAULT_WINDOW;
+    for (std::uint64_t offset = 1; offset <= last; ++offset) {
+        accept(positions, offset);
+    }
+
+    positions.reconnected();
+
+    // Replay starts below the oldest remembered offset
+    for (std::uint64_t offset = 50; offset <= last; ++offset) {
+        CAPTURE(offset);
+        const auto r = accept(positions, offset);
+        CHECK(r.duplicate);
+        CHECK_FALSE(r.newStream);
+    }
+    CHECK(positions.lastOffset(CHANNEL) == last);
+    CHECK_FALSE(accept(positions, last + 1).duplicate);
+}
+
+TEST_CASE("Offsets starting over below the window are a new stream")
+{
+    StreamPositions positions;
+    for (std::uint64_t offset = 1; offset <= 3 * StreamPositions::DEFAULT_WINDOW; ++offset) {
+        accept(positions, offset);
+    }
+
+    positions.reconnected();
+
+    const auto r = positions.accept(CHANNEL, 2, hashOf(R"({"type":"start_game"})"));
+    CHECK(r.newStream);
+    CHECK_FALSE(r.duplicate);
+    CHECK(positions.lastOffset(CHANNEL) == 2);
+}
+
+TEST_CASE("Gap in offsets is reported")
+{
+    StreamPositions positions;
+    accept(positions, 1);
+    positions.reconnected();
+
+    const auto r = accept(positions, 5);
+    CHECK_FALSE(r.duplicate);
+    CHECK(r.missed == 3);
+}
+
+TEST_CASE("Offsets starting over after reconnect are a new stream")
+{
+    StreamPositions positions;
+    for (std::uint64_t offset = 1; offset <= 10; ++offset) {
+        accept(positions, offset);
+    }
+
+    positions.reconnected();
+
+    // Same offset, other payload - server lost the history, new epoch
+    const auto r = positions.accept(CHANNEL, 1, hashOf(R"({"type":"start_game"})"));
+    CHECK(r.newStream);
+    CHECK_FALSE(r.duplicate);
+    CHECK(positions.lastOffset(CHANNEL) == 1);
+
+    CHECK_FALSE(accept(positions, 2).duplicate);
+    CHECK(accept(positions, 2).duplicate);
+}
+
+TEST_CASE("Offsets only start over across reconnects")
+{
+    StreamPositions positions;
+    accept(positions, 1);
+    accept(positions, 2);
+
+    const auto r = positions.accept(CHANNEL, 1, hashOf("other"));
+    CHECK(r.duplicate);
+    CHECK_FALSE(r.newStream);
+}
+
+TEST_CASE("Publications without offset are never dropped")
+{
+    StreamPositions positions;
+    for (int i = 0; i < 3; ++i) {
+        CHECK_FALSE(positions.accept(CHANNEL, 0, hashOf("same")).duplicate);
+    }
+    CHECK(positions.lastOffset(CHANNEL) == 0);
+}
+
+TEST_CASE("Channels are tracked separately")
+{
+    StreamPositions positions;
+    accept(positions, 5, "a");
+    CHECK_FALSE(accept(positions, 5, "b").duplicate);
+    CHECK(accept(positions, 5, "a").duplicate);
+    CHECK(positions.lastOffset("a") == 5);
+    CHECK(positions.lastOffset("b") == 5);
+}
+
+TEST_CASE("Repeated reconnects with replays hand each publication out once")
+{
+    // Flapping connection, every reconnect replays the whole history from the start
+    StreamPositions positions;
+    int handled = 0;
+    std::uint64_t published = 0;
+    for (int reconnect = 0; reconnect < 20; ++reconnect) {
+        published += 3;
+        for (std::uint64_t offset = 1; offset <= published; ++offset) {
+            if (!accept(positions, offset).duplicate) {
+                ++handled;
+            }
+        }
+        positions.reconnected();
+    }
+    CHECK(handled == static_cast<int>(published));
+}
@@ -0,0 +1,92 @@
+/*
+ * Scorbit SDK
+ *
+ * (c) 2025 Spinner Systems, Inc. (DBA Scorbit), scrobit.io, All Rights Reserved
+ *
+ * MIT License
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "streaming_multipart.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <boost/filesystem.hpp>
+#include <fstream>
+
+using namespace scorbit::detail;
+namespace fs = boost::filesystem;
+
+namespace {
+
+std::string readBody(const StreamingMultipart &multipart, bool &ok)
+{
+    auto callback = multipart.readCallback();
+    std::string body;
+    char buffer[1000];
+    for (;;) {
+        size_t size = sizeof(buffer);
+        ok = callback(buffer, size);
+        if (!ok || size == 0) {
+            return body;
+        }
+        body.append(buffer, size);
+    }
+}
+
+} // namespace
+
+TEST_CASE("StreamingMultipart wraps the archive in a file part", "[StreamingMultipart]")
+{
+    auto content = std::make_shared<ArchiveContent>();
+    content->memoryEntries.push_back({"logs/extra.log", std::string(100'000, 'x')});
+
+    StreamingMultipart multipart {"file", "diagnostics.tar.gz",
+                                  std::make_shared<ArchiveStream>(content, ArchiveOptions {})};
+
+    const auto contentType = multipart.contentType();
+    const std::string prefix = "multipart/form-data; boundary=";
+    REQUIRE(contentType.starts_with(prefix));
+    const auto boundary = contentType.substr(prefix.size());
+    REQUIRE_FALSE(boundary.empty());
+
+    bool ok = false;
+    const auto body = readBody(multipart, ok);
+    REQUIRE(ok);
+
+    const auto head = "--" + boundary
+                    + "\r\nContent-Disposition: form-data; name=\"file\"; "
+                      "filename=\"diagnostics.tar.gz\"\r\nContent-Type: "
+                      "application/octet-stream\r\n\r\n";
+    const auto tail = "\r\n--" + boundary + "--\r\n";
+    REQUIRE(body.starts_with(head));
+    REQUIRE(body.ends_with(tail));
+
+    const auto dir = fs::temp_directory_path() / fs::unique_path("test_multipart_%%%%-%%%%");
+    fs::create_directories(dir);
+    const auto archive = (dir / "diagnostics.tar.gz").string();
+    {
+        std::ofstream out(archive, std::ios::binary);
+        out << body.substr(head.size(), body.size() - head.size() - tail.size());
+    }
+    CHECK(extract(archive, (dir / "out").string()));
+    CHECK(fs::file_size(dir / "out" / "logs" / "extra.log") == 100'000);
+    fs::remove_all(dir);
+}
+
+TEST_CASE("StreamingMultipart boundaries are unique", "[StreamingMultipart]")
+{
+    auto content = std::make_shared<ArchiveContent>();
+    StreamingMultipart a {"file", "a", std::make_shared<ArchiveStream>(content, ArchiveOptions {})};
+    StreamingMultipart b {"file", "b", std::make_shared<ArchiveStream>(content, ArchiveOptions {})};
+    CHECK(a.contentType() != b.contentType());
+}
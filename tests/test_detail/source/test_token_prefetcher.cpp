@@ -0,0 +1,261 @@
+/*
+ * Scorbit SDK
+ *
+ * (c) 2025 Spinner Systems, Inc. (DBA Scorbit), scrobit.io, All Rights Reserved
+ *
+ * MIT License
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "token_prefetcher.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <deque>
+#include <future>
+#include <thread>
+#include <utility>
+
+using namespace scorbit::detail;
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr TokenPrefetcher::Timing TIMING {
+        .prefetchBefore = 5min,
+        .minValidity = 4min,
+        .retryDelay = 10s,
+        .unknownLifetime = 10min,
+};
+
+// Token server stand-in, tasks and timer run when the test says so
+struct Fixture {
+    std::deque<std::string> replies; // Empty string - failed fetch
+    std::chrono::seconds lifetime {1h};
+    int fetches {0};
+    std::deque<std::function<void()>> tasks;
+    std::optional<std::chrono::steady_clock::duration> timerDelay;
+    std::function<void()> timerTask;
+
+    TokenPrefetcher prefetcher {
+            [this] {
+                ++fetches;
+                auto reply = replies.empty() ? std::string {} : replies.front();
+                if (!replies.empty()) {
+                    replies.pop_front();
+                }
+                return reply;
+            },
+            [this](const std::string &) { return std::optional {lifetime}; },
+            [this](std::function<void()> task) { tasks.push_back(std::move(task)); },
+            [this](std::chrono::steady_clock::duration delay, std::function<void()> task) {
+                timerDelay = delay;
+                timerTask = std::move(task);
+            },
+            TIMING,
+    };
+
+    void runTasks()
+    {
+        while (!tasks.empty()) {
+            auto task = std::move(tasks.front());
+            tasks.pop_front();
+            task();
+        }
+    }
+
+    void fireTimer()
+    {
+        REQUIRE(timerTask);
+        std::exchange(timerTask, {})();
+    }
+};
+
+} // namespace
+
+TEST_CASE("TokenPrefetcher delivers token through callback", "[TokenPrefetcher]")
+{
+    Fixture f;
+    f.replies = {"t1"};
+
+    std::vector<std::string> received;
+    f.prefetcher.get([&received](const std::string &token) { received.push_back(token); });
+    f.prefetcher.get([&received](const std::string &token) { received.push_back(token); });
+    CHECK(received.empty());
+    CHECK(f.prefetcher.current().empty());
+
+    f.runTasks();
+    CHECK(f.fetches == 1); // Coalesced
+    CHECK(received == std::vector<std::string> {"t1", "t1"});
+    CHECK(f.prefetcher.current() == "t1");
+
+    // Ready token is delivered right away
+    f.prefetcher.get([&received](const std::string &token) { received.push_back(token); });
+    CHECK(received.size() == 3);
+    CHECK(f.tasks.empty());
+
+    // Next one is fetched ahead of expiry
+    REQUIRE(f.timerDelay.has_value());
+    CHECK(*f.timerDelay > 1h - TIMING.prefetchBefore - 1s);
+    CHECK(*f.timerDelay <= 1h - TIMING.prefetchBefore);
+}
+
+TEST_CASE("TokenPrefetcher serves current token while next one is fetched", "[TokenPrefetcher]")
+{
+    Fixture f;
+    f.replies = {"t1", "t2"};
+    f.prefetcher.refresh();
+    f.runTasks();
+    REQUIRE(f.prefetcher.current() == "t1");
+
+    f.fireTimer();
+    CHECK(f.tasks.size() == 1);
+    CHECK(f.prefetcher.current() == "t1");
+
+    f.runTasks();
+    CHECK(f.prefetcher.current() == "t2");
+    CHECK(f.fetches == 2);
+}
+
+TEST_CASE("TokenPrefetcher retries failed fetch", "[TokenPrefetcher]")
+{
+    Fixture f;
+    f.replies = {"", "t1"};
+
+    std::optional<std::string> received;
+    f.prefetcher.get([&received](const std::string &token) { received = token; });
+    f.runTasks();
+    CHECK(received == "");
+    CHECK(f.timerDelay == TIMING.retryDelay);
+    CHECK(f.prefetcher.current().empty());
+    f.runTasks(); // current() started a fetch too
+    CHECK(f.prefetcher.current() == "t1");
+}
+
+TEST_CASE("TokenPrefetcher doesn't serve token about to expire", "[TokenPrefetcher]")
+{
+    Fixture f;
+    f.lifetime = 3min; // Less than min validity
+    f.replies = {"t1"};
+    f.prefetcher.refresh();
+    f.runTasks();
+
+    CHECK(f.prefetcher.current().empty());
+    CHECK(f.timerDelay == TIMING.retryDelay);
+}
+
+TEST_CASE("TokenPrefetcher retries already expired token after retry delay", "[TokenPrefetcher]")
+{
+    Fixture f;
+    f.lifetime = 0s;
+    f.replies = {"expired", "t1"};
+
+    std::optional<std::string> received;
+    f.prefetcher.refresh([&received](const std::string &token) { received = token; });
+    f.runTasks();
+    CHECK(f.fetches == 1);
+    CHECK(received == ""); // Same as failed fetch
+    CHECK(f.timerDelay == TIMING.retryDelay);
+    CHECK(f.tasks.empty());
+
+    f.lifetime = 1h;
+    f.fireTimer();
+    f.runTasks();
+    CHECK(f.fetches == 2);
+    CHECK(f.prefetcher.current() == "t1");
+}
+
+TEST_CASE("TokenPrefetcher keeps previous token if new one is expired", "[TokenPrefetcher]")
+{
+    Fixture f;
+    f.replies = {"t1", "expired"};
+    f.prefetcher.refresh();
+    f.runTasks();
+    REQUIRE(f.prefetcher.current() == "t1");
+
+    f.lifetime = 0s;
+    f.fireTimer();
+    f.runTasks();
+    CHECK(f.fetches == 2);
+    CHECK(f.prefetcher.current() == "t1");
+    CHECK(f.timerDelay == TIMING.retryDelay);
+}
+
+TEST_CASE("TokenPrefetcher refresh discards token fetched before it", "[TokenPrefetcher]")
+{
+    Fixture f;
+    f.replies = {"old", "new"};
+
+    std::vector<std::string> received;
+    f.prefetcher.get([&received](const std::string &token) { received.push_back(token); });
+    f.prefetcher.refresh([&received](const std::string &token) { received.push_back(token); });
+    CHECK(f.tasks.size() == 1); // Old fetch still in flight
+
+    f.runTasks();
+    CHECK(f.fetches == 2);
+    CHECK(received == std::vector<std::string> {"new", "new"});
+    CHECK(f.prefetcher.current() == "new");
+}
+
+TEST_CASE("TokenPrefetcher stop drops callbacks", "[TokenPrefetcher]")
+{
+    Fixture f;
+    f.replies = {"t1"};
+    bool called = false;
+    f.prefetcher.get([&called](const std::string &) { called = true; });
+    f.prefetcher.stop();
+    f.runTasks();
+
+    CHECK_FALSE(called);
+    CHECK_FALSE(f.timerTask);
+    f.prefetcher.refresh();
+    CHECK(f.tasks.empty());
+}
+
+TEST_CASE("TokenPrefetcher current never waits for fetch", "[TokenPrefetcher]")
+{
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    std::vector<std::thread> threads;
+
+    TokenPrefetcher prefetcher {
+            [released] {
+                released.wait(); // Slow token server
+                return std::string {"t1"};
+            },
+            [](const std::string &) { return std::optional {std::chrono::seconds {1h}}; },
+            [&threads](std::function<void()> task) { threads.emplace_back(std::move(task)); },
+            [](std::chrono::steady_clock::duration, std::function<void()>) {},
+            TIMING,
+    };
+
+    std::promise<std::string> fetched;
+    prefetcher.get([&fetched](const std::string &token) { fetched.set_value(token); });
+
+    const auto startedAt = std::chrono::steady_clock::now();
+    for (int i = 0; i < 100; ++i) {
+        CHECK(prefetcher.current().empty());
+    }
+    CHECK(std::chrono::steady_clock::now() - startedAt < 100ms);
+
+    release.set_value();
+    auto future = fetched.get_future();
+    REQUIRE(future.wait_for(5s) == std::future_status::ready);
+    CHECK(future.get() == "t1");
+    CHECK(prefetcher.current() == "t1");
+
+    for (auto &thread : threads) {
+        thread.join();
+    }
+}
@@ -19,6 +19,8 @@
 
 #include <scorbit_sdk/version.h>
 #include <updater.h>
+#include <utils/archiver.h>
+#include <utils/download_range.h>
 #include "device_info.h"
 #include "net_util.h"
 #include "trompeloeil_printer.h"
@@ -26,6 +28,10 @@
 #include <nlohmann/json.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <trompeloeil.hpp>
+#include <boost/filesystem.hpp>
+#include <algorithm>
+#include <fstream>
+#include <map>
 
 using namespace scorbit;
 using namespace scorbit::detail;
@@ -62,6 +68,9 @@ public:
                           LeaderboardHandleCallback) override
     {
     };
+    void requestTopScoresMulti(std::vector<LeaderboardQuery>, LeaderboardMultiCallback) override
+    {
+    };
     void requestUnpair(StringCallback) override {};
     void authenticate() override { };
     void sessionCreate(const scorbit::detail::GameData &, GameStartOrigin,
@@ -72,13 +81,65 @@ public:
     MAKE_MOCK4(updateConfig,
                void(const std::string &, const std::string &, bool, std::optional<std::string>),
                override);
-    MAKE_MOCK5(download,
+    MAKE_MOCK6(download,
                void(bool isAsync, StringCallback, const std::string &, const std::string &,
-                    const HttpHeaders &),
+                    const HttpHeaders &, const DownloadOptions &),
                override);
 
-    void downloadBuffer(bool isAsync, VectorCallback, const std::string &, size_t,
+    void downloadBuffer(bool isAsync, BufferCallback, const std::string &, size_t,
                         const HttpHeaders &) override { };
+
+    // Fake release server: files by URL, verified like Net does. Streams are fed in small
+    // chunks, like a slow network would
+    void downloadStream(bool, StringCallback callback, const std::string &url,
+                        const HttpHeaders &, const DownloadOptions &options,
+                        DataCallback onData) override
+    {
+        requested.push_back(url);
+        const auto it = releaseFiles.find(url);
+        if (it == releaseFiles.end()) {
+            callback(Error::ApiError, "404");
+            return;
+        }
+        const auto &content = it->second;
+        for (size_t i = 0; i < content.size(); i += 1000) {
+            if (!onData(std::string_view {content}.substr(i, 1000))) {
+                callback(Error::FileError, "rejected");
+                return;
+            }
+        }
+        callback(verify(content, options), url);
+    }
+
+    void serveFile(const StringCallback &callback, const std::string &url,
+                   const std::string &filename, const DownloadOptions &options)
+    {
+        requested.push_back(url);
+        const auto it = releaseFiles.find(url);
+        if (it == releaseFiles.end()) {
+            callback(Error::ApiError, "404");
+            return;
+        }
+        const auto error = verify(it->second, options);
+        if (error == Error::Success) {
+            std::ofstream(filename, std::ios::binary) << it->second;
+        }
+        callback(error, url);
+    }
+
+    Error verify(const std::string &content, const DownloadOptions &options) const
+    {
+        Sha256Stream hasher;
+        hasher.update(content);
+        if (!options.expectedSha256.empty()
+            && !sha256Matches(hasher.hexDigest(), options.expectedSha256)) {
+            return Error::FileError;
+        }
+        return Error::Success;
+    }
+
+    std::map<std::string, std::string> releaseFiles;
+    std::vector<std::string> requested;
     PlayerProfilesManager &playersManager() override { return m_playersManager; };
     void patchScorbitron(std::string, StringCallback, std::vector<AuthStatus>) override {};
     std::string consumeNonce() override { return {}; };
@@ -107,6 +168,54 @@ protected:
     }
 };
 
+class StagedUpdater : public Updater
+{
+public:
+    StagedUpdater(NetBase &net, boost::filesystem::path executable)
+        : Updater(net, false, "1.99.30", "test_platform")
+        , m_executable(std::move(executable))
+    {
+    }
+
+protected:
+    boost::filesystem::path getSdkLibraryPath() const override
+    {
+        return "/fake/libscorbit_sdk.dylib";
+    }
+    boost::filesystem::path getProcessExecutablePath() const override { return m_executable; }
+
+private:
+    boost::filesystem::path m_executable;
+};
+
+std::string readFile(const boost::filesystem::path &path)
+{
+    std::ifstream ifs(path.string(), std::ios::binary);
+    return {(std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>()};
+}
+
+std::string sha256(const std::string &data)
+{
+    Sha256Stream hasher;
+    hasher.update(data);
+    return hasher.hexDigest();
+}
+
+/// bsdiff integer encoding
+std::string offtout(int64_t x)
+{
+    std::string buf(8, '\0');
+    auto y = static_cast<uint64_t>(x < 0 ? -x : x);
+    for (auto &c : buf) {
+        c = static_cast<char>(y & 0xFF);
+        y >>= 8;
+    }
+    if (x < 0) {
+        buf[7] = static_cast<char>(buf[7] | 0x80);
+    }
+    return buf;
+}
+
 } // namespace
 
 TEST_CASE("Updater")
@@ -135,7 +244,9 @@ TEST_CASE("Updater")
     {
         REQUIRE_CALL(mockNetRef,
                      download(false, _,
-                              "https://example.com/scorbit_sdk-1.0.2-testarch_testabi.tgz", _, _))
+                              "https://example.com/scorbit_sdk-1.0.2-testarch_testabi.tgz", _, _,
+                              _))
+                .WITH(_6.keepPartial && _6.expectedSha256.empty() && _6.expectedSize == -1)
                 .TIMES(1);
 
         updater.checkNewVersionAndUpdate(json, nullptr);
@@ -145,7 +256,8 @@ TEST_CASE("Updater")
     {
         REQUIRE_CALL(mockNetRef,
                      download(false, _,
-                              "https://example.com/scorbit_sdk-1.0.2-testarch_testabi.tgz", _, _))
+                              "https://example.com/scorbit_sdk-1.0.2-testarch_testabi.tgz", _, _,
+                              _))
                 .LR_SIDE_EFFECT(_2(Error::ApiError, "some_temp_file.tar.gz");)
                 .TIMES(1);
 
@@ -248,7 +360,8 @@ TEST_CASE("Updater prod key hash check")
 
         REQUIRE_CALL(mockNetRef,
                      download(false, _,
-                              "https://example.com/scorbit_sdk-1.0.2-testarch_testabi.tgz", _, _))
+                              "https://example.com/scorbit_sdk-1.0.2-testarch_testabi.tgz", _, _,
+                              _))
                 .TIMES(1);
 
         updater.checkNewVersionAndUpdate(json, nullptr);
@@ -268,3 +381,142 @@ TEST_CASE("Updater relies on host-based internal download auth (not device provi
             "https://api.scorbit.io/v2/releases/scorbit_sdk-1.0.2-testarch_testabi.tgz", apiBase,
             nonScorbit));
 }
+
+TEST_CASE("Updater installs from the fake release server")
+{
+    namespace fs = boost::filesystem;
+    const auto dir = fs::temp_directory_path() / fs::unique_path("test_updater_%%%%-%%%%");
+    fs::create_directories(dir);
+    std::shared_ptr<void> cleanup(nullptr, [&dir](void *) { fs::remove_all(dir); });
+
+    std::string oldBinary(50'000, 'o');
+    oldBinary.replace(0, 10, "old binary");
+    auto newBinary = oldBinary;
+    newBinary.replace(0, 10, "new binary");
+    newBinary[40'000] = 'n';
+
+    const auto executable = dir / "scorbitd";
+    std::ofstream(executable.string(), std::ios::binary) << oldBinary;
+
+    const auto archivePath = (dir / "scorbitd-1.2.0-test_platform.tgz").string();
+    REQUIRE(createTarGz(archivePath, {},
+                        {{"scorbitd-1.2.0/README.md", "read me"},
+                         {"scorbitd-1.2.0/bin/scorbitd", newBinary}}));
+    const auto archive = readFile(archivePath);
+    fs::remove(archivePath);
+
+    // bsdiff patch with one control: all bytes are diff, nothing extra
+    std::string patch = "ENDSLEY/BSDIFF43" + offtout(newBinary.size());
+    patch += offtout(newBinary.size()) + offtout(0) + offtout(0);
+    for (size_t i = 0; i < newBinary.size(); ++i) {
+        patch += static_cast<char>(newBinary[i] - oldBinary[i]);
+    }
+
+    const std::string archiveUrl = "https://example.com/scorbitd-1.2.0-test_platform.tgz";
+    const std::string patchUrl = "https://example.com/scorbitd-1.1.0-1.2.0.patch";
+
+    auto json = nlohmann::json::parse(R"(
+            {
+                "scorbitd": {
+                    "version": "1.2.0",
+                    "assets_json": [
+                        {
+                            "name": "scorbitd-1.2.0-test_platform.tgz",
+                            "download_url": "https://example.com/scorbitd-1.2.0-test_platform.tgz",
+                            "content_type": "application/gzip",
+                            "size": 0
+                        }
+                    ]
+                }
+            }
+        )");
+    json["scorbitd"]["assets_json"][0]["size"] = archive.size();
+    json["scorbitd"]["assets_json"][0]["sha256"] = sha256(archive);
+
+    MockNetBase mockNet;
+    mockNet.releaseFiles[archiveUrl] = archive;
+    mockNet.releaseFiles[patchUrl] = patch;
+    StagedUpdater updater(mockNet, executable);
+
+    const auto addDelta = [&](const std::string &from, const std::string &target) {
+        json["scorbitd"]["deltas"].push_back({{"download_url", patchUrl},
+                                              {"from_sha256", sha256(from)},
+                                              {"target_sha256", sha256(target)},
+                                              {"sha256", sha256(patch)},
+                                              {"size", patch.size()}});
+    };
+
+    SECTION("Archive is extracted while downloaded, only the binary")
+    {
+        REQUIRE_CALL(mockNet, updateConfig(eq("sdk"), eq(SCORBIT_SDK_VERSION), eq(true), _))
+                .TIMES(1);
+
+        updater.checkNewVersionAndUpdate(json, nullptr);
+
+        CHECK(readFile(executable) == newBinary);
+        CHECK(mockNet.requested == std::vector<std::string> {archiveUrl});
+        CHECK_FALSE(fs::exists(dir / "scorbit_update"));
+        CHECK_FALSE(fs::exists(dir / "README.md"));
+    }
+
+    SECTION("Failed stream falls back to downloading the archive")
+    {
+        json["scorbitd"]["assets_json"][0]["sha256"] = sha256("other");
+
+        REQUIRE_CALL(mockNet, download(false, _, archiveUrl, _, _, _))
+                .LR_SIDE_EFFECT(mockNet.serveFile(_2, _3, _4, _6))
+                .TIMES(1);
+        ALLOW_CALL(mockNet, updateConfig(_, _, eq(false), _));
+
+        updater.checkNewVersionAndUpdate(json, nullptr);
+
+        CHECK(readFile(executable) == oldBinary);
+        CHECK_FALSE(fs::exists(dir / "scorbit_update"));
+    }
+
+    SECTION("Delta is applied to the current binary")
+    {
+        addDelta(oldBinary, newBinary);
+
+        REQUIRE_CALL(mockNet, download(false, _, patchUrl, _, _, _))
+                .LR_SIDE_EFFECT(mockNet.serveFile(_2, _3, _4, _6))
+                .TIMES(1);
+        REQUIRE_CALL(mockNet, updateConfig(eq("sdk"), eq(SCORBIT_SDK_VERSION), eq(true), _))
+                .TIMES(1);
+
+        updater.checkNewVersionAndUpdate(json, nullptr);
+
+        CHECK(readFile(executable) == newBinary);
+        CHECK(mockNet.requested == std::vector<std::string> {patchUrl});
+        CHECK_FALSE(fs::exists(dir / "scorbit_update"));
+    }
+
+    SECTION("Wrong patched binary falls back to the full archive")
+    {
+        addDelta(oldBinary, "something else");
+
+        REQUIRE_CALL(mockNet, download(false, _, patchUrl, _, _, _))
+                .LR_SIDE_EFFECT(mockNet.serveFile(_2, _3, _4, _6))
+                .TIMES(1);
+        REQUIRE_CALL(mockNet, updateConfig(eq("sdk"), eq(SCORBIT_SDK_VERSION), eq(true), _))
+                .TIMES(1);
+
+        updater.checkNewVersionAndUpdate(json, nullptr);
+
+        CHECK(readFile(executable) == newBinary);
+        CHECK(mockNet.requested == std::vector<std::string> {patchUrl, archiveUrl});
+    }
+
+    SECTION("Delta of another build is not downloaded")
+    {
+        addDelta("another build", newBinary);
+
+        REQUIRE_CALL(mockNet, updateConfig(eq("sdk"), eq(SCORBIT_SDK_VERSION), eq(true), _))
+                .TIMES(1);
+
+        updater.checkNewVersionAndUpdate(json, nullptr);
+
+        CHECK(readFile(executable) == newBinary);
+        CHECK(mockNet.requested == std::vector<std::string> {archiveUrl});
+    }
+}
@@ -0,0 +1,169 @@
+/*
+ * Scorbit SDK
+ *
+ * (c) 2025 Spinner Systems, Inc. (DBA Scorbit), scrobit.io, All Rights Reserved
+ *
+ * MIT License
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "warm_start_cache.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+#include <iterator>
+#include <string>
+
+using namespace scorbit::detail;
+using json = nlohmann::json;
+
+namespace fs = boost::filesystem;
+
+namespace {
+
+constexpr auto IDENTITY = "scorbitron:0:f0b4c4a0@https://api.scorbit.io";
+
+struct TempFile {
+    const fs::path path {fs::temp_directory_path() / fs::unique_path("warm_start_%%%%-%%%%")};
+    ~TempFile() { fs::remove(path); }
+};
+
+std::string readFile(const fs::path &path)
+{
+    std::ifstream file(path.string(), std::ios::binary);
+    return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+}
+
+void writeFile(const fs::path &path, const std::string &content)
+{
+    std::ofstream file(path.string(), std::ios::binary | std::ios::trunc);
+    file << content;
+}
+
+const json config {{"venue", "v1"}, {"pricing", {{"price", 1}}}};
+const json machine {{"machine_uuid", "m1"}, {"game_slug", nullptr}};
+
+// Cache as the previous run left it
+void savePreviousRun(const fs::path &path)
+{
+    WarmStartCache cache;
+    CHECK_FALSE(cache.open(path.string(), IDENTITY));
+    CHECK(cache.confirm(WARM_START_CONFIG, config));
+    CHECK(cache.confirm(WARM_START_MACHINE, machine));
+}
+
+} // namespace
+
+TEST_CASE("Warm start cache serves previous run until confirmed", "[warm_start]")
+{
+    TempFile file;
+    savePreviousRun(file.path);
+
+    WarmStartCache cache;
+    REQUIRE(cache.open(file.path.string(), IDENTITY));
+    CHECK(cache.provisional(WARM_START_CONFIG) == config);
+    CHECK(cache.provisional(WARM_START_MACHINE) == machine);
+    CHECK_FALSE(cache.provisional(WARM_START_SHORT_CODE).has_value());
+
+    const auto saved = readFile(file.path);
+
+    SECTION("Unchanged data is not announced again nor written")
+    {
+        CHECK_FALSE(cache.confirm(WARM_START_CONFIG, config));
+        CHECK_FALSE(cache.provisional(WARM_START_CONFIG).has_value());
+        CHECK(readFile(file.path) == saved);
+
+        // Later replies are not provisional anymore, e.g. config requested by integrator
+        CHECK(cache.confirm(WARM_START_CONFIG, config));
+        CHECK(readFile(file.path) == saved);
+    }
+
+    SECTION("Changed data is announced and saved")
+    {
+        const json changed {{"venue", "v2"}};
+        CHECK(cache.confirm(WARM_START_CONFIG, changed));
+        CHECK(readFile(file.path) != saved);
+
+        WarmStartCache next;
+        REQUIRE(next.open(file.path.string(), IDENTITY));
+        CHECK(next.provisional(WARM_START_CONFIG) == changed);
+        CHECK(next.provisional(WARM_START_MACHINE) == machine);
+    }
+
+    SECTION("New section is announced")
+    {
+        CHECK(cache.confirm(WARM_START_SHORT_CODE, "ABC123"));
+    }
+}
+
+TEST_CASE("Warm start cache ignores unusable files", "[warm_start]")
+{
+    TempFile file;
+    savePreviousRun(file.path);
+    auto content = readFile(file.path);
+    REQUIRE_FALSE(content.empty());
+
+    WarmStartCache cache;
+    std::string identity = IDENTITY;
+
+    SECTION("Other machine or server")
+    {
+        identity = "scorbitron:0:other@https://api.scorbit.io";
+        CHECK_FALSE(cache.open(file.path.string(), identity));
+    }
+
+    SECTION("Corrupted")
+    {
+        content[content.size() - 3] ^= 0x01;
+        writeFile(file.path, content);
+        CHECK_FALSE(cache.open(file.path.string(), IDENTITY));
+    }
+
+    SECTION("Truncated")
+    {
+        writeFile(file.path, content.substr(0, content.size() / 2));
+        CHECK_FALSE(cache.open(file.path.string(), IDENTITY));
+    }
+
+    SECTION("Unknown format")
+    {
+        writeFile(file.path, config.dump());
+        CHECK_FALSE(cache.open(file.path.string(), IDENTITY));
+    }
+
+    SECTION("Missing")
+    {
+        fs::remove(file.path);
+        CHECK_FALSE(cache.open(file.path.string(), IDENTITY));
+    }
+
+    CHECK_FALSE(cache.provisional(WARM_START_CONFIG).has_value());
+    CHECK(cache.isOpen());
+
+    // Replaced by the data of this run
+    CHECK(cache.confirm(WARM_START_CONFIG, config));
+    WarmStartCache next;
+    CHECK(next.open(file.path.string(), identity));
+    CHECK(next.provisional(WARM_START_CONFIG) == config);
+}
+
+TEST_CASE("Warm start cache without file announces everything", "[warm_start]")
+{
+    WarmStartCache cache;
+    CHECK_FALSE(cache.isOpen());
+    CHECK(cache.confirm(WARM_START_CONFIG, config));
+    CHECK(cache.confirm(WARM_START_CONFIG, config));
+    CHECK_FALSE(cache.provisional(WARM_START_CONFIG).has_value());
+}
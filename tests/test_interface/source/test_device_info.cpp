@@ -97,6 +97,63 @@ TEST_CASE("sb_config_t setters", "[Config][C]")
         sb_config_set_auto_download_player_pics(config, false);
     }
 
+    SECTION("Set picture_cache_dir")
+    {
+        sb_config_set_picture_cache_dir(config, "/tmp/scorbit_pictures");
+        sb_config_set_picture_cache_dir(config, nullptr);
+    }
+
+    SECTION("Set leaderboard_cache_ttl")
+    {
+        sb_config_set_leaderboard_cache_ttl(config, 60, 600);
+        sb_config_set_leaderboard_cache_ttl(config, -1, -1);
+    }
+
+    SECTION("Set leaderboard_prefetch")
+    {
+        const sb_leaderboard_query_t queries[] = {
+                {SB_LEADERBOARD_SCOPE_MACHINE, SB_LEADERBOARD_PERIOD_ALL_TIME, nullptr,
+                 SB_LEADERBOARD_VPIN_ANY},
+                {SB_LEADERBOARD_SCOPE_GAME, SB_LEADERBOARD_PERIOD_30D, "2026-01-01",
+                 SB_LEADERBOARD_VPIN_ANY},
+        };
+        sb_config_set_leaderboard_prefetch(config, queries, 2, 600);
+        sb_config_set_leaderboard_prefetch(config, nullptr, 0, -1);
+    }
+
+    SECTION("Set local_scores_path")
+    {
+        sb_config_set_local_scores_path(config, "/tmp/scores.bin");
+        sb_config_set_local_scores_path(config, nullptr);
+    }
+
+    SECTION("Set flight_recorder_path")
+    {
+        sb_config_set_flight_recorder_path(config, "/tmp/flight_recorder.bin");
+        sb_config_set_flight_recorder_path(config, nullptr);
+    }
+
+    SECTION("Set warm_start_cache_path")
+    {
+        sb_config_set_warm_start_cache_path(config, "/tmp/warm_start.json");
+        sb_config_set_warm_start_cache_path(config, nullptr);
+    }
+
+    SECTION("Set diagnostics_archive")
+    {
+        sb_config_set_diagnostics_archive(config, SB_DIAGNOSTICS_ZSTD, 3, 4, true);
+        sb_config_set_diagnostics_archive(config, SB_DIAGNOSTICS_GZIP, -1, 0, false);
+    }
+
+    SECTION("Add control_handler")
+    {
+        auto callback = [](const char *, const char *, void *) {};
+        sb_config_add_control_handler(config, "custom", nullptr, nullptr, callback, nullptr);
+        sb_config_add_control_handler(config, "action", "MSG", "custom", callback, nullptr);
+        sb_config_add_control_handler(config, nullptr, nullptr, nullptr, callback, nullptr);
+        sb_config_add_control_handler(config, "custom", nullptr, nullptr, nullptr, nullptr);
+    }
+
     SECTION("Set threads_priority")
     {
         sb_config_set_threads_priority(config, 0);
@@ -119,6 +176,12 @@ TEST_CASE("sb_config_t setters", "[Config][C]")
         sb_config_set_encrypted_key(config, "encrypted_key_data");
     }
 
+    SECTION("Set signing_key_cache_ttl")
+    {
+        sb_config_set_signing_key_cache_ttl(config, 60);
+        sb_config_set_signing_key_cache_ttl(config, -1);
+    }
+
     sb_config_destroy(config);
 }
 
@@ -132,9 +195,18 @@ TEST_CASE("sb_config_t null safety", "[Config][C]")
     sb_config_set_uuid(nullptr, "uuid");
     sb_config_set_serial_number(nullptr, 123);
     sb_config_set_auto_download_player_pics(nullptr, true);
+    sb_config_set_picture_cache_dir(nullptr, "/tmp");
+    sb_config_set_leaderboard_cache_ttl(nullptr, 30, 300);
+    sb_config_set_leaderboard_prefetch(nullptr, nullptr, 0, 0);
+    sb_config_set_local_scores_path(nullptr, "/tmp/scores.bin");
+    sb_config_set_flight_recorder_path(nullptr, "/tmp/flight_recorder.bin");
+    sb_config_set_warm_start_cache_path(nullptr, "/tmp/warm_start.json");
+    sb_config_set_diagnostics_archive(nullptr, SB_DIAGNOSTICS_ZSTD, 3, 4, true);
+    sb_config_add_control_handler(nullptr, "custom", nullptr, nullptr, nullptr, nullptr);
     sb_config_set_threads_priority(nullptr, 10);
     sb_config_set_score_features(nullptr, nullptr, 0, 0);
     sb_config_set_encrypted_key(nullptr, "key");
+    sb_config_set_signing_key_cache_ttl(nullptr, 300);
 }
 
 // =================================================================================================
@@ -225,6 +297,58 @@ TEST_CASE("Config setters", "[Config][C++]")
         REQUIRE(config.isValid());
     }
 
+    SECTION("Set picture_cache_dir")
+    {
+        config.setPictureCacheDir("/tmp/scorbit_pictures");
+        REQUIRE(config.isValid());
+    }
+
+    SECTION("Set leaderboard_cache_ttl")
+    {
+        config.setLeaderboardCacheTtl(60);
+        REQUIRE(config.isValid());
+    }
+
+    SECTION("Set leaderboard_prefetch")
+    {
+        config.setLeaderboardPrefetch({{LeaderboardScope::Machine, LeaderboardPeriod::AllTime},
+                                       {LeaderboardScope::Game, LeaderboardPeriod::Days30}},
+                                      600);
+        REQUIRE(config.isValid());
+    }
+
+    SECTION("Set local_scores_path")
+    {
+        config.setLocalScoresPath("/tmp/scores.bin");
+        REQUIRE(config.isValid());
+    }
+
+    SECTION("Set flight_recorder_path")
+    {
+        config.setFlightRecorderPath("/tmp/flight_recorder.bin");
+        REQUIRE(config.isValid());
+    }
+
+    SECTION("Set warm_start_cache_path")
+    {
+        config.setWarmStartCachePath("/tmp/warm_start.json");
+        REQUIRE(config.isValid());
+    }
+
+    SECTION("Set diagnostics_archive")
+    {
+        config.setDiagnosticsArchive(DiagnosticsCompression::Zstd, 3, 4, true);
+        REQUIRE(config.isValid());
+    }
+
+    SECTION("Add control_handler")
+    {
+        config.addControlHandler("custom", "", "", [](const std::string &, const std::string &) {})
+                .addControlHandler("action", "MSG", "custom",
+                                   [](const std::string &, const std::string &) {});
+        REQUIRE(config.isValid());
+    }
+
     SECTION("Set threads_priority")
     {
         config.setThreadsPriority(0);
@@ -259,6 +383,12 @@ TEST_CASE("Config setters", "[Config][C++]")
         config.setEncryptedKey("encrypted_key_data");
         REQUIRE(config.isValid());
     }
+
+    SECTION("Set signing_key_cache_ttl")
+    {
+        config.setSigningKeyCacheTtl(60);
+        REQUIRE(config.isValid());
+    }
 }
 
 TEST_CASE("Config move semantics", "[Config][C++]")
@@ -52,6 +52,28 @@ static MunitResult test_sb_add_logger_callback(const MunitParameter params[], vo
     return MUNIT_OK;
 }
 
+static void logBatchCallback(const sb_log_record_t *records, size_t count, void *userData)
+{
+    if (count > 0) {
+        logCallback(records[count - 1].message, records[count - 1].level, records[count - 1].file,
+                    records[count - 1].line, records[count - 1].timestamp, userData);
+    }
+}
+
+static MunitResult test_sb_log_set_batch_callback(const MunitParameter params[], void *user_data)
+{
+    (void)params;
+    (void)user_data;
+
+    UserData data;
+    sb_log_set_batch_callback(logBatchCallback, &data, 16, 50, 512);
+    sb_log_set_batch_callback(NULL, NULL, 0, 0, 0);
+    sb_log_set_batch_callback(logBatchCallback, &data, 0, 0, 512);
+    sb_reset_logger();
+
+    return MUNIT_OK;
+}
+
 static MunitResult test_sb_logger_callbacks_supported(const MunitParameter params[], void *user_data)
 {
     (void)params;
@@ -65,12 +87,63 @@ static MunitResult test_sb_logger_callbacks_supported(const MunitParameter param
     return MUNIT_OK;
 }
 
+static MunitResult test_sb_log_set_level(const MunitParameter params[], void *user_data)
+{
+    (void)params;
+    (void)user_data;
+
+    munit_assert_int(sb_log_get_level(), ==, SB_DEBUG);
+    sb_log_set_level(SB_WARN);
+    munit_assert_int(sb_log_get_level(), ==, SB_WARN);
+    sb_log_set_level(SB_DEBUG);
+    munit_assert_int(sb_log_get_level(), ==, SB_DEBUG);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_sb_log_set_deferred_format(const MunitParameter params[],
+                                                   void *user_data)
+{
+    (void)params;
+    (void)user_data;
+
+    sb_log_set_deferred_format(true, 0);
+    sb_log_set_deferred_format(false, 16 * 1024);
+    munit_assert_uint64(sb_log_dropped_count(), ==, 0);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_sb_log_rate_limited_sites(const MunitParameter params[], void *user_data)
+{
+    (void)params;
+    (void)user_data;
+
+    sb_log_site_stats_t stats[64];
+    size_t count = sb_log_rate_limited_sites(NULL, 0);
+    munit_assert_size(sb_log_rate_limited_sites(stats, 64), >=, count);
+    for (size_t i = 0; i < count && i < 64; ++i) {
+        munit_assert_not_null(stats[i].file);
+        munit_assert_int(stats[i].line, >, 0);
+    }
+
+    return MUNIT_OK;
+}
+
 // Test suite setup
 static MunitTest tests[] = {
     {"/sb_add_logger_callback/add_callback", test_sb_add_logger_callback, NULL, NULL,
      MUNIT_TEST_OPTION_NONE, NULL},
+    {"/sb_log_set_batch_callback/set_and_reset", test_sb_log_set_batch_callback, NULL, NULL,
+     MUNIT_TEST_OPTION_NONE, NULL},
     {"/sb_logger_callbacks_supported/matches_build", test_sb_logger_callbacks_supported, NULL, NULL,
      MUNIT_TEST_OPTION_NONE, NULL},
+    {"/sb_log_set_level/set_and_get", test_sb_log_set_level, NULL, NULL, MUNIT_TEST_OPTION_NONE,
+     NULL},
+    {"/sb_log_set_deferred_format/toggle", test_sb_log_set_deferred_format, NULL, NULL,
+     MUNIT_TEST_OPTION_NONE, NULL},
+    {"/sb_log_rate_limited_sites/query", test_sb_log_rate_limited_sites, NULL, NULL,
+     MUNIT_TEST_OPTION_NONE, NULL},
     {NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL},
 };
 
@@ -29,6 +29,7 @@ from ctypes import (
     c_uint32,
     c_uint64,
     c_void_p,
+    Structure,
 )
 
 from ._loader import _lib
@@ -74,6 +75,10 @@ sb_signer_callback_t = CFUNCTYPE(
     c_void_p,               # user_data
 )
 
+# void (*sb_control_message_callback_t)(const char *type, const char *payload_json,
+#                                        void *user_data)
+sb_control_message_callback_t = CFUNCTYPE(None, c_char_p, c_char_p, c_void_p)
+
 # void (*sb_save_key_callback_t)(const char *key, void *user_data)
 sb_save_key_callback_t = CFUNCTYPE(None, c_char_p, c_void_p)
 
@@ -93,6 +98,23 @@ sb_log_callback_t = CFUNCTYPE(
     c_void_p,   # user_data
 )
 
+
+
+class sb_log_record_t(Structure):
+    """Log message of ``sb_log_batch_callback_t``."""
+
+    _fields_ = [
+        ("message", c_char_p),
+        ("level", c_int),
+        ("file", c_char_p),
+        ("line", c_int),
+        ("timestamp", c_int64),
+    ]
+
+
+# void (*sb_log_batch_callback_t)(const sb_log_record_t *records, size_t count, void *user_data)
+sb_log_batch_callback_t = CFUNCTYPE(None, POINTER(sb_log_record_t), c_size_t, c_void_p)
+
 # ---------------------------------------------------------------------------
 # config_c.h
 # ---------------------------------------------------------------------------
@@ -137,6 +159,30 @@ _lib.sb_config_set_serial_number.argtypes = [sb_config_t, c_uint64]
 _lib.sb_config_set_auto_download_player_pics.restype = None
 _lib.sb_config_set_auto_download_player_pics.argtypes = [sb_config_t, c_bool]
 
+# void sb_config_set_picture_cache_dir(sb_config_t, const char*)
+_lib.sb_config_set_picture_cache_dir.restype = None
+_lib.sb_config_set_picture_cache_dir.argtypes = [sb_config_t, c_char_p]
+
+# void sb_config_set_leaderboard_cache_ttl(sb_config_t, int, int)
+_lib.sb_config_set_leaderboard_cache_ttl.restype = None
+_lib.sb_config_set_leaderboard_cache_ttl.argtypes = [sb_config_t, c_int, c_int]
+
+# void sb_config_set_local_scores_path(sb_config_t, const char*)
+_lib.sb_config_set_local_scores_path.restype = None
+_lib.sb_config_set_local_scores_path.argtypes = [sb_config_t, c_char_p]
+
+# void sb_config_set_flight_recorder_path(sb_config_t, const char*)
+_lib.sb_config_set_flight_recorder_path.restype = None
+_lib.sb_config_set_flight_recorder_path.argtypes = [sb_config_t, c_char_p]
+
+# void sb_config_set_warm_start_cache_path(sb_config_t, const char*)
+_lib.sb_config_set_warm_start_cache_path.restype = None
+_lib.sb_config_set_warm_start_cache_path.argtypes = [sb_config_t, c_char_p]
+
+# void sb_config_set_diagnostics_archive(sb_config_t, sb_diagnostics_compression_t, int, int, bool)
+_lib.sb_config_set_diagnostics_archive.restype = None
+_lib.sb_config_set_diagnostics_archive.argtypes = [sb_config_t, c_int, c_int, c_int, c_bool]
+
 # void sb_config_set_threads_priority(sb_config_t, int)
 _lib.sb_config_set_threads_priority.restype = None
 _lib.sb_config_set_threads_priority.argtypes = [sb_config_t, c_int]
@@ -154,6 +200,10 @@ _lib.sb_config_set_score_features.argtypes = [
 _lib.sb_config_set_encrypted_key.restype = None
 _lib.sb_config_set_encrypted_key.argtypes = [sb_config_t, c_char_p]
 
+# void sb_config_set_signing_key_cache_ttl(sb_config_t, int)
+_lib.sb_config_set_signing_key_cache_ttl.restype = None
+_lib.sb_config_set_signing_key_cache_ttl.argtypes = [sb_config_t, c_int]
+
 # void sb_config_set_signer(sb_config_t, sb_signer_callback_t, void*)
 _lib.sb_config_set_signer.restype = None
 _lib.sb_config_set_signer.argtypes = [sb_config_t, sb_signer_callback_t, c_void_p]
@@ -178,6 +228,13 @@ _lib.sb_config_set_extra_fingerprint.argtypes = [sb_config_t, c_char_p]
 _lib.sb_config_set_event_callback.restype = None
 _lib.sb_config_set_event_callback.argtypes = [sb_config_t, sb_event_callback_t, c_void_p]
 
+# void sb_config_add_control_handler(sb_config_t, const char*, const char*, const char*,
+#                                    sb_control_message_callback_t, void*)
+_lib.sb_config_add_control_handler.restype = None
+_lib.sb_config_add_control_handler.argtypes = [
+    sb_config_t, c_char_p, c_char_p, c_char_p, sb_control_message_callback_t, c_void_p,
+]
+
 # void sb_config_set_save_key_callback(sb_config_t, sb_save_key_callback_t, void*)
 _lib.sb_config_set_save_key_callback.restype = None
 _lib.sb_config_set_save_key_callback.argtypes = [sb_config_t, sb_save_key_callback_t, c_void_p]
@@ -499,6 +556,21 @@ if _has_logger:
     _lib.sb_add_logger_callback.restype = None
     _lib.sb_add_logger_callback.argtypes = [sb_log_callback_t, c_void_p, c_size_t]
 
+    if hasattr(_lib, "sb_log_set_batch_callback"):
+        # void sb_log_set_batch_callback(sb_log_batch_callback_t, void*, size_t, int, size_t)
+        _lib.sb_log_set_batch_callback.restype = None
+        _lib.sb_log_set_batch_callback.argtypes = [
+            sb_log_batch_callback_t, c_void_p, c_size_t, c_int, c_size_t,
+        ]
+
     # void sb_reset_logger(void)
     _lib.sb_reset_logger.restype = None
     _lib.sb_reset_logger.argtypes = []
+
+# void sb_log_set_level(sb_log_level_t) / sb_log_level_t sb_log_get_level(void)
+_has_log_level = hasattr(_lib, "sb_log_set_level")
+if _has_log_level:
+    _lib.sb_log_set_level.restype = None
+    _lib.sb_log_set_level.argtypes = [c_int]
+    _lib.sb_log_get_level.restype = c_int
+    _lib.sb_log_get_level.argtypes = []
@@ -56,6 +56,9 @@ class LeaderboardScope(IntEnum):
     Game = 2
     """Shared game leaderboard across variants."""
 
+    Local = 3
+    """Scores played on this machine, answered without network."""
+
 
 class LeaderboardPeriod(IntEnum):
     """Time bucket to query for leaderboard results."""
@@ -92,6 +95,16 @@ class LeaderboardVpinFilter(IntEnum):
     """Exclude virtual pinball scores."""
 
 
+class DiagnosticsCompression(IntEnum):
+    """Compression of the diagnostics archive."""
+
+    Gzip = 0
+    """tar.gz, single threaded."""
+
+    Zstd = 1
+    """tar.zst, multi-threaded, gzip if the SDK's libarchive lacks zstd."""
+
+
 class Capability(IntFlag):
     """Device capability flags (combine with bitwise OR)."""
 
@@ -346,7 +346,8 @@ class GameState(object):
 
         Args:
             scope: :class:`LeaderboardScope` or integer value selecting
-                machine vs variant vs game leaderboard.
+                machine vs variant vs game leaderboard, or local one answered
+                without network.
             period: :class:`LeaderboardPeriod` or integer value selecting
                 the backend time bucket.
             since: Optional UTC ISO-8601 lower-bound time filter. When set,
@@ -43,6 +43,7 @@ from ._version import __version__
 from ._enums import (
     AuthStatus,
     Capability,
+    DiagnosticsCompression,
     Error,
     EventType,
     GameStartOrigin,
@@ -64,12 +65,14 @@ from .event import Event
 from .game_state import GameState, create_game_state
 
 # -- logger API (only when the native library wires callbacks; spdlog builds omit it).
+from ._bindings import _has_log_level as _has_log_level
 from ._bindings import _has_logger as _has_logger, _lib as _lib
 
 if _has_logger:
     import traceback as _traceback
 
     from . import config as _config_mod
+    from ._bindings import sb_log_batch_callback_t as _sb_log_batch_callback_t
     from ._bindings import sb_log_callback_t as _sb_log_callback_t
 
     _logger_prevent_gc = []  # type: list
@@ -106,6 +109,48 @@ if _has_logger:
         _logger_prevent_gc.append(_trampoline)
         _lib.sb_add_logger_callback(_trampoline, None, max_length)
 
+    def set_logger_batch_callback(callback, max_count=0, max_delay_ms=0, max_length=512):
+        # type: (..., int, int, int) -> None
+        """Register a callback receiving log messages in batches.
+
+        One call per batch saves the per-message cost of crossing into Python.
+        The callback receives a list of ``(message, level, file, line, timestamp)``
+        tuples, oldest first::
+
+            def my_logger(records: list) -> None:
+                for message, level, file, line, timestamp in records:
+                    ...
+
+        Args:
+            callback: The batch logger function, ``None`` removes it.
+            max_count: Maximum messages in a batch, ``0`` - default (64).
+            max_delay_ms: Maximum delay of a message, ``0`` - default (100 ms).
+            max_length: Maximum log message length.
+        """
+        if callback is None:
+            _lib.sb_log_set_batch_callback(_sb_log_batch_callback_t(), None, 0, 0, 0)
+            return
+
+        def _decode(value):
+            if isinstance(value, bytes):
+                return value.decode("utf-8", "replace")
+            return value or ""
+
+        @_sb_log_batch_callback_t
+        def _trampoline(records, count, user_data):
+            if _config_mod._shutting_down:
+                return
+            try:
+                callback([
+                    (_decode(r.message), LogLevel(r.level), _decode(r.file), r.line, r.timestamp)
+                    for r in (records[i] for i in range(count))
+                ])
+            except Exception:
+                _traceback.print_exc()
+
+        _logger_prevent_gc.append(_trampoline)
+        _lib.sb_log_set_batch_callback(_trampoline, None, max_count, max_delay_ms, max_length)
+
     def reset_logger():
         # type: () -> None
         """Remove all previously registered logger callbacks."""
@@ -113,12 +158,25 @@ if _has_logger:
         del _logger_prevent_gc[:]
 
 
+if _has_log_level:
+
+    def set_log_level(level):
+        # type: (LogLevel) -> None
+        """Drop SDK log messages below ``level`` before they are formatted."""
+        _lib.sb_log_set_level(int(level))
+
+    def get_log_level():
+        # type: () -> LogLevel
+        """Minimal level of SDK log messages."""
+        return LogLevel(_lib.sb_log_get_level())
+
 __all__ = [
     # Version
     "__version__",
     # Enums
     "AuthStatus",
     "Capability",
+    "DiagnosticsCompression",
     "Error",
     "EventType",
     "GameStartOrigin",
@@ -142,4 +200,7 @@ __all__ = [
 ]
 
 if _has_logger:
-    __all__ = __all__ + ["add_logger_callback", "reset_logger"]
+    __all__ = __all__ + ["add_logger_callback", "set_logger_batch_callback", "reset_logger"]
+
+if _has_log_level:
+    __all__ = __all__ + ["set_log_level", "get_log_level"]
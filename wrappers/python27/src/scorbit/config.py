@@ -25,6 +25,7 @@ from ._bindings import (
     SB_DIGEST_LENGTH,
     SB_SIGNATURE_MAX_LENGTH,
     _lib,
+    sb_control_message_callback_t,
     sb_event_callback_t,
     sb_load_key_callback_t,
     sb_save_key_callback_t,
@@ -176,6 +177,44 @@ class Config(object):
         _lib.sb_config_set_auto_download_player_pics(self._handle, enable)
         return self
 
+    def set_picture_cache_dir(self, path):
+        # type: (str) -> Config
+        """Directory to persist downloaded player pictures between runs."""
+        _lib.sb_config_set_picture_cache_dir(self._handle, _encode(path))
+        return self
+
+    def set_leaderboard_cache_ttl(self, ttl, stale_window=300):
+        # type: (int, int) -> Config
+        """Seconds leaderboards are cached, then served stale while refreshed."""
+        _lib.sb_config_set_leaderboard_cache_ttl(self._handle, ttl, stale_window)
+        return self
+
+    def set_local_scores_path(self, path):
+        # type: (str) -> Config
+        """File to keep final scores played here for ``LeaderboardScope.Local``."""
+        _lib.sb_config_set_local_scores_path(self._handle, _encode(path))
+        return self
+
+    def set_flight_recorder_path(self, path):
+        # type: (str) -> Config
+        """File to keep recent SDK logs and events in, added to uploaded diagnostics."""
+        _lib.sb_config_set_flight_recorder_path(self._handle, _encode(path))
+        return self
+
+    def set_warm_start_cache_path(self, path):
+        # type: (str) -> Config
+        """File to keep machine state in between runs, used at start until revalidated."""
+        _lib.sb_config_set_warm_start_cache_path(self._handle, _encode(path))
+        return self
+
+    def set_diagnostics_archive(self, compression, level=0, threads=1, stream_upload=False):
+        # type: (int, int, int, bool) -> Config
+        """``DiagnosticsCompression`` of uploaded diagnostics, optionally sent while created."""
+        _lib.sb_config_set_diagnostics_archive(
+            self._handle, int(compression), level, threads, stream_upload
+        )
+        return self
+
     def set_threads_priority(self, priority):
         # type: (int) -> Config
         """Nice / QOS for SDK background threads; ``0`` leaves scheduling unchanged (default)."""
@@ -216,6 +255,12 @@ class Config(object):
         _lib.sb_config_set_encrypted_key(self._handle, _encode(encrypted_key))
         return self
 
+    def set_signing_key_cache_ttl(self, ttl):
+        # type: (int) -> Config
+        """Idle seconds the decrypted key is kept for signing, 0 keeps nothing."""
+        _lib.sb_config_set_signing_key_cache_ttl(self._handle, ttl)
+        return self
+
     def set_signer(self, callback):
         # type: (...) -> Config
         """Set a TPM signer callback for authentication.
@@ -290,6 +335,46 @@ class Config(object):
         _lib.sb_config_set_event_callback(self._handle, _trampoline, None)
         return self
 
+    # ------------------------------------------------------------------
+    # Control channel handlers
+    # ------------------------------------------------------------------
+
+    def add_control_handler(self, message_type, callback, method=None, action=None):
+        # type: (str, ..., str | None, str | None) -> Config
+        """Handle custom messages published to the machine control channel.
+
+        Callback signature::
+
+            def on_message(type: str, payload: str) -> None:
+                data = json.loads(payload)
+
+        Args:
+            message_type: Message ``type`` to match.
+            callback: Receives the message type and its JSON payload.
+            method: Payload ``method`` to match, ``None`` - any.
+            action: Payload ``name`` to match, ``None`` - any.
+
+        Note:
+            Handlers can't replace the SDK ones. The callback is invoked from
+            a background thread.
+        """
+
+        @sb_control_message_callback_t
+        def _trampoline(msg_type, payload, user_data):
+            if _shutting_down:
+                return
+            try:
+                callback(msg_type.decode("utf-8", errors="replace"),
+                         payload.decode("utf-8", errors="replace"))
+            except Exception:
+                traceback.print_exc()
+
+        self._prevent_gc.append(_trampoline)
+        _lib.sb_config_add_control_handler(
+            self._handle, _encode(message_type), _encode(method), _encode(action), _trampoline, None
+        )
+        return self
+
     # ------------------------------------------------------------------
     # Key persistence callbacks
     # ------------------------------------------------------------------